@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define CONSUMERS 8
+#define ROUNDS 2000
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    size_t sizes[] = { 256, 64 * 1024, 1024 * 1024 };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t size = sizes[s];
+        char* body = malloc(size);
+        for (size_t i = 0; i < size; i++) {
+            body[i] = 'a' + i % 26;
+        }
+
+        ds_String* request = ds_init_string_n(body, size);
+        ds_String consumers[CONSUMERS];
+        size_t checksum = 0;
+
+        // what a copying clone costs, every consumer gets its own buffer
+        double start = now();
+        for (int round = 0; round < ROUNDS; round++) {
+            for (int c = 0; c < CONSUMERS; c++) {
+                ds_string_init_inplace_n(&consumers[c], ds_data(request), ds_length(request));
+            }
+            for (int c = 0; c < CONSUMERS; c++) {
+                checksum += ds_data(&consumers[c])[round % size];
+                ds_string_deinit(&consumers[c]);
+            }
+        }
+        double copy_time = now() - start;
+
+        start = now();
+        for (int round = 0; round < ROUNDS; round++) {
+            for (int c = 0; c < CONSUMERS; c++) {
+                ds_string_init_inplace(&consumers[c], "");
+                ds_clone(&consumers[c], request);
+            }
+            for (int c = 0; c < CONSUMERS; c++) {
+                checksum += ds_data(&consumers[c])[round % size];
+                ds_string_deinit(&consumers[c]);
+            }
+        }
+        double clone_time = now() - start;
+
+        double count = (double)ROUNDS * CONSUMERS;
+        printf("%8zu bytes  copy: %9.1f ns/consumer  ds_clone: %6.1f ns/consumer\n",
+               size, copy_time / count * 1e9, clone_time / count * 1e9);
+        printf("(checksum %zu)\n", checksum);
+
+        ds_free_string(request);
+        free(body);
+    }
+
+    return 0;
+}
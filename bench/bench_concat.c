@@ -0,0 +1,67 @@
+
+#include <stdio.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define ITERATIONS 1000000
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    const char* fragments[] = {
+        "2024-05-01T12:00:00Z", " ", "INFO", " ", "[worker-17]", " ",
+        "request_id=", "9f2c1a7e-4b1d-4c55-9a0e-2f1d7c3b8e11", " ",
+        "path=", "/api/v1/items/123456", " status=200",
+    };
+    size_t count = sizeof(fragments) / sizeof(fragments[0]);
+
+    ds_StringView parts[sizeof(fragments) / sizeof(fragments[0])];
+    for (size_t i = 0; i < count; i++) {
+        parts[i] = ds_string_view_from_cstr(fragments[i]);
+    }
+
+    size_t checksum = 0;
+
+    double start = now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ds_String line = DS_STRING_INIT;
+        for (size_t j = 0; j < count; j++) {
+            ds_append(&line, fragments[j]);
+        }
+        checksum += ds_length(&line);
+        ds_string_deinit(&line);
+    }
+    double append_time = now() - start;
+
+    start = now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ds_String line = DS_STRING_INIT;
+        ds_concat(&line, parts, count);
+        checksum += ds_length(&line);
+        ds_string_deinit(&line);
+    }
+    double concat_time = now() - start;
+
+    // reused buffer, the steady state of a logger
+    ds_String line = DS_STRING_INIT;
+    start = now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ds_clear(&line);
+        ds_concat(&line, parts, count);
+        checksum += ds_length(&line);
+    }
+    double reuse_time = now() - start;
+    ds_string_deinit(&line);
+
+    printf("chained ds_append: %8.1f ns/line\n", append_time / ITERATIONS * 1e9);
+    printf("ds_concat:         %8.1f ns/line\n", concat_time / ITERATIONS * 1e9);
+    printf("ds_concat reused:  %8.1f ns/line\n", reuse_time / ITERATIONS * 1e9);
+    printf("(checksum %zu)\n", checksum);
+
+    return 0;
+}
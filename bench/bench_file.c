@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define FILE_SIZE (256u * 1024 * 1024)
+#define CHUNK (64 * 1024)
+#define ROUNDS 5
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// one byte per page, enough to fault every page of a mapping in
+static size_t touch(const char* data, size_t size) {
+    size_t sum = 0;
+    for (size_t i = 0; i < size; i += 4096) {
+        sum += (unsigned char)data[i];
+    }
+    return sum;
+}
+
+int main() {
+    const char* path = "bench_file.tmp";
+    FILE* out = fopen(path, "wb");
+    if (!out) return 1;
+
+    char* line = malloc(CHUNK);
+    for (size_t i = 0; i < CHUNK; i++) {
+        line[i] = (i % 100 == 99) ? '\n' : 'a' + i % 26;
+    }
+    for (size_t written = 0; written < FILE_SIZE; written += CHUNK) {
+        fwrite(line, 1, CHUNK, out);
+    }
+    fclose(out);
+
+    size_t checksum = 0;
+    double fread_time = 0, read_time = 0, map_time = 0;
+
+    // page cache is warm after the first round, so this compares the copies and not the disk
+    for (int round = 0; round < ROUNDS; round++) {
+        // the old way, stdio into a temp buffer and appended from there
+        double start = now();
+        ds_String* appended = ds_init_string("");
+        FILE* in = fopen(path, "rb");
+        size_t got;
+        while ((got = fread(line, 1, CHUNK, in)) > 0) {
+            ds_append_view(appended, &(ds_StringView){ line, (uint32_t)got });
+        }
+        fclose(in);
+        checksum += touch(ds_data(appended), ds_length(appended));
+        ds_free_string(appended);
+        fread_time += now() - start;
+
+        start = now();
+        ds_String* read = ds_init_string("");
+        ds_read_file(read, path);
+        checksum += touch(ds_data(read), ds_length(read));
+        ds_free_string(read);
+        read_time += now() - start;
+
+        start = now();
+        ds_MappedFile file;
+        ds_map_file(&file, path, DS_FILE_SEQUENTIAL | DS_FILE_WILLNEED);
+        checksum += touch(file.data, file.size);
+        ds_unmap_file(&file);
+        map_time += now() - start;
+    }
+
+    double mib = (double)FILE_SIZE / (1024 * 1024) * ROUNDS;
+    printf("%u MiB  fread + ds_append: %7.0f MiB/s  ds_read_file: %7.0f MiB/s  ds_map_file: %7.0f MiB/s\n",
+           FILE_SIZE >> 20, mib / fread_time, mib / read_time, mib / map_time);
+    printf("(checksum %zu)\n", checksum);
+
+    remove(path);
+    free(line);
+    return 0;
+}
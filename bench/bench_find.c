@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define LOG_SIZE (256u * 1024 * 1024)
+#define ROUNDS 4
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    // log lines between 40 and 200 bytes
+    char* log = malloc(LOG_SIZE);
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (size_t i = 0; i < LOG_SIZE;) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t line = 40 + state % 160;
+        for (size_t j = 0; j < line && i < LOG_SIZE; j++, i++) {
+            log[i] = 'a' + (i + j) % 26;
+        }
+        if (i < LOG_SIZE) log[i++] = '\n';
+    }
+    ds_StringView view = ds_string_view_from_buffer(log, LOG_SIZE);
+
+    size_t checksum = 0;
+
+    double start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        const char* p = log;
+        const char* end = log + LOG_SIZE;
+        while ((p = memchr(p, '\n', end - p))) {
+            checksum++;
+            p++;
+        }
+    }
+    double memchr_time = now() - start;
+
+    start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        checksum += ds_string_view_count_char(&view, '\n');
+    }
+    double count_time = now() - start;
+
+    // a needle that is never there measures the raw scan speed,
+    // volatile so the compiler cant hoist memchr out of the loop
+    volatile char missing = '#';
+    start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        checksum += memchr(log, missing, LOG_SIZE) == NULL;
+    }
+    double memchr_scan_time = now() - start;
+
+    start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        checksum += ds_string_view_find_char(&view, missing) < 0;
+    }
+    double find_time = now() - start;
+
+    start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        checksum += ds_string_view_rfind_char(&view, missing) < 0;
+    }
+    double rfind_time = now() - start;
+
+    double gigabytes = (double)LOG_SIZE * ROUNDS / 1e9;
+    printf("memchr line count:          %6.2f GB/s\n", gigabytes / memchr_time);
+    printf("ds_string_view_count_char:  %6.2f GB/s\n", gigabytes / count_time);
+    printf("memchr scan:                %6.2f GB/s\n", gigabytes / memchr_scan_time);
+    printf("ds_string_view_find_char:   %6.2f GB/s\n", gigabytes / find_time);
+    printf("ds_string_view_rfind_char:  %6.2f GB/s\n", gigabytes / rfind_time);
+    printf("(checksum %zu)\n", checksum);
+
+    free(log);
+
+    return 0;
+}
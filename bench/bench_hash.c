@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define KEYS (1u << 20)
+#define ROUNDS 16
+#define BLOCK_SIZE (64u * 1024 * 1024)
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// fnv-1a, the usual hand rolled string hash
+static uint64_t fnv1a(const char* data, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+int main() {
+    // identifier like keys between 4 and 40 bytes
+    ds_StringView* keys = malloc(KEYS * sizeof(ds_StringView));
+    char* storage = malloc(KEYS * 40);
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (size_t i = 0; i < KEYS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t length = 4 + state % 37;
+        char* key = storage + i * 40;
+        for (size_t j = 0; j < length; j++) {
+            key[j] = 'a' + (state >> (j % 48)) % 26;
+        }
+        keys[i] = ds_string_view_from_buffer(key, length);
+    }
+
+    uint64_t checksum = 0;
+
+    double start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (size_t i = 0; i < KEYS; i++) {
+            checksum += fnv1a(keys[i].data, keys[i].length);
+        }
+    }
+    double fnv_time = now() - start;
+
+    start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (size_t i = 0; i < KEYS; i++) {
+            checksum += ds_string_view_hash(&keys[i], round);
+        }
+    }
+    double hash_time = now() - start;
+
+    // the cached path, the same heap string hashed over and over
+    ds_String* string = ds_init_string("a heap string that is used as a key again and again");
+    start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (size_t i = 0; i < KEYS; i++) {
+            checksum += ds_string_hash(string);
+        }
+    }
+    double cached_time = now() - start;
+    ds_free_string(string);
+
+    char* block = malloc(BLOCK_SIZE);
+    for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        block[i] = (char)(i * 131);
+    }
+
+    start = now();
+    for (int round = 0; round < 4; round++) {
+        checksum += fnv1a(block, BLOCK_SIZE);
+    }
+    double fnv_bulk_time = now() - start;
+
+    start = now();
+    for (int round = 0; round < 4; round++) {
+        checksum += ds_hash_bytes(block, BLOCK_SIZE, round);
+    }
+    double bulk_time = now() - start;
+
+    double count = (double)KEYS * ROUNDS;
+    double gigabytes = (double)BLOCK_SIZE * 4 / 1e9;
+    printf("fnv1a keys:                 %6.2f ns/key\n", fnv_time / count * 1e9);
+    printf("ds_string_view_hash keys:   %6.2f ns/key\n", hash_time / count * 1e9);
+    printf("ds_string_hash cached:      %6.2f ns/key\n", cached_time / count * 1e9);
+    printf("fnv1a bulk:                 %6.2f GB/s\n", gigabytes / fnv_bulk_time);
+    printf("ds_hash_bytes bulk:         %6.2f GB/s\n", gigabytes / bulk_time);
+    printf("(checksum %llu)\n", (unsigned long long)checksum);
+
+    free(block);
+    free(storage);
+    free(keys);
+
+    return 0;
+}
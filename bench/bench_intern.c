@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define NAMES 300000
+#define EVENTS (1u << 22)
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    // a stream of tag names drawn from a fixed vocabulary
+    char (*names)[40] = malloc(NAMES * sizeof(*names));
+    for (size_t i = 0; i < NAMES; i++) {
+        snprintf(names[i], sizeof(names[i]), "service.request.tag.%zu", i);
+    }
+    uint32_t* events = malloc(EVENTS * sizeof(uint32_t));
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (size_t i = 0; i < EVENTS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        events[i] = state % NAMES;
+    }
+
+    size_t checksum = 0;
+
+    // one ds_String per event, compared against the previous one
+    ds_String** strings = malloc(EVENTS * sizeof(ds_String*));
+    double start = now();
+    for (size_t i = 0; i < EVENTS; i++) {
+        strings[i] = ds_init_string(names[events[i]]);
+        checksum += i > 0 && ds_equal(strings[i], strings[i - 1]);
+    }
+    double copy_time = now() - start;
+    for (size_t i = 0; i < EVENTS; i++) {
+        ds_free_string(strings[i]);
+    }
+    free(strings);
+
+    const ds_String** interned = malloc(EVENTS * sizeof(ds_String*));
+    start = now();
+    for (size_t i = 0; i < EVENTS; i++) {
+        ds_StringView view = ds_string_view_from_cstr(names[events[i]]);
+        interned[i] = ds_intern(&view);
+        checksum += i > 0 && interned[i] == interned[i - 1];
+    }
+    double intern_time = now() - start;
+
+    // every name is interned now, this is the lock free path
+    start = now();
+    for (size_t i = 0; i < EVENTS; i++) {
+        ds_StringView view = ds_string_view_from_cstr(names[events[i]]);
+        checksum += ds_intern(&view) == interned[i];
+    }
+    double hit_time = now() - start;
+
+    // interned strings are read through the const accessors
+    for (size_t i = 0; i < EVENTS; i++) {
+        ds_StringView view = ds_string_view_from_string(interned[i]);
+        if (view.length != strlen(names[events[i]]) || strcmp(ds_cdata(interned[i]), names[events[i]]) != 0) {
+            fprintf(stderr, "interned string %zu does not match its name\n", i);
+            return 1;
+        }
+    }
+    free(interned);
+
+    printf("ds_init_string + ds_equal:  %6.1f ns/event, %zu strings live\n", copy_time / EVENTS * 1e9, (size_t)EVENTS);
+    printf("ds_intern (cold):           %6.1f ns/event, %zu strings live\n", intern_time / EVENTS * 1e9, (size_t)NAMES);
+    printf("ds_intern (all hits):       %6.1f ns/event\n", hit_time / EVENTS * 1e9);
+    printf("(checksum %zu)\n", checksum);
+
+    free(events);
+    free(names);
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <drings/drings.h>
+
+#define LINES (2 * 1000 * 1000)
+#define ROUNDS 5
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    const char* path = "bench_lines.tmp";
+    FILE* out = fopen(path, "wb");
+    if (!out) return 1;
+
+    // log shaped lines between 20 and 200 bytes
+    size_t bytes = 0;
+    for (int i = 0; i < LINES; i++) {
+        int width = 20 + (int)((i * 7919u) % 180);
+        bytes += fprintf(out, "%08d INFO %.*s\n", i, width - 14,
+                         "request handled in 12ms path=/api/v1/items/42 user=alice status=200 bytes=1532 "
+                         "agent=curl/8.0 referer=- upstream=10.0.0.7:8080 cache=miss region=eu-west-1 trace=9f2c");
+    }
+    fclose(out);
+
+    size_t checksum = 0;
+    double getline_time = 0, reader_time = 0;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        // the old loop, one allocation per line
+        double start = now();
+        FILE* in = fopen(path, "rb");
+        char* line = NULL;
+        size_t line_capacity = 0;
+        ssize_t length;
+        while ((length = getline(&line, &line_capacity, in)) > 0) {
+            ds_String* string = ds_init_string_n(line, (size_t)length - 1);
+            checksum += ds_length(string);
+            ds_free_string(string);
+        }
+        free(line);
+        fclose(in);
+        getline_time += now() - start;
+
+        start = now();
+        int fd = open(path, O_RDONLY);
+        ds_LineReader reader;
+        ds_line_reader_init(&reader, fd, 0, 0);
+        ds_StringView view;
+        while (ds_line_reader_next(&reader, &view)) {
+            checksum += view.length;
+        }
+        ds_line_reader_deinit(&reader);
+        close(fd);
+        reader_time += now() - start;
+    }
+
+    double mib = (double)bytes / (1024 * 1024) * ROUNDS;
+    printf("%d lines  getline + ds_init_string: %6.0f MiB/s  ds_LineReader: %6.0f MiB/s\n",
+           LINES, mib / getline_time, mib / reader_time);
+    printf("(checksum %zu)\n", checksum);
+
+    remove(path);
+    return 0;
+}
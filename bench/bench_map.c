@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define KEYS (1u << 18)
+#define ROUNDS 8
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// the generic chained map this replaces, lookups need a ds_String temporary
+typedef struct Node {
+    ds_String* key;
+    void* value;
+    struct Node* next;
+} Node;
+
+static uint64_t fnv1a(const char* data, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static void* chained_get(Node** buckets, size_t mask, ds_String* key) {
+    const char* data = ds_to_c_str(key);
+    for (Node* node = buckets[fnv1a(data, strlen(data)) & mask]; node; node = node->next) {
+        if (ds_equal(node->key, key)) return node->value;
+    }
+    return NULL;
+}
+
+int main() {
+    char (*names)[32] = malloc(KEYS * 2 * sizeof(*names));
+    for (size_t i = 0; i < KEYS * 2; i++) {
+        snprintf(names[i], sizeof(names[i]), "service.metric.%zu", i * 2654435761u % 1000003);
+    }
+
+    size_t mask = KEYS - 1;
+    Node** buckets = calloc(KEYS, sizeof(Node*));
+    Node* nodes = malloc(KEYS * sizeof(Node));
+    ds_Map* map = ds_init_map();
+    for (size_t i = 0; i < KEYS; i++) {
+        nodes[i].key = ds_init_string(names[i]);
+        nodes[i].value = (void*)(i + 1);
+        size_t bucket = fnv1a(names[i], strlen(names[i])) & mask;
+        nodes[i].next = buckets[bucket];
+        buckets[bucket] = &nodes[i];
+        ds_map_insert(map, nodes[i].key, (void*)(i + 1));
+    }
+
+    // every second lookup misses
+    size_t checksum = 0;
+    double start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (size_t i = 0; i < KEYS; i++) {
+            ds_String* key = ds_init_string(names[i * 2]);
+            checksum += (size_t)chained_get(buckets, mask, key);
+            ds_free_string(key);
+        }
+    }
+    double chained_time = now() - start;
+
+    start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (size_t i = 0; i < KEYS; i++) {
+            void** value = ds_map_get_cstr(map, names[i * 2]);
+            checksum += value ? (size_t)*value : 0;
+        }
+    }
+    double map_time = now() - start;
+
+    // keys that already are heap ds_Strings hash once
+    start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (size_t i = 0; i < KEYS; i++) {
+            void** value = ds_map_get_string(map, nodes[i].key);
+            checksum += value ? (size_t)*value : 0;
+        }
+    }
+    double string_time = now() - start;
+
+    double count = (double)KEYS * ROUNDS;
+    printf("chained map + ds_init_string:  %6.1f ns/lookup\n", chained_time / count * 1e9);
+    printf("ds_map_get_cstr:               %6.1f ns/lookup\n", map_time / count * 1e9);
+    printf("ds_map_get_string (cached):    %6.1f ns/lookup\n", string_time / count * 1e9);
+    printf("(checksum %zu)\n", checksum);
+
+    for (size_t i = 0; i < KEYS; i++) {
+        ds_free_string(nodes[i].key);
+    }
+    ds_free_map(map);
+    free(nodes);
+    free(buckets);
+    free(names);
+
+    return 0;
+}
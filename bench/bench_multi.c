@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define LINES 200000
+#define MAX_KEYWORDS 500
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t next_random(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+int main() {
+    static ds_StringView lines[LINES];
+    static ds_StringView keywords[MAX_KEYWORDS];
+    static char keyword_text[MAX_KEYWORDS][16];
+    static ds_Match matches[256];
+    static const char* levels[] = { "INFO", "WARN", "ERROR", "DEBUG" };
+
+    char* line_text = malloc(LINES * 128);
+    char* write = line_text;
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+
+    for (int i = 0; i < LINES; i++) {
+        uint64_t r = next_random(&state);
+        int length = sprintf(write, "2024-05-01T12:00:00Z %s [worker-%d] user=u%05d action=op%04d latency=%dms",
+                levels[r % 4], (int)(r >> 8) % 32, (int)(r >> 16) % 100000, (int)(r >> 32) % 2000, (int)(r >> 48) % 1000);
+        lines[i] = ds_string_view_from_buffer(write, length);
+        write += length + 1;
+    }
+
+    // keywords like "op0042" and "u01234", a few of them hit
+    for (int k = 0; k < MAX_KEYWORDS; k++) {
+        uint64_t r = next_random(&state);
+        int length = k % 2 ? sprintf(keyword_text[k], "op%04d", (int)(r % 20000))
+                           : sprintf(keyword_text[k], "u%05d", (int)(r % 1000000));
+        keywords[k] = ds_string_view_from_buffer(keyword_text[k], length);
+    }
+
+    size_t checksum = 0;
+    int keyword_counts[] = { 10, 100, 500 };
+
+    for (int c = 0; c < 3; c++) {
+        int count = keyword_counts[c];
+
+        double start = now();
+        for (int i = 0; i < LINES; i++) {
+            for (int k = 0; k < count; k++) {
+                checksum += ds_string_view_find_substr(&lines[i], &keywords[k]) >= 0;
+            }
+        }
+        double loop_time = now() - start;
+
+        ds_MultiMatcher* matcher = ds_init_multi_matcher(keywords, count);
+        start = now();
+        for (int i = 0; i < LINES; i++) {
+            checksum += ds_multi_matcher_scan(matcher, &lines[i], matches, 256);
+        }
+        double matcher_time = now() - start;
+        ds_free_multi_matcher(matcher);
+
+        printf("%3d keywords, find_substr loop:  %8.1f ns/line\n", count, loop_time / LINES * 1e9);
+        printf("%3d keywords, ds_MultiMatcher:   %8.1f ns/line\n", count, matcher_time / LINES * 1e9);
+    }
+    printf("(checksum %zu)\n", checksum);
+
+    free(line_text);
+
+    return 0;
+}
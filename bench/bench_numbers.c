@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define ITERATIONS 1000000
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t next_random(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+int main() {
+    static int64_t integers[ITERATIONS];
+    static double doubles[ITERATIONS];
+
+    // mixed widths so the digit count is not predictable
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (int i = 0; i < ITERATIONS; i++) {
+        uint64_t bits = next_random(&state);
+        integers[i] = (int64_t)bits >> (bits % 64);
+        doubles[i] = (double)(int64_t)(bits >> 20) / (double)((bits & 0xffff) + 1);
+    }
+
+    size_t checksum = 0;
+    char buffer[64];
+    ds_String line = DS_STRING_INIT;
+
+    double start = now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        checksum += snprintf(buffer, sizeof(buffer), "%" PRId64, integers[i]);
+    }
+    double snprintf_int_time = now() - start;
+
+    start = now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ds_clear(&line);
+        ds_append_i64(&line, integers[i]);
+        checksum += ds_length(&line);
+    }
+    double append_int_time = now() - start;
+
+    start = now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        checksum += snprintf(buffer, sizeof(buffer), "%.17g", doubles[i]);
+    }
+    double snprintf_double_time = now() - start;
+
+    start = now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ds_clear(&line);
+        ds_append_double(&line, doubles[i]);
+        checksum += ds_length(&line);
+    }
+    double append_double_time = now() - start;
+
+    ds_string_deinit(&line);
+
+    printf("snprintf %%lld:       %8.1f ns/value\n", snprintf_int_time / ITERATIONS * 1e9);
+    printf("ds_append_i64:       %8.1f ns/value\n", append_int_time / ITERATIONS * 1e9);
+    printf("snprintf %%.17g:      %8.1f ns/value\n", snprintf_double_time / ITERATIONS * 1e9);
+    printf("ds_append_double:    %8.1f ns/value\n", append_double_time / ITERATIONS * 1e9);
+    printf("(checksum %zu)\n", checksum);
+
+    return 0;
+}
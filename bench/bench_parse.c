@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define FIELDS 1000000
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t next_random(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// NUL separated fields so strtol/strtod can read them in place
+static char* make_fields(ds_StringView* views, bool floating) {
+    char* text = malloc(FIELDS * 32);
+    char* write = text;
+    uint64_t state = floating ? 0x2545f4914f6cdd1dull : 0x9e3779b97f4a7c15ull;
+
+    for (int i = 0; i < FIELDS; i++) {
+        uint64_t r = next_random(&state);
+        int length;
+
+        if (!floating) {
+            // status codes, row ids and unix timestamps in milliseconds
+            switch (r % 3) {
+                case 0:  length = sprintf(write, "%d", (int)(r >> 8) % 600); break;
+                case 1:  length = sprintf(write, "%" PRIu64, (r >> 8) % 10000000); break;
+                default: length = sprintf(write, "%" PRIu64, 1700000000000ull + (r >> 24) % 100000000000ull); break;
+            }
+        }
+        else {
+            // prices, coordinates and measurements in scientific notation
+            switch (r % 3) {
+                case 0:  length = sprintf(write, "%.2f", (double)((r >> 8) % 1000000) / 100); break;
+                case 1:  length = sprintf(write, "%.6f", (double)((int64_t)((r >> 8) % 360000000) - 180000000) / 1e6); break;
+                default: length = sprintf(write, "%.4e", (double)((r >> 8) % 100000) * 1e-3); break;
+            }
+        }
+
+        views[i] = ds_string_view_from_buffer(write, length);
+        write += length + 1;
+    }
+
+    return text;
+}
+
+int main() {
+    static ds_StringView integers[FIELDS];
+    static ds_StringView doubles[FIELDS];
+    char* integer_text = make_fields(integers, false);
+    char* double_text = make_fields(doubles, true);
+
+    int64_t integer_sums[2] = {0};
+    double double_sums[2] = {0};
+
+    double start = now();
+    for (int i = 0; i < FIELDS; i++) {
+        integer_sums[0] += strtoll(integers[i].data, NULL, 10);
+    }
+    double strtoll_time = now() - start;
+
+    start = now();
+    for (int i = 0; i < FIELDS; i++) {
+        bool success;
+        integer_sums[1] += ds_string_view_to_i64(&integers[i], &success);
+    }
+    double to_i64_time = now() - start;
+
+    start = now();
+    for (int i = 0; i < FIELDS; i++) {
+        double_sums[0] += strtod(doubles[i].data, NULL);
+    }
+    double strtod_time = now() - start;
+
+    start = now();
+    for (int i = 0; i < FIELDS; i++) {
+        bool success;
+        double_sums[1] += ds_string_view_to_double(&doubles[i], &success);
+    }
+    double to_double_time = now() - start;
+
+    printf("strtoll:                   %8.1f ns/field\n", strtoll_time / FIELDS * 1e9);
+    printf("ds_string_view_to_i64:     %8.1f ns/field\n", to_i64_time / FIELDS * 1e9);
+    printf("strtod:                    %8.1f ns/field\n", strtod_time / FIELDS * 1e9);
+    printf("ds_string_view_to_double:  %8.1f ns/field\n", to_double_time / FIELDS * 1e9);
+    printf("(checksums %" PRId64 " %" PRId64 " %.17g %.17g)\n", integer_sums[0], integer_sums[1], double_sums[0], double_sums[1]);
+
+    free(integer_text);
+    free(double_text);
+
+    // both sides add the same values in the same order, so any difference is a parse bug
+    if (integer_sums[0] != integer_sums[1] || double_sums[0] != double_sums[1]) {
+        fprintf(stderr, "checksums differ from strtoll/strtod\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define LINES 1000000
+#define TEXT_SIZE (64u * 1024 * 1024)
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t next_random(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+int main() {
+    static ds_StringView lines[LINES];
+    static const char* statuses[] = { "200", "201", "304", "404", "500" };
+    char* line_text = malloc(LINES * 128);
+    char* write = line_text;
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+
+    for (int i = 0; i < LINES; i++) {
+        uint64_t r = next_random(&state);
+        int length = sprintf(write, "2024-05-01T12:%02d:%02dZ INFO [worker-%d] path=/api/v1/items/%d status=%s",
+                (int)(r % 60), (int)(r >> 8) % 60, (int)(r >> 16) % 32, (int)(r >> 24) % 100000, statuses[(r >> 40) % 5]);
+        lines[i] = ds_string_view_from_buffer(write, length);
+        write += length + 1;
+    }
+
+    size_t checksum = 0;
+    ds_StringView needle = DS_LIT("status=500");
+
+    // many short haystacks, one needle
+    double start = now();
+    for (int i = 0; i < LINES; i++) {
+        checksum += memmem(lines[i].data, lines[i].length, needle.data, needle.length) != NULL;
+    }
+    double memmem_lines_time = now() - start;
+
+    ds_Searcher searcher;
+    ds_searcher_init(&searcher, &needle);
+    start = now();
+    for (int i = 0; i < LINES; i++) {
+        checksum += ds_searcher_find(&searcher, &lines[i]) >= 0;
+    }
+    double searcher_lines_time = now() - start;
+
+    // one long haystack, a long needle that only matches at the very end
+    char* text = malloc(TEXT_SIZE);
+    for (size_t i = 0; i < TEXT_SIZE; i++) {
+        text[i] = "abcdefghij klmnopqrstuvwxyz"[next_random(&state) % 27];
+    }
+    const char* long_needle = "the quick brown fox jumps over the lazy dog, twice over";
+    size_t long_length = strlen(long_needle);
+    memcpy(text + TEXT_SIZE - long_length, long_needle, long_length);
+
+    ds_StringView text_view = ds_string_view_from_buffer(text, TEXT_SIZE);
+    ds_StringView long_view = ds_string_view_from_buffer(long_needle, long_length);
+
+    start = now();
+    checksum += (const char*)memmem(text, TEXT_SIZE, long_needle, long_length) - text;
+    double memmem_text_time = now() - start;
+
+    start = now();
+    checksum += ds_string_view_find_substr(&text_view, &long_view);
+    double find_text_time = now() - start;
+
+    printf("memmem, 1M lines:            %8.1f ns/line\n", memmem_lines_time / LINES * 1e9);
+    printf("ds_searcher_find, 1M lines:  %8.1f ns/line\n", searcher_lines_time / LINES * 1e9);
+    printf("memmem, 64 MB text:          %8.2f GB/s\n", TEXT_SIZE / memmem_text_time / 1e9);
+    printf("ds_string_view_find_substr:  %8.2f GB/s\n", TEXT_SIZE / find_text_time / 1e9);
+    printf("(checksum %zu)\n", checksum);
+
+    free(line_text);
+    free(text);
+
+    return 0;
+}
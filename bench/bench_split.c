@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <drings/drings.h>
+
+#define RECORDS 1000000
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    ds_StringView record = DS_LIT("1714564800,worker-17,GET,/api/v1/items/123456,200,0.0042");
+    size_t checksum = 0;
+
+    // one exact size allocation per record
+    double start = now();
+    for (int i = 0; i < RECORDS; i++) {
+        ds_StringViewArray* fields = ds_string_view_split(&record, ',');
+        checksum += fields->count;
+        ds_free_string_view_array(fields);
+    }
+    double array_time = now() - start;
+
+    // reused inline array, nothing allocated after the first record
+    ds_SmallViewArray fields = DS_SMALL_VIEW_ARRAY_INIT;
+    start = now();
+    for (int i = 0; i < RECORDS; i++) {
+        ds_SplitIter iter;
+        ds_split_iter_init_char(&iter, &record, ',', 0);
+        ds_small_view_array_clear(&fields);
+        ds_split_iter_append(&iter, &fields);
+        checksum += fields.count;
+    }
+    double small_time = now() - start;
+    ds_small_view_array_deinit(&fields);
+
+    printf("ds_string_view_split:       %8.1f ns/record\n", array_time / RECORDS * 1e9);
+    printf("ds_SmallViewArray reused:   %8.1f ns/record\n", small_time / RECORDS * 1e9);
+    printf("(checksum %zu)\n", checksum);
+
+    return 0;
+}
@@ -4,8 +4,28 @@
 
 #define DRINGS_IMPL // Temp only for development
                     
+// DS_COMPACT_STRING selects a 24 byte ds_String with 23 inline chars
+#ifdef DS_COMPACT_STRING
+#define DS_SMALL_STRING_CAPACITY 23
+#else
 #define DS_SMALL_STRING_CAPACITY 15
+#endif
 #define DS_STACK_CAPACITY 0
+#define DS_MAX_CAPACITY UINT32_MAX
+#define DS_DEFAULT_GROWTH_FACTOR 2.0
+#define DS_DOUBLE_MAX_LENGTH 32
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DS_PRINTF_FORMAT(format_index, args_index) __attribute__((format(printf, format_index, args_index)))
+#else
+#define DS_PRINTF_FORMAT(format_index, args_index)
+#endif
+#define DS_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define DS_ARENA_ALIGNMENT 16
+#define DS_SEARCHER_SHORT_NEEDLE 32 // longer needles use Two-Way
+#define DS_SMALL_VIEW_ARRAY_CAPACITY 8
+#define DS_MULTI_MATCHER_DENSE_ENTRIES (16 * 1024) // budget for full transition rows
+#define DS_LINE_READER_DEFAULT_CAPACITY (256 * 1024)
 
 #include <stdio.h>
 #include <string.h> 
@@ -13,6 +33,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <stdarg.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +53,7 @@ typedef enum {
     DS_INVALID_INPUT = -4,
     DS_INVALID_LENGTH = -5,
     DS_REACHED_UNINTENTIONAL_CONTROL_BLOCK = -6,
+    DS_OVERFLOW = -7,
 } DS_RESULT;
 
 typedef enum {
@@ -39,6 +61,8 @@ typedef enum {
     DS_OWNS_MEM = 0x2,
     DS_READ_ONLY = 0x4,
     DS_STICKY_HEAP = 0x8,
+    DS_HASH_CACHED = 0x10, // heap_hash is valid, cleared by ds_set_length
+    DS_SHARED = 0x20, // heap_data points into a refcounted block, see ds_clone
 } DS_FLAG;
 
 typedef enum {
@@ -47,27 +71,225 @@ typedef enum {
     DS_ALL = 0x4,
 } DS_TRIM_FLAG;
 
+typedef enum {
+    DS_MATCH_OVERLAPPING = 0x1, // next search starts one byte after a match instead of behind it
+} DS_MATCH_FLAG;
+
+typedef enum {
+    DS_SPLIT_SKIP_EMPTY = 0x1,
+} DS_SPLIT_FLAG;
+
+typedef enum {
+    DS_SPLIT_ON_CHAR,
+    DS_SPLIT_ON_STRING,
+    DS_SPLIT_ON_SET,
+} DS_SPLIT_KIND;
+
+// hints for ds_map_file, ignored where the platform has no equivalent
+typedef enum {
+    DS_FILE_SEQUENTIAL = 0x1, // read ahead aggressively and drop pages behind the reader
+    DS_FILE_WILLNEED = 0x2, // start paging the whole file in right away
+    DS_FILE_HUGE_PAGES = 0x4, // best effort, file mappings only get huge pages with read only THP for the page cache (CONFIG_READ_ONLY_THP_FOR_FS)
+} DS_FILE_FLAG;
+
+typedef enum {
+    DS_LINE_STRIP_CR = 0x1, // \r\n endings lose the \r as well
+} DS_LINE_FLAG;
+
+// sizes are passed back to realloc/free so sized allocators dont need a lookup.
+// usable_size is optional and reports the real size of a block so growth can use the slack
+typedef struct {
+    void* (*alloc)(void* context, size_t size);
+    void* (*realloc)(void* context, void* ptr, size_t old_size, size_t new_size);
+    void  (*free)(void* context, void* ptr, size_t size);
+    void* context;
+    size_t (*usable_size)(void* context, void* ptr, size_t size);
+} ds_Allocator;
+
+typedef struct ds_ArenaBlock ds_ArenaBlock;
+
+// bump allocator, everything is released at once with ds_arena_reset
+typedef struct {
+    ds_ArenaBlock* head;
+    size_t block_size;
+    ds_Allocator allocator; // hands out arena memory, free is a no-op
+} ds_Arena;
+
+#ifdef DS_COMPACT_STRING
+
+/*  NOTE:
+ *  the last byte is shared between both modes. stack strings keep
+ *  DS_SMALL_STRING_CAPACITY - length there, so a full small string
+ *  is terminated by it. heap strings keep DS_COMPACT_HEAP_MARK | flags.
+ *  stack strings carry no flags, heap strings are always sticky and
+ *  every string uses the global allocator.
+ */
+#define DS_COMPACT_HEAP_MARK 0x80
+
+typedef struct {
+    union {
+        char stack_data[DS_SMALL_STRING_CAPACITY + 1];
+        struct {
+            char* heap_data;
+            uint32_t heap_length;
+            uint32_t capacity;
+            char reserved[DS_SMALL_STRING_CAPACITY - sizeof(char*) - 2 * sizeof(uint32_t)];
+            uint8_t flags;
+        };
+    };
+} ds_String;
+
+typedef char ds_compact_string_size_check[sizeof(ds_String) == DS_SMALL_STRING_CAPACITY + 1 ? 1 : -1];
+
+#ifdef __cplusplus
+// C++ has no array designators, the empty string is built at runtime there
+static inline ds_String ds_string_compact_init(void) {
+    ds_String string;
+    memset(&string, 0, sizeof(string));
+    string.stack_data[DS_SMALL_STRING_CAPACITY] = DS_SMALL_STRING_CAPACITY;
+    return string;
+}
+#define DS_STRING_INIT ds_string_compact_init()
+#else
+#define DS_STRING_INIT { { .stack_data = { [DS_SMALL_STRING_CAPACITY] = DS_SMALL_STRING_CAPACITY } } }
+#endif
+
+#else
+
 typedef struct {
     uint32_t length;
     uint32_t capacity;
     uint32_t flags;
+    const ds_Allocator* allocator; // NULL uses malloc/realloc/free directly
     union {
         char stack_data[DS_SMALL_STRING_CAPACITY + 1]; 
-        char* heap_data;
+        struct {
+            char* heap_data;
+            uint64_t heap_hash; // ds_string_hash of heap strings, see DS_HASH_CACHED
+        };
     };
 } ds_String;
 
+#define DS_STRING_INIT {0}
+
+#endif
+
 typedef struct {
     const char* data;
     uint32_t length;
 } ds_StringView;
 
+// view of a string literal with its length known at compile time, ds_append_view(s, &DS_LIT("abc"))
+#define DS_LIT(literal) ((ds_StringView){ (literal), (uint32_t)(sizeof(literal) - 1) })
+
+// DS_CONCAT(string, DS_LIT("key="), view, DS_LIT(";"))
+#define DS_CONCAT(string, ...) \
+    ds_concat((string), (const ds_StringView[]){ __VA_ARGS__ }, \
+            sizeof((const ds_StringView[]){ __VA_ARGS__ }) / sizeof(ds_StringView))
+
+// 256 bit membership bitmap, the nibble tables drive the SIMD search
+// and are only valid while the set has at most 8 distinct high nibbles
+typedef struct {
+    uint64_t bits[4];
+    uint8_t low_nibbles[16];
+    uint8_t high_nibbles[16];
+    bool nibble_lookup;
+} ds_ByteSet;
+
+// preprocessed needle, it points into the needle so the needle has to outlive it
+typedef struct {
+    ds_StringView needle;
+    size_t critical; // Two-Way factorization, only set up for long needles
+    size_t period;
+    size_t memory;
+    uint32_t shift[256];
+} ds_Searcher;
+
+// yields the offsets of every match of a needle, reset to walk another haystack with the same needle
+typedef struct {
+    ds_Searcher searcher;
+    ds_StringView haystack;
+    uint64_t position; // next offset to search from, past the end once done
+    uint32_t flags;
+} ds_MatchIter;
+
+// lazy tokenizer, the tokens point into the view and nothing is allocated
+typedef struct {
+    ds_StringView rest;
+    uint32_t kind; // DS_SPLIT_KIND
+    uint32_t flags;
+    bool done;
+    union {
+        char c;
+        ds_ByteSet set;
+        ds_Searcher searcher;
+    } delimiter;
+} ds_SplitIter;
+
+typedef struct {
+    uint64_t low;
+    uint64_t high;
+} ds_Hash128;
+
+typedef struct {
+    uint32_t pattern; // index into the patterns the matcher was built from
+    uint32_t offset;
+} ds_Match;
+
+// compiled set of patterns, matches all of them in one pass
+typedef struct ds_MultiMatcher ds_MultiMatcher;
+
+// string keyed hash map, keys are copied in and values are opaque pointers
+typedef struct ds_Map ds_Map;
+
+// canonical strings, one per distinct content
+typedef struct ds_InternTable ds_InternTable;
+
+// read only file contents. view covers the whole file as long as it fits
+// into a view (DS_MAX_CAPACITY bytes), bigger files are only reachable through data and size
+typedef struct {
+    ds_StringView view;
+    const char* data;
+    size_t size;
+    void* address; // start of the mapping, or of the buffer the file was read into
+    bool mapped;
+} ds_MappedFile;
+
+// reads an fd in big chunks and hands out the lines in place. a line only
+// stays valid until the next call, the buffer grows only for a line longer than itself
+typedef struct {
+    char* buffer;
+    size_t capacity;
+    size_t start; // first byte not handed out yet
+    size_t end; // behind the last byte read
+    size_t scanned; // bytes after start already known to hold no newline
+    int fd;
+    int error; // errno of a failed read, 0 otherwise
+    uint32_t flags;
+    bool eof;
+    const ds_Allocator* allocator;
+} ds_LineReader;
+
 typedef struct {
     ds_StringView* views;
     uint32_t count;
     uint32_t capacity;
+    const ds_Allocator* allocator;
 } ds_StringViewArray;
 
+// the first DS_SMALL_VIEW_ARRAY_CAPACITY views live inline, capacity is DS_STACK_CAPACITY until it spills
+typedef struct {
+    uint32_t count;
+    uint32_t capacity;
+    const ds_Allocator* allocator;
+    union {
+        ds_StringView inline_views[DS_SMALL_VIEW_ARRAY_CAPACITY];
+        ds_StringView* heap_views;
+    };
+} ds_SmallViewArray;
+
+#define DS_SMALL_VIEW_ARRAY_INIT {0}
+
 typedef struct {
     DS_RESULT error_code;
     const char* function_name;
@@ -78,40 +300,119 @@ typedef struct {
 
 // construct
 ds_String*      ds_init_string(const char* string);
+ds_String*      ds_init_string_n(const char* data, size_t length); // data doesnt need to be NUL terminated
+ds_String*      ds_init_string_allocator(const ds_Allocator* allocator, const char* string);
 void            ds_free_string(ds_String* string);
 
+// construct into caller owned storage (stack, structs, arrays), no header allocation.
+// a ds_String set to DS_STRING_INIT is a valid empty string as well (using malloc)
+size_t          ds_string_init_inplace(ds_String* string, const char* literal);
+size_t          ds_string_init_inplace_n(ds_String* string, const char* data, size_t length);
+size_t          ds_string_init_inplace_allocator(ds_String* string, const ds_Allocator* allocator, const char* literal);
+void            ds_string_deinit(ds_String* string); // frees the buffer, not the ds_String itself
+
+// allocator used by every string created afterwards, NULL restores malloc.
+// compact strings dont store their allocator, so with DS_COMPACT_STRING it can
+// only be set before the first string is created and later calls fail
+void            ds_set_allocator(const ds_Allocator* allocator);
+const ds_Allocator* ds_get_allocator();
+
+// heap capacity is multiplied by this when an append runs out of space
+void            ds_set_growth_factor(double factor);
+double          ds_get_growth_factor();
+
 // methods
 const char*     ds_to_c_str(ds_String* string);
 void            ds_append(ds_String* string, const char* literal);
+void            ds_append_n(ds_String* string, const char* data, size_t n);
+void            ds_append_view(ds_String* string, const ds_StringView* view);
 void            ds_append_dstring(ds_String* string, ds_String* append);
+void            ds_concat(ds_String* string, const ds_StringView* parts, size_t n); // one grow for all parts, parts may view string itself
+size_t          ds_appendf(ds_String* string, const char* format, ...) DS_PRINTF_FORMAT(2, 3);
+size_t          ds_vappendf(ds_String* string, const char* format, va_list args);
+size_t          ds_append_i64(ds_String* string, int64_t value);
+size_t          ds_append_u64(ds_String* string, uint64_t value);
+size_t          ds_append_double(ds_String* string, double value); // shortest text that parses back to value
 
 char            ds_pop(ds_String* string);
 size_t          ds_pop_n(ds_String* string, size_t n);
 
-size_t          ds_reserve(ds_String* string, size_t n);
+size_t          ds_reserve(ds_String* string, size_t n); // same as ds_reserve_exact
+size_t          ds_reserve_exact(ds_String* string, size_t n); // room for n chars, no extra
+size_t          ds_reserve_at_least(ds_String* string, size_t n); // room for n chars, grown by the growth factor
 size_t          ds_clear(ds_String* string);
-bool            ds_equal(ds_String* string0, ds_String* string1); // true if equal
+bool            ds_equal(const ds_String* string0, const ds_String* string1); // true if equal
+int             ds_compare(const ds_String* string0, const ds_String* string1); // <0, 0, >0 in memcmp order
+uint64_t        ds_string_hash(ds_String* string); // unseeded, heap strings cache it until the next change
 size_t          ds_set(ds_String* string, const char* literal);
+size_t          ds_set_n(ds_String* string, const char* data, size_t n);
+size_t          ds_set_view(ds_String* string, const ds_StringView* view);
+// string becomes a copy of clone. heap strings share one refcounted buffer until either side changes
 size_t          ds_clone(ds_String* string, ds_String* clone);
+size_t          ds_clone_substr(ds_String* string, ds_String* source, size_t start, size_t length); // shares like ds_clone
+
+// borrowed strings read external memory that has to outlive them, the first change copies it.
+// adopt takes over a buffer from the global allocator, release hands the buffer back out
+ds_String*      ds_string_wrap(const char* data, size_t length);
+ds_String*      ds_string_wrap_cstr(const char* literal); // ds_to_c_str can use the terminator in place
+size_t          ds_string_wrap_inplace(ds_String* string, const char* data, size_t length);
+ds_String*      ds_string_adopt(char* data, size_t length, size_t capacity); // capacity has to leave room for the terminator
+size_t          ds_string_adopt_inplace(ds_String* string, char* data, size_t length, size_t capacity);
+char*           ds_string_release(ds_String* string, size_t* length, size_t* capacity); // capacity can be NULL, string is left empty
 size_t          ds_trim_whitespace(ds_String* string);
 size_t          ds_trim_whitespace_flags(ds_String* string, uint32_t flags);
 ds_String*      ds_split(ds_String* string, char c); // returns split up string from first occurance
 
 // string view
 ds_StringView   ds_string_view_from_cstr(const char* str);
-ds_StringView   ds_string_view_from_string(ds_String* string);
+ds_StringView   ds_string_view_from_string(const ds_String* string);
 ds_StringView   ds_string_view_from_buffer(const char* data, uint32_t length);
 ds_StringView   ds_string_view_from_substr(const ds_StringView* view, uint32_t start, uint32_t length);
 ds_StringView   ds_string_view_from_substr_to_end(const ds_StringView* view, uint32_t start);
-ds_StringView   ds_string_view_from_string_substr(ds_String* string, uint32_t start, uint32_t length);
-ds_StringView   ds_string_view_from_string_substr_to_end(ds_String* string, uint32_t start);
+ds_StringView   ds_string_view_from_string_substr(const ds_String* string, uint32_t start, uint32_t length);
+ds_StringView   ds_string_view_from_string_substr_to_end(const ds_String* string, uint32_t start);
 
 bool            ds_string_view_equal(const ds_StringView* view1, const ds_StringView* view2);
 bool            ds_string_view_equal_cstr(const ds_StringView* view, const char* str);
+int             ds_string_view_compare(const ds_StringView* view1, const ds_StringView* view2); // <0, 0, >0 in memcmp order
+
+// hashing, wyhash class, the same value on every platform
+uint64_t        ds_hash_bytes(const void* data, size_t length, uint64_t seed);
+uint64_t        ds_string_view_hash(const ds_StringView* view, uint64_t seed); // seed 0 matches ds_string_hash
+ds_Hash128      ds_string_view_hash128(const ds_StringView* view, uint64_t seed);
 bool            ds_string_view_is_empty(const ds_StringView* view);
 
 int32_t         ds_string_view_find_char(const ds_StringView* view, char c);
+int32_t         ds_string_view_rfind_char(const ds_StringView* view, char c); // last occurrence
+int32_t         ds_string_view_find_nth_char(const ds_StringView* view, char c, size_t n); // n counts from 0
+size_t          ds_string_view_count_char(const ds_StringView* view, char c);
+
+// byte sets, build once and search many views with them
+ds_ByteSet      ds_byte_set_from_cstr(const char* chars);
+ds_ByteSet      ds_byte_set_from_buffer(const char* chars, size_t length);
+void            ds_byte_set_add(ds_ByteSet* set, char c);
+bool            ds_byte_set_contains(const ds_ByteSet* set, char c);
+
+int32_t         ds_string_view_find_first_of(const ds_StringView* view, const ds_ByteSet* set);
+int32_t         ds_string_view_find_first_not_of(const ds_StringView* view, const ds_ByteSet* set);
+int32_t         ds_string_view_find_last_of(const ds_StringView* view, const ds_ByteSet* set);
+int32_t         ds_string_view_find_last_not_of(const ds_StringView* view, const ds_ByteSet* set);
+uint32_t        ds_string_view_span(const ds_StringView* view, const ds_ByteSet* set); // length of the prefix inside the set
+uint32_t        ds_string_view_cspan(const ds_StringView* view, const ds_ByteSet* set); // length of the prefix outside the set
 int32_t         ds_string_view_find_substr(const ds_StringView* view, const ds_StringView* substr);
+size_t          ds_searcher_init(ds_Searcher* searcher, const ds_StringView* needle);
+int32_t         ds_searcher_find(const ds_Searcher* searcher, const ds_StringView* haystack);
+
+size_t          ds_match_iter_init(ds_MatchIter* iter, const ds_StringView* haystack, const ds_StringView* needle, uint32_t flags);
+void            ds_match_iter_reset(ds_MatchIter* iter, const ds_StringView* haystack);
+bool            ds_match_iter_next(ds_MatchIter* iter, uint32_t* offset); // false once there are no more matches
+// writes up to capacity offsets and returns the number of matches, which can be bigger than capacity
+size_t          ds_string_view_find_all(const ds_StringView* view, const ds_StringView* needle, uint32_t* offsets, size_t capacity, uint32_t flags);
+
+// multi pattern, every (pattern, offset) is reported ordered by where the match ends. empty patterns never match
+ds_MultiMatcher* ds_init_multi_matcher(const ds_StringView* patterns, size_t count);
+void            ds_free_multi_matcher(ds_MultiMatcher* matcher);
+size_t          ds_multi_matcher_scan(const ds_MultiMatcher* matcher, const ds_StringView* view, ds_Match* matches, size_t capacity); // returns the number of matches, can be bigger than capacity
 
 bool            ds_string_view_starts_with(const ds_StringView* view, const ds_StringView* prefix);
 bool            ds_string_view_ends_with(const ds_StringView* view, const ds_StringView* suffix);
@@ -123,14 +424,85 @@ void            ds_string_view_print(const ds_StringView* view);
 const char*     ds_string_view_get_data(const ds_StringView* view);
 uint32_t        ds_string_view_get_length(const ds_StringView* view);
 
+// the whole view has to be the number, out of range values are clamped and report DS_OVERFLOW
 int32_t         ds_string_view_to_int(const ds_StringView* view, bool* success);
-double          ds_string_view_to_double(const ds_StringView* view, bool* success);
+int64_t         ds_string_view_to_i64(const ds_StringView* view, bool* success);
+uint64_t        ds_string_view_to_u64(const ds_StringView* view, bool* success);
+uint64_t        ds_string_view_to_hex(const ds_StringView* view, bool* success); // optional 0x prefix
+double          ds_string_view_to_double(const ds_StringView* view, bool* success); // also inf, infinity and nan
+
+size_t          ds_split_iter_init_char(ds_SplitIter* iter, const ds_StringView* view, char delimiter, uint32_t flags);
+size_t          ds_split_iter_init_string(ds_SplitIter* iter, const ds_StringView* view, const ds_StringView* delimiter, uint32_t flags);
+size_t          ds_split_iter_init_set(ds_SplitIter* iter, const ds_StringView* view, const ds_ByteSet* delimiters, uint32_t flags);
+bool            ds_split_iter_next(ds_SplitIter* iter, ds_StringView* token); // false once the view is used up
+ds_StringViewArray* ds_split_iter_collect(ds_SplitIter* iter); // remaining tokens in one exact size allocation
+size_t          ds_split_iter_append(ds_SplitIter* iter, ds_SmallViewArray* array); // pushes the remaining tokens
+
+// small view array, clear keeps the storage so a reused array stops allocating
+void            ds_small_view_array_init(ds_SmallViewArray* array);
+void            ds_small_view_array_init_allocator(ds_SmallViewArray* array, const ds_Allocator* allocator); // ds_arena_allocator for arena backing
+void            ds_small_view_array_deinit(ds_SmallViewArray* array);
+size_t          ds_small_view_array_reserve(ds_SmallViewArray* array, size_t capacity);
+size_t          ds_small_view_array_push(ds_SmallViewArray* array, const ds_StringView* view);
+void            ds_small_view_array_clear(ds_SmallViewArray* array);
 
 ds_StringViewArray* ds_string_view_split(const ds_StringView* view, char split);
 void            ds_free_string_view_array(ds_StringViewArray* array);
 
+// map, lookups take a view, a C string or a ds_String without copying the key.
+// the returned value slot stays valid until the next insert or remove
+ds_Map*         ds_init_map(void);
+ds_Map*         ds_init_map_allocator(const ds_Allocator* allocator);
+void            ds_free_map(ds_Map* map);
+void            ds_map_clear(ds_Map* map); // keeps the table
+size_t          ds_map_count(const ds_Map* map);
+size_t          ds_map_reserve(ds_Map* map, size_t count);
+size_t          ds_map_insert(ds_Map* map, ds_String* key, void* value); // replaces the value of an existing key
+size_t          ds_map_insert_view(ds_Map* map, const ds_StringView* key, void* value);
+void**          ds_map_get(const ds_Map* map, const ds_StringView* key); // NULL if the key is missing
+void**          ds_map_get_cstr(const ds_Map* map, const char* key);
+void**          ds_map_get_string(const ds_Map* map, ds_String* key); // uses the cached hash of heap strings
+bool            ds_map_remove(ds_Map* map, const ds_StringView* key);
+bool            ds_map_next(const ds_Map* map, size_t* cursor, ds_StringView* key, void** value); // cursor starts at 0, order is unspecified
+
+// interning, safe to call from any thread. interned strings live as long as their table,
+// must not be changed or freed, and equal contents give the same pointer. they are always
+// terminated, so ds_cdata is a C string for them. ds_string_view_hash(view, 0) gives the
+// value ds_string_hash would, without writing the hash cache other threads read
+const ds_String* ds_intern(const ds_StringView* view); // process wide table
+const ds_String* ds_intern_lookup(uint32_t id);
+uint32_t        ds_intern_id(const ds_String* interned); // dense, in the order strings were first seen
+ds_InternTable* ds_init_intern_table(void); // uses the global allocator
+ds_InternTable* ds_init_intern_table_allocator(const ds_Allocator* allocator); // for the table and its slots, entries live in arenas
+void            ds_free_intern_table(ds_InternTable* table); // no other thread may use the table anymore
+const ds_String* ds_intern_table_intern(ds_InternTable* table, const ds_StringView* view);
+const ds_String* ds_intern_table_lookup(ds_InternTable* table, uint32_t id); // NULL for ids not handed out yet
+size_t          ds_intern_table_count(ds_InternTable* table);
+
+// files. a mapping is not NUL terminated and stays valid until ds_unmap_file,
+// files without a size (procfs) and systems without mmap get the file read into memory instead
+size_t          ds_map_file(ds_MappedFile* file, const char* path, uint32_t flags); // flags are DS_FILE_FLAG
+void            ds_unmap_file(ds_MappedFile* file);
+size_t          ds_read_file(ds_String* string, const char* path); // replaces the content on success only, one allocation for regular files
+
+// line reader, lines come without the \n and the last one may lack it in the file as well
+size_t          ds_line_reader_init(ds_LineReader* reader, int fd, size_t capacity, uint32_t flags); // 0 for DS_LINE_READER_DEFAULT_CAPACITY, flags are DS_LINE_FLAG
+void            ds_line_reader_deinit(ds_LineReader* reader); // leaves the fd open
+bool            ds_line_reader_next(ds_LineReader* reader, ds_StringView* line); // false at the end or after a failed read (error is set)
+
+// arena
+ds_Arena*       ds_init_arena(size_t block_size); // 0 for DS_ARENA_DEFAULT_BLOCK_SIZE
+void            ds_free_arena(ds_Arena* arena);
+void            ds_arena_reset(ds_Arena* arena); // invalidates every string allocated from the arena
+void*           ds_arena_alloc(ds_Arena* arena, size_t size);
+void*           ds_arena_realloc(ds_Arena* arena, void* ptr, size_t old_size, size_t new_size);
+const ds_Allocator* ds_arena_allocator(ds_Arena* arena);
+
+ds_String*      ds_init_string_arena(ds_Arena* arena, const char* string);
+ds_StringViewArray* ds_string_view_split_arena(ds_Arena* arena, const ds_StringView* view, char split);
+
 // Erroc management
-static ds_ErrorInfo ds_last_error = {0};
+static ds_ErrorInfo ds_last_error = {DS_OK};
 static bool ds_error_login_enabled = true;
 
 void ds_default_error_callback(const ds_ErrorInfo* error);
@@ -157,40 +529,254 @@ void ds_clear_last_error();
 const char* ds_error_string(DS_RESULT result);
 
 // helper
+#ifdef DS_COMPACT_STRING
+
+static inline bool ds_is_heap(const ds_String* string) {
+    return (string->flags & DS_COMPACT_HEAP_MARK) != 0;
+}
+
+static inline size_t ds_length(const ds_String* string) {
+    return ds_is_heap(string) ? string->heap_length
+        : (uint32_t)(DS_SMALL_STRING_CAPACITY - (uint8_t)string->stack_data[DS_SMALL_STRING_CAPACITY]);
+}
+
+static inline void ds_set_length(ds_String* string, size_t length) {
+    if (ds_is_heap(string)) string->heap_length = length;
+    else string->stack_data[DS_SMALL_STRING_CAPACITY] = (char)(DS_SMALL_STRING_CAPACITY - length);
+}
+
+static inline size_t ds_capacity(const ds_String* string) {
+    return ds_is_heap(string) ? string->capacity : DS_STACK_CAPACITY;
+}
+
+static inline void ds_set_capacity(ds_String* string, size_t capacity) {
+    if (ds_is_heap(string)) string->capacity = capacity;
+}
+
+// the caller sets the length right after switching modes
+static inline void ds_set_is_heap(ds_String* string) {
+    if (!ds_is_heap(string)) string->flags = DS_COMPACT_HEAP_MARK | DS_IS_HEAP | DS_STICKY_HEAP;
+}
+
+static inline void ds_set_is_stack(ds_String* string) {
+    string->stack_data[DS_SMALL_STRING_CAPACITY] = DS_SMALL_STRING_CAPACITY;
+}
+
+static inline void ds_set_sticky_heap(ds_String* string) {
+    if (ds_is_heap(string)) string->flags |= DS_STICKY_HEAP;
+}
+
+static inline bool ds_has_sticky_heap(const ds_String* string) {
+    return ds_is_heap(string) && (string->flags & DS_STICKY_HEAP) != 0;
+}
+
+static inline bool ds_is_shared(const ds_String* string) {
+    return ds_is_heap(string) && (string->flags & DS_SHARED) != 0;
+}
+
+static inline void ds_set_shared(ds_String* string, bool shared) {
+    if (!ds_is_heap(string)) return;
+    string->flags = shared ? string->flags | DS_SHARED : string->flags & ~DS_SHARED;
+}
+
+static inline bool ds_is_read_only(const ds_String* string) {
+    return ds_is_heap(string) && (string->flags & DS_READ_ONLY) != 0;
+}
+
+static inline bool ds_owns_memory(const ds_String* string) {
+    return ds_is_heap(string) && (string->flags & DS_OWNS_MEM) != 0;
+}
+
+// owned buffers are writable and freed with the string, borrowed ones are neither
+static inline void ds_set_owns_memory(ds_String* string, bool owned) {
+    if (!ds_is_heap(string)) return;
+    string->flags = owned ? (string->flags | DS_OWNS_MEM) & ~DS_READ_ONLY : (string->flags | DS_READ_ONLY) & ~DS_OWNS_MEM;
+}
+
+// turns raw storage into an empty stack string
+static inline void ds_string_reset(ds_String* string) {
+    string->stack_data[0] = '\0';
+    string->stack_data[DS_SMALL_STRING_CAPACITY] = DS_SMALL_STRING_CAPACITY;
+}
+
+// the global allocator, from here on ds_set_allocator refuses to swap it
+const ds_Allocator* ds_compact_string_allocator(void);
+
+static inline const ds_Allocator* ds_string_allocator(const ds_String* string) {
+    (void)string;
+    return ds_compact_string_allocator();
+}
+
+static inline void ds_string_set_allocator(ds_String* string, const ds_Allocator* allocator) {
+    (void)string; (void)allocator;
+}
+
+// no room for a hash in the compact layout
+static inline bool ds_string_cached_hash(const ds_String* string, uint64_t* hash) {
+    (void)string; (void)hash;
+    return false;
+}
+
+static inline void ds_string_cache_hash(ds_String* string, uint64_t hash) {
+    (void)string; (void)hash;
+}
+
+#else
+
 static inline bool ds_is_heap(const ds_String* string) {
     return (string->flags & DS_IS_HEAP) != 0;
 }
 
-static inline bool ds_is_stack(const ds_String* string) {
-    return (string->flags & DS_IS_HEAP) == 0;
+static inline size_t ds_length(const ds_String* string) {
+    return string->length;
 }
 
-static inline bool ds_is_empty(const ds_String* string) {
-    return string->length == 0;
+// every change to the content goes through here, so this is where the cached hash dies
+static inline void ds_set_length(ds_String* string, size_t length) {
+    string->length = length;
+    string->flags &= ~DS_HASH_CACHED;
 }
 
-static inline char* ds_data(ds_String* string) {
-    return ds_is_heap(string) ? string->heap_data : string->stack_data;
+static inline size_t ds_capacity(const ds_String* string) {
+    return string->capacity;
+}
+
+static inline void ds_set_capacity(ds_String* string, size_t capacity) {
+    string->capacity = capacity;
 }
 
 static inline void ds_set_is_heap(ds_String* string) {
-    string->flags |= DS_IS_HEAP;
+    string->flags = (string->flags | DS_IS_HEAP) & ~DS_HASH_CACHED;
 }
 
 static inline void ds_set_is_stack(ds_String* string) {
-    string->flags &= ~DS_IS_HEAP;
+    string->flags &= ~(DS_IS_HEAP | DS_OWNS_MEM | DS_READ_ONLY | DS_HASH_CACHED | DS_SHARED);
 }
 
 static inline void ds_set_sticky_heap(ds_String* string) {
     string->flags |= DS_STICKY_HEAP;
 }
 
+static inline bool ds_has_sticky_heap(const ds_String* string) {
+    return (string->flags & DS_STICKY_HEAP) != 0;
+}
+
+static inline bool ds_is_shared(const ds_String* string) {
+    return (string->flags & DS_SHARED) != 0;
+}
+
+static inline void ds_set_shared(ds_String* string, bool shared) {
+    string->flags = shared ? string->flags | DS_SHARED : string->flags & ~DS_SHARED;
+}
+
+static inline bool ds_is_read_only(const ds_String* string) {
+    return (string->flags & DS_READ_ONLY) != 0;
+}
+
+static inline bool ds_owns_memory(const ds_String* string) {
+    return (string->flags & DS_OWNS_MEM) != 0;
+}
+
+// owned buffers are writable and freed with the string, borrowed ones are neither
+static inline void ds_set_owns_memory(ds_String* string, bool owned) {
+    string->flags = owned ? (string->flags | DS_OWNS_MEM) & ~DS_READ_ONLY : (string->flags | DS_READ_ONLY) & ~DS_OWNS_MEM;
+}
+
+// turns raw storage into an empty stack string
+static inline void ds_string_reset(ds_String* string) {
+    string->length = 0;
+    string->capacity = DS_STACK_CAPACITY;
+    string->flags = 0;
+    string->stack_data[0] = '\0';
+}
+
+static inline const ds_Allocator* ds_string_allocator(const ds_String* string) {
+    return string->allocator;
+}
+
+static inline void ds_string_set_allocator(ds_String* string, const ds_Allocator* allocator) {
+    string->allocator = allocator;
+}
+
+static inline bool ds_string_cached_hash(const ds_String* string, uint64_t* hash) {
+    if (!(string->flags & DS_HASH_CACHED)) return false;
+    *hash = string->heap_hash;
+    return true;
+}
+
+// stack strings are short enough to rehash
+static inline void ds_string_cache_hash(ds_String* string, uint64_t hash) {
+    if (!ds_is_heap(string)) return;
+    string->heap_hash = hash;
+    string->flags |= DS_HASH_CACHED;
+}
+
+#endif
+
+static inline bool ds_is_stack(const ds_String* string) {
+    return !ds_is_heap(string);
+}
+
+static inline bool ds_is_empty(const ds_String* string) {
+    return ds_length(string) == 0;
+}
+
+// shared strings must not be written through this, and a shared substring is only terminated after ds_to_c_str
+static inline char* ds_data(ds_String* string) {
+    return ds_is_heap(string) ? string->heap_data : string->stack_data;
+}
+
+// read only access, a shared substring is not terminated so use it with ds_length
+static inline const char* ds_cdata(const ds_String* string) {
+    return ds_is_heap(string) ? string->heap_data : string->stack_data;
+}
+
 static inline bool ds_has_valid_heap_data(const ds_String* string) {
     return (ds_is_heap(string) && string->heap_data);
 }
 
-static inline bool ds_has_sticky_heap(const ds_String* string) {
-    return (string->flags & DS_STICKY_HEAP) != 0;
+static inline void* ds_allocator_alloc(const ds_Allocator* allocator, size_t size) {
+    return allocator ? allocator->alloc(allocator->context, size) : malloc(size);
+}
+
+static inline void* ds_allocator_realloc(const ds_Allocator* allocator, void* ptr, size_t old_size, size_t new_size) {
+    return allocator ? allocator->realloc(allocator->context, ptr, old_size, new_size) : realloc(ptr, new_size);
+}
+
+static inline void ds_allocator_free(const ds_Allocator* allocator, void* ptr, size_t size) {
+    if (allocator) allocator->free(allocator->context, ptr, size);
+    else free(ptr);
+}
+
+static inline void* ds_string_alloc_buffer(ds_String* string, size_t size) {
+    return ds_allocator_alloc(ds_string_allocator(string), size);
+}
+
+static inline void* ds_string_realloc_buffer(ds_String* string, void* ptr, size_t old_size, size_t new_size) {
+    return ds_allocator_realloc(ds_string_allocator(string), ptr, old_size, new_size);
+}
+
+static inline void ds_string_free_buffer(ds_String* string, void* ptr, size_t size) {
+    ds_allocator_free(ds_string_allocator(string), ptr, size);
+}
+
+// switches a stack string over to an already filled heap buffer
+static inline void ds_string_set_heap_buffer(ds_String* string, char* buffer, size_t length, size_t capacity) {
+    string->heap_data = buffer;
+    ds_set_is_heap(string);
+    ds_set_length(string, length);
+    ds_set_capacity(string, capacity);
+    ds_set_owns_memory(string, true);
+}
+
+// points the string at memory it doesnt own. capacity is how many bytes can be read,
+// only if it is past length does ds_to_c_str look for a terminator there
+static inline void ds_string_set_borrowed_buffer(ds_String* string, const char* data, size_t length, size_t readable) {
+    string->heap_data = (char*)data;
+    ds_set_is_heap(string);
+    ds_set_length(string, length);
+    ds_set_capacity(string, readable);
+    ds_set_owns_memory(string, false);
 }
 
 static inline size_t ds_move_dstring_to_heap(ds_String* string) {
@@ -199,45 +785,38 @@ static inline size_t ds_move_dstring_to_heap(ds_String* string) {
         return -1;
     }
 
-    string->capacity = string->length + 1;
-    char* heap_buffer = (char*)malloc(string->capacity);
+    size_t length = ds_length(string);
+    char* heap_buffer = (char*)ds_string_alloc_buffer(string, length + 1);
     if (!heap_buffer) {
         DS_SET_ERROR(DS_ALLOC_FAIL, "Couldnt allocate heap buffer");
         return -1;
     }
 
-    memcpy(heap_buffer, string->stack_data, string->length + 1);
-    string->heap_data = heap_buffer;
-    ds_set_is_heap(string);
+    memcpy(heap_buffer, string->stack_data, length + 1);
+    ds_string_set_heap_buffer(string, heap_buffer, length, length + 1);
 
     return 0;
 }
 
-static inline size_t ds_move_dsstring_to_stack(ds_String* string) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
-    }
-
-    if (string->length > DS_SMALL_STRING_CAPACITY) {
-        DS_SET_ERROR(DS_INVALID_LENGTH, "Input string is to big for stack");
-        return -1;
-    }
+// releases the heap buffer through its owner, so shared and borrowed strings are safe to pass
+size_t ds_move_dsstring_to_stack(ds_String* string);
 
-    memcpy(string->stack_data, string->heap_data, string->length + 1);
-    string->capacity = DS_STACK_CAPACITY;
-    ds_set_is_stack(string);
+static inline char* ds_string_get_data(ds_String* string) {
+    return ds_data(string);
+}
 
-    return 0;
+static inline bool ds_small_view_array_is_heap(const ds_SmallViewArray* array) {
+    return array->capacity != DS_STACK_CAPACITY;
 }
 
-static inline char* ds_string_get_data(ds_String* string) {
-    return ds_is_heap(string) ? string->heap_data : string->stack_data;
+static inline ds_StringView* ds_small_view_array_data(ds_SmallViewArray* array) {
+    return ds_small_view_array_is_heap(array) ? array->heap_views : array->inline_views;
 }
 
 // private
 
 
+
 #ifdef __cplusplus
 
 #ifdef DS_NAMESPACE
@@ -251,6 +830,1427 @@ static inline char* ds_string_get_data(ds_String* string) {
 
 #ifdef DRINGS_IMPL
 
+#ifndef DRINGS_TABLES_H
+#define DRINGS_TABLES_H
+
+// lookup tables for the number formatting and parsing in drings.c
+
+#define DS_POW5_TABLE_SIZE 326
+#define DS_POW5_INV_TABLE_SIZE 342
+#define DS_POW5_BITCOUNT 125
+#define DS_POW5_INV_BITCOUNT 125
+
+// 5^i shifted to DS_POW5_BITCOUNT bits as { low, high }: 5^i >> (bitlen(5^i) - 125)
+static const uint64_t ds_pow5_split[DS_POW5_TABLE_SIZE][2] = {
+    { 0x0000000000000000ull, 0x1000000000000000ull },
+    { 0x0000000000000000ull, 0x1400000000000000ull },
+    { 0x0000000000000000ull, 0x1900000000000000ull },
+    { 0x0000000000000000ull, 0x1f40000000000000ull },
+    { 0x0000000000000000ull, 0x1388000000000000ull },
+    { 0x0000000000000000ull, 0x186a000000000000ull },
+    { 0x0000000000000000ull, 0x1e84800000000000ull },
+    { 0x0000000000000000ull, 0x1312d00000000000ull },
+    { 0x0000000000000000ull, 0x17d7840000000000ull },
+    { 0x0000000000000000ull, 0x1dcd650000000000ull },
+    { 0x0000000000000000ull, 0x12a05f2000000000ull },
+    { 0x0000000000000000ull, 0x174876e800000000ull },
+    { 0x0000000000000000ull, 0x1d1a94a200000000ull },
+    { 0x0000000000000000ull, 0x12309ce540000000ull },
+    { 0x0000000000000000ull, 0x16bcc41e90000000ull },
+    { 0x0000000000000000ull, 0x1c6bf52634000000ull },
+    { 0x0000000000000000ull, 0x11c37937e0800000ull },
+    { 0x0000000000000000ull, 0x16345785d8a00000ull },
+    { 0x0000000000000000ull, 0x1bc16d674ec80000ull },
+    { 0x0000000000000000ull, 0x1158e460913d0000ull },
+    { 0x0000000000000000ull, 0x15af1d78b58c4000ull },
+    { 0x0000000000000000ull, 0x1b1ae4d6e2ef5000ull },
+    { 0x0000000000000000ull, 0x10f0cf064dd59200ull },
+    { 0x0000000000000000ull, 0x152d02c7e14af680ull },
+    { 0x0000000000000000ull, 0x1a784379d99db420ull },
+    { 0x0000000000000000ull, 0x108b2a2c28029094ull },
+    { 0x0000000000000000ull, 0x14adf4b7320334b9ull },
+    { 0x4000000000000000ull, 0x19d971e4fe8401e7ull },
+    { 0x8800000000000000ull, 0x1027e72f1f128130ull },
+    { 0xaa00000000000000ull, 0x1431e0fae6d7217cull },
+    { 0xd480000000000000ull, 0x193e5939a08ce9dbull },
+    { 0xc9a0000000000000ull, 0x1f8def8808b02452ull },
+    { 0xbe04000000000000ull, 0x13b8b5b5056e16b3ull },
+    { 0xad85000000000000ull, 0x18a6e32246c99c60ull },
+    { 0xd8e6400000000000ull, 0x1ed09bead87c0378ull },
+    { 0x878fe80000000000ull, 0x13426172c74d822bull },
+    { 0x6973e20000000000ull, 0x1812f9cf7920e2b6ull },
+    { 0x03d0da8000000000ull, 0x1e17b84357691b64ull },
+    { 0x8262889000000000ull, 0x12ced32a16a1b11eull },
+    { 0x22fb2ab400000000ull, 0x178287f49c4a1d66ull },
+    { 0xabb9f56100000000ull, 0x1d6329f1c35ca4bfull },
+    { 0xcb54395ca0000000ull, 0x125dfa371a19e6f7ull },
+    { 0xbe2947b3c8000000ull, 0x16f578c4e0a060b5ull },
+    { 0x2db399a0ba000000ull, 0x1cb2d6f618c878e3ull },
+    { 0xfc90400474400000ull, 0x11efc659cf7d4b8dull },
+    { 0x7bb4500591500000ull, 0x166bb7f0435c9e71ull },
+    { 0xdaa16406f5a40000ull, 0x1c06a5ec5433c60dull },
+    { 0xa8a4de8459868000ull, 0x118427b3b4a05bc8ull },
+    { 0xd2ce16256fe82000ull, 0x15e531a0a1c872baull },
+    { 0x87819baecbe22800ull, 0x1b5e7e08ca3a8f69ull },
+    { 0xf4b1014d3f6d5900ull, 0x111b0ec57e6499a1ull },
+    { 0x71dd41a08f48af40ull, 0x1561d276ddfdc00aull },
+    { 0x0e549208b31adb10ull, 0x1aba4714957d300dull },
+    { 0x28f4db456ff0c8eaull, 0x10b46c6cdd6e3e08ull },
+    { 0x33321216cbecfb24ull, 0x14e1878814c9cd8aull },
+    { 0xbffe969c7ee839edull, 0x1a19e96a19fc40ecull },
+    { 0xf7ff1e21cf512434ull, 0x105031e2503da893ull },
+    { 0xf5fee5aa43256d41ull, 0x14643e5ae44d12b8ull },
+    { 0x337e9f14d3eec892ull, 0x197d4df19d605767ull },
+    { 0x005e46da08ea7ab6ull, 0x1fdca16e04b86d41ull },
+    { 0xa03aec4845928cb2ull, 0x13e9e4e4c2f34448ull },
+    { 0xc849a75a56f72fdeull, 0x18e45e1df3b0155aull },
+    { 0x7a5c1130ecb4fbd6ull, 0x1f1d75a5709c1ab1ull },
+    { 0xec798abe93f11d65ull, 0x13726987666190aeull },
+    { 0xa797ed6e38ed64bfull, 0x184f03e93ff9f4daull },
+    { 0x517de8c9c728bdefull, 0x1e62c4e38ff87211ull },
+    { 0xd2eeb17e1c7976b5ull, 0x12fdbb0e39fb474aull },
+    { 0x87aa5ddda397d462ull, 0x17bd29d1c87a191dull },
+    { 0xe994f5550c7dc97bull, 0x1dac74463a989f64ull },
+    { 0x11fd195527ce9dedull, 0x128bc8abe49f639full },
+    { 0xd67c5faa71c24568ull, 0x172ebad6ddc73c86ull },
+    { 0x8c1b77950e32d6c2ull, 0x1cfa698c95390ba8ull },
+    { 0x57912abd28dfc639ull, 0x121c81f7dd43a749ull },
+    { 0xad75756c7317b7c8ull, 0x16a3a275d494911bull },
+    { 0x98d2d2c78fdda5baull, 0x1c4c8b1349b9b562ull },
+    { 0x9f83c3bcb9ea8794ull, 0x11afd6ec0e14115dull },
+    { 0x0764b4abe8652979ull, 0x161bcca7119915b5ull },
+    { 0x493de1d6e27e73d7ull, 0x1ba2bfd0d5ff5b22ull },
+    { 0x6dc6ad264d8f0866ull, 0x1145b7e285bf98f5ull },
+    { 0xc938586fe0f2ca80ull, 0x159725db272f7f32ull },
+    { 0x7b866e8bd92f7d20ull, 0x1afcef51f0fb5effull },
+    { 0xad34051767bdae34ull, 0x10de1593369d1b5full },
+    { 0x9881065d41ad19c1ull, 0x15159af804446237ull },
+    { 0x7ea147f492186032ull, 0x1a5b01b605557ac5ull },
+    { 0x6f24ccf8db4f3c1full, 0x1078e111c3556cbbull },
+    { 0x4aee003712230b27ull, 0x14971956342ac7eaull },
+    { 0xdda98044d6abcdf0ull, 0x19bcdfabc13579e4ull },
+    { 0x0a89f02b062b60b6ull, 0x10160bcb58c16c2full },
+    { 0xcd2c6c35c7b638e4ull, 0x141b8ebe2ef1c73aull },
+    { 0x8077874339a3c71dull, 0x1922726dbaae3909ull },
+    { 0xe0956914080cb8e4ull, 0x1f6b0f092959c74bull },
+    { 0x6c5d61ac8507f38eull, 0x13a2e965b9d81c8full },
+    { 0x4774ba17a649f072ull, 0x188ba3bf284e23b3ull },
+    { 0x1951e89d8fdc6c8full, 0x1eae8caef261aca0ull },
+    { 0x0fd3316279e9c3d9ull, 0x132d17ed577d0be4ull },
+    { 0x13c7fdbb186434cfull, 0x17f85de8ad5c4eddull },
+    { 0x58b9fd29de7d4203ull, 0x1df67562d8b36294ull },
+    { 0xb7743e3a2b0e4942ull, 0x12ba095dc7701d9cull },
+    { 0xe5514dc8b5d1db92ull, 0x17688bb5394c2503ull },
+    { 0xdea5a13ae3465277ull, 0x1d42aea2879f2e44ull },
+    { 0x0b2784c4ce0bf38aull, 0x1249ad2594c37cebull },
+    { 0xcdf165f6018ef06dull, 0x16dc186ef9f45c25ull },
+    { 0x416dbf7381f2ac88ull, 0x1c931e8ab871732full },
+    { 0x88e497a83137abd5ull, 0x11dbf316b346e7fdull },
+    { 0xeb1dbd923d8596caull, 0x1652efdc6018a1fcull },
+    { 0x25e52cf6cce6fc7dull, 0x1be7abd3781eca7cull },
+    { 0x97af3c1a40105dceull, 0x1170cb642b133e8dull },
+    { 0xfd9b0b20d0147542ull, 0x15ccfe3d35d80e30ull },
+    { 0x3d01cde904199292ull, 0x1b403dcc834e11bdull },
+    { 0x462120b1a28ffb9bull, 0x1108269fd210cb16ull },
+    { 0xd7a968de0b33fa82ull, 0x154a3047c694fddbull },
+    { 0xcd93c3158e00f923ull, 0x1a9cbc59b83a3d52ull },
+    { 0xc07c59ed78c09bb6ull, 0x10a1f5b813246653ull },
+    { 0xb09b7068d6f0c2a3ull, 0x14ca732617ed7fe8ull },
+    { 0xdcc24c830cacf34cull, 0x19fd0fef9de8dfe2ull },
+    { 0xc9f96fd1e7ec180full, 0x103e29f5c2b18bedull },
+    { 0x3c77cbc661e71e13ull, 0x144db473335deee9ull },
+    { 0x8b95beb7fa60e598ull, 0x1961219000356aa3ull },
+    { 0x6e7b2e65f8f91efeull, 0x1fb969f40042c54cull },
+    { 0xc50cfcffbb9bb35full, 0x13d3e2388029bb4full },
+    { 0xb6503c3faa82a037ull, 0x18c8dac6a0342a23ull },
+    { 0xa3e44b4f95234844ull, 0x1efb1178484134acull },
+    { 0xe66eaf11bd360d2bull, 0x135ceaeb2d28c0ebull },
+    { 0xe00a5ad62c839075ull, 0x183425a5f872f126ull },
+    { 0x980cf18bb7a47493ull, 0x1e412f0f768fad70ull },
+    { 0x5f0816f752c6c8dcull, 0x12e8bd69aa19cc66ull },
+    { 0xf6ca1cb527787b13ull, 0x17a2ecc414a03f7full },
+    { 0xf47ca3e2715699d7ull, 0x1d8ba7f519c84f5full },
+    { 0xf8cde66d86d62026ull, 0x127748f9301d319bull },
+    { 0xf7016008e88ba830ull, 0x17151b377c247e02ull },
+    { 0xb4c1b80b22ae923cull, 0x1cda62055b2d9d83ull },
+    { 0x50f91306f5ad1b65ull, 0x12087d4358fc8272ull },
+    { 0xe53757c8b318623full, 0x168a9c942f3ba30eull },
+    { 0x9e852dbadfde7acfull, 0x1c2d43b93b0a8bd2ull },
+    { 0xa3133c94cbeb0cc1ull, 0x119c4a53c4e69763ull },
+    { 0x8bd80bb9fee5cff1ull, 0x16035ce8b6203d3cull },
+    { 0xaece0ea87e9f43eeull, 0x1b843422e3a84c8bull },
+    { 0x4d40c9294f238a75ull, 0x1132a095ce492fd7ull },
+    { 0x2090fb73a2ec6d12ull, 0x157f48bb41db7bcdull },
+    { 0x68b53a508ba78856ull, 0x1adf1aea12525ac0ull },
+    { 0x417144725748b536ull, 0x10cb70d24b7378b8ull },
+    { 0x51cd958eed1ae283ull, 0x14fe4d06de5056e6ull },
+    { 0xe640faf2a8619b24ull, 0x1a3de04895e46c9full },
+    { 0xefe89cd7a93d00f7ull, 0x1066ac2d5daec3e3ull },
+    { 0xebe2c40d938c4134ull, 0x14805738b51a74dcull },
+    { 0x26db7510f86f5181ull, 0x19a06d06e2611214ull },
+    { 0x9849292a9b4592f1ull, 0x100444244d7cab4cull },
+    { 0xbe5b73754216f7adull, 0x1405552d60dbd61full },
+    { 0xadf25052929cb598ull, 0x1906aa78b912cba7ull },
+    { 0x996ee4673743e2ffull, 0x1f485516e7577e91ull },
+    { 0xffe54ec0828a6ddfull, 0x138d352e5096af1aull },
+    { 0xbfdea270a32d0957ull, 0x18708279e4bc5ae1ull },
+    { 0x2fd64b0ccbf84badull, 0x1e8ca3185deb719aull },
+    { 0x5de5eee7ff7b2f4cull, 0x1317e5ef3ab32700ull },
+    { 0x755f6aa1ff59fb1full, 0x17dddf6b095ff0c0ull },
+    { 0x92b7454a7f3079e7ull, 0x1dd55745cbb7ecf0ull },
+    { 0x5bb28b4e8f7e4c30ull, 0x12a5568b9f52f416ull },
+    { 0xf29f2e22335ddf3cull, 0x174eac2e8727b11bull },
+    { 0xef46f9aac035570bull, 0x1d22573a28f19d62ull },
+    { 0xd58c5c0ab8215667ull, 0x123576845997025dull },
+    { 0x4aef730d6629ac01ull, 0x16c2d4256ffcc2f5ull },
+    { 0x9dab4fd0bfb41701ull, 0x1c73892ecbfbf3b2ull },
+    { 0xa28b11e277d08e60ull, 0x11c835bd3f7d784full },
+    { 0x8b2dd65b15c4b1f9ull, 0x163a432c8f5cd663ull },
+    { 0x6df94bf1db35de77ull, 0x1bc8d3f7b3340bfcull },
+    { 0xc4bbcf772901ab0aull, 0x115d847ad000877dull },
+    { 0x35eac354f34215cdull, 0x15b4e5998400a95dull },
+    { 0x8365742a30129b40ull, 0x1b221effe500d3b4ull },
+    { 0xd21f689a5e0ba108ull, 0x10f5535fef208450ull },
+    { 0x06a742c0f58e894aull, 0x1532a837eae8a565ull },
+    { 0x4851137132f22b9dull, 0x1a7f5245e5a2cebeull },
+    { 0xed32ac26bfd75b42ull, 0x108f936baf85c136ull },
+    { 0xa87f57306fcd3212ull, 0x14b378469b673184ull },
+    { 0xd29f2cfc8bc07e97ull, 0x19e056584240fde5ull },
+    { 0xa3a37c1dd7584f1eull, 0x102c35f729689eafull },
+    { 0x8c8c5b254d2e62e6ull, 0x14374374f3c2c65bull },
+    { 0x6faf71eea079fb9full, 0x1945145230b377f2ull },
+    { 0x0b9b4e6a48987a87ull, 0x1f965966bce055efull },
+    { 0x674111026d5f4c94ull, 0x13bdf7e0360c35b5ull },
+    { 0xc111554308b71fbaull, 0x18ad75d8438f4322ull },
+    { 0x7155aa93cae4e7a8ull, 0x1ed8d34e547313ebull },
+    { 0x26d58a9c5ecf10c9ull, 0x13478410f4c7ec73ull },
+    { 0xf08aed437682d4fbull, 0x1819651531f9e78full },
+    { 0xecada89454238a3aull, 0x1e1fbe5a7e786173ull },
+    { 0x73ec895cb4963664ull, 0x12d3d6f88f0b3ce8ull },
+    { 0x90e7abb3e1bbc3fdull, 0x1788ccb6b2ce0c22ull },
+    { 0x352196a0da2ab4fdull, 0x1d6affe45f818f2bull },
+    { 0x0134fe24885ab11eull, 0x1262dfeebbb0f97bull },
+    { 0xc1823dadaa715d65ull, 0x16fb97ea6a9d37d9ull },
+    { 0x31e2cd19150db4bfull, 0x1cba7de5054485d0ull },
+    { 0x1f2dc02fad2890f7ull, 0x11f48eaf234ad3a2ull },
+    { 0xa6f9303b9872b535ull, 0x1671b25aec1d888aull },
+    { 0x50b77c4a7e8f6282ull, 0x1c0e1ef1a724eaadull },
+    { 0x5272adae8f199d91ull, 0x1188d357087712acull },
+    { 0x670f591a32e004f6ull, 0x15eb082cca94d757ull },
+    { 0x40d32f60bf980633ull, 0x1b65ca37fd3a0d2dull },
+    { 0x4883fd9c77bf03e0ull, 0x111f9e62fe44483cull },
+    { 0x5aa4fd0395aec4d8ull, 0x156785fbbdd55a4bull },
+    { 0x314e3c447b1a760eull, 0x1ac1677aad4ab0deull },
+    { 0xded0e5aaccf089c9ull, 0x10b8e0acac4eae8aull },
+    { 0x96851f15802cac3bull, 0x14e718d7d7625a2dull },
+    { 0xfc2666dae037d74aull, 0x1a20df0dcd3af0b8ull },
+    { 0x9d980048cc22e68eull, 0x10548b68a044d673ull },
+    { 0x84fe005aff2ba032ull, 0x1469ae42c8560c10ull },
+    { 0xa63d8071bef6883eull, 0x198419d37a6b8f14ull },
+    { 0xcfcce08e2eb42a4eull, 0x1fe52048590672d9ull },
+    { 0x21e00c58dd309a70ull, 0x13ef342d37a407c8ull },
+    { 0x2a580f6f147cc10dull, 0x18eb0138858d09baull },
+    { 0xb4ee134ad99bf150ull, 0x1f25c186a6f04c28ull },
+    { 0x7114cc0ec80176d2ull, 0x137798f428562f99ull },
+    { 0xcd59ff127a01d486ull, 0x18557f31326bbb7full },
+    { 0xc0b07ed7188249a8ull, 0x1e6adefd7f06aa5full },
+    { 0xd86e4f466f516e09ull, 0x1302cb5e6f642a7bull },
+    { 0xce89e3180b25c98bull, 0x17c37e360b3d351aull },
+    { 0x822c5bde0def3beeull, 0x1db45dc38e0c8261ull },
+    { 0xf15bb96ac8b58575ull, 0x1290ba9a38c7d17cull },
+    { 0x2db2a7c57ae2e6d2ull, 0x1734e940c6f9c5dcull },
+    { 0x391f51b6d99ba086ull, 0x1d022390f8b83753ull },
+    { 0x03b3931248014454ull, 0x1221563a9b732294ull },
+    { 0x04a077d6da019569ull, 0x16a9abc9424feb39ull },
+    { 0x45c895cc9081fac3ull, 0x1c5416bb92e3e607ull },
+    { 0x8b9d5d9fda513cbaull, 0x11b48e353bce6fc4ull },
+    { 0xae84b507d0e58be8ull, 0x1621b1c28ac20bb5ull },
+    { 0x1a25e249c51eeee3ull, 0x1baa1e332d728ea3ull },
+    { 0xf057ad6e1b33554dull, 0x114a52dffc679925ull },
+    { 0x6c6d98c9a2002aa1ull, 0x159ce797fb817f6full },
+    { 0x4788fefc0a803549ull, 0x1b04217dfa61df4bull },
+    { 0x0cb59f5d8690214eull, 0x10e294eebc7d2b8full },
+    { 0xcfe30734e83429a1ull, 0x151b3a2a6b9c7672ull },
+    { 0x83dbc9022241340aull, 0x1a6208b50683940full },
+    { 0xb2695da15568c086ull, 0x107d457124123c89ull },
+    { 0x1f03b509aac2f0a7ull, 0x149c96cd6d16cbacull },
+    { 0x26c4a24c1573acd1ull, 0x19c3bc80c85c7e97ull },
+    { 0x783ae56f8d684c03ull, 0x101a55d07d39cf1eull },
+    { 0x16499ecb70c25f03ull, 0x1420eb449c8842e6ull },
+    { 0x9bdc067e4cf2f6c4ull, 0x19292615c3aa539full },
+    { 0x82d3081de02fb476ull, 0x1f736f9b3494e887ull },
+    { 0xb1c3e512ac1dd0c9ull, 0x13a825c100dd1154ull },
+    { 0xde34de57572544fcull, 0x18922f31411455a9ull },
+    { 0x55c215ed2cee963bull, 0x1eb6bafd91596b14ull },
+    { 0xb5994db43c151de5ull, 0x133234de7ad7e2ecull },
+    { 0xe2ffa1214b1a655eull, 0x17fec216198ddba7ull },
+    { 0xdbbf89699de0feb6ull, 0x1dfe729b9ff15291ull },
+    { 0x2957b5e202ac9f31ull, 0x12bf07a143f6d39bull },
+    { 0xf3ada35a8357c6feull, 0x176ec98994f48881ull },
+    { 0x70990c31242db8bdull, 0x1d4a7bebfa31aaa2ull },
+    { 0x865fa79eb69c9376ull, 0x124e8d737c5f0aa5ull },
+    { 0xe7f791866443b854ull, 0x16e230d05b76cd4eull },
+    { 0xa1f575e7fd54a669ull, 0x1c9abd04725480a2ull },
+    { 0xa53969b0fe54e801ull, 0x11e0b622c774d065ull },
+    { 0x0e87c41d3dea2202ull, 0x1658e3ab7952047full },
+    { 0xd229b5248d64aa82ull, 0x1bef1c9657a6859eull },
+    { 0x435a1136d85eea91ull, 0x117571ddf6c81383ull },
+    { 0x143095848e76a536ull, 0x15d2ce55747a1864ull },
+    { 0x193cbae5b2144e83ull, 0x1b4781ead1989e7dull },
+    { 0x2fc5f4cf8f4cb112ull, 0x110cb132c2ff630eull },
+    { 0xbbb77203731fdd56ull, 0x154fdd7f73bf3bd1ull },
+    { 0x2aa54e844fe7d4acull, 0x1aa3d4df50af0ac6ull },
+    { 0xdaa75112b1f0e4ebull, 0x10a6650b926d66bbull },
+    { 0xd15125575e6d1e26ull, 0x14cffe4e7708c06aull },
+    { 0x85a56ead360865b0ull, 0x1a03fde214caf085ull },
+    { 0x7387652c41c53f8eull, 0x10427ead4cfed653ull },
+    { 0x50693e7752368f71ull, 0x14531e58a03e8be8ull },
+    { 0x64838e1526c4334eull, 0x1967e5eec84e2ee2ull },
+    { 0xfda4719a70754022ull, 0x1fc1df6a7a61ba9aull },
+    { 0xde86c70086494815ull, 0x13d92ba28c7d14a0ull },
+    { 0x162878c0a7db9a1aull, 0x18cf768b2f9c59c9ull },
+    { 0x5bb296f0d1d280a1ull, 0x1f03542dfb83703bull },
+    { 0x194f9e5683239064ull, 0x1362149cbd322625ull },
+    { 0x5fa385ec23ec747eull, 0x183a99c3ec7eafaeull },
+    { 0xf78c67672ce7919dull, 0x1e494034e79e5b99ull },
+    { 0x3ab7c0a07c10bb02ull, 0x12edc82110c2f940ull },
+    { 0x4965b0c89b14e9c3ull, 0x17a93a2954f3b790ull },
+    { 0x5bbf1cfac1da2433ull, 0x1d9388b3aa30a574ull },
+    { 0xb957721cb92856a0ull, 0x127c35704a5e6768ull },
+    { 0xe7ad4ea3e7726c48ull, 0x171b42cc5cf60142ull },
+    { 0xa198a24ce14f075aull, 0x1ce2137f74338193ull },
+    { 0x44ff65700cd16498ull, 0x120d4c2fa8a030fcull },
+    { 0x563f3ecc1005bdbeull, 0x16909f3b92c83d3bull },
+    { 0x2bcf0e7f14072d2eull, 0x1c34c70a777a4c8aull },
+    { 0x5b61690f6c847c3dull, 0x11a0fc668aac6fd6ull },
+    { 0xf239c35347a59b4cull, 0x16093b802d578bcbull },
+    { 0xeec83428198f021full, 0x1b8b8a6038ad6ebeull },
+    { 0x553d20990ff96153ull, 0x1137367c236c6537ull },
+    { 0x2a8c68bf53f7b9a8ull, 0x1585041b2c477e85ull },
+    { 0x752f82ef28f5a812ull, 0x1ae64521f7595e26ull },
+    { 0x093db1d57999890bull, 0x10cfeb353a97dad8ull },
+    { 0x0b8d1e4ad7ffeb4eull, 0x1503e602893dd18eull },
+    { 0x8e7065dd8dffe622ull, 0x1a44df832b8d45f1ull },
+    { 0xf9063faa78bfefd5ull, 0x106b0bb1fb384bb6ull },
+    { 0xb747cf9516efebcaull, 0x1485ce9e7a065ea4ull },
+    { 0xe519c37a5cabe6bdull, 0x19a742461887f64dull },
+    { 0xaf301a2c79eb7036ull, 0x1008896bcf54f9f0ull },
+    { 0xdafc20b798664c43ull, 0x140aabc6c32a386cull },
+    { 0x11bb28e57e7fdf54ull, 0x190d56b873f4c688ull },
+    { 0x1629f31ede1fd72aull, 0x1f50ac6690f1f82aull },
+    { 0x4dda37f34ad3e67aull, 0x13926bc01a973b1aull },
+    { 0xe150c5f01d88e019ull, 0x187706b0213d09e0ull },
+    { 0x19a4f76c24eb181full, 0x1e94c85c298c4c59ull },
+    { 0xb0071aa39712ef13ull, 0x131cfd3999f7afb7ull },
+    { 0x9c08e14c7cd7aad8ull, 0x17e43c8800759ba5ull },
+    { 0x030b199f9c0d958eull, 0x1ddd4baa0093028full },
+    { 0x61e6f003c1887d79ull, 0x12aa4f4a405be199ull },
+    { 0xba60ac04b1ea9cd7ull, 0x1754e31cd072d9ffull },
+    { 0xa8f8d705de65440dull, 0x1d2a1be4048f907full },
+    { 0xc99b8663aaff4a88ull, 0x123a516e82d9ba4full },
+    { 0xbc0267fc95bf1d2aull, 0x16c8e5ca239028e3ull },
+    { 0xab0301fbbb2ee474ull, 0x1c7b1f3cac74331cull },
+    { 0xeae1e13d54fd4ec9ull, 0x11ccf385ebc89ff1ull },
+    { 0x659a598caa3ca27bull, 0x1640306766bac7eeull },
+    { 0xff00efefd4cbcb1aull, 0x1bd03c81406979e9ull },
+    { 0x3f6095f5e4ff5ef0ull, 0x116225d0c841ec32ull },
+    { 0xcf38bb735e3f36acull, 0x15baaf44fa52673eull },
+    { 0x8306ea5035cf0457ull, 0x1b295b1638e7010eull },
+    { 0x11e4527221a162b6ull, 0x10f9d8ede39060a9ull },
+    { 0x565d670eaa09bb64ull, 0x15384f295c7478d3ull },
+    { 0x2bf4c0d2548c2a3dull, 0x1a8662f3b3919708ull },
+    { 0x1b78f88374d79a66ull, 0x1093fdd8503afe65ull },
+    { 0x625736a4520d8100ull, 0x14b8fd4e6449bdfeull },
+    { 0xfaed044d6690e140ull, 0x19e73ca1fd5c2d7dull },
+    { 0xbcd422b0601a8cc8ull, 0x103085e53e599c6eull },
+    { 0x6c092b5c78212ffaull, 0x143ca75e8df0038aull },
+    { 0x070b763396297bf8ull, 0x194bd136316c046dull },
+    { 0x48ce53c07bb3daf6ull, 0x1f9ec583bdc70588ull },
+    { 0x2d80f4584d5068daull, 0x13c33b72569c6375ull },
+    { 0x78e1316e60a48310ull, 0x18b40a4eec437c52ull },
+};
+
+// 2^(bitlen(5^i) - 1 + 125) / 5^i + 1 as { low, high }
+static const uint64_t ds_pow5_inv_split[DS_POW5_INV_TABLE_SIZE][2] = {
+    { 0x0000000000000001ull, 0x2000000000000000ull },
+    { 0x999999999999999aull, 0x1999999999999999ull },
+    { 0x47ae147ae147ae15ull, 0x147ae147ae147ae1ull },
+    { 0x6c8b4395810624deull, 0x10624dd2f1a9fbe7ull },
+    { 0x7a786c226809d496ull, 0x1a36e2eb1c432ca5ull },
+    { 0x61f9f01b866e43abull, 0x14f8b588e368f084ull },
+    { 0xb4c7f34938583622ull, 0x10c6f7a0b5ed8d36ull },
+    { 0x87a6520ec08d236aull, 0x1ad7f29abcaf4857ull },
+    { 0x9fb841a566d74f88ull, 0x15798ee2308c39dfull },
+    { 0xe62d01511f12a607ull, 0x112e0be826d694b2ull },
+    { 0xd6ae6881cb5109a4ull, 0x1b7cdfd9d7bdbab7ull },
+    { 0xdef1ed34a2a73aeaull, 0x15fd7fe17964955full },
+    { 0x7f27f0f6e885c8bbull, 0x119799812dea1119ull },
+    { 0x650cb4be40d60df8ull, 0x1c25c268497681c2ull },
+    { 0xea70909833de7193ull, 0x16849b86a12b9b01ull },
+    { 0x21f3a6e0297ec143ull, 0x1203af9ee756159bull },
+    { 0x6985d7cd0f313537ull, 0x1cd2b297d889bc2bull },
+    { 0x2137dfd73f5a90f9ull, 0x170ef54646d49689ull },
+    { 0xe75fe645cc4873faull, 0x12725dd1d243aba0ull },
+    { 0xa5663d3c7a0d865dull, 0x1d83c94fb6d2ac34ull },
+    { 0x511e976394d79eb1ull, 0x179ca10c9242235dull },
+    { 0xda7edf82dd794bc1ull, 0x12e3b40a0e9b4f7dull },
+    { 0x2a6498d1625bac68ull, 0x1e392010175ee596ull },
+    { 0xeeb6e0a781e2f053ull, 0x182db34012b25144ull },
+    { 0x58924d52ce4f26a9ull, 0x1357c299a88ea76aull },
+    { 0x27507bb7b07ea441ull, 0x1ef2d0f5da7dd8aaull },
+    { 0x52a6c95fc0655034ull, 0x18c240c4aecb13bbull },
+    { 0x0eebd44c99eaa690ull, 0x13ce9a36f23c0fc9ull },
+    { 0xb17953adc3110a80ull, 0x1fb0f6be50601941ull },
+    { 0xc12ddc8b02740867ull, 0x195a5efea6b34767ull },
+    { 0x3424b06f3529a052ull, 0x14484bfeebc29f86ull },
+    { 0x901d59f290ee19dbull, 0x1039d66589687f9eull },
+    { 0x4cfbc31db4b0295full, 0x19f623d5a8a73297ull },
+    { 0x3d9635b15d59bab2ull, 0x14c4e977ba1f5bacull },
+    { 0x97ab5e277de16228ull, 0x109d8792fb4c4956ull },
+    { 0xf2abc9d8c9689d0dull, 0x1a95a5b7f87a0ef0ull },
+    { 0x5bbca17a3aba173eull, 0x154484932d2e725aull },
+    { 0xafca1ac82efb45cbull, 0x11039d428a8b8eaeull },
+    { 0xb2dcf7a6b1920945ull, 0x1b38fb9daa78e44aull },
+    { 0xf57d92ebc141a104ull, 0x15c72fb1552d836eull },
+    { 0xc46475896767b403ull, 0x116c262777579c58ull },
+    { 0x6d6d88dbd8a5ecd2ull, 0x1be03d0bf225c6f4ull },
+    { 0x8abe071646eb23dbull, 0x164cfda3281e38c3ull },
+    { 0x6efe6c11d255b649ull, 0x11d7314f534b609cull },
+    { 0xb197134fb6ef8a0eull, 0x1c8b821885456760ull },
+    { 0x27ac0f72f8bfa1a5ull, 0x16d601ad376ab91aull },
+    { 0xb95672c260994e1eull, 0x1244ce242c5560e1ull },
+    { 0xf5571e03cdc21695ull, 0x1d3ae36d13bbce35ull },
+    { 0x2aac18030b01ababull, 0x17624f8a762fd82bull },
+    { 0xbbbce0026f348956ull, 0x12b50c6ec4f31355ull },
+    { 0x92c7ccd0b1eda889ull, 0x1dee7a4ad4b81eefull },
+    { 0xdbd30a408e57ba07ull, 0x17f1fb6f10934bf2ull },
+    { 0x7ca8d50071dfc806ull, 0x1327fc58da0f6ff5ull },
+    { 0xfaa7bb33e9660cd6ull, 0x1ea6608e29b24cbbull },
+    { 0x9552fc298784d711ull, 0x18851a0b548ea3c9ull },
+    { 0xaaa8c9bad2d0ac0eull, 0x139dae6f76d88307ull },
+    { 0xdddadc5e1e1aace3ull, 0x1f62b0b257c0d1a5ull },
+    { 0x7e48b04b4b488a4full, 0x191bc08eac9a4151ull },
+    { 0xcb6d59d5d5d3a1d9ull, 0x141633a556e1cddaull },
+    { 0x3c577b1177dc817bull, 0x1011c2eaabe7d7e2ull },
+    { 0xc6f25e825960cf2aull, 0x19b604aaaca62636ull },
+    { 0x6bf518684780a5bbull, 0x14919d5556eb51c5ull },
+    { 0x232a79ed06008496ull, 0x10747ddddf22a7d1ull },
+    { 0xd1dd8fe1a3340756ull, 0x1a53fc9631d10c81ull },
+    { 0xa7e4731ae8f66c45ull, 0x150ffd44f4a73d34ull },
+    { 0x531d28e253f8569eull, 0x10d9976a5d52975dull },
+    { 0xeb61db03b98d5762ull, 0x1af5bf109550f22eull },
+    { 0xbc4e48cfc7a445e8ull, 0x159165a6ddda5b58ull },
+    { 0x6371d3d96c836b20ull, 0x11411e1f17e1e2adull },
+    { 0x9f1c8628ad9f11cdull, 0x1b9b6364f3030448ull },
+    { 0xe5b06b53be18db0bull, 0x1615e91d8f359d06ull },
+    { 0xeaf3890fcb4715a2ull, 0x11ab20e472914a6bull },
+    { 0x44b8db4c7871bc37ull, 0x1c45016d841baa46ull },
+    { 0x03c715d6c6c1635full, 0x169d9abe03495505ull },
+    { 0x3638de456bcde919ull, 0x1217aefe69077737ull },
+    { 0x56c163a2461641c1ull, 0x1cf2b1970e725858ull },
+    { 0xdf011c81d1ab67ceull, 0x17288e1271f51379ull },
+    { 0x7f3416ce4155eca5ull, 0x1286d80ec190dc61ull },
+    { 0x6520247d3556476eull, 0x1da48ce468e7c702ull },
+    { 0xea801d30f7783925ull, 0x17b6d71d20b96c01ull },
+    { 0xbb99b0f3f92cfa84ull, 0x12f8ac174d612334ull },
+    { 0x5f5c4e532847f739ull, 0x1e5aacf215683854ull },
+    { 0x7f7d0b75b9d32c2eull, 0x18488a5b44536043ull },
+    { 0x9930d5f7c7dc2358ull, 0x136d3b7c36a919cfull },
+    { 0x8eb4898c72f9d226ull, 0x1f152bf9f10e8fb2ull },
+    { 0x722a07a38f2e41b8ull, 0x18ddbcc7f40ba628ull },
+    { 0xc1bb394fa5be9afaull, 0x13e497065cd61e86ull },
+    { 0x9c5ec2190930f7f6ull, 0x1fd424d6faf030d7ull },
+    { 0x49e56814075a5ff8ull, 0x197683df2f268d79ull },
+    { 0x6e51201005e1e660ull, 0x145ecfe5bf520ac7ull },
+    { 0xf1da800cd181851aull, 0x104bd984990e6f05ull },
+    { 0x4fc400148268d4f5ull, 0x1a12f5a0f4e3e4d6ull },
+    { 0xd96999aa01ed772bull, 0x14dbf7b3f71cb711ull },
+    { 0xadee1488018ac5bcull, 0x10aff95cc5b09274ull },
+    { 0x497ceda668de092cull, 0x1ab328946f80ea54ull },
+    { 0x3aca57b853e4d424ull, 0x155c2076bf9a5510ull },
+    { 0x623b7960431d7683ull, 0x1116805effaeaa73ull },
+    { 0x9d2bf566d1c8bd9eull, 0x1b5733cb32b110b8ull },
+    { 0x7dbcc452416d647full, 0x15df5ca28ef40d60ull },
+    { 0xcafd69db678ab6ccull, 0x117f7d4ed8c33de6ull },
+    { 0xab2f0fc572778adfull, 0x1bff2ee48e052fd7ull },
+    { 0x88f273045b92d580ull, 0x1665bf1d3e6a8cacull },
+    { 0xd3f528d049424466ull, 0x11eaff4a98553d56ull },
+    { 0xb988414d4203a0a3ull, 0x1cab3210f3bb9557ull },
+    { 0x6139cdd76802e6e9ull, 0x16ef5b40c2fc7779ull },
+    { 0xe761717920025254ull, 0x125915cd68c9f92dull },
+    { 0xa568b58e999d5086ull, 0x1d5b561574765b7cull },
+    { 0x5120913ee14aa6d2ull, 0x177c44ddf6c515fdull },
+    { 0xa74d40ff1aa21f0eull, 0x12c9d0b1923744caull },
+    { 0x0baece64f769cb4aull, 0x1e0fb44f50586e11ull },
+    { 0x3c8bd850c5ee3c3bull, 0x180c903f7379f1a7ull },
+    { 0xca0979da37f1c9c9ull, 0x133d4032c2c7f485ull },
+    { 0xa9a8c2f6bfe942dbull, 0x1ec866b79e0cba6full },
+    { 0x2153cf2bccba9be3ull, 0x18a0522c7e709526ull },
+    { 0x1aa9728970954982ull, 0x13b374f06526ddb8ull },
+    { 0xf775840f1a88759dull, 0x1f8587e7083e2f8cull },
+    { 0x5f9136727ba05e17ull, 0x19379fec0698260aull },
+    { 0x1940f85b9619e4dfull, 0x142c7ff0054684d5ull },
+    { 0xe100c6afab47ea4cull, 0x1023998cd1053710ull },
+    { 0xce67a44c453fdd47ull, 0x19d28f47b4d524e7ull },
+    { 0xd852e9d69dccb106ull, 0x14a8729fc3ddb71full },
+    { 0x79dbee454b0a2738ull, 0x1086c219697e2c19ull },
+    { 0x295fe3a211a9d859ull, 0x1a71368f0f30468full },
+    { 0xbab31c81a7bb137aull, 0x15275ed8d8f36ba5ull },
+    { 0x6228e39aec95a92full, 0x10ec4be0ad8f8951ull },
+    { 0x9d0e38f7e0ef7517ull, 0x1b13ac9aaf4c0ee8ull },
+    { 0xb0d82d931a592a79ull, 0x15a956e225d67253ull },
+    { 0x8d79be0f4847552eull, 0x11544581b7dec1dcull },
+    { 0x158f967eda0bbb7cull, 0x1bba08cf8c979c94ull },
+    { 0x77a611ff14d62f97ull, 0x162e6d72d6dfb076ull },
+    { 0xf951a7ff43de8c79ull, 0x11bebdf578b2f391ull },
+    { 0xc21c3ffed2fdad8eull, 0x1c6463225ab7ec1cull },
+    { 0x01b0333242648ad8ull, 0x16b6b5b5155ff017ull },
+    { 0x0159c28e9b83a246ull, 0x122bc490dde659acull },
+    { 0xcef604175f3903a3ull, 0x1d12d41afca3c2acull },
+    { 0x725e69ac4c2d9c83ull, 0x17424348ca1c9bbdull },
+    { 0xf5185489d68ae39cull, 0x129b69070816e2fdull },
+    { 0xee8d540fbdab05c6ull, 0x1dc574d80cf16b2full },
+    { 0xbed77672fe226b05ull, 0x17d12a4670c1228cull },
+    { 0xff12c528cb4ebc04ull, 0x130dbb6b8d674ed6ull },
+    { 0xcb513b74787df9a0ull, 0x1e7c5f127bd87e24ull },
+    { 0x090dc929f9fe614dull, 0x18637f41fcad31b7ull },
+    { 0xa0d7d42194cb810aull, 0x1382cc34ca2427c5ull },
+    { 0x67bfb9cf5478ce77ull, 0x1f37ad21436d0c6full },
+    { 0x1fcc94a5dd2d71f9ull, 0x18f9574dcf8a7059ull },
+    { 0x7fd6dd517dbdf4c7ull, 0x13faac3e3fa1f37aull },
+    { 0xffbe2ee8c92fee0bull, 0x1ff779fd329cb8c3ull },
+    { 0x6631bf20a0f324d6ull, 0x1992c7fdc216fa36ull },
+    { 0xb827cc1a1a5c1d78ull, 0x14756ccb01abfb5eull },
+    { 0x935309ae7b7ce460ull, 0x105df0a267bcc918ull },
+    { 0x1eeb42b0c594a099ull, 0x1a2fe76a3f9474f4ull },
+    { 0xe58902270476e6e1ull, 0x14f31f8832dd2a5cull },
+    { 0xb7a0ce859d2bebe7ull, 0x10c27fa028b0eeb0ull },
+    { 0x59014a6f61dfdfd8ull, 0x1ad0cc33744e4ab4ull },
+    { 0xe0cdd525e7e64cadull, 0x1573d68f903ea229ull },
+    { 0x4d7177518651d6f1ull, 0x11297872d9cbb4eeull },
+    { 0x7be8bee8d6e957e8ull, 0x1b758d848fac54b0ull },
+    { 0xfcba3253df211320ull, 0x15f7a46a0c89dd59ull },
+    { 0x63c8284318e74280ull, 0x1192e9ee706e4aaeull },
+    { 0x060d0d3827d86a66ull, 0x1c1e43171a4a1117ull },
+    { 0x6b3da42cecad21ebull, 0x167e9c127b6e7412ull },
+    { 0x88fe1cf0bd574e56ull, 0x11fee341fc585cdbull },
+    { 0x419694b462254a23ull, 0x1ccb0536608d615full },
+    { 0x67abaa29e81dd4e9ull, 0x1708d0f84d3de77full },
+    { 0xb95621bb2017dd87ull, 0x126d73f9d764b932ull },
+    { 0xc223692b668c95a5ull, 0x1d7becc2f23ac1eaull },
+    { 0xce82ba891ed6de1dull, 0x179657025b6234bbull },
+    { 0xa53562074bdf1818ull, 0x12deac01e2b4f6fcull },
+    { 0x3b889cd87964f359ull, 0x1e3113363787f194ull },
+    { 0xfc6d4a46c783f5e1ull, 0x18274291c6065adcull },
+    { 0x30576e9f06032b1aull, 0x13529ba7d19eaf17ull },
+    { 0x1a257dcb3cd1de90ull, 0x1eea92a61c311825ull },
+    { 0x481dfe3c30a7e540ull, 0x18bba884e35a79b7ull },
+    { 0xd34b31c9c0865100ull, 0x13c9539d82aec7c5ull },
+    { 0x5211e942cda3b4cdull, 0x1fa885c8d117a609ull },
+    { 0x74db21023e1c90a4ull, 0x19539e3a40dfb807ull },
+    { 0xf715b401cb4a0d50ull, 0x1442e4fb67196005ull },
+    { 0xf8de299b09080aa7ull, 0x103583fc527ab337ull },
+    { 0x8e304291a80cddd7ull, 0x19ef3993b72ab859ull },
+    { 0x3e8d020e200a4b13ull, 0x14bf6142f8eef9e1ull },
+    { 0x653d9b3e80083c0full, 0x10991a9bfa58c7e7ull },
+    { 0x6ec8f864000d2ce4ull, 0x1a8e90f9908e0ca5ull },
+    { 0x8bd3f9e999a423eaull, 0x153eda614071a3b7ull },
+    { 0x3ca994bae1501cbbull, 0x10ff151a99f482f9ull },
+    { 0xc775bac49bb3612bull, 0x1b31bb5dc320d18eull },
+    { 0xd2c4956a16291a89ull, 0x15c162b168e70e0bull },
+    { 0xdbd0778811ba7ba1ull, 0x11678227871f3e6full },
+    { 0x2c80bf401c5d929bull, 0x1bd8d03f3e9863e6ull },
+    { 0xbd33cc3349e47549ull, 0x16470cff6546b651ull },
+    { 0xca8fd68f6e505dd4ull, 0x11d270cc51055ea7ull },
+    { 0x4419574be3b3c953ull, 0x1c83e7ad4e6efdd9ull },
+    { 0x0347790982f63aa9ull, 0x16cfec8aa52597e1ull },
+    { 0xcf6c60d468c4fbbaull, 0x123ff06eea847980ull },
+    { 0xe57a34870e07f92aull, 0x1d331a4b10d3f59aull },
+    { 0x512e906c0b399422ull, 0x175c1508da432ae2ull },
+    { 0xda8ba6bcd5c7a9b5ull, 0x12b010d3e1cf5581ull },
+    { 0x90df712e22d90f87ull, 0x1de6815302e5559cull },
+    { 0xda4c5a8b4f140c6cull, 0x17eb9aa8cf1dde16ull },
+    { 0xaea37ba2a5a9a38aull, 0x1322e220a5b17e78ull },
+    { 0x7dd25f6aa2a905a9ull, 0x1e9e369aa2b59727ull },
+    { 0x97db7f888220d154ull, 0x187e92154ef7ac1full },
+    { 0x797c6606ce80a777ull, 0x139874ddd8c6234cull },
+    { 0x8f2d700ae4010bf1ull, 0x1f5a549627a36badull },
+    { 0x0c2459a25000d65aull, 0x191510781fb5efbeull },
+    { 0x701d1481d99a4515ull, 0x1410d9f9b2f7f2feull },
+    { 0xc017439b147b6a77ull, 0x100d7b2e28c65bfeull },
+    { 0xccf205c4ed9243f2ull, 0x19af2b7d0e0a2ccaull },
+    { 0x0a5b37d0be0e9cc2ull, 0x148c22ca71a1bd6full },
+    { 0x0848f973cb3ee3ceull, 0x10701bd527b4978cull },
+    { 0xda0e5bec78649fb0ull, 0x1a4cf9550c5425acull },
+    { 0x7b3eaff060507fc0ull, 0x150a6110d6a9b7bdull },
+    { 0x95cbbff380406633ull, 0x10d51a73deee2c97ull },
+    { 0xefac665266cd7052ull, 0x1aee90b964b04758ull },
+    { 0x2623850eb8a459dbull, 0x158ba6fab6f36c47ull },
+    { 0x1e82d0d893b6ae49ull, 0x113c85955f29236cull },
+    { 0xfd9e1af41f8ab075ull, 0x1b9408eefea838acull },
+    { 0x97b1af29b2d559f7ull, 0x16100725988693bdull },
+    { 0xac8e25baf5777b2cull, 0x11a66c1e139edc97ull },
+    { 0x7a7d092b2258c513ull, 0x1c3d79c9b8fe2dbfull },
+    { 0x61fda0ef4ead6a76ull, 0x169794a160cb57ccull },
+    { 0xe7fe1a590bbdeec5ull, 0x1212dd4de7091309ull },
+    { 0xa6635d5b45fcb13aull, 0x1ceafbafd80e84dcull },
+    { 0x851c4aaf6b308dc8ull, 0x172262f3133ed0b0ull },
+    { 0xd0e36ef2bc26d7d4ull, 0x1281e8c275cbda26ull },
+    { 0xb49f17eac6a48c86ull, 0x1d9ca79d894629d7ull },
+    { 0x2a18dfef0550706bull, 0x17b08617a104ee46ull },
+    { 0x54e0b3259dd9f389ull, 0x12f39e794d9d8b6bull },
+    { 0x87cdeb6f62f65274ull, 0x1e5297287c2f4578ull },
+    { 0xd30b22bf825ea85dull, 0x18421286c9bf6ac6ull },
+    { 0x0f3c1bcc684bb9e4ull, 0x13680ed23aff889full },
+    { 0x18602c7a4079296dull, 0x1f0ce4839198da98ull },
+    { 0x46b356c833942124ull, 0x18d71d360e13e213ull },
+    { 0x388f78a029434db6ull, 0x13df4a91a4dcb4dcull },
+    { 0x5a7f2766a86baf8aull, 0x1fcbaa82a1612160ull },
+    { 0x153285ebb9efbfa2ull, 0x196fbb9bb44db44dull },
+    { 0xaa8ed189618c994eull, 0x145962e2f6a4903dull },
+    { 0xeed8a7a11ad6e10cull, 0x1047824f2bb6d9caull },
+    { 0x7e27729b5e249b45ull, 0x1a0c03b1df8af611ull },
+    { 0xfe85f549181d4904ull, 0x14d6695b193bf80dull },
+    { 0xcb9e5dd4134aa0d0ull, 0x10ab877c142ff9a4ull },
+    { 0xdf63c9535211014dull, 0x1aac0bf9b9e65c3aull },
+    { 0x191ca10f74da6771ull, 0x15566ffafb1eb02full },
+    { 0xadb080d92a4852c1ull, 0x1111f32f2f4bc025ull },
+    { 0x15e7348eaa0d5134ull, 0x1b4feb7eb212cd09ull },
+    { 0xab1f5d3eee710dc4ull, 0x15d98932280f0a6dull },
+    { 0xbc1917658b8da49dull, 0x117ad428200c0857ull },
+    { 0x2cf4f23c127c3a94ull, 0x1bf7b9d9cce00d59ull },
+    { 0xf0c3f4fcdb969543ull, 0x165fc7e170b33de0ull },
+    { 0x5a365d9716121103ull, 0x11e6398126f5cb1aull },
+    { 0x9056fc24f01ce804ull, 0x1ca38f350b22de90ull },
+    { 0xd9df301d8ce3ecd0ull, 0x16e93f5da2824ba6ull },
+    { 0xe17f59b13d8323daull, 0x125432b14ecea2ebull },
+    { 0x68cbc2b52f38395cull, 0x1d53844ee47dd179ull },
+    { 0x53d6355dbf602de3ull, 0x177603725064a794ull },
+    { 0xa9782ab165e68b1cull, 0x12c4cf8ea6b6ec76ull },
+    { 0x0f26aab56fd744faull, 0x1e07b27dd78b13f1ull },
+    { 0x3f52222abfdf6a62ull, 0x18062864ac6f4327ull },
+    { 0x65db4e88997f884eull, 0x1338205089f29c1full },
+    { 0x6fc54a7428cc0d4aull, 0x1ec033b40fea9365ull },
+    { 0x596aa1f68709a43bull, 0x1899c2f673220f84ull },
+    { 0xadeee7f86c07b696ull, 0x13ae3591f5b4d936ull },
+    { 0x497e3ff3e00c5756ull, 0x1f7d228322baf524ull },
+    { 0xd464fff64cd6ac45ull, 0x1930e868e89590e9ull },
+    { 0x4383fff83d7889d1ull, 0x14272053ed4473eeull },
+    { 0xcf9cccc69793a174ull, 0x101f4d0ff1038ff1ull },
+    { 0x7f6147a425b90252ull, 0x19cbae7fe805b31cull },
+    { 0xcc4dd2e9b7c7350full, 0x14a2f1ffecd15c16ull },
+    { 0x3d0b0f215fd290d9ull, 0x10825b3323dab012ull },
+    { 0x61ab4b689950e7c1ull, 0x1a6a2b85062ab350ull },
+    { 0x4e22a2ba1440b967ull, 0x1521bc6a6b555c40ull },
+    { 0x0b4ee894dd009453ull, 0x10e7c9eebc4449cdull },
+    { 0x1217da87c800ed51ull, 0x1b0c764ac6d3a948ull },
+    { 0xdb46486ca000bddaull, 0x15a391d56bdc876cull },
+    { 0x490506bd4ccd64afull, 0x114fa7ddefe39f8aull },
+    { 0xa8080ac87ae23ab1ull, 0x1bb2a62fe638ff43ull },
+    { 0x5339a239fbe82ef4ull, 0x162884f31e93ff69ull },
+    { 0x75c7b4fb2fecf25dull, 0x11ba03f5b20fff87ull },
+    { 0x22d92191e647ea2eull, 0x1c5cd322b67fff3full },
+    { 0xb57a8141850654f2ull, 0x16b0a8e891ffff65ull },
+    { 0xc4620101373843f5ull, 0x1226ed86db3332b7ull },
+    { 0x3a366801f1f39feeull, 0x1d0b15a491eb8459ull },
+    { 0xfb5eb99b27f6198bull, 0x173c115074bc69e0ull },
+    { 0x2f7efae2865e7ad6ull, 0x129674405d6387e7ull },
+    { 0xe597f7d0d6fd9156ull, 0x1dbd86cd6238d971ull },
+    { 0x8479930d78cadaabull, 0x17cad23de82d7ac1ull },
+    { 0xd06142712d6f1556ull, 0x1308a831868ac89aull },
+    { 0x4d686a4eaf182222ull, 0x1e74404f3daada91ull },
+    { 0xa453883ef279b4e8ull, 0x185d003f6488aedaull },
+    { 0xe9dc6cff28615d87ull, 0x137d99cc506d58aeull },
+    { 0xa960ae650d6895a4ull, 0x1f2f5c7a1a488de4ull },
+    { 0xbab3beb73ded4483ull, 0x18f2b061aea07183ull },
+    { 0x2ef6322c318a9d36ull, 0x13f559e7bee6c136ull },
+    { 0xe4bd1d13827761f0ull, 0x1feef63f97d79b89ull },
+    { 0x83ca7da9352c4e5aull, 0x198bf832dfdfafa1ull },
+    { 0x9ca1fe20f756a515ull, 0x146ff9c24cb2f2e7ull },
+    { 0x4a1b31b3f9121daaull, 0x1059949b708f28b9ull },
+    { 0x435eb5ecc1b695ddull, 0x1a28edc580e50df5ull },
+    { 0x35e55e57015ede4aull, 0x14ed8b04671da4c4ull },
+    { 0xc4b77eac0118b1d5ull, 0x10be08d0527e1d69ull },
+    { 0xa12597799b5ab622ull, 0x1ac9a7b3b7302f0full },
+    { 0x4db7ac6149155e81ull, 0x156e1fc2f8f358d9ull },
+    { 0xd7c6238107444b9bull, 0x1124e63593f5e0adull },
+    { 0x593d059b3ed3ac2bull, 0x1b6e3d2286563449ull },
+    { 0xe0fd9e15cbdc89bcull, 0x15f1ca820511c36dull },
+    { 0xb3fe18116fe3a163ull, 0x118e3b9b37416924ull },
+    { 0x866359b57fd29bd1ull, 0x1c16c5c525357507ull },
+    { 0xd1e91491330ee30eull, 0x16789e3750f790d2ull },
+    { 0x74ba76da8f3f1c0bull, 0x11fa182c40c60d75ull },
+    { 0xedf72490e531c678ull, 0x1cc359e067a348bbull },
+    { 0x8b2c1d40b75b052dull, 0x1702ae4d1fb5d3c9ull },
+    { 0x6f567dcd5f7c0424ull, 0x12688b70e62b0fd4ull },
+    { 0x7ef0c94898c66d06ull, 0x1d74124e3d11b2edull },
+    { 0x98c0a106e09ebd9full, 0x17900ea4fda7c257ull },
+    { 0x470080d24d4bcae6ull, 0x12d9a550caec9b79ull },
+    { 0xd800ce1d487944a2ull, 0x1e29088144adc58eull },
+    { 0x1333d8176d2dd082ull, 0x1820d39a9d57d13full },
+    { 0xa8f646792424a6ceull, 0x134d76154aaca765ull },
+    { 0x74bd3d8ea03aa47dull, 0x1ee25688777aa56full },
+    { 0x5d64313ee6955064ull, 0x18b51206c5fbb78cull },
+    { 0x4ab68dcbebaaa6b7ull, 0x13c40e6bd1962c70ull },
+    { 0x1124161312aaa457ull, 0x1fa01712e8f0471aull },
+    { 0xda8344dc0eeee9dfull, 0x194cdf4253f36c14ull },
+    { 0xe2029d7cd8bf2180ull, 0x143d7f6843292343ull },
+    { 0x4e687dfd7a328133ull, 0x103132b9cf541c36ull },
+    { 0x4a40c9959050ceb8ull, 0x19e851294bb9c6bdull },
+    { 0x0833d477a6a70bc6ull, 0x14b9da876fc7d231ull },
+    { 0xa02976c61eec096bull, 0x1094aed2bfd30e8dull },
+    { 0x004257a364acdbdfull, 0x1a877e1dffb81749ull },
+    { 0xcd01dfb5ea23e319ull, 0x153931b1996012a0ull },
+    { 0x70ce4c91881cb5aeull, 0x10fa8e27ade6754dull },
+    { 0x1ae3adb5a69455e2ull, 0x1b2a7d0c4970bbafull },
+    { 0x7be957c4854377e8ull, 0x15bb973d078d62f2ull },
+    { 0xc987796a0435f987ull, 0x1162df64060ab58eull },
+    { 0x75a58f1006bcc271ull, 0x1bd1656cd67788e4ull },
+    { 0xf7b7a5a66bca3527ull, 0x16411df0ab92d3e9ull },
+    { 0x5fc61e1ebca1c41full, 0x11cdb18d560f0feeull },
+    { 0xffa363646102d365ull, 0x1c7c4f4889b1b316ull },
+    { 0x32e91c504d9bdc51ull, 0x16c9d906d48e28dfull },
+    { 0x8f20e37371497d0eull, 0x123b140576d820b2ull },
+    { 0x7e9b0585820f2e7cull, 0x1d2b533bf159cdeaull },
+    { 0xcbaf379e01a5becaull, 0x1755dc2ff447d7eeull },
+    { 0x0958f94b348498a1ull, 0x12ab168cc36cacbfull },
+};
+
+#define DS_POW10_MIN_EXPONENT (-342)
+#define DS_POW10_MAX_EXPONENT 308
+
+// 128 bit mantissa of 10^q for the Eisel-Lemire parser as { low, high }, index q - DS_POW10_MIN_EXPONENT.
+// normalized so the top bit is set, negative powers are rounded up
+static const uint64_t ds_pow10_mantissa[DS_POW10_MAX_EXPONENT - DS_POW10_MIN_EXPONENT + 1][2] = {
+    { 0x113faa2906a13b3full, 0xeef453d6923bd65aull },
+    { 0x4ac7ca59a424c507ull, 0x9558b4661b6565f8ull },
+    { 0x5d79bcf00d2df649ull, 0xbaaee17fa23ebf76ull },
+    { 0xf4d82c2c107973dcull, 0xe95a99df8ace6f53ull },
+    { 0x79071b9b8a4be869ull, 0x91d8a02bb6c10594ull },
+    { 0x9748e2826cdee284ull, 0xb64ec836a47146f9ull },
+    { 0xfd1b1b2308169b25ull, 0xe3e27a444d8d98b7ull },
+    { 0xfe30f0f5e50e20f7ull, 0x8e6d8c6ab0787f72ull },
+    { 0xbdbd2d335e51a935ull, 0xb208ef855c969f4full },
+    { 0xad2c788035e61382ull, 0xde8b2b66b3bc4723ull },
+    { 0x4c3bcb5021afcc31ull, 0x8b16fb203055ac76ull },
+    { 0xdf4abe242a1bbf3dull, 0xaddcb9e83c6b1793ull },
+    { 0xd71d6dad34a2af0dull, 0xd953e8624b85dd78ull },
+    { 0x8672648c40e5ad68ull, 0x87d4713d6f33aa6bull },
+    { 0x680efdaf511f18c2ull, 0xa9c98d8ccb009506ull },
+    { 0x0212bd1b2566def2ull, 0xd43bf0effdc0ba48ull },
+    { 0x014bb630f7604b57ull, 0x84a57695fe98746dull },
+    { 0x419ea3bd35385e2dull, 0xa5ced43b7e3e9188ull },
+    { 0x52064cac828675b9ull, 0xcf42894a5dce35eaull },
+    { 0x7343efebd1940993ull, 0x818995ce7aa0e1b2ull },
+    { 0x1014ebe6c5f90bf8ull, 0xa1ebfb4219491a1full },
+    { 0xd41a26e077774ef6ull, 0xca66fa129f9b60a6ull },
+    { 0x8920b098955522b4ull, 0xfd00b897478238d0ull },
+    { 0x55b46e5f5d5535b0ull, 0x9e20735e8cb16382ull },
+    { 0xeb2189f734aa831dull, 0xc5a890362fddbc62ull },
+    { 0xa5e9ec7501d523e4ull, 0xf712b443bbd52b7bull },
+    { 0x47b233c92125366eull, 0x9a6bb0aa55653b2dull },
+    { 0x999ec0bb696e840aull, 0xc1069cd4eabe89f8ull },
+    { 0xc00670ea43ca250dull, 0xf148440a256e2c76ull },
+    { 0x380406926a5e5728ull, 0x96cd2a865764dbcaull },
+    { 0xc605083704f5ecf2ull, 0xbc807527ed3e12bcull },
+    { 0xf7864a44c633682eull, 0xeba09271e88d976bull },
+    { 0x7ab3ee6afbe0211dull, 0x93445b8731587ea3ull },
+    { 0x5960ea05bad82964ull, 0xb8157268fdae9e4cull },
+    { 0x6fb92487298e33bdull, 0xe61acf033d1a45dfull },
+    { 0xa5d3b6d479f8e056ull, 0x8fd0c16206306babull },
+    { 0x8f48a4899877186cull, 0xb3c4f1ba87bc8696ull },
+    { 0x331acdabfe94de87ull, 0xe0b62e2929aba83cull },
+    { 0x9ff0c08b7f1d0b14ull, 0x8c71dcd9ba0b4925ull },
+    { 0x07ecf0ae5ee44dd9ull, 0xaf8e5410288e1b6full },
+    { 0xc9e82cd9f69d6150ull, 0xdb71e91432b1a24aull },
+    { 0xbe311c083a225cd2ull, 0x892731ac9faf056eull },
+    { 0x6dbd630a48aaf406ull, 0xab70fe17c79ac6caull },
+    { 0x092cbbccdad5b108ull, 0xd64d3d9db981787dull },
+    { 0x25bbf56008c58ea5ull, 0x85f0468293f0eb4eull },
+    { 0xaf2af2b80af6f24eull, 0xa76c582338ed2621ull },
+    { 0x1af5af660db4aee1ull, 0xd1476e2c07286faaull },
+    { 0x50d98d9fc890ed4dull, 0x82cca4db847945caull },
+    { 0xe50ff107bab528a0ull, 0xa37fce126597973cull },
+    { 0x1e53ed49a96272c8ull, 0xcc5fc196fefd7d0cull },
+    { 0x25e8e89c13bb0f7aull, 0xff77b1fcbebcdc4full },
+    { 0x77b191618c54e9acull, 0x9faacf3df73609b1ull },
+    { 0xd59df5b9ef6a2417ull, 0xc795830d75038c1dull },
+    { 0x4b0573286b44ad1dull, 0xf97ae3d0d2446f25ull },
+    { 0x4ee367f9430aec32ull, 0x9becce62836ac577ull },
+    { 0x229c41f793cda73full, 0xc2e801fb244576d5ull },
+    { 0x6b43527578c1110full, 0xf3a20279ed56d48aull },
+    { 0x830a13896b78aaa9ull, 0x9845418c345644d6ull },
+    { 0x23cc986bc656d553ull, 0xbe5691ef416bd60cull },
+    { 0x2cbfbe86b7ec8aa8ull, 0xedec366b11c6cb8full },
+    { 0x7bf7d71432f3d6a9ull, 0x94b3a202eb1c3f39ull },
+    { 0xdaf5ccd93fb0cc53ull, 0xb9e08a83a5e34f07ull },
+    { 0xd1b3400f8f9cff68ull, 0xe858ad248f5c22c9ull },
+    { 0x23100809b9c21fa1ull, 0x91376c36d99995beull },
+    { 0xabd40a0c2832a78aull, 0xb58547448ffffb2dull },
+    { 0x16c90c8f323f516cull, 0xe2e69915b3fff9f9ull },
+    { 0xae3da7d97f6792e3ull, 0x8dd01fad907ffc3bull },
+    { 0x99cd11cfdf41779cull, 0xb1442798f49ffb4aull },
+    { 0x40405643d711d583ull, 0xdd95317f31c7fa1dull },
+    { 0x482835ea666b2572ull, 0x8a7d3eef7f1cfc52ull },
+    { 0xda3243650005eecfull, 0xad1c8eab5ee43b66ull },
+    { 0x90bed43e40076a82ull, 0xd863b256369d4a40ull },
+    { 0x5a7744a6e804a291ull, 0x873e4f75e2224e68ull },
+    { 0x711515d0a205cb36ull, 0xa90de3535aaae202ull },
+    { 0x0d5a5b44ca873e03ull, 0xd3515c2831559a83ull },
+    { 0xe858790afe9486c2ull, 0x8412d9991ed58091ull },
+    { 0x626e974dbe39a872ull, 0xa5178fff668ae0b6ull },
+    { 0xfb0a3d212dc8128full, 0xce5d73ff402d98e3ull },
+    { 0x7ce66634bc9d0b99ull, 0x80fa687f881c7f8eull },
+    { 0x1c1fffc1ebc44e80ull, 0xa139029f6a239f72ull },
+    { 0xa327ffb266b56220ull, 0xc987434744ac874eull },
+    { 0x4bf1ff9f0062baa8ull, 0xfbe9141915d7a922ull },
+    { 0x6f773fc3603db4a9ull, 0x9d71ac8fada6c9b5ull },
+    { 0xcb550fb4384d21d3ull, 0xc4ce17b399107c22ull },
+    { 0x7e2a53a146606a48ull, 0xf6019da07f549b2bull },
+    { 0x2eda7444cbfc426dull, 0x99c102844f94e0fbull },
+    { 0xfa911155fefb5308ull, 0xc0314325637a1939ull },
+    { 0x793555ab7eba27caull, 0xf03d93eebc589f88ull },
+    { 0x4bc1558b2f3458deull, 0x96267c7535b763b5ull },
+    { 0x9eb1aaedfb016f16ull, 0xbbb01b9283253ca2ull },
+    { 0x465e15a979c1cadcull, 0xea9c227723ee8bcbull },
+    { 0x0bfacd89ec191ec9ull, 0x92a1958a7675175full },
+    { 0xcef980ec671f667bull, 0xb749faed14125d36ull },
+    { 0x82b7e12780e7401aull, 0xe51c79a85916f484ull },
+    { 0xd1b2ecb8b0908810ull, 0x8f31cc0937ae58d2ull },
+    { 0x861fa7e6dcb4aa15ull, 0xb2fe3f0b8599ef07ull },
+    { 0x67a791e093e1d49aull, 0xdfbdcece67006ac9ull },
+    { 0xe0c8bb2c5c6d24e0ull, 0x8bd6a141006042bdull },
+    { 0x58fae9f773886e18ull, 0xaecc49914078536dull },
+    { 0xaf39a475506a899eull, 0xda7f5bf590966848ull },
+    { 0x6d8406c952429603ull, 0x888f99797a5e012dull },
+    { 0xc8e5087ba6d33b83ull, 0xaab37fd7d8f58178ull },
+    { 0xfb1e4a9a90880a64ull, 0xd5605fcdcf32e1d6ull },
+    { 0x5cf2eea09a55067full, 0x855c3be0a17fcd26ull },
+    { 0xf42faa48c0ea481eull, 0xa6b34ad8c9dfc06full },
+    { 0xf13b94daf124da26ull, 0xd0601d8efc57b08bull },
+    { 0x76c53d08d6b70858ull, 0x823c12795db6ce57ull },
+    { 0x54768c4b0c64ca6eull, 0xa2cb1717b52481edull },
+    { 0xa9942f5dcf7dfd09ull, 0xcb7ddcdda26da268ull },
+    { 0xd3f93b35435d7c4cull, 0xfe5d54150b090b02ull },
+    { 0xc47bc5014a1a6dafull, 0x9efa548d26e5a6e1ull },
+    { 0x359ab6419ca1091bull, 0xc6b8e9b0709f109aull },
+    { 0xc30163d203c94b62ull, 0xf867241c8cc6d4c0ull },
+    { 0x79e0de63425dcf1dull, 0x9b407691d7fc44f8ull },
+    { 0x985915fc12f542e4ull, 0xc21094364dfb5636ull },
+    { 0x3e6f5b7b17b2939dull, 0xf294b943e17a2bc4ull },
+    { 0xa705992ceecf9c42ull, 0x979cf3ca6cec5b5aull },
+    { 0x50c6ff782a838353ull, 0xbd8430bd08277231ull },
+    { 0xa4f8bf5635246428ull, 0xece53cec4a314ebdull },
+    { 0x871b7795e136be99ull, 0x940f4613ae5ed136ull },
+    { 0x28e2557b59846e3full, 0xb913179899f68584ull },
+    { 0x331aeada2fe589cfull, 0xe757dd7ec07426e5ull },
+    { 0x3ff0d2c85def7621ull, 0x9096ea6f3848984full },
+    { 0x0fed077a756b53a9ull, 0xb4bca50b065abe63ull },
+    { 0xd3e8495912c62894ull, 0xe1ebce4dc7f16dfbull },
+    { 0x64712dd7abbbd95cull, 0x8d3360f09cf6e4bdull },
+    { 0xbd8d794d96aacfb3ull, 0xb080392cc4349decull },
+    { 0xecf0d7a0fc5583a0ull, 0xdca04777f541c567ull },
+    { 0xf41686c49db57244ull, 0x89e42caaf9491b60ull },
+    { 0x311c2875c522ced5ull, 0xac5d37d5b79b6239ull },
+    { 0x7d633293366b828bull, 0xd77485cb25823ac7ull },
+    { 0xae5dff9c02033197ull, 0x86a8d39ef77164bcull },
+    { 0xd9f57f830283fdfcull, 0xa8530886b54dbdebull },
+    { 0xd072df63c324fd7bull, 0xd267caa862a12d66ull },
+    { 0x4247cb9e59f71e6dull, 0x8380dea93da4bc60ull },
+    { 0x52d9be85f074e608ull, 0xa46116538d0deb78ull },
+    { 0x67902e276c921f8bull, 0xcd795be870516656ull },
+    { 0x00ba1cd8a3db53b6ull, 0x806bd9714632dff6ull },
+    { 0x80e8a40eccd228a4ull, 0xa086cfcd97bf97f3ull },
+    { 0x6122cd128006b2cdull, 0xc8a883c0fdaf7df0ull },
+    { 0x796b805720085f81ull, 0xfad2a4b13d1b5d6cull },
+    { 0xcbe3303674053bb0ull, 0x9cc3a6eec6311a63ull },
+    { 0xbedbfc4411068a9cull, 0xc3f490aa77bd60fcull },
+    { 0xee92fb5515482d44ull, 0xf4f1b4d515acb93bull },
+    { 0x751bdd152d4d1c4aull, 0x991711052d8bf3c5ull },
+    { 0xd262d45a78a0635dull, 0xbf5cd54678eef0b6ull },
+    { 0x86fb897116c87c34ull, 0xef340a98172aace4ull },
+    { 0xd45d35e6ae3d4da0ull, 0x9580869f0e7aac0eull },
+    { 0x8974836059cca109ull, 0xbae0a846d2195712ull },
+    { 0x2bd1a438703fc94bull, 0xe998d258869facd7ull },
+    { 0x7b6306a34627ddcfull, 0x91ff83775423cc06ull },
+    { 0x1a3bc84c17b1d542ull, 0xb67f6455292cbf08ull },
+    { 0x20caba5f1d9e4a93ull, 0xe41f3d6a7377eecaull },
+    { 0x547eb47b7282ee9cull, 0x8e938662882af53eull },
+    { 0xe99e619a4f23aa43ull, 0xb23867fb2a35b28dull },
+    { 0x6405fa00e2ec94d4ull, 0xdec681f9f4c31f31ull },
+    { 0xde83bc408dd3dd04ull, 0x8b3c113c38f9f37eull },
+    { 0x9624ab50b148d445ull, 0xae0b158b4738705eull },
+    { 0x3badd624dd9b0957ull, 0xd98ddaee19068c76ull },
+    { 0xe54ca5d70a80e5d6ull, 0x87f8a8d4cfa417c9ull },
+    { 0x5e9fcf4ccd211f4cull, 0xa9f6d30a038d1dbcull },
+    { 0x7647c3200069671full, 0xd47487cc8470652bull },
+    { 0x29ecd9f40041e073ull, 0x84c8d4dfd2c63f3bull },
+    { 0xf468107100525890ull, 0xa5fb0a17c777cf09ull },
+    { 0x7182148d4066eeb4ull, 0xcf79cc9db955c2ccull },
+    { 0xc6f14cd848405530ull, 0x81ac1fe293d599bfull },
+    { 0xb8ada00e5a506a7cull, 0xa21727db38cb002full },
+    { 0xa6d90811f0e4851cull, 0xca9cf1d206fdc03bull },
+    { 0x908f4a166d1da663ull, 0xfd442e4688bd304aull },
+    { 0x9a598e4e043287feull, 0x9e4a9cec15763e2eull },
+    { 0x40eff1e1853f29fdull, 0xc5dd44271ad3cdbaull },
+    { 0xd12bee59e68ef47cull, 0xf7549530e188c128ull },
+    { 0x82bb74f8301958ceull, 0x9a94dd3e8cf578b9ull },
+    { 0xe36a52363c1faf01ull, 0xc13a148e3032d6e7ull },
+    { 0xdc44e6c3cb279ac1ull, 0xf18899b1bc3f8ca1ull },
+    { 0x29ab103a5ef8c0b9ull, 0x96f5600f15a7b7e5ull },
+    { 0x7415d448f6b6f0e7ull, 0xbcb2b812db11a5deull },
+    { 0x111b495b3464ad21ull, 0xebdf661791d60f56ull },
+    { 0xcab10dd900beec34ull, 0x936b9fcebb25c995ull },
+    { 0x3d5d514f40eea742ull, 0xb84687c269ef3bfbull },
+    { 0x0cb4a5a3112a5112ull, 0xe65829b3046b0afaull },
+    { 0x47f0e785eaba72abull, 0x8ff71a0fe2c2e6dcull },
+    { 0x59ed216765690f56ull, 0xb3f4e093db73a093ull },
+    { 0x306869c13ec3532cull, 0xe0f218b8d25088b8ull },
+    { 0x1e414218c73a13fbull, 0x8c974f7383725573ull },
+    { 0xe5d1929ef90898faull, 0xafbd2350644eeacfull },
+    { 0xdf45f746b74abf39ull, 0xdbac6c247d62a583ull },
+    { 0x6b8bba8c328eb783ull, 0x894bc396ce5da772ull },
+    { 0x066ea92f3f326564ull, 0xab9eb47c81f5114full },
+    { 0xc80a537b0efefebdull, 0xd686619ba27255a2ull },
+    { 0xbd06742ce95f5f36ull, 0x8613fd0145877585ull },
+    { 0x2c48113823b73704ull, 0xa798fc4196e952e7ull },
+    { 0xf75a15862ca504c5ull, 0xd17f3b51fca3a7a0ull },
+    { 0x9a984d73dbe722fbull, 0x82ef85133de648c4ull },
+    { 0xc13e60d0d2e0ebbaull, 0xa3ab66580d5fdaf5ull },
+    { 0x318df905079926a8ull, 0xcc963fee10b7d1b3ull },
+    { 0xfdf17746497f7052ull, 0xffbbcfe994e5c61full },
+    { 0xfeb6ea8bedefa633ull, 0x9fd561f1fd0f9bd3ull },
+    { 0xfe64a52ee96b8fc0ull, 0xc7caba6e7c5382c8ull },
+    { 0x3dfdce7aa3c673b0ull, 0xf9bd690a1b68637bull },
+    { 0x06bea10ca65c084eull, 0x9c1661a651213e2dull },
+    { 0x486e494fcff30a62ull, 0xc31bfa0fe5698db8ull },
+    { 0x5a89dba3c3efccfaull, 0xf3e2f893dec3f126ull },
+    { 0xf89629465a75e01cull, 0x986ddb5c6b3a76b7ull },
+    { 0xf6bbb397f1135823ull, 0xbe89523386091465ull },
+    { 0x746aa07ded582e2cull, 0xee2ba6c0678b597full },
+    { 0xa8c2a44eb4571cdcull, 0x94db483840b717efull },
+    { 0x92f34d62616ce413ull, 0xba121a4650e4ddebull },
+    { 0x77b020baf9c81d17ull, 0xe896a0d7e51e1566ull },
+    { 0x0ace1474dc1d122eull, 0x915e2486ef32cd60ull },
+    { 0x0d819992132456baull, 0xb5b5ada8aaff80b8ull },
+    { 0x10e1fff697ed6c69ull, 0xe3231912d5bf60e6ull },
+    { 0xca8d3ffa1ef463c1ull, 0x8df5efabc5979c8full },
+    { 0xbd308ff8a6b17cb2ull, 0xb1736b96b6fd83b3ull },
+    { 0xac7cb3f6d05ddbdeull, 0xddd0467c64bce4a0ull },
+    { 0x6bcdf07a423aa96bull, 0x8aa22c0dbef60ee4ull },
+    { 0x86c16c98d2c953c6ull, 0xad4ab7112eb3929dull },
+    { 0xe871c7bf077ba8b7ull, 0xd89d64d57a607744ull },
+    { 0x11471cd764ad4972ull, 0x87625f056c7c4a8bull },
+    { 0xd598e40d3dd89bcfull, 0xa93af6c6c79b5d2dull },
+    { 0x4aff1d108d4ec2c3ull, 0xd389b47879823479ull },
+    { 0xcedf722a585139baull, 0x843610cb4bf160cbull },
+    { 0xc2974eb4ee658828ull, 0xa54394fe1eedb8feull },
+    { 0x733d226229feea32ull, 0xce947a3da6a9273eull },
+    { 0x0806357d5a3f525full, 0x811ccc668829b887ull },
+    { 0xca07c2dcb0cf26f7ull, 0xa163ff802a3426a8ull },
+    { 0xfc89b393dd02f0b5ull, 0xc9bcff6034c13052ull },
+    { 0xbbac2078d443ace2ull, 0xfc2c3f3841f17c67ull },
+    { 0xd54b944b84aa4c0dull, 0x9d9ba7832936edc0ull },
+    { 0x0a9e795e65d4df11ull, 0xc5029163f384a931ull },
+    { 0x4d4617b5ff4a16d5ull, 0xf64335bcf065d37dull },
+    { 0x504bced1bf8e4e45ull, 0x99ea0196163fa42eull },
+    { 0xe45ec2862f71e1d6ull, 0xc06481fb9bcf8d39ull },
+    { 0x5d767327bb4e5a4cull, 0xf07da27a82c37088ull },
+    { 0x3a6a07f8d510f86full, 0x964e858c91ba2655ull },
+    { 0x890489f70a55368bull, 0xbbe226efb628afeaull },
+    { 0x2b45ac74ccea842eull, 0xeadab0aba3b2dbe5ull },
+    { 0x3b0b8bc90012929dull, 0x92c8ae6b464fc96full },
+    { 0x09ce6ebb40173744ull, 0xb77ada0617e3bbcbull },
+    { 0xcc420a6a101d0515ull, 0xe55990879ddcaabdull },
+    { 0x9fa946824a12232dull, 0x8f57fa54c2a9eab6ull },
+    { 0x47939822dc96abf9ull, 0xb32df8e9f3546564ull },
+    { 0x59787e2b93bc56f7ull, 0xdff9772470297ebdull },
+    { 0x57eb4edb3c55b65aull, 0x8bfbea76c619ef36ull },
+    { 0xede622920b6b23f1ull, 0xaefae51477a06b03ull },
+    { 0xe95fab368e45ecedull, 0xdab99e59958885c4ull },
+    { 0x11dbcb0218ebb414ull, 0x88b402f7fd75539bull },
+    { 0xd652bdc29f26a119ull, 0xaae103b5fcd2a881ull },
+    { 0x4be76d3346f0495full, 0xd59944a37c0752a2ull },
+    { 0x6f70a4400c562ddbull, 0x857fcae62d8493a5ull },
+    { 0xcb4ccd500f6bb952ull, 0xa6dfbd9fb8e5b88eull },
+    { 0x7e2000a41346a7a7ull, 0xd097ad07a71f26b2ull },
+    { 0x8ed400668c0c28c8ull, 0x825ecc24c873782full },
+    { 0x728900802f0f32faull, 0xa2f67f2dfa90563bull },
+    { 0x4f2b40a03ad2ffb9ull, 0xcbb41ef979346bcaull },
+    { 0xe2f610c84987bfa8ull, 0xfea126b7d78186bcull },
+    { 0x0dd9ca7d2df4d7c9ull, 0x9f24b832e6b0f436ull },
+    { 0x91503d1c79720dbbull, 0xc6ede63fa05d3143ull },
+    { 0x75a44c6397ce912aull, 0xf8a95fcf88747d94ull },
+    { 0xc986afbe3ee11abaull, 0x9b69dbe1b548ce7cull },
+    { 0xfbe85badce996168ull, 0xc24452da229b021bull },
+    { 0xfae27299423fb9c3ull, 0xf2d56790ab41c2a2ull },
+    { 0xdccd879fc967d41aull, 0x97c560ba6b0919a5ull },
+    { 0x5400e987bbc1c920ull, 0xbdb6b8e905cb600full },
+    { 0x290123e9aab23b68ull, 0xed246723473e3813ull },
+    { 0xf9a0b6720aaf6521ull, 0x9436c0760c86e30bull },
+    { 0xf808e40e8d5b3e69ull, 0xb94470938fa89bceull },
+    { 0xb60b1d1230b20e04ull, 0xe7958cb87392c2c2ull },
+    { 0xb1c6f22b5e6f48c2ull, 0x90bd77f3483bb9b9ull },
+    { 0x1e38aeb6360b1af3ull, 0xb4ecd5f01a4aa828ull },
+    { 0x25c6da63c38de1b0ull, 0xe2280b6c20dd5232ull },
+    { 0x579c487e5a38ad0eull, 0x8d590723948a535full },
+    { 0x2d835a9df0c6d851ull, 0xb0af48ec79ace837ull },
+    { 0xf8e431456cf88e65ull, 0xdcdb1b2798182244ull },
+    { 0x1b8e9ecb641b58ffull, 0x8a08f0f8bf0f156bull },
+    { 0xe272467e3d222f3full, 0xac8b2d36eed2dac5ull },
+    { 0x5b0ed81dcc6abb0full, 0xd7adf884aa879177ull },
+    { 0x98e947129fc2b4e9ull, 0x86ccbb52ea94baeaull },
+    { 0x3f2398d747b36224ull, 0xa87fea27a539e9a5ull },
+    { 0x8eec7f0d19a03aadull, 0xd29fe4b18e88640eull },
+    { 0x1953cf68300424acull, 0x83a3eeeef9153e89ull },
+    { 0x5fa8c3423c052dd7ull, 0xa48ceaaab75a8e2bull },
+    { 0x3792f412cb06794dull, 0xcdb02555653131b6ull },
+    { 0xe2bbd88bbee40bd0ull, 0x808e17555f3ebf11ull },
+    { 0x5b6aceaeae9d0ec4ull, 0xa0b19d2ab70e6ed6ull },
+    { 0xf245825a5a445275ull, 0xc8de047564d20a8bull },
+    { 0xeed6e2f0f0d56712ull, 0xfb158592be068d2eull },
+    { 0x55464dd69685606bull, 0x9ced737bb6c4183dull },
+    { 0xaa97e14c3c26b886ull, 0xc428d05aa4751e4cull },
+    { 0xd53dd99f4b3066a8ull, 0xf53304714d9265dfull },
+    { 0xe546a8038efe4029ull, 0x993fe2c6d07b7fabull },
+    { 0xde98520472bdd033ull, 0xbf8fdb78849a5f96ull },
+    { 0x963e66858f6d4440ull, 0xef73d256a5c0f77cull },
+    { 0xdde7001379a44aa8ull, 0x95a8637627989aadull },
+    { 0x5560c018580d5d52ull, 0xbb127c53b17ec159ull },
+    { 0xaab8f01e6e10b4a6ull, 0xe9d71b689dde71afull },
+    { 0xcab3961304ca70e8ull, 0x9226712162ab070dull },
+    { 0x3d607b97c5fd0d22ull, 0xb6b00d69bb55c8d1ull },
+    { 0x8cb89a7db77c506aull, 0xe45c10c42a2b3b05ull },
+    { 0x77f3608e92adb242ull, 0x8eb98a7a9a5b04e3ull },
+    { 0x55f038b237591ed3ull, 0xb267ed1940f1c61cull },
+    { 0x6b6c46dec52f6688ull, 0xdf01e85f912e37a3ull },
+    { 0x2323ac4b3b3da015ull, 0x8b61313bbabce2c6ull },
+    { 0xabec975e0a0d081aull, 0xae397d8aa96c1b77ull },
+    { 0x96e7bd358c904a21ull, 0xd9c7dced53c72255ull },
+    { 0x7e50d64177da2e54ull, 0x881cea14545c7575ull },
+    { 0xdde50bd1d5d0b9e9ull, 0xaa242499697392d2ull },
+    { 0x955e4ec64b44e864ull, 0xd4ad2dbfc3d07787ull },
+    { 0xbd5af13bef0b113eull, 0x84ec3c97da624ab4ull },
+    { 0xecb1ad8aeacdd58eull, 0xa6274bbdd0fadd61ull },
+    { 0x67de18eda5814af2ull, 0xcfb11ead453994baull },
+    { 0x80eacf948770ced7ull, 0x81ceb32c4b43fcf4ull },
+    { 0xa1258379a94d028dull, 0xa2425ff75e14fc31ull },
+    { 0x096ee45813a04330ull, 0xcad2f7f5359a3b3eull },
+    { 0x8bca9d6e188853fcull, 0xfd87b5f28300ca0dull },
+    { 0x775ea264cf55347eull, 0x9e74d1b791e07e48ull },
+    { 0x95364afe032a819eull, 0xc612062576589ddaull },
+    { 0x3a83ddbd83f52205ull, 0xf79687aed3eec551ull },
+    { 0xc4926a9672793543ull, 0x9abe14cd44753b52ull },
+    { 0x75b7053c0f178294ull, 0xc16d9a0095928a27ull },
+    { 0x5324c68b12dd6339ull, 0xf1c90080baf72cb1ull },
+    { 0xd3f6fc16ebca5e04ull, 0x971da05074da7beeull },
+    { 0x88f4bb1ca6bcf585ull, 0xbce5086492111aeaull },
+    { 0x2b31e9e3d06c32e6ull, 0xec1e4a7db69561a5ull },
+    { 0x3aff322e62439fd0ull, 0x9392ee8e921d5d07ull },
+    { 0x09befeb9fad487c3ull, 0xb877aa3236a4b449ull },
+    { 0x4c2ebe687989a9b4ull, 0xe69594bec44de15bull },
+    { 0x0f9d37014bf60a11ull, 0x901d7cf73ab0acd9ull },
+    { 0x538484c19ef38c95ull, 0xb424dc35095cd80full },
+    { 0x2865a5f206b06fbaull, 0xe12e13424bb40e13ull },
+    { 0xf93f87b7442e45d4ull, 0x8cbccc096f5088cbull },
+    { 0xf78f69a51539d749ull, 0xafebff0bcb24aafeull },
+    { 0xb573440e5a884d1cull, 0xdbe6fecebdedd5beull },
+    { 0x31680a88f8953031ull, 0x89705f4136b4a597ull },
+    { 0xfdc20d2b36ba7c3eull, 0xabcc77118461cefcull },
+    { 0x3d32907604691b4dull, 0xd6bf94d5e57a42bcull },
+    { 0xa63f9a49c2c1b110ull, 0x8637bd05af6c69b5ull },
+    { 0x0fcf80dc33721d54ull, 0xa7c5ac471b478423ull },
+    { 0xd3c36113404ea4a9ull, 0xd1b71758e219652bull },
+    { 0x645a1cac083126eaull, 0x83126e978d4fdf3bull },
+    { 0x3d70a3d70a3d70a4ull, 0xa3d70a3d70a3d70aull },
+    { 0xcccccccccccccccdull, 0xccccccccccccccccull },
+    { 0x0000000000000000ull, 0x8000000000000000ull },
+    { 0x0000000000000000ull, 0xa000000000000000ull },
+    { 0x0000000000000000ull, 0xc800000000000000ull },
+    { 0x0000000000000000ull, 0xfa00000000000000ull },
+    { 0x0000000000000000ull, 0x9c40000000000000ull },
+    { 0x0000000000000000ull, 0xc350000000000000ull },
+    { 0x0000000000000000ull, 0xf424000000000000ull },
+    { 0x0000000000000000ull, 0x9896800000000000ull },
+    { 0x0000000000000000ull, 0xbebc200000000000ull },
+    { 0x0000000000000000ull, 0xee6b280000000000ull },
+    { 0x0000000000000000ull, 0x9502f90000000000ull },
+    { 0x0000000000000000ull, 0xba43b74000000000ull },
+    { 0x0000000000000000ull, 0xe8d4a51000000000ull },
+    { 0x0000000000000000ull, 0x9184e72a00000000ull },
+    { 0x0000000000000000ull, 0xb5e620f480000000ull },
+    { 0x0000000000000000ull, 0xe35fa931a0000000ull },
+    { 0x0000000000000000ull, 0x8e1bc9bf04000000ull },
+    { 0x0000000000000000ull, 0xb1a2bc2ec5000000ull },
+    { 0x0000000000000000ull, 0xde0b6b3a76400000ull },
+    { 0x0000000000000000ull, 0x8ac7230489e80000ull },
+    { 0x0000000000000000ull, 0xad78ebc5ac620000ull },
+    { 0x0000000000000000ull, 0xd8d726b7177a8000ull },
+    { 0x0000000000000000ull, 0x878678326eac9000ull },
+    { 0x0000000000000000ull, 0xa968163f0a57b400ull },
+    { 0x0000000000000000ull, 0xd3c21bcecceda100ull },
+    { 0x0000000000000000ull, 0x84595161401484a0ull },
+    { 0x0000000000000000ull, 0xa56fa5b99019a5c8ull },
+    { 0x0000000000000000ull, 0xcecb8f27f4200f3aull },
+    { 0x4000000000000000ull, 0x813f3978f8940984ull },
+    { 0x5000000000000000ull, 0xa18f07d736b90be5ull },
+    { 0xa400000000000000ull, 0xc9f2c9cd04674edeull },
+    { 0x4d00000000000000ull, 0xfc6f7c4045812296ull },
+    { 0xf020000000000000ull, 0x9dc5ada82b70b59dull },
+    { 0x6c28000000000000ull, 0xc5371912364ce305ull },
+    { 0xc732000000000000ull, 0xf684df56c3e01bc6ull },
+    { 0x3c7f400000000000ull, 0x9a130b963a6c115cull },
+    { 0x4b9f100000000000ull, 0xc097ce7bc90715b3ull },
+    { 0x1e86d40000000000ull, 0xf0bdc21abb48db20ull },
+    { 0x1314448000000000ull, 0x96769950b50d88f4ull },
+    { 0x17d955a000000000ull, 0xbc143fa4e250eb31ull },
+    { 0x5dcfab0800000000ull, 0xeb194f8e1ae525fdull },
+    { 0x5aa1cae500000000ull, 0x92efd1b8d0cf37beull },
+    { 0xf14a3d9e40000000ull, 0xb7abc627050305adull },
+    { 0x6d9ccd05d0000000ull, 0xe596b7b0c643c719ull },
+    { 0xe4820023a2000000ull, 0x8f7e32ce7bea5c6full },
+    { 0xdda2802c8a800000ull, 0xb35dbf821ae4f38bull },
+    { 0xd50b2037ad200000ull, 0xe0352f62a19e306eull },
+    { 0x4526f422cc340000ull, 0x8c213d9da502de45ull },
+    { 0x9670b12b7f410000ull, 0xaf298d050e4395d6ull },
+    { 0x3c0cdd765f114000ull, 0xdaf3f04651d47b4cull },
+    { 0xa5880a69fb6ac800ull, 0x88d8762bf324cd0full },
+    { 0x8eea0d047a457a00ull, 0xab0e93b6efee0053ull },
+    { 0x72a4904598d6d880ull, 0xd5d238a4abe98068ull },
+    { 0x47a6da2b7f864750ull, 0x85a36366eb71f041ull },
+    { 0x999090b65f67d924ull, 0xa70c3c40a64e6c51ull },
+    { 0xfff4b4e3f741cf6dull, 0xd0cf4b50cfe20765ull },
+    { 0xbff8f10e7a8921a4ull, 0x82818f1281ed449full },
+    { 0xaff72d52192b6a0dull, 0xa321f2d7226895c7ull },
+    { 0x9bf4f8a69f764490ull, 0xcbea6f8ceb02bb39ull },
+    { 0x02f236d04753d5b4ull, 0xfee50b7025c36a08ull },
+    { 0x01d762422c946590ull, 0x9f4f2726179a2245ull },
+    { 0x424d3ad2b7b97ef5ull, 0xc722f0ef9d80aad6ull },
+    { 0xd2e0898765a7deb2ull, 0xf8ebad2b84e0d58bull },
+    { 0x63cc55f49f88eb2full, 0x9b934c3b330c8577ull },
+    { 0x3cbf6b71c76b25fbull, 0xc2781f49ffcfa6d5ull },
+    { 0x8bef464e3945ef7aull, 0xf316271c7fc3908aull },
+    { 0x97758bf0e3cbb5acull, 0x97edd871cfda3a56ull },
+    { 0x3d52eeed1cbea317ull, 0xbde94e8e43d0c8ecull },
+    { 0x4ca7aaa863ee4bddull, 0xed63a231d4c4fb27ull },
+    { 0x8fe8caa93e74ef6aull, 0x945e455f24fb1cf8ull },
+    { 0xb3e2fd538e122b44ull, 0xb975d6b6ee39e436ull },
+    { 0x60dbbca87196b616ull, 0xe7d34c64a9c85d44ull },
+    { 0xbc8955e946fe31cdull, 0x90e40fbeea1d3a4aull },
+    { 0x6babab6398bdbe41ull, 0xb51d13aea4a488ddull },
+    { 0xc696963c7eed2dd1ull, 0xe264589a4dcdab14ull },
+    { 0xfc1e1de5cf543ca2ull, 0x8d7eb76070a08aecull },
+    { 0x3b25a55f43294bcbull, 0xb0de65388cc8ada8ull },
+    { 0x49ef0eb713f39ebeull, 0xdd15fe86affad912ull },
+    { 0x6e3569326c784337ull, 0x8a2dbf142dfcc7abull },
+    { 0x49c2c37f07965404ull, 0xacb92ed9397bf996ull },
+    { 0xdc33745ec97be906ull, 0xd7e77a8f87daf7fbull },
+    { 0x69a028bb3ded71a3ull, 0x86f0ac99b4e8dafdull },
+    { 0xc40832ea0d68ce0cull, 0xa8acd7c0222311bcull },
+    { 0xf50a3fa490c30190ull, 0xd2d80db02aabd62bull },
+    { 0x792667c6da79e0faull, 0x83c7088e1aab65dbull },
+    { 0x577001b891185938ull, 0xa4b8cab1a1563f52ull },
+    { 0xed4c0226b55e6f86ull, 0xcde6fd5e09abcf26ull },
+    { 0x544f8158315b05b4ull, 0x80b05e5ac60b6178ull },
+    { 0x696361ae3db1c721ull, 0xa0dc75f1778e39d6ull },
+    { 0x03bc3a19cd1e38e9ull, 0xc913936dd571c84cull },
+    { 0x04ab48a04065c723ull, 0xfb5878494ace3a5full },
+    { 0x62eb0d64283f9c76ull, 0x9d174b2dcec0e47bull },
+    { 0x3ba5d0bd324f8394ull, 0xc45d1df942711d9aull },
+    { 0xca8f44ec7ee36479ull, 0xf5746577930d6500ull },
+    { 0x7e998b13cf4e1ecbull, 0x9968bf6abbe85f20ull },
+    { 0x9e3fedd8c321a67eull, 0xbfc2ef456ae276e8ull },
+    { 0xc5cfe94ef3ea101eull, 0xefb3ab16c59b14a2ull },
+    { 0xbba1f1d158724a12ull, 0x95d04aee3b80ece5ull },
+    { 0x2a8a6e45ae8edc97ull, 0xbb445da9ca61281full },
+    { 0xf52d09d71a3293bdull, 0xea1575143cf97226ull },
+    { 0x593c2626705f9c56ull, 0x924d692ca61be758ull },
+    { 0x6f8b2fb00c77836cull, 0xb6e0c377cfa2e12eull },
+    { 0x0b6dfb9c0f956447ull, 0xe498f455c38b997aull },
+    { 0x4724bd4189bd5eacull, 0x8edf98b59a373fecull },
+    { 0x58edec91ec2cb657ull, 0xb2977ee300c50fe7ull },
+    { 0x2f2967b66737e3edull, 0xdf3d5e9bc0f653e1ull },
+    { 0xbd79e0d20082ee74ull, 0x8b865b215899f46cull },
+    { 0xecd8590680a3aa11ull, 0xae67f1e9aec07187ull },
+    { 0xe80e6f4820cc9495ull, 0xda01ee641a708de9ull },
+    { 0x3109058d147fdcddull, 0x884134fe908658b2ull },
+    { 0xbd4b46f0599fd415ull, 0xaa51823e34a7eedeull },
+    { 0x6c9e18ac7007c91aull, 0xd4e5e2cdc1d1ea96ull },
+    { 0x03e2cf6bc604ddb0ull, 0x850fadc09923329eull },
+    { 0x84db8346b786151cull, 0xa6539930bf6bff45ull },
+    { 0xe612641865679a63ull, 0xcfe87f7cef46ff16ull },
+    { 0x4fcb7e8f3f60c07eull, 0x81f14fae158c5f6eull },
+    { 0xe3be5e330f38f09dull, 0xa26da3999aef7749ull },
+    { 0x5cadf5bfd3072cc5ull, 0xcb090c8001ab551cull },
+    { 0x73d9732fc7c8f7f6ull, 0xfdcb4fa002162a63ull },
+    { 0x2867e7fddcdd9afaull, 0x9e9f11c4014dda7eull },
+    { 0xb281e1fd541501b8ull, 0xc646d63501a1511dull },
+    { 0x1f225a7ca91a4226ull, 0xf7d88bc24209a565ull },
+    { 0x3375788de9b06958ull, 0x9ae757596946075full },
+    { 0x0052d6b1641c83aeull, 0xc1a12d2fc3978937ull },
+    { 0xc0678c5dbd23a49aull, 0xf209787bb47d6b84ull },
+    { 0xf840b7ba963646e0ull, 0x9745eb4d50ce6332ull },
+    { 0xb650e5a93bc3d898ull, 0xbd176620a501fbffull },
+    { 0xa3e51f138ab4cebeull, 0xec5d3fa8ce427affull },
+    { 0xc66f336c36b10137ull, 0x93ba47c980e98cdfull },
+    { 0xb80b0047445d4184ull, 0xb8a8d9bbe123f017ull },
+    { 0xa60dc059157491e5ull, 0xe6d3102ad96cec1dull },
+    { 0x87c89837ad68db2full, 0x9043ea1ac7e41392ull },
+    { 0x29babe4598c311fbull, 0xb454e4a179dd1877ull },
+    { 0xf4296dd6fef3d67aull, 0xe16a1dc9d8545e94ull },
+    { 0x1899e4a65f58660cull, 0x8ce2529e2734bb1dull },
+    { 0x5ec05dcff72e7f8full, 0xb01ae745b101e9e4ull },
+    { 0x76707543f4fa1f73ull, 0xdc21a1171d42645dull },
+    { 0x6a06494a791c53a8ull, 0x899504ae72497ebaull },
+    { 0x0487db9d17636892ull, 0xabfa45da0edbde69ull },
+    { 0x45a9d2845d3c42b6ull, 0xd6f8d7509292d603ull },
+    { 0x0b8a2392ba45a9b2ull, 0x865b86925b9bc5c2ull },
+    { 0x8e6cac7768d7141eull, 0xa7f26836f282b732ull },
+    { 0x3207d795430cd926ull, 0xd1ef0244af2364ffull },
+    { 0x7f44e6bd49e807b8ull, 0x8335616aed761f1full },
+    { 0x5f16206c9c6209a6ull, 0xa402b9c5a8d3a6e7ull },
+    { 0x36dba887c37a8c0full, 0xcd036837130890a1ull },
+    { 0xc2494954da2c9789ull, 0x802221226be55a64ull },
+    { 0xf2db9baa10b7bd6cull, 0xa02aa96b06deb0fdull },
+    { 0x6f92829494e5acc7ull, 0xc83553c5c8965d3dull },
+    { 0xcb772339ba1f17f9ull, 0xfa42a8b73abbf48cull },
+    { 0xff2a760414536efbull, 0x9c69a97284b578d7ull },
+    { 0xfef5138519684abaull, 0xc38413cf25e2d70dull },
+    { 0x7eb258665fc25d69ull, 0xf46518c2ef5b8cd1ull },
+    { 0xef2f773ffbd97a61ull, 0x98bf2f79d5993802ull },
+    { 0xaafb550ffacfd8faull, 0xbeeefb584aff8603ull },
+    { 0x95ba2a53f983cf38ull, 0xeeaaba2e5dbf6784ull },
+    { 0xdd945a747bf26183ull, 0x952ab45cfa97a0b2ull },
+    { 0x94f971119aeef9e4ull, 0xba756174393d88dfull },
+    { 0x7a37cd5601aab85dull, 0xe912b9d1478ceb17ull },
+    { 0xac62e055c10ab33aull, 0x91abb422ccb812eeull },
+    { 0x577b986b314d6009ull, 0xb616a12b7fe617aaull },
+    { 0xed5a7e85fda0b80bull, 0xe39c49765fdf9d94ull },
+    { 0x14588f13be847307ull, 0x8e41ade9fbebc27dull },
+    { 0x596eb2d8ae258fc8ull, 0xb1d219647ae6b31cull },
+    { 0x6fca5f8ed9aef3bbull, 0xde469fbd99a05fe3ull },
+    { 0x25de7bb9480d5854ull, 0x8aec23d680043beeull },
+    { 0xaf561aa79a10ae6aull, 0xada72ccc20054ae9ull },
+    { 0x1b2ba1518094da04ull, 0xd910f7ff28069da4ull },
+    { 0x90fb44d2f05d0842ull, 0x87aa9aff79042286ull },
+    { 0x353a1607ac744a53ull, 0xa99541bf57452b28ull },
+    { 0x42889b8997915ce8ull, 0xd3fa922f2d1675f2ull },
+    { 0x69956135febada11ull, 0x847c9b5d7c2e09b7ull },
+    { 0x43fab9837e699095ull, 0xa59bc234db398c25ull },
+    { 0x94f967e45e03f4bbull, 0xcf02b2c21207ef2eull },
+    { 0x1d1be0eebac278f5ull, 0x8161afb94b44f57dull },
+    { 0x6462d92a69731732ull, 0xa1ba1ba79e1632dcull },
+    { 0x7d7b8f7503cfdcfeull, 0xca28a291859bbf93ull },
+    { 0x5cda735244c3d43eull, 0xfcb2cb35e702af78ull },
+    { 0x3a0888136afa64a7ull, 0x9defbf01b061adabull },
+    { 0x088aaa1845b8fdd0ull, 0xc56baec21c7a1916ull },
+    { 0x8aad549e57273d45ull, 0xf6c69a72a3989f5bull },
+    { 0x36ac54e2f678864bull, 0x9a3c2087a63f6399ull },
+    { 0x84576a1bb416a7ddull, 0xc0cb28a98fcf3c7full },
+    { 0x656d44a2a11c51d5ull, 0xf0fdf2d3f3c30b9full },
+    { 0x9f644ae5a4b1b325ull, 0x969eb7c47859e743ull },
+    { 0x873d5d9f0dde1feeull, 0xbc4665b596706114ull },
+    { 0xa90cb506d155a7eaull, 0xeb57ff22fc0c7959ull },
+    { 0x09a7f12442d588f2ull, 0x9316ff75dd87cbd8ull },
+    { 0x0c11ed6d538aeb2full, 0xb7dcbf5354e9beceull },
+    { 0x8f1668c8a86da5faull, 0xe5d3ef282a242e81ull },
+    { 0xf96e017d694487bcull, 0x8fa475791a569d10ull },
+    { 0x37c981dcc395a9acull, 0xb38d92d760ec4455ull },
+    { 0x85bbe253f47b1417ull, 0xe070f78d3927556aull },
+    { 0x93956d7478ccec8eull, 0x8c469ab843b89562ull },
+    { 0x387ac8d1970027b2ull, 0xaf58416654a6babbull },
+    { 0x06997b05fcc0319eull, 0xdb2e51bfe9d0696aull },
+    { 0x441fece3bdf81f03ull, 0x88fcf317f22241e2ull },
+    { 0xd527e81cad7626c3ull, 0xab3c2fddeeaad25aull },
+    { 0x8a71e223d8d3b074ull, 0xd60b3bd56a5586f1ull },
+    { 0xf6872d5667844e49ull, 0x85c7056562757456ull },
+    { 0xb428f8ac016561dbull, 0xa738c6bebb12d16cull },
+    { 0xe13336d701beba52ull, 0xd106f86e69d785c7ull },
+    { 0xecc0024661173473ull, 0x82a45b450226b39cull },
+    { 0x27f002d7f95d0190ull, 0xa34d721642b06084ull },
+    { 0x31ec038df7b441f4ull, 0xcc20ce9bd35c78a5ull },
+    { 0x7e67047175a15271ull, 0xff290242c83396ceull },
+    { 0x0f0062c6e984d386ull, 0x9f79a169bd203e41ull },
+    { 0x52c07b78a3e60868ull, 0xc75809c42c684dd1ull },
+    { 0xa7709a56ccdf8a82ull, 0xf92e0c3537826145ull },
+    { 0x88a66076400bb691ull, 0x9bbcc7a142b17ccbull },
+    { 0x6acff893d00ea435ull, 0xc2abf989935ddbfeull },
+    { 0x0583f6b8c4124d43ull, 0xf356f7ebf83552feull },
+    { 0xc3727a337a8b704aull, 0x98165af37b2153deull },
+    { 0x744f18c0592e4c5cull, 0xbe1bf1b059e9a8d6ull },
+    { 0x1162def06f79df73ull, 0xeda2ee1c7064130cull },
+    { 0x8addcb5645ac2ba8ull, 0x9485d4d1c63e8be7ull },
+    { 0x6d953e2bd7173692ull, 0xb9a74a0637ce2ee1ull },
+    { 0xc8fa8db6ccdd0437ull, 0xe8111c87c5c1ba99ull },
+    { 0x1d9c9892400a22a2ull, 0x910ab1d4db9914a0ull },
+    { 0x2503beb6d00cab4bull, 0xb54d5e4a127f59c8ull },
+    { 0x2e44ae64840fd61dull, 0xe2a0b5dc971f303aull },
+    { 0x5ceaecfed289e5d2ull, 0x8da471a9de737e24ull },
+    { 0x7425a83e872c5f47ull, 0xb10d8e1456105dadull },
+    { 0xd12f124e28f77719ull, 0xdd50f1996b947518ull },
+    { 0x82bd6b70d99aaa6full, 0x8a5296ffe33cc92full },
+    { 0x636cc64d1001550bull, 0xace73cbfdc0bfb7bull },
+    { 0x3c47f7e05401aa4eull, 0xd8210befd30efa5aull },
+    { 0x65acfaec34810a71ull, 0x8714a775e3e95c78ull },
+    { 0x7f1839a741a14d0dull, 0xa8d9d1535ce3b396ull },
+    { 0x1ede48111209a050ull, 0xd31045a8341ca07cull },
+    { 0x934aed0aab460432ull, 0x83ea2b892091e44dull },
+    { 0xf81da84d5617853full, 0xa4e4b66b68b65d60ull },
+    { 0x36251260ab9d668eull, 0xce1de40642e3f4b9ull },
+    { 0xc1d72b7c6b426019ull, 0x80d2ae83e9ce78f3ull },
+    { 0xb24cf65b8612f81full, 0xa1075a24e4421730ull },
+    { 0xdee033f26797b627ull, 0xc94930ae1d529cfcull },
+    { 0x169840ef017da3b1ull, 0xfb9b7cd9a4a7443cull },
+    { 0x8e1f289560ee864eull, 0x9d412e0806e88aa5ull },
+    { 0xf1a6f2bab92a27e2ull, 0xc491798a08a2ad4eull },
+    { 0xae10af696774b1dbull, 0xf5b5d7ec8acb58a2ull },
+    { 0xacca6da1e0a8ef29ull, 0x9991a6f3d6bf1765ull },
+    { 0x17fd090a58d32af3ull, 0xbff610b0cc6edd3full },
+    { 0xddfc4b4cef07f5b0ull, 0xeff394dcff8a948eull },
+    { 0x4abdaf101564f98eull, 0x95f83d0a1fb69cd9ull },
+    { 0x9d6d1ad41abe37f1ull, 0xbb764c4ca7a4440full },
+    { 0x84c86189216dc5edull, 0xea53df5fd18d5513ull },
+    { 0x32fd3cf5b4e49bb4ull, 0x92746b9be2f8552cull },
+    { 0x3fbc8c33221dc2a1ull, 0xb7118682dbb66a77ull },
+    { 0x0fabaf3feaa5334aull, 0xe4d5e82392a40515ull },
+    { 0x29cb4d87f2a7400eull, 0x8f05b1163ba6832dull },
+    { 0x743e20e9ef511012ull, 0xb2c71d5bca9023f8ull },
+    { 0x914da9246b255416ull, 0xdf78e4b2bd342cf6ull },
+    { 0x1ad089b6c2f7548eull, 0x8bab8eefb6409c1aull },
+    { 0xa184ac2473b529b1ull, 0xae9672aba3d0c320ull },
+    { 0xc9e5d72d90a2741eull, 0xda3c0f568cc4f3e8ull },
+    { 0x7e2fa67c7a658892ull, 0x8865899617fb1871ull },
+    { 0xddbb901b98feeab7ull, 0xaa7eebfb9df9de8dull },
+    { 0x552a74227f3ea565ull, 0xd51ea6fa85785631ull },
+    { 0xd53a88958f87275full, 0x8533285c936b35deull },
+    { 0x8a892abaf368f137ull, 0xa67ff273b8460356ull },
+    { 0x2d2b7569b0432d85ull, 0xd01fef10a657842cull },
+    { 0x9c3b29620e29fc73ull, 0x8213f56a67f6b29bull },
+    { 0x8349f3ba91b47b8full, 0xa298f2c501f45f42ull },
+    { 0x241c70a936219a73ull, 0xcb3f2f7642717713ull },
+    { 0xed238cd383aa0110ull, 0xfe0efb53d30dd4d7ull },
+    { 0xf4363804324a40aaull, 0x9ec95d1463e8a506ull },
+    { 0xb143c6053edcd0d5ull, 0xc67bb4597ce2ce48ull },
+    { 0xdd94b7868e94050aull, 0xf81aa16fdc1b81daull },
+    { 0xca7cf2b4191c8326ull, 0x9b10a4e5e9913128ull },
+    { 0xfd1c2f611f63a3f0ull, 0xc1d4ce1f63f57d72ull },
+    { 0xbc633b39673c8cecull, 0xf24a01a73cf2dccfull },
+    { 0xd5be0503e085d813ull, 0x976e41088617ca01ull },
+    { 0x4b2d8644d8a74e18ull, 0xbd49d14aa79dbc82ull },
+    { 0xddf8e7d60ed1219eull, 0xec9c459d51852ba2ull },
+    { 0xcabb90e5c942b503ull, 0x93e1ab8252f33b45ull },
+    { 0x3d6a751f3b936243ull, 0xb8da1662e7b00a17ull },
+    { 0x0cc512670a783ad4ull, 0xe7109bfba19c0c9dull },
+    { 0x27fb2b80668b24c5ull, 0x906a617d450187e2ull },
+    { 0xb1f9f660802dedf6ull, 0xb484f9dc9641e9daull },
+    { 0x5e7873f8a0396973ull, 0xe1a63853bbd26451ull },
+    { 0xdb0b487b6423e1e8ull, 0x8d07e33455637eb2ull },
+    { 0x91ce1a9a3d2cda62ull, 0xb049dc016abc5e5full },
+    { 0x7641a140cc7810fbull, 0xdc5c5301c56b75f7ull },
+    { 0xa9e904c87fcb0a9dull, 0x89b9b3e11b6329baull },
+    { 0x546345fa9fbdcd44ull, 0xac2820d9623bf429ull },
+    { 0xa97c177947ad4095ull, 0xd732290fbacaf133ull },
+    { 0x49ed8eabcccc485dull, 0x867f59a9d4bed6c0ull },
+    { 0x5c68f256bfff5a74ull, 0xa81f301449ee8c70ull },
+    { 0x73832eec6fff3111ull, 0xd226fc195c6a2f8cull },
+    { 0xc831fd53c5ff7eabull, 0x83585d8fd9c25db7ull },
+    { 0xba3e7ca8b77f5e55ull, 0xa42e74f3d032f525ull },
+    { 0x28ce1bd2e55f35ebull, 0xcd3a1230c43fb26full },
+    { 0x7980d163cf5b81b3ull, 0x80444b5e7aa7cf85ull },
+    { 0xd7e105bcc332621full, 0xa0555e361951c366ull },
+    { 0x8dd9472bf3fefaa7ull, 0xc86ab5c39fa63440ull },
+    { 0xb14f98f6f0feb951ull, 0xfa856334878fc150ull },
+    { 0x6ed1bf9a569f33d3ull, 0x9c935e00d4b9d8d2ull },
+    { 0x0a862f80ec4700c8ull, 0xc3b8358109e84f07ull },
+    { 0xcd27bb612758c0faull, 0xf4a642e14c6262c8ull },
+    { 0x8038d51cb897789cull, 0x98e7e9cccfbd7dbdull },
+    { 0xe0470a63e6bd56c3ull, 0xbf21e44003acdd2cull },
+    { 0x1858ccfce06cac74ull, 0xeeea5d5004981478ull },
+    { 0x0f37801e0c43ebc8ull, 0x95527a5202df0ccbull },
+    { 0xd30560258f54e6baull, 0xbaa718e68396cffdull },
+    { 0x47c6b82ef32a2069ull, 0xe950df20247c83fdull },
+    { 0x4cdc331d57fa5441ull, 0x91d28b7416cdd27eull },
+    { 0xe0133fe4adf8e952ull, 0xb6472e511c81471dull },
+    { 0x58180fddd97723a6ull, 0xe3d8f9e563a198e5ull },
+    { 0x570f09eaa7ea7648ull, 0x8e679c2f5e44ff8full },
+};
+
+#endif // DRINGS_TABLES_H
+
+
+#include <float.h>
+#include <math.h>
+#include <stdatomic.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define malloc_usable_size malloc_size
+#endif
+
+// files are mapped where there is mmap and read with stdio everywhere else
+#include <errno.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DS_HAS_MMAP
+#elif defined(_WIN32)
+#include <io.h>
+#endif
+
+// number parsing falls back to strtod pinned to the C locale
+#include <locale.h>
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#include <xlocale.h>
+#endif
+
+// vector paths are picked at compile time, everything else goes word at a time
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DS_SIMD_AVX2
+#define DS_SIMD_SSSE3
+#define DS_SIMD_SSE2
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define DS_SIMD_SSSE3
+#define DS_SIMD_SSE2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DS_SIMD_SSE2
+#endif
+
+static const ds_Allocator* ds_global_allocator = NULL;
+static double ds_growth_factor = DS_DEFAULT_GROWTH_FACTOR;
+
+#ifdef DS_COMPACT_STRING
+// set once a string has used the global allocator, its buffers have to go back to the same one
+static atomic_bool ds_global_allocator_used;
+
+const ds_Allocator* ds_compact_string_allocator(void) {
+    if (!atomic_load_explicit(&ds_global_allocator_used, memory_order_relaxed)) {
+        atomic_store_explicit(&ds_global_allocator_used, true, memory_order_relaxed);
+    }
+    return ds_global_allocator;
+}
+#endif
+
+void ds_set_allocator(const ds_Allocator* allocator) {
+#ifdef DS_COMPACT_STRING
+    if (allocator != ds_global_allocator && atomic_load_explicit(&ds_global_allocator_used, memory_order_relaxed)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Compact strings already use the global allocator, it cant be changed anymore");
+        return;
+    }
+#endif
+    ds_global_allocator = allocator;
+}
+
+const ds_Allocator* ds_get_allocator() {
+    return ds_global_allocator;
+}
+
 void ds_set_error_callback(ds_ErrorCallback callback) {
     if (callback) ds_error_callback = callback;
 }
@@ -280,6 +2280,7 @@ const char* ds_error_string(DS_RESULT result) {
         case DS_INVALID_INPUT:  return "Invalid function input";
         case DS_INVALID_LENGTH: return "Invalid Length";
         case DS_REACHED_UNINTENTIONAL_CONTROL_BLOCK: return "Unintentional control block reached";
+        case DS_OVERFLOW:       return "Value out of range";
         default:                return "Unkown Error";
     }
 }
@@ -294,804 +2295,5229 @@ void ds_default_error_callback(const ds_ErrorInfo *error) {
             );
 }
 
-ds_String* ds_init_string(const char* literal) {
-    if (!literal) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input String in NULL");
-        return NULL;
+static size_t ds_usable_size(const ds_Allocator* allocator, void* ptr, size_t size) {
+    if (allocator) {
+        return allocator->usable_size ? allocator->usable_size(allocator->context, ptr, size) : size;
     }
+#if defined(__GLIBC__) || defined(__APPLE__)
+    size_t usable = malloc_usable_size(ptr);
+    return usable > size ? usable : size;
+#else
+    return size;
+#endif
+}
 
-    ds_String* string = (ds_String*)malloc(sizeof(ds_String));
-    if (!string) {
-        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string failed");
-        return NULL;
+/*  NOTE:
+ *  shared strings point into a refcounted block. the header sits in
+ *  the slack after the terminator of the string that was shared
+ *  first, and the capacity field of every sharer holds the distance
+ *  from its data to the header, so substrings find it as well. the
+ *  sharers only read, every mutator calls ds_string_make_writable
+ *  first, which copies the bytes out or, for the last owner, slides
+ *  them to the front of the block and takes it over. borrowed strings
+ *  (DS_READ_ONLY without DS_OWNS_MEM) go through the same path.
+ */
+typedef struct {
+    atomic_size_t references;
+    char* block; // start of the allocation
+    size_t size; // size of the allocation, handed back to the allocator
+} ds_SharedHeader;
+
+static inline ds_SharedHeader* ds_shared_header(const ds_String* string) {
+    return (ds_SharedHeader*)(string->heap_data + ds_capacity(string));
+}
+
+// the last reference frees the block
+static void ds_shared_release(ds_String* string) {
+    ds_SharedHeader* header = ds_shared_header(string);
+    if (atomic_fetch_sub_explicit(&header->references, 1, memory_order_acq_rel) == 1) {
+        ds_string_free_buffer(string, header->block, header->size);
     }
-    
-    size_t lit_length = strlen(literal);
-    
-    // small enoguh for stack?
-    if (lit_length <= DS_SMALL_STRING_CAPACITY) {
-        memcpy(string->stack_data, literal, lit_length + 1);
-        string->length = lit_length;
-        string->capacity = DS_STACK_CAPACITY;
-        ds_set_is_stack(string);
+}
+
+static void ds_string_release_buffer(ds_String* string) {
+    if (ds_is_shared(string)) {
+        ds_shared_release(string);
     }
-    // on the heap
-    else {
-        string->heap_data = (char*)malloc(lit_length + 1);
-        memcpy(string->heap_data, literal, lit_length + 1);
-        string->length = lit_length;
-        string->capacity = lit_length + 1;
-        ds_set_is_heap(string);
+    else if (ds_owns_memory(string)) {
+        ds_string_free_buffer(string, string->heap_data, ds_capacity(string));
     }
+}
 
-    ds_set_sticky_heap(string);
-
-    return string;
+static inline bool ds_string_needs_detach(const ds_String* string) {
+    return ds_is_shared(string) || ds_is_read_only(string);
 }
 
-void ds_free_string(ds_String* string)  {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return;
+// puts the header behind the terminator of a plain heap string, reallocating only if the slack is too small
+static ds_SharedHeader* ds_string_make_shared(ds_String* string) {
+    if (ds_is_shared(string)) {
+        return ds_shared_header(string);
     }
 
+    size_t length = ds_length(string);
+    size_t capacity = ds_capacity(string);
+    size_t offset = (length + _Alignof(ds_SharedHeader)) & ~(size_t)(_Alignof(ds_SharedHeader) - 1);
+
+    if (offset + sizeof(ds_SharedHeader) > capacity) {
+        const ds_Allocator* allocator = ds_string_allocator(string);
+        size_t new_capacity = offset + sizeof(ds_SharedHeader);
+        char* buffer = (char*)ds_allocator_realloc(allocator, string->heap_data, capacity, new_capacity);
+        if (!buffer) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
+            return NULL;
+        }
+        string->heap_data = buffer;
+        capacity = ds_usable_size(allocator, buffer, new_capacity);
+    }
 
-    if (ds_is_heap(string)) {
-        free(string->heap_data);
-        string->heap_data = NULL;
+    ds_SharedHeader* header = (ds_SharedHeader*)(string->heap_data + offset);
+    atomic_init(&header->references, 1);
+    header->block = string->heap_data;
+    header->size = capacity;
+
+    ds_set_capacity(string, offset);
+    ds_set_shared(string, true);
+
+    return header;
+}
+
+// gives a shared or borrowed string its own buffer with room for at least length chars
+static size_t ds_string_detach(ds_String* string, size_t length) {
+    size_t old_length = ds_length(string);
+    if (length < old_length) length = old_length;
+
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested length %zu is to big", length);
+        return -1;
     }
-    free(string);
-    string = NULL;
+
+    // nobody else can see the block anymore, so it is ours to write
+    if (ds_is_shared(string)) {
+        ds_SharedHeader* header = ds_shared_header(string);
+        if (atomic_load_explicit(&header->references, memory_order_acquire) == 1
+                && length < header->size && header->size <= DS_MAX_CAPACITY) {
+            char* block = header->block;
+            size_t size = header->size;
+            memmove(block, string->heap_data, old_length);
+            block[old_length] = '\0';
+            ds_string_set_heap_buffer(string, block, old_length, size);
+            ds_set_shared(string, false);
+            return 0;
+        }
+    }
+
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    char* buffer = (char*)ds_allocator_alloc(allocator, length + 1);
+    if (!buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer allocation failed");
+        return -1;
+    }
+    size_t capacity = ds_usable_size(allocator, buffer, length + 1);
+    if (capacity > DS_MAX_CAPACITY) capacity = DS_MAX_CAPACITY;
+
+    memcpy(buffer, string->heap_data, old_length);
+    buffer[old_length] = '\0';
+    ds_string_release_buffer(string);
+    ds_string_set_heap_buffer(string, buffer, old_length, capacity);
+    ds_set_shared(string, false);
+
+    return 0;
 }
 
-const char* ds_to_c_str(ds_String* string) {
+// every mutator calls this before it writes to the buffer
+static inline size_t ds_string_make_writable(ds_String* string) {
+    return ds_string_needs_detach(string) ? ds_string_detach(string, ds_length(string)) : 0;
+}
+
+// offset of data inside the chars of string, SIZE_MAX if it points somewhere else.
+// compared as integers, a relational compare of unrelated pointers is undefined
+static inline size_t ds_string_inner_offset(const ds_String* string, const char* data) {
+    uintptr_t begin = (uintptr_t)ds_data((ds_String*)string);
+    uintptr_t position = (uintptr_t)data;
+    return position >= begin && position <= begin + ds_length(string) ? (size_t)(position - begin) : SIZE_MAX;
+}
+
+// a shared substring isnt terminated, so only length chars are copied
+size_t ds_move_dsstring_to_stack(ds_String* string) {
     if (!string) {
         DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return NULL;
-    }
-   
-    if (ds_has_valid_heap_data(string)) {
-        return string->heap_data;
+        return -1;
     }
-    else {
-        return string->stack_data;
+
+    if (ds_is_stack(string)) return 0;
+
+    size_t length = ds_length(string);
+    if (length > DS_SMALL_STRING_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Input string is to big for stack");
+        return -1;
     }
+
+    // stack_data overlaps heap_data, the buffer is let go before it is overwritten
+    char content[DS_SMALL_STRING_CAPACITY + 1];
+    memcpy(content, string->heap_data, length);
+    ds_string_release_buffer(string);
+
+    ds_set_is_stack(string);
+    ds_set_capacity(string, DS_STACK_CAPACITY);
+    memcpy(string->stack_data, content, length);
+    string->stack_data[length] = '\0';
+    ds_set_length(string, length);
+
+    return 0;
 }
 
-void ds_append(ds_String *string, const char *literal) {
-    if (!literal || !string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
-        return;
+/*  NOTE:
+ *  every growth path ends up here. the target capacity is
+ *  computed once, so there is at most one (re)allocation.
+ *  exact skips the growth factor, the slack malloc hands
+ *  out anyway is always taken
+ */
+static size_t ds_string_grow(ds_String* string, size_t length, bool exact) {
+    if (ds_string_needs_detach(string)) {
+        return ds_string_detach(string, length);
     }
 
-    size_t lit_length = strlen(literal);
-    
-    if (string->length + lit_length <= DS_SMALL_STRING_CAPACITY && ds_is_stack(string)) {
-        memcpy(string->stack_data + string->length, literal, lit_length + 1);
-        string->length += lit_length;
+    size_t capacity = ds_capacity(string);
+
+    if (ds_is_stack(string) ? length <= DS_SMALL_STRING_CAPACITY : length < capacity) {
+        return 0;
+    }
+
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested length %zu is to big", length);
+        return -1;
+    }
+
+    size_t new_capacity = length + 1;
+    if (!exact) {
+        size_t base = ds_is_stack(string) ? DS_SMALL_STRING_CAPACITY + 1 : capacity;
+        double grown = (double)base * ds_growth_factor;
+        if (grown > DS_MAX_CAPACITY) grown = DS_MAX_CAPACITY;
+        if ((size_t)grown > new_capacity) new_capacity = (size_t)grown;
     }
-    else if (ds_is_stack(string)) {
-        char* heap_buffer = (char*)malloc(string->length + lit_length + 1);
+
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    char* heap_buffer;
+
+    if (ds_is_heap(string)) {
+        heap_buffer = (char*)ds_allocator_realloc(allocator, string->heap_data, capacity, new_capacity);
         if (!heap_buffer) {
-            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer allocation failed");
-            return;
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
+            return -1;
         }
-        memcpy(heap_buffer, string->stack_data, string->length);
-        memcpy(heap_buffer + string->length, literal, lit_length + 1);
+        new_capacity = ds_usable_size(allocator, heap_buffer, new_capacity);
+        if (new_capacity > DS_MAX_CAPACITY) new_capacity = DS_MAX_CAPACITY;
         string->heap_data = heap_buffer;
-        string->length += lit_length;
-        string->capacity = string->length + 1;
-        ds_set_is_heap(string);
+        ds_set_capacity(string, new_capacity);
     }
     else {
-        while (string->capacity <= string->length + lit_length + 1) {
-            string->capacity *= 2;
-            char* heap_buffer = (char*)realloc(string->heap_data, string->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Failed heap buffer reallocation");
-                return;
-            }
-            string->heap_data = heap_buffer;
+        size_t old_length = ds_length(string);
+        heap_buffer = (char*)ds_allocator_alloc(allocator, new_capacity);
+        if (!heap_buffer) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer allocation failed");
+            return -1;
         }
-        memcpy(string->heap_data + string->length, literal, lit_length + 1);
-        string->length += lit_length;
-     }
+        new_capacity = ds_usable_size(allocator, heap_buffer, new_capacity);
+        if (new_capacity > DS_MAX_CAPACITY) new_capacity = DS_MAX_CAPACITY;
+        memcpy(heap_buffer, string->stack_data, old_length + 1);
+        ds_string_set_heap_buffer(string, heap_buffer, old_length, new_capacity);
+    }
+
+    return 0;
 }
 
-void ds_append_dstring(ds_String *string, ds_String *append) {
-    if (!string || !append) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
+void ds_set_growth_factor(double factor) {
+    if (factor <= 1.0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Growth factor %f has to be bigger than 1", factor);
         return;
     }
-    
-    if (string->length + append->length <= DS_SMALL_STRING_CAPACITY && ds_is_stack(string) && ds_is_stack(append)) {
-        memcpy(string->stack_data + string->length, append->stack_data, append->length + 1);
-        string->length += append->length;
+
+    ds_growth_factor = factor;
+}
+
+double ds_get_growth_factor() {
+    return ds_growth_factor;
+}
+
+// little endian load, so the lowest set bit belongs to the first byte
+static inline uint64_t ds_load_u64_le(const char* data) {
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+static inline uint32_t ds_count_trailing_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    uint32_t count = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        count++;
     }
-    else if (ds_is_stack(string) && ds_is_stack(append)) {
-        size_t new_length = string->length + append->length;
-        char* heap_buffer = (char*)malloc(string->length + new_length + 1);
-        if (!heap_buffer) {
-            DS_SET_ERROR(DS_ALLOC_FAIL, "Failed heap buffer allocation");
-            return;
+    return count;
+#endif
+}
+
+static inline uint32_t ds_bit_length_u64(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return value ? 64 - __builtin_clzll(value) : 0;
+#else
+    uint32_t bits = 0;
+    while (value) {
+        bits++;
+        value >>= 1;
+    }
+    return bits;
+#endif
+}
+
+// index of the first byte that differs, length if there is none
+static size_t ds_mismatch(const char* a, const char* b, size_t length) {
+    size_t i = 0;
+
+#if defined(DS_SIMD_AVX2)
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (mask) return i + ds_count_trailing_zeros(mask);
+    }
+#endif
+
+#if defined(DS_SIMD_SSE2)
+    for (; i + 16 <= length; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        uint32_t mask = 0xffff ^ (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+        if (mask) return i + ds_count_trailing_zeros(mask);
+    }
+#endif
+
+    for (; i + 8 <= length; i += 8) {
+        uint64_t difference = ds_load_u64_le(a + i) ^ ds_load_u64_le(b + i);
+        if (difference) return i + (ds_count_trailing_zeros(difference) >> 3);
+    }
+
+    for (; i < length; i++) {
+        if (a[i] != b[i]) return i;
+    }
+
+    return length;
+}
+
+// memcmp order, a prefix sorts before the longer string
+static int ds_compare_bytes(const char* a, size_t a_length, const char* b, size_t b_length) {
+    size_t length = a_length < b_length ? a_length : b_length;
+    size_t i = ds_mismatch(a, b, length);
+
+    if (i < length) {
+        return (unsigned char)a[i] < (unsigned char)b[i] ? -1 : 1;
+    }
+
+    return (a_length > b_length) - (a_length < b_length);
+}
+
+static inline uint32_t ds_count_ones(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(value);
+#else
+    uint32_t count = 0;
+    for (; value; value &= value - 1) count++;
+    return count;
+#endif
+}
+
+static inline uint32_t ds_highest_bit(uint64_t value) {
+    return ds_bit_length_u64(value) - 1;
+}
+
+static inline uint64_t ds_broadcast_byte(char c) {
+    return 0x0101010101010101ull * (unsigned char)c;
+}
+
+// 0x80 in every zero byte of word. exact, so it can be scanned from either end
+static inline uint64_t ds_zero_byte_mask(uint64_t word) {
+    const uint64_t low_bits = 0x7f7f7f7f7f7f7f7full;
+    return ~(((word & low_bits) + low_bits) | word | low_bits);
+}
+
+#if defined(DS_SIMD_SSE2)
+static inline uint32_t ds_match_mask16(const char* data, __m128i needle) {
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)data), needle));
+}
+#endif
+
+#if defined(DS_SIMD_AVX2)
+static inline uint32_t ds_match_mask32(const char* data, __m256i needle) {
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)data), needle));
+}
+#endif
+
+// one bit per byte of data[0..64) that equals c
+static inline uint64_t ds_match_mask64(const char* data, char c) {
+#if defined(DS_SIMD_AVX2)
+    __m256i needle = _mm256_set1_epi8(c);
+    return ds_match_mask32(data, needle) | (uint64_t)ds_match_mask32(data + 32, needle) << 32;
+#elif defined(DS_SIMD_SSE2)
+    __m128i needle = _mm_set1_epi8(c);
+    return ds_match_mask16(data, needle)
+        | (uint64_t)ds_match_mask16(data + 16, needle) << 16
+        | (uint64_t)ds_match_mask16(data + 32, needle) << 32
+        | (uint64_t)ds_match_mask16(data + 48, needle) << 48;
+#else
+    uint64_t pattern = ds_broadcast_byte(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 8; i++) {
+        uint64_t bytes = ds_zero_byte_mask(ds_load_u64_le(data + i * 8) ^ pattern) >> 7;
+        // gathers the lowest bit of each byte into the top byte
+        mask |= ((bytes * 0x0102040810204080ull) >> 56) << (i * 8);
+    }
+    return mask;
+#endif
+}
+
+// cheaper than ds_match_mask64 when most blocks dont match: one movemask for all 64 bytes
+static inline bool ds_block_has_byte(const char* data, char c) {
+#if defined(DS_SIMD_AVX2)
+    __m256i needle = _mm256_set1_epi8(c);
+    __m256i first = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)data), needle);
+    __m256i second = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + 32)), needle);
+    return _mm256_movemask_epi8(_mm256_or_si256(first, second)) != 0;
+#elif defined(DS_SIMD_SSE2)
+    __m128i needle = _mm_set1_epi8(c);
+    __m128i matches = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)data), needle),
+                     _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), needle)),
+        _mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), needle),
+                     _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), needle)));
+    return _mm_movemask_epi8(matches) != 0;
+#else
+    uint64_t pattern = ds_broadcast_byte(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 8; i++) {
+        mask |= ds_zero_byte_mask(ds_load_u64_le(data + i * 8) ^ pattern);
+    }
+    return mask != 0;
+#endif
+}
+
+/*  NOTE:
+ *  the byte scanners below run 64 bytes per step with unaligned loads.
+ *  once less than a vector is left they reload the last full vector
+ *  overlapping what was already scanned and mask the seen part off,
+ *  short inputs go word at a time.
+ */
+static const char* ds_find_byte(const char* data, size_t length, char c) {
+    size_t i = 0;
+
+    for (; i + 64 <= length; i += 64) {
+        if (ds_block_has_byte(data + i, c)) {
+            return data + i + ds_count_trailing_zeros(ds_match_mask64(data + i, c));
         }
-        memcpy(heap_buffer, string->stack_data, string->length);
-        memcpy(heap_buffer + string->length, append->stack_data, append->length + 1);
-        string->heap_data = heap_buffer;
-        string->capacity = new_length + 1;
-        string->length = new_length;
-        ds_set_is_heap(string);
-    }
-    else if (ds_is_heap(string)) {
-        size_t new_length = string->length + append->length;
-        char* heap_buffer = NULL;
-        while (string->capacity <= new_length + 1) {
-            string->capacity *= 2;
-            heap_buffer = (char*)realloc(string->heap_data, string->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Failed heap buffer reallocation");
-                return;
-            }
+    }
+
+#if defined(DS_SIMD_SSE2)
+    __m128i needle16 = _mm_set1_epi8(c);
+    for (; i + 16 <= length; i += 16) {
+        uint32_t mask = ds_match_mask16(data + i, needle16);
+        if (mask) return data + i + ds_count_trailing_zeros(mask);
+    }
+    if (i < length && length >= 16) {
+        uint32_t mask = ds_match_mask16(data + length - 16, needle16) >> (16 - (length - i));
+        return mask ? data + i + ds_count_trailing_zeros(mask) : NULL;
+    }
+#endif
+
+    uint64_t pattern = ds_broadcast_byte(c);
+    for (; i + 8 <= length; i += 8) {
+        uint64_t mask = ds_zero_byte_mask(ds_load_u64_le(data + i) ^ pattern);
+        if (mask) return data + i + (ds_count_trailing_zeros(mask) >> 3);
+    }
+
+    for (; i < length; i++) {
+        if (data[i] == c) return data + i;
+    }
+
+    return NULL;
+}
+
+static const char* ds_rfind_byte(const char* data, size_t length, char c) {
+    size_t end = length;
+
+    for (; end >= 64; end -= 64) {
+        if (ds_block_has_byte(data + end - 64, c)) {
+            return data + end - 64 + ds_highest_bit(ds_match_mask64(data + end - 64, c));
+        }
+    }
+
+#if defined(DS_SIMD_SSE2)
+    __m128i needle16 = _mm_set1_epi8(c);
+    for (; end >= 16; end -= 16) {
+        uint32_t mask = ds_match_mask16(data + end - 16, needle16);
+        if (mask) return data + end - 16 + ds_highest_bit(mask);
+    }
+    if (end > 0 && length >= 16) {
+        uint32_t mask = ds_match_mask16(data, needle16) & ((1u << end) - 1);
+        return mask ? data + ds_highest_bit(mask) : NULL;
+    }
+#endif
+
+    uint64_t pattern = ds_broadcast_byte(c);
+    for (; end >= 8; end -= 8) {
+        uint64_t mask = ds_zero_byte_mask(ds_load_u64_le(data + end - 8) ^ pattern);
+        if (mask) return data + end - 8 + (ds_highest_bit(mask) >> 3);
+    }
+
+    while (end > 0) {
+        end--;
+        if (data[end] == c) return data + end;
+    }
+
+    return NULL;
+}
+
+static size_t ds_count_byte(const char* data, size_t length, char c) {
+    size_t count = 0;
+    size_t i = 0;
+
+    /*  NOTE:
+     *  matches are summed per byte lane (cmpeq gives -1, so subtract)
+     *  and folded with sad every 255 vectors before a lane overflows
+     */
+#if defined(DS_SIMD_AVX2)
+    __m256i needle32 = _mm256_set1_epi8(c);
+    while (i + 32 <= length) {
+        size_t blocks = (length - i) / 32;
+        if (blocks > 255) blocks = 255;
+
+        __m256i lanes = _mm256_setzero_si256();
+        for (size_t block = 0; block < blocks; block++, i += 32) {
+            __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+            lanes = _mm256_sub_epi8(lanes, _mm256_cmpeq_epi8(chunk, needle32));
+        }
+
+        __m256i sums = _mm256_sad_epu8(lanes, _mm256_setzero_si256());
+        count += (size_t)_mm256_extract_epi64(sums, 0) + (size_t)_mm256_extract_epi64(sums, 1)
+            + (size_t)_mm256_extract_epi64(sums, 2) + (size_t)_mm256_extract_epi64(sums, 3);
+    }
+#endif
+
+#if defined(DS_SIMD_SSE2)
+    __m128i needle16 = _mm_set1_epi8(c);
+    while (i + 16 <= length) {
+        size_t blocks = (length - i) / 16;
+        if (blocks > 255) blocks = 255;
+
+        __m128i lanes = _mm_setzero_si128();
+        for (size_t block = 0; block < blocks; block++, i += 16) {
+            __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+            lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(chunk, needle16));
+        }
+
+        __m128i sums = _mm_sad_epu8(lanes, _mm_setzero_si128());
+        count += (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+    if (i < length && length >= 16) {
+        return count + ds_count_ones(ds_match_mask16(data + length - 16, needle16) >> (16 - (length - i)));
+    }
+#endif
+
+    uint64_t pattern = ds_broadcast_byte(c);
+    for (; i + 8 <= length; i += 8) {
+        count += ds_count_ones(ds_zero_byte_mask(ds_load_u64_le(data + i) ^ pattern));
+    }
+
+    for (; i < length; i++) {
+        count += data[i] == c;
+    }
+
+    return count;
+}
+
+// n counts from 0, whole 64 byte blocks are skipped by their popcount
+static const char* ds_find_nth_byte(const char* data, size_t length, char c, size_t n) {
+    size_t i = 0;
+
+    for (; i + 64 <= length; i += 64) {
+        uint64_t mask = ds_match_mask64(data + i, c);
+        size_t matches = ds_count_ones(mask);
+        if (n >= matches) {
+            n -= matches;
+            continue;
+        }
+
+        for (; n > 0; n--) mask &= mask - 1;
+        return data + i + ds_count_trailing_zeros(mask);
+    }
+
+    for (; i < length; i++) {
+        if (data[i] == c && n-- == 0) return data + i;
+    }
+
+    return NULL;
+}
+
+/*  NOTE:
+ *  nibble lookup: every distinct high nibble in the set gets one of 8
+ *  bits. low_nibbles[lo] holds the bits of the high nibbles that appear
+ *  with lo, high_nibbles[hi] the bit of hi. a byte is in the set when
+ *  both lookups share a bit, that is two pshufb and an and per vector.
+ */
+#if defined(DS_SIMD_SSSE3)
+static inline uint32_t ds_byte_set_mask16(const char* data, __m128i low_table, __m128i high_table) {
+    __m128i chunk = _mm_loadu_si128((const __m128i*)data);
+    __m128i nibble = _mm_set1_epi8(0x0f);
+    __m128i low = _mm_shuffle_epi8(low_table, _mm_and_si128(chunk, nibble));
+    __m128i high = _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble));
+    __m128i miss = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+    return 0xffff ^ (uint32_t)_mm_movemask_epi8(miss);
+}
+#endif
+
+static inline bool ds_byte_set_has(const ds_ByteSet* set, char c) {
+    unsigned char byte = (unsigned char)c;
+    return (set->bits[byte >> 6] >> (byte & 63)) & 1;
+}
+
+// first byte that is (member) or is not (!member) in the set
+static const char* ds_find_in_byte_set(const char* data, size_t length, const ds_ByteSet* set, bool member) {
+    size_t i = 0;
+
+#if defined(DS_SIMD_SSSE3)
+    if (set->nibble_lookup && length >= 16) {
+        __m128i low_table = _mm_loadu_si128((const __m128i*)set->low_nibbles);
+        __m128i high_table = _mm_loadu_si128((const __m128i*)set->high_nibbles);
+        uint32_t flip = member ? 0 : 0xffff;
+
+        for (; i + 16 <= length; i += 16) {
+            uint32_t mask = ds_byte_set_mask16(data + i, low_table, high_table) ^ flip;
+            if (mask) return data + i + ds_count_trailing_zeros(mask);
+        }
+        if (i < length) {
+            uint32_t mask = (ds_byte_set_mask16(data + length - 16, low_table, high_table) ^ flip) >> (16 - (length - i));
+            if (mask) return data + i + ds_count_trailing_zeros(mask);
+        }
+        return NULL;
+    }
+#endif
+
+    for (; i < length; i++) {
+        if (ds_byte_set_has(set, data[i]) == member) return data + i;
+    }
+
+    return NULL;
+}
+
+static const char* ds_rfind_in_byte_set(const char* data, size_t length, const ds_ByteSet* set, bool member) {
+    size_t end = length;
+
+#if defined(DS_SIMD_SSSE3)
+    if (set->nibble_lookup && length >= 16) {
+        __m128i low_table = _mm_loadu_si128((const __m128i*)set->low_nibbles);
+        __m128i high_table = _mm_loadu_si128((const __m128i*)set->high_nibbles);
+        uint32_t flip = member ? 0 : 0xffff;
+
+        for (; end >= 16; end -= 16) {
+            uint32_t mask = ds_byte_set_mask16(data + end - 16, low_table, high_table) ^ flip;
+            if (mask) return data + end - 16 + ds_highest_bit(mask);
+        }
+        if (end > 0) {
+            uint32_t mask = (ds_byte_set_mask16(data, low_table, high_table) ^ flip) & ((1u << end) - 1);
+            if (mask) return data + ds_highest_bit(mask);
+        }
+        return NULL;
+    }
+#endif
+
+    while (end > 0) {
+        end--;
+        if (ds_byte_set_has(set, data[end]) == member) return data + end;
+    }
+
+    return NULL;
+}
+
+/*  NOTE:
+ *  short needles: scan for positions where the first and the last
+ *  byte of the needle both match, a whole vector at a time, and only
+ *  compare the middle there. long needles: Two-Way (Crochemore-Perrin)
+ *  with a last byte shift table, linear in the worst case.
+ */
+static const char* ds_search_short(const ds_Searcher* searcher, const char* haystack, size_t length) {
+    const char* needle = searcher->needle.data;
+    size_t needle_length = searcher->needle.length;
+    size_t last = needle_length - 1;
+    size_t i = 0;
+
+#if defined(DS_SIMD_AVX2)
+    __m256i first32 = _mm256_set1_epi8(needle[0]);
+    __m256i last32 = _mm256_set1_epi8(needle[last]);
+    for (; i + last + 32 <= length; i += 32) {
+        uint32_t mask = ds_match_mask32(haystack + i, first32) & ds_match_mask32(haystack + i + last, last32);
+        for (; mask; mask &= mask - 1) {
+            size_t position = i + ds_count_trailing_zeros(mask);
+            if (memcmp(haystack + position + 1, needle + 1, needle_length - 2) == 0) return haystack + position;
+        }
+    }
+#endif
+
+#if defined(DS_SIMD_SSE2)
+    __m128i first16 = _mm_set1_epi8(needle[0]);
+    __m128i last16 = _mm_set1_epi8(needle[last]);
+    for (; i + last + 16 <= length; i += 16) {
+        uint32_t mask = ds_match_mask16(haystack + i, first16) & ds_match_mask16(haystack + i + last, last16);
+        for (; mask; mask &= mask - 1) {
+            size_t position = i + ds_count_trailing_zeros(mask);
+            if (memcmp(haystack + position + 1, needle + 1, needle_length - 2) == 0) return haystack + position;
+        }
+    }
+#endif
+
+    uint64_t first_pattern = ds_broadcast_byte(needle[0]);
+    uint64_t last_pattern = ds_broadcast_byte(needle[last]);
+    for (; i + last + 8 <= length; i += 8) {
+        uint64_t mask = ds_zero_byte_mask(ds_load_u64_le(haystack + i) ^ first_pattern)
+            & ds_zero_byte_mask(ds_load_u64_le(haystack + i + last) ^ last_pattern);
+        for (; mask; mask &= mask - 1) {
+            size_t position = i + (ds_count_trailing_zeros(mask) >> 3);
+            if (memcmp(haystack + position + 1, needle + 1, needle_length - 2) == 0) return haystack + position;
+        }
+    }
+
+    for (; i + last < length; i++) {
+        if (haystack[i] == needle[0] && haystack[i + last] == needle[last]
+            && memcmp(haystack + i + 1, needle + 1, needle_length - 2) == 0) {
+            return haystack + i;
+        }
+    }
+
+    return NULL;
+}
+
+static const char* ds_search_two_way(const ds_Searcher* searcher, const char* haystack, size_t length) {
+    const unsigned char* needle = (const unsigned char*)searcher->needle.data;
+    const unsigned char* h = (const unsigned char*)haystack;
+    const unsigned char* end = h + length;
+    size_t needle_length = searcher->needle.length;
+    size_t critical = searcher->critical;
+    size_t memory = 0;
+
+    while ((size_t)(end - h) >= needle_length) {
+        // the last byte decides how far we can jump
+        size_t shift = searcher->shift[h[needle_length - 1]];
+        if (shift != needle_length) {
+            size_t k = needle_length - shift;
+            h += k < memory ? memory : k;
+            memory = 0;
+            continue;
         }
 
-        if (heap_buffer) {
-            memcpy(heap_buffer, string->heap_data, string->length);
-            string->heap_data = heap_buffer; 
+        // right half first, then the left half
+        size_t k = critical + 1 > memory ? critical + 1 : memory;
+        while (k < needle_length && needle[k] == h[k]) k++;
+        if (k < needle_length) {
+            h += k - critical;
+            memory = 0;
+            continue;
         }
 
-        if (ds_is_stack(append)) {
-            memcpy(string->heap_data + string->length, append->stack_data, append->length + 1);
+        for (k = critical + 1; k > memory && needle[k - 1] == h[k - 1]; k--);
+        if (k <= memory) return (const char*)h;
+
+        h += searcher->period;
+        memory = searcher->memory;
+    }
+
+    return NULL;
+}
+
+// maximal suffix of needle under < or > with its period, the start is returned one too low
+static size_t ds_maximal_suffix(const unsigned char* needle, size_t length, bool reverse, size_t* period) {
+    size_t suffix = (size_t)-1;
+    size_t j = 0;
+    size_t k = 1;
+    size_t p = 1;
+
+    while (j + k < length) {
+        unsigned char a = needle[suffix + k];
+        unsigned char b = needle[j + k];
+        if (a == b) {
+            if (k == p) {
+                j += p;
+                k = 1;
+            }
+            else {
+                k++;
+            }
+        }
+        else if (reverse ? a < b : a > b) {
+            j += k;
+            k = 1;
+            p = j - suffix;
         }
         else {
-            memcpy(string->heap_data + string->length, append->heap_data, append->length + 1);
+            suffix = j++;
+            k = p = 1;
         }
-        string->length = new_length;
     }
-}
 
+    *period = p;
+    return suffix;
+}
+
+static const char* ds_searcher_search(const ds_Searcher* searcher, const char* haystack, size_t length) {
+    size_t needle_length = searcher->needle.length;
+
+    if (needle_length == 0) return haystack;
+    if (needle_length > length) return NULL;
+    if (needle_length == 1) return ds_find_byte(haystack, length, searcher->needle.data[0]);
+    if (needle_length <= DS_SEARCHER_SHORT_NEEDLE) return ds_search_short(searcher, haystack, length);
+
+    return ds_search_two_way(searcher, haystack, length);
+}
+
+static ds_String* ds_init_string_allocator_n(const ds_Allocator* allocator, const char* data, size_t length);
+static size_t ds_string_init_inplace_allocator_n(ds_String* string, const ds_Allocator* allocator, const char* data, size_t length);
+
+ds_String* ds_init_string(const char* literal) {
+    if (!literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input String in NULL");
+        return NULL;
+    }
+
+    return ds_init_string_allocator_n(ds_global_allocator, literal, strlen(literal));
+}
+
+ds_String* ds_init_string_n(const char* data, size_t length) {
+    return ds_init_string_allocator_n(ds_global_allocator, data, length);
+}
+
+ds_String* ds_init_string_allocator(const ds_Allocator* allocator, const char* literal) {
+    if (!literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input String in NULL");
+        return NULL;
+    }
+
+    return ds_init_string_allocator_n(allocator, literal, strlen(literal));
+}
+
+static ds_String* ds_init_string_allocator_n(const ds_Allocator* allocator, const char* data, size_t length) {
+    if (!data && length) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input String in NULL");
+        return NULL;
+    }
+
+    ds_String* string = (ds_String*)ds_allocator_alloc(allocator, sizeof(ds_String));
+    if (!string) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string failed");
+        return NULL;
+    }
+
+    if (ds_string_init_inplace_allocator_n(string, allocator, data, length) != 0) {
+        ds_allocator_free(allocator, string, sizeof(ds_String));
+        return NULL;
+    }
+
+    return string;
+}
+
+void ds_free_string(ds_String* string)  {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return;
+    }
+
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    ds_string_deinit(string);
+    ds_allocator_free(allocator, string, sizeof(ds_String));
+    string = NULL;
+}
+
+size_t ds_string_init_inplace(ds_String* string, const char* literal) {
+    if (!string || !literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    return ds_string_init_inplace_allocator_n(string, ds_global_allocator, literal, strlen(literal));
+}
+
+size_t ds_string_init_inplace_n(ds_String* string, const char* data, size_t length) {
+    return ds_string_init_inplace_allocator_n(string, ds_global_allocator, data, length);
+}
+
+size_t ds_string_init_inplace_allocator(ds_String* string, const ds_Allocator* allocator, const char* literal) {
+    if (!string || !literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    return ds_string_init_inplace_allocator_n(string, allocator, literal, strlen(literal));
+}
+
+static size_t ds_string_init_inplace_allocator_n(ds_String* string, const ds_Allocator* allocator, const char* data, size_t length) {
+    if (!string || (!data && length)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+#ifdef DS_COMPACT_STRING
+    if (allocator != ds_compact_string_allocator()) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Compact strings only support the global allocator");
+        return -1;
+    }
+#endif
+
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested length %zu is to big", length);
+        return -1;
+    }
+
+    ds_string_reset(string);
+    ds_string_set_allocator(string, allocator);
+    
+    // small enoguh for stack?
+    if (length <= DS_SMALL_STRING_CAPACITY) {
+        memcpy(string->stack_data, data, length);
+        string->stack_data[length] = '\0';
+        ds_set_length(string, length);
+    }
+    // on the heap
+    else {
+        char* heap_buffer = (char*)ds_allocator_alloc(allocator, length + 1);
+        if (!heap_buffer) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer allocation failed");
+            return -1;
+        }
+        memcpy(heap_buffer, data, length);
+        heap_buffer[length] = '\0';
+        ds_string_set_heap_buffer(string, heap_buffer, length, length + 1);
+    }
+
+    ds_set_sticky_heap(string);
+
+    return 0;
+}
+
+void ds_string_deinit(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return;
+    }
+
+    if (ds_is_heap(string)) {
+        ds_string_release_buffer(string);
+    }
+
+    // leave an empty stack string behind so it can be reused
+    ds_string_reset(string);
+}
+
+static size_t ds_string_wrap_readable(ds_String* string, const char* data, size_t length, size_t readable) {
+    if (!string || (!data && length)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or data is NULL");
+        return -1;
+    }
+
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested length %zu is to big", length);
+        return -1;
+    }
+
+    ds_string_reset(string);
+    ds_string_set_allocator(string, ds_global_allocator);
+
+    if (data) {
+        ds_string_set_borrowed_buffer(string, data, length, readable);
+    }
+
+    return 0;
+}
+
+static ds_String* ds_init_string_wrap(const char* data, size_t length, size_t readable) {
+    ds_String* string = (ds_String*)ds_allocator_alloc(ds_global_allocator, sizeof(ds_String));
+    if (!string) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string failed");
+        return NULL;
+    }
+
+    if (ds_string_wrap_readable(string, data, length, readable) != 0) {
+        ds_allocator_free(ds_global_allocator, string, sizeof(ds_String));
+        return NULL;
+    }
+
+    return string;
+}
+
+ds_String* ds_string_wrap(const char* data, size_t length) {
+    return ds_init_string_wrap(data, length, length);
+}
+
+ds_String* ds_string_wrap_cstr(const char* literal) {
+    if (!literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input literal is NULL");
+        return NULL;
+    }
+
+    size_t length = strlen(literal);
+    return ds_init_string_wrap(literal, length, length + 1);
+}
+
+size_t ds_string_wrap_inplace(ds_String* string, const char* data, size_t length) {
+    return ds_string_wrap_readable(string, data, length, length);
+}
+
+size_t ds_string_adopt_inplace(ds_String* string, char* data, size_t length, size_t capacity) {
+    if (!string || !data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or data is NULL");
+        return -1;
+    }
+
+    if (capacity <= length || capacity > DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Capacity %zu cant hold %zu chars and the terminator", capacity, length);
+        return -1;
+    }
+
+    ds_string_reset(string);
+    ds_string_set_allocator(string, ds_global_allocator);
+
+    data[length] = '\0';
+    ds_string_set_heap_buffer(string, data, length, capacity);
+
+    return 0;
+}
+
+ds_String* ds_string_adopt(char* data, size_t length, size_t capacity) {
+    ds_String* string = (ds_String*)ds_allocator_alloc(ds_global_allocator, sizeof(ds_String));
+    if (!string) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string failed");
+        return NULL;
+    }
+
+    if (ds_string_adopt_inplace(string, data, length, capacity) != 0) {
+        ds_allocator_free(ds_global_allocator, string, sizeof(ds_String));
+        return NULL;
+    }
+
+    return string;
+}
+
+/*  NOTE:
+ *  an owned heap buffer is handed out as is. stack strings and
+ *  borrowed memory are copied, shared buffers are detached first
+ *  (which is free for the last owner). either way the buffer comes
+ *  from the allocator of the string and belongs to the caller.
+ */
+char* ds_string_release(ds_String* string, size_t* length, size_t* capacity) {
+    if (!string || !length) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or length is NULL");
+        return NULL;
+    }
+
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    size_t string_length = ds_length(string);
+    size_t buffer_capacity;
+    char* buffer;
+
+    if (ds_is_heap(string)) {
+        if (ds_string_make_writable(string) != 0) {
+            return NULL;
+        }
+        buffer = string->heap_data;
+        buffer_capacity = ds_capacity(string);
+    }
+    else {
+        buffer_capacity = string_length + 1;
+        buffer = (char*)ds_allocator_alloc(allocator, buffer_capacity);
+        if (!buffer) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", buffer_capacity);
+            return NULL;
+        }
+        memcpy(buffer, string->stack_data, string_length + 1);
+    }
+
+    ds_string_reset(string);
+    ds_string_set_allocator(string, allocator);
+
+    *length = string_length;
+    if (capacity) *capacity = buffer_capacity;
+
+    return buffer;
+}
+
+const char* ds_to_c_str(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return NULL;
+    }
+   
+    // a shared substring can end in the middle of its block, borrowed memory might not be terminated at all
+    size_t length = ds_length(string);
+    if (ds_string_needs_detach(string) && (length >= ds_capacity(string) || string->heap_data[length] != '\0')) {
+        if (ds_string_make_writable(string) != 0) {
+            return NULL;
+        }
+    }
+
+    if (ds_has_valid_heap_data(string)) {
+        return string->heap_data;
+    }
+    else {
+        return string->stack_data;
+    }
+}
+
+void ds_append(ds_String *string, const char *literal) {
+    if (!literal || !string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
+        return;
+    }
+
+    ds_append_n(string, literal, strlen(literal));
+}
+
+void ds_append_n(ds_String* string, const char* data, size_t n) {
+    if (!string || (!data && n)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
+        return;
+    }
+
+    size_t length = ds_length(string);
+
+    // data may be a piece of string itself, growing can move or free it
+    size_t offset = ds_string_inner_offset(string, data);
+    if (offset != SIZE_MAX && offset + n > length) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Data runs past the end of the string");
+        return;
+    }
+
+    if (ds_string_grow(string, length + n, false) != 0) {
+        return;
+    }
+
+    char* string_data = ds_data(string);
+    if (offset != SIZE_MAX) data = string_data + offset;
+    memcpy(string_data + length, data, n);
+    string_data[length + n] = '\0';
+    ds_set_length(string, length + n);
+}
+
+void ds_append_view(ds_String* string, const ds_StringView* view) {
+    if (!string || !view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or view is NULL");
+        return;
+    }
+
+    ds_append_n(string, view->data, view->length);
+}
+
+size_t ds_appendf(ds_String* string, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    size_t result = ds_vappendf(string, format, args);
+    va_end(args);
+
+    return result;
+}
+
+/*  NOTE:
+ *  formats straight into the spare capacity. if it doesnt fit
+ *  vsnprintf told us the exact length, so one grow and one
+ *  more pass are always enough
+ */
+size_t ds_vappendf(ds_String* string, const char* format, va_list args) {
+    if (!string || !format) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or format is NULL");
+        return -1;
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+
+    size_t length = ds_length(string);
+    size_t spare = (ds_is_heap(string) ? ds_capacity(string) : DS_SMALL_STRING_CAPACITY + 1) - length;
+
+    va_list retry;
+    va_copy(retry, args);
+    int written = vsnprintf(ds_data(string) + length, spare, format, args);
+
+    if (written < 0) {
+        va_end(retry);
+        ds_data(string)[length] = '\0';
+        DS_SET_ERROR(DS_INVALID_INPUT, "Invalid format string");
+        return -1;
+    }
+
+    if ((size_t)written >= spare) {
+        // a truncated pass can clobber the compact length byte
+        ds_data(string)[length] = '\0';
+        ds_set_length(string, length);
+
+        if (ds_string_grow(string, length + written, false) != 0) {
+            va_end(retry);
+            return -1;
+        }
+        vsnprintf(ds_data(string) + length, (size_t)written + 1, format, retry);
+    }
+    va_end(retry);
+
+    ds_set_length(string, length + written);
+
+    return 0;
+}
+
+static const char ds_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// index 0 is 0 so that ds_count_digits_u64(0) == 1
+static const uint64_t ds_digit_thresholds[20] = {
+    0ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull,
+};
+
+// log10 estimate from the bit length, corrected with one compare
+static inline uint32_t ds_count_digits_u64(uint64_t value) {
+    uint32_t t = (ds_bit_length_u64(value | 1) * 1233) >> 12;
+    return t - (value < ds_digit_thresholds[t]) + 1;
+}
+
+// writes exactly ds_count_digits_u64(value) chars, no terminator
+static size_t ds_write_u64(char* out, uint64_t value) {
+    size_t digits = ds_count_digits_u64(value);
+    char* write = out + digits;
+
+    while (value >= 100) {
+        uint32_t pair = (uint32_t)(value % 100) * 2;
+        value /= 100;
+        write -= 2;
+        write[0] = ds_digit_pairs[pair];
+        write[1] = ds_digit_pairs[pair + 1];
+    }
+
+    if (value >= 10) {
+        uint32_t pair = (uint32_t)value * 2;
+        write -= 2;
+        write[0] = ds_digit_pairs[pair];
+        write[1] = ds_digit_pairs[pair + 1];
+    }
+    else {
+        *--write = (char)('0' + value);
+    }
+
+    return digits;
+}
+
+// makes room for max_length more chars and returns where they go
+static char* ds_append_begin(ds_String* string, size_t max_length) {
+    size_t length = ds_length(string);
+    if (ds_string_grow(string, length + max_length, false) != 0) {
+        return NULL;
+    }
+
+    return ds_data(string) + length;
+}
+
+static void ds_append_end(ds_String* string, size_t written) {
+    size_t length = ds_length(string) + written;
+    ds_data(string)[length] = '\0';
+    ds_set_length(string, length);
+}
+
+size_t ds_append_u64(ds_String* string, uint64_t value) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    char* write = ds_append_begin(string, 20);
+    if (!write) {
+        return -1;
+    }
+
+    ds_append_end(string, ds_write_u64(write, value));
+
+    return 0;
+}
+
+size_t ds_append_i64(ds_String* string, int64_t value) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    char* write = ds_append_begin(string, 20);
+    if (!write) {
+        return -1;
+    }
+
+    size_t written = 0;
+    uint64_t magnitude = (uint64_t)value;
+    if (value < 0) {
+        write[written++] = '-';
+        magnitude = 0 - magnitude;
+    }
+
+    written += ds_write_u64(write + written, magnitude);
+    ds_append_end(string, written);
+
+    return 0;
+}
+
+/*  NOTE:
+ *  shortest round trip double to decimal conversion, this is
+ *  Ulf Adams' Ryu (d2s) on top of the tables in drings_tables.h.
+ *  it finds the shortest digit string inside the rounding interval
+ *  of the double and prefers the one closest to the exact value
+ */
+#define DS_DOUBLE_MANTISSA_BITS 52
+#define DS_DOUBLE_EXPONENT_BITS 11
+#define DS_DOUBLE_BIAS 1023
+
+static inline uint64_t ds_umul128(uint64_t a, uint64_t b, uint64_t* high) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    *high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (uint32_t)lo_lo;
+#endif
+}
+
+static inline uint64_t ds_shiftright128(uint64_t low, uint64_t high, uint32_t dist) {
+    return (high << (64 - dist)) | (low >> dist);
+}
+
+static inline uint64_t ds_mul_shift64(uint64_t m, const uint64_t* mul, int32_t j) {
+    uint64_t high0;
+    ds_umul128(m, mul[0], &high0);
+    uint64_t high1;
+    uint64_t low1 = ds_umul128(m, mul[1], &high1);
+    uint64_t sum = high0 + low1;
+    if (sum < high0) high1++;
+    return ds_shiftright128(sum, high1, (uint32_t)(j - 64));
+}
+
+static inline int32_t ds_pow5bits(int32_t e) {
+    return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+static inline uint32_t ds_log10_pow2(int32_t e) {
+    return ((uint32_t)e * 78913) >> 18;
+}
+
+static inline uint32_t ds_log10_pow5(int32_t e) {
+    return ((uint32_t)e * 732923) >> 20;
+}
+
+static inline bool ds_multiple_of_pow5(uint64_t value, uint32_t p) {
+    uint32_t count = 0;
+    while (value % 5 == 0) {
+        value /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+static inline bool ds_multiple_of_pow2(uint64_t value, uint32_t p) {
+    return (value & ((1ull << p) - 1)) == 0;
+}
+
+// decimal mantissa and exponent of a finite, non zero double
+static void ds_double_to_decimal(uint64_t ieee_mantissa, uint32_t ieee_exponent, uint64_t* mantissa, int32_t* exponent) {
+    int32_t e2;
+    uint64_t m2;
+    if (ieee_exponent == 0) {
+        e2 = 1 - DS_DOUBLE_BIAS - DS_DOUBLE_MANTISSA_BITS - 2;
+        m2 = ieee_mantissa;
+    }
+    else {
+        e2 = (int32_t)ieee_exponent - DS_DOUBLE_BIAS - DS_DOUBLE_MANTISSA_BITS - 2;
+        m2 = (1ull << DS_DOUBLE_MANTISSA_BITS) | ieee_mantissa;
+    }
+    bool accept_bounds = (m2 & 1) == 0;
+
+    // the interval of valid representations is [mm, mp] around mv, scaled by 4
+    uint64_t mv = 4 * m2;
+    uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+    uint64_t vr, vp, vm;
+    int32_t e10;
+    bool vm_trailing_zeros = false;
+    bool vr_trailing_zeros = false;
+
+    if (e2 >= 0) {
+        uint32_t q = ds_log10_pow2(e2) - (e2 > 3);
+        e10 = (int32_t)q;
+        int32_t k = DS_POW5_INV_BITCOUNT + ds_pow5bits((int32_t)q) - 1;
+        int32_t i = -e2 + (int32_t)q + k;
+        vr = ds_mul_shift64(mv, ds_pow5_inv_split[q], i);
+        vp = ds_mul_shift64(mv + 2, ds_pow5_inv_split[q], i);
+        vm = ds_mul_shift64(mv - 1 - mm_shift, ds_pow5_inv_split[q], i);
+        if (q <= 21) {
+            if (mv % 5 == 0) {
+                vr_trailing_zeros = ds_multiple_of_pow5(mv, q);
+            }
+            else if (accept_bounds) {
+                vm_trailing_zeros = ds_multiple_of_pow5(mv - 1 - mm_shift, q);
+            }
+            else {
+                vp -= ds_multiple_of_pow5(mv + 2, q);
+            }
+        }
+    }
+    else {
+        uint32_t q = ds_log10_pow5(-e2) - (-e2 > 1);
+        e10 = (int32_t)q + e2;
+        int32_t i = -e2 - (int32_t)q;
+        int32_t k = ds_pow5bits(i) - DS_POW5_BITCOUNT;
+        int32_t j = (int32_t)q - k;
+        vr = ds_mul_shift64(mv, ds_pow5_split[i], j);
+        vp = ds_mul_shift64(mv + 2, ds_pow5_split[i], j);
+        vm = ds_mul_shift64(mv - 1 - mm_shift, ds_pow5_split[i], j);
+        if (q <= 1) {
+            vr_trailing_zeros = true;
+            if (accept_bounds) {
+                vm_trailing_zeros = mm_shift == 1;
+            }
+            else {
+                vp--;
+            }
+        }
+        else if (q < 63) {
+            vr_trailing_zeros = ds_multiple_of_pow2(mv, q);
+        }
+    }
+
+    // drop digits while the interval still contains a shorter number
+    int32_t removed = 0;
+    uint8_t last_removed_digit = 0;
+    uint64_t output;
+
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        while (vp / 10 > vm / 10) {
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed_digit == 0;
+            last_removed_digit = (uint8_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_trailing_zeros) {
+            while (vm % 10 == 0) {
+                vr_trailing_zeros &= last_removed_digit == 0;
+                last_removed_digit = (uint8_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        // round half to even if the exact value is ...50..0
+        if (vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+            last_removed_digit = 4;
+        }
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed_digit >= 5);
+    }
+    else {
+        bool round_up = false;
+        if (vp / 100 > vm / 100) {
+            round_up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            round_up = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+
+    *mantissa = output;
+    *exponent = e10 + removed;
+}
+
+// shortest round trip representation, fixed notation for 1e-7 < |value| < 1e21
+static size_t ds_write_double(char* out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    bool sign = (bits >> 63) != 0;
+    uint64_t ieee_mantissa = bits & ((1ull << DS_DOUBLE_MANTISSA_BITS) - 1);
+    uint32_t ieee_exponent = (uint32_t)((bits >> DS_DOUBLE_MANTISSA_BITS) & ((1u << DS_DOUBLE_EXPONENT_BITS) - 1));
+
+    char* write = out;
+
+    if (ieee_exponent == (1u << DS_DOUBLE_EXPONENT_BITS) - 1) {
+        if (ieee_mantissa) {
+            memcpy(write, "nan", 3);
+            return 3;
+        }
+        if (sign) *write++ = '-';
+        memcpy(write, "inf", 3);
+        return (size_t)(write - out) + 3;
+    }
+
+    if (sign) *write++ = '-';
+
+    if (ieee_exponent == 0 && ieee_mantissa == 0) {
+        *write++ = '0';
+        return (size_t)(write - out);
+    }
+
+    uint64_t mantissa;
+    int32_t exponent;
+    ds_double_to_decimal(ieee_mantissa, ieee_exponent, &mantissa, &exponent);
+
+    char digits[20];
+    int32_t count = (int32_t)ds_write_u64(digits, mantissa);
+    // position of the decimal point relative to the first digit
+    int32_t point = count + exponent;
+
+    if (point > 21 || point <= -6) {
+        *write++ = digits[0];
+        if (count > 1) {
+            *write++ = '.';
+            memcpy(write, digits + 1, count - 1);
+            write += count - 1;
+        }
+        *write++ = 'e';
+        int32_t e = point - 1;
+        if (e < 0) {
+            *write++ = '-';
+            e = -e;
+        }
+        else {
+            *write++ = '+';
+        }
+        write += ds_write_u64(write, (uint64_t)e);
+    }
+    else if (point <= 0) {
+        *write++ = '0';
+        *write++ = '.';
+        memset(write, '0', -point);
+        write += -point;
+        memcpy(write, digits, count);
+        write += count;
+    }
+    else if (point >= count) {
+        memcpy(write, digits, count);
+        write += count;
+        memset(write, '0', point - count);
+        write += point - count;
+    }
+    else {
+        memcpy(write, digits, point);
+        write += point;
+        *write++ = '.';
+        memcpy(write, digits + point, count - point);
+        write += count - point;
+    }
+
+    return (size_t)(write - out);
+}
+
+size_t ds_append_double(ds_String* string, double value) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    char* write = ds_append_begin(string, DS_DOUBLE_MAX_LENGTH);
+    if (!write) {
+        return -1;
+    }
+
+    ds_append_end(string, ds_write_double(write, value));
+
+    return 0;
+}
+
+void ds_concat(ds_String* string, const ds_StringView* parts, size_t n) {
+    if (!string || (!parts && n)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or parts are NULL");
+        return;
+    }
+
+    size_t length = ds_length(string);
+    size_t total = length;
+    for (size_t i = 0; i < n; i++) {
+        total += parts[i].length;
+    }
+
+    // parts may be views into string itself, those are found again after growing
+    uintptr_t old_begin = (uintptr_t)ds_data(string);
+
+    if (ds_string_grow(string, total, false) != 0) {
+        return;
+    }
+
+    char* begin = ds_data(string);
+    char* write = begin + length;
+    for (size_t i = 0; i < n; i++) {
+        const char* data = parts[i].data;
+        uintptr_t position = (uintptr_t)data;
+        if (position >= old_begin && position + parts[i].length <= old_begin + length) {
+            data = begin + (position - old_begin);
+        }
+        memcpy(write, data, parts[i].length);
+        write += parts[i].length;
+    }
+    *write = '\0';
+    ds_set_length(string, total);
+}
+
+void ds_append_dstring(ds_String *string, ds_String *append) {
+    if (!string || !append) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
+        return;
+    }
+
+    size_t length = ds_length(string);
+    size_t append_length = ds_length(append);
+
+    if (ds_string_grow(string, length + append_length, false) != 0) {
+        return;
+    }
+
+    // append may be string itself, so only read its data after growing
+    char* data = ds_data(string);
+    memcpy(data + length, ds_data(append), append_length);
+    data[length + append_length] = '\0';
+    ds_set_length(string, length + append_length);
+}
+
+
+char ds_pop(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    size_t length = ds_length(string);
+    
+    if (length == 0) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Length of the string going under 0");
+        return -1;
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+    
+    char c = -1;
+
+    if (ds_is_stack(string)) {
+        c = string->stack_data[length - 1];
+        string->stack_data[length - 1] = '\0';
+        ds_set_length(string, length - 1);
+    }
+    else if (ds_has_valid_heap_data(string) && ds_has_sticky_heap(string)) {
+        c = string->heap_data[length - 1];
+        string->heap_data[length - 1] = '\0';
+        ds_set_length(string, length - 1);
+    }
+    else if (ds_has_valid_heap_data(string)) {
+        c = string->heap_data[length - 1];
+        string->heap_data[length - 1] = '\0';
+        ds_set_length(string, length - 1);
+
+        if (length - 1 <= DS_SMALL_STRING_CAPACITY) {
+            ds_move_dsstring_to_stack(string);
+        }
+    }
+
+    return c;
+
+}
+
+size_t ds_pop_n(ds_String* string, size_t n) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input String is NULL");
+        return -1;
+    }
+
+    size_t length = ds_length(string);
+
+    if (n > length) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Length - n < 0");
+        return -1;
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+
+    // move to stack
+    if ((ds_is_heap(string) && length - n <= DS_SMALL_STRING_CAPACITY && !ds_has_sticky_heap(string))
+            || ds_is_stack(string)) {
+        ds_data(string)[length - n] = '\0';
+        ds_set_length(string, length - n);
+        
+        if (ds_is_heap(string)) {
+            ds_move_dsstring_to_stack(string);
+        }
+    }
+    else {
+        string->heap_data[length - n] = '\0';
+        ds_set_length(string, length - n);
+    }
+    
+    return 0;
+}
+
+size_t ds_reserve(ds_String *string, size_t n) {
+    return ds_reserve_exact(string, n);
+}
+
+size_t ds_reserve_exact(ds_String* string, size_t n) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    return ds_string_grow(string, n, true);
+}
+
+size_t ds_reserve_at_least(ds_String* string, size_t n) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    return ds_string_grow(string, n, false);
+}
+
+size_t ds_clear(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    // a shared or borrowed buffer is let go instead of copied
+    if (ds_string_needs_detach(string)) {
+        ds_string_release_buffer(string);
+        ds_set_is_stack(string);
+        ds_set_capacity(string, DS_STACK_CAPACITY);
+    }
+
+    ds_data(string)[0] = '\0';
+    ds_set_length(string, 0);
+
+    return 0;
+}
+
+bool ds_equal(const ds_String* string0, const ds_String* string1) {
+    if (!string0 || !string1) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return false;
+    }
+
+    size_t length = ds_length(string0);
+
+    if (length != ds_length(string1)) {
+        return false;
+    }
+
+    return ds_mismatch(ds_cdata(string0), ds_cdata(string1), length) == length;
+}
+
+int ds_compare(const ds_String* string0, const ds_String* string1) {
+    if (!string0 || !string1) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return 0;
+    }
+
+    return ds_compare_bytes(ds_cdata(string0), ds_length(string0), ds_cdata(string1), ds_length(string1));
+}
+
+size_t ds_set(ds_String* string, const char* literal) {
+    if (!string || !literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    return ds_set_n(string, literal, strlen(literal));
+}
+
+size_t ds_set_n(ds_String* string, const char* data, size_t n) {
+    if (!string || (!data && n)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    // a piece of string itself is cut out in place, the buffer cant be let go before it is read
+    size_t offset = ds_string_inner_offset(string, data);
+    if (offset != SIZE_MAX) {
+        if (offset + n > ds_length(string)) {
+            DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Data runs past the end of the string");
+            return -1;
+        }
+        if (ds_string_make_writable(string) != 0) {
+            return -1;
+        }
+
+        char* string_data = ds_data(string);
+        memmove(string_data, string_data + offset, n);
+        string_data[n] = '\0';
+        ds_set_length(string, n);
+
+        if (n <= DS_SMALL_STRING_CAPACITY && ds_is_heap(string) && !ds_has_sticky_heap(string)) {
+            return ds_move_dsstring_to_stack(string);
+        }
+        return 0;
+    }
+
+    // move to stack, sticky heap strings keep their buffer
+    if (n <= DS_SMALL_STRING_CAPACITY && ds_is_heap(string) && !ds_has_sticky_heap(string)) {
+        ds_string_release_buffer(string);
+        ds_set_is_stack(string);
+        ds_set_capacity(string, DS_STACK_CAPACITY);
+    }
+
+    if (ds_string_grow(string, n, false) != 0) {
+        return -1;
+    }
+
+    char* string_data = ds_data(string);
+    memcpy(string_data, data, n);
+    string_data[n] = '\0';
+    ds_set_length(string, n);
+
+    return 0;
+}
+
+size_t ds_set_view(ds_String* string, const ds_StringView* view) {
+    if (!string || !view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or view is NULL");
+        return -1;
+    }
+
+    return ds_set_n(string, view->data, view->length);
+}
+
+static inline bool ds_string_is_borrowed(const ds_String* string) {
+    return ds_is_read_only(string) && !ds_owns_memory(string);
+}
+
+// borrowed memory can be borrowed again, owned buffers are only shared between strings of one allocator
+static inline bool ds_string_can_share(ds_String* string, ds_String* source) {
+    if (string == source || !ds_is_heap(source)) return false;
+    if (ds_string_is_borrowed(source)) return true;
+    return !ds_is_read_only(source) && ds_string_allocator(string) == ds_string_allocator(source);
+}
+
+// string ends up pointing at the buffer of source, which gains a reference if it is owned
+static size_t ds_string_share_from(ds_String* string, ds_String* source) {
+    if (!ds_string_is_borrowed(source)) {
+        ds_SharedHeader* header = ds_string_make_shared(source);
+        if (!header) {
+            return -1;
+        }
+        atomic_fetch_add_explicit(&header->references, 1, memory_order_relaxed);
+    }
+
+    if (ds_is_heap(string)) {
+        ds_string_release_buffer(string);
+    }
+
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    *string = *source;
+    ds_string_set_allocator(string, allocator);
+
+    return 0;
+}
+
+/*  NOTE:
+ *  this function can ignore flags of
+ *  the string because it is cloning the 
+ *  argument string with its flags
+ */
+size_t ds_clone(ds_String* string, ds_String* clone) {
+    if (!string || !clone) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    // heap strings only bump the refcount, the copy happens on the first write
+    if (ds_string_can_share(string, clone)) {
+        return ds_string_share_from(string, clone);
+    }
+
+    size_t clone_length = ds_length(clone);
+
+    if (ds_is_heap(string) && ds_is_stack(clone)) {
+        ds_clear(string);
+        if (ds_is_heap(string)) {
+            ds_move_dsstring_to_stack(string);
+        }
+    }
+
+    if (ds_string_grow(string, clone_length, true) != 0) {
+        return -1;
+    }
+
+    // clone can be a shared substring without a terminator
+    char* data = ds_data(string);
+    memcpy(data, ds_data(clone), clone_length);
+    data[clone_length] = '\0';
+    ds_set_length(string, clone_length);
+    if (ds_has_sticky_heap(clone)) {
+        ds_set_sticky_heap(string);
+    }
+
+    return 0;
+}
+
+size_t ds_clone_substr(ds_String* string, ds_String* source, size_t start, size_t length) {
+    if (!string || !source) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    size_t source_length = ds_length(source);
+    if (start > source_length || length > source_length - start) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Substring [%zu, %zu) is outside of the string", start, start + length);
+        return -1;
+    }
+
+    // short substrings fit inline and are cheaper to copy
+    if (length > DS_SMALL_STRING_CAPACITY && ds_string_can_share(string, source)) {
+        if (ds_string_share_from(string, source) != 0) {
+            return -1;
+        }
+        string->heap_data += start;
+        ds_set_capacity(string, ds_capacity(source) - start);
+        ds_set_length(string, length);
+
+        return 0;
+    }
+
+    if (string == source) {
+        if (ds_string_make_writable(string) != 0) {
+            return -1;
+        }
+        char* data = ds_data(string);
+        memmove(data, data + start, length);
+        data[length] = '\0';
+        ds_set_length(string, length);
+
+        return 0;
+    }
+
+    return ds_set_n(string, ds_data(source) + start, length);
+}
+
+size_t ds_trim_whitespace(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+
+    char* data = ds_data(string);
+    size_t length = ds_length(string);
+
+    size_t write = 0;
+    for (size_t read = 0; read < length; read++) {
+        if (!isspace((unsigned char)data[read])) {
+            data[write++] = data[read];
+        }
+    }
+
+    data[write] = '\0';
+    ds_set_length(string, write);
+    
+    return 0;
+}
+
+size_t ds_trim_whitespace_flags(ds_String* string, uint32_t flags) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (flags & DS_ALL) {
+        return ds_trim_whitespace(string);
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+
+    char* data = ds_data(string);
+
+    size_t start = 0, end = ds_length(string);
+
+    if (flags & DS_FRONT) {
+        while (start < end && isspace((unsigned char)data[start])) {
+            start++;
+        }
+    }
+
+    if (flags & DS_BACK) {
+        while (end > start && isspace((unsigned char)data[end - 1])) {
+            end--;
+        }
+    }
+
+    size_t delta_length = end - start;
+    if (start > 0 && delta_length > 0) {
+        memmove(data, data + start, delta_length);
+    }
+    data[delta_length] = '\0';
+    ds_set_length(string, delta_length);
+
+    return 0;
+}
+
+ds_String* ds_split(ds_String* string, char seperator) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return NULL;
+    }
+
+    char* data = ds_data(string);
+    size_t length = ds_length(string);
+
+    const char* found = ds_find_byte(data, length, seperator);
+    if (!found) {
+        return NULL;
+    }
+    size_t start = found - data;
+
+    if (ds_string_make_writable(string) != 0) {
+        return NULL;
+    }
+    data = ds_data(string);
+
+    // only the tail is copied
+    ds_String* cut = ds_init_string_allocator_n(ds_string_allocator(string), data + start + 1, length - start - 1);
+    if (!cut) {
+        return NULL;
+    }
+
+    data[start] = '\0';
+    ds_set_length(string, start);
+
+    return cut;
+}
+
+ds_StringView ds_string_view_from_cstr(const char *str) {
+    ds_StringView view = {0};
+
+    if (!str) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return view;
+    }
+
+    view.data = str;
+    view.length = strlen(str);
+
+    return view;
+}
+
+ds_StringView ds_string_view_from_string(const ds_String* string) {
+    ds_StringView view = {0};
+
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return view;
+    }
+
+    view.data = ds_cdata(string);
+    view.length = ds_length(string);
+
+    return view;
+}
+
+ds_StringView ds_string_view_from_buffer(const char *data, uint32_t length) {
+    ds_StringView view = {0};
+
+    if (!data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input buffer is NULL");
+        return view;
+    }
+
+    view.data = data;
+    view.length = length;
+
+    return view;
+}
+
+ds_StringView ds_string_view_from_substr(const ds_StringView *view, uint32_t start, uint32_t length) {
+    ds_StringView lview = {0};
+
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return lview;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return lview;
+    }
+
+    if (start >= view->length) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
+        return lview;
+    }
+
+    uint32_t available_length = view->length - start;
+    uint32_t actual_length = (length > available_length) ? available_length : length;
+
+    lview.data = view->data + start;
+    lview.length = actual_length;
+
+    return lview;
+}
+
+ds_StringView ds_string_view_from_substr_to_end(const ds_StringView *view, uint32_t start) {
+    ds_StringView lview = {0};
+
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return lview;
+    }
+
+    if (start >= view->length) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
+        return lview;
+    }
+
+    lview.data = view->data + start;
+    lview.length = view->length - start;
+
+    return lview;
+}
+
+ds_StringView ds_string_view_from_string_substr(const ds_String* string, uint32_t start, uint32_t length) {
+    ds_StringView view = {0};
+
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return view;
+    }
+
+    if (start >= ds_length(string)) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
+        return view;
+    }
+
+    uint32_t available_length = ds_length(string) - start;
+    uint32_t actual_length = (length > available_length) ? available_length : length;
+
+    view.data = ds_cdata(string) + start;
+    view.length = actual_length;
+
+    return view;
+}
+
+ds_StringView ds_string_view_from_string_substr_to_end(const ds_String* string, uint32_t start) {
+    ds_StringView view = {0};
+
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return view;
+    }
+
+    if (start >= ds_length(string)) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
+        return view;
+    }
+
+    view.data = ds_cdata(string) + start;
+    view.length = ds_length(string) - start;
+
+    return view;
+
+}
+
+bool ds_string_view_equal(const ds_StringView *view1, const ds_StringView *view2) {
+    if (!view1 || !view2) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return false;
+    }
+
+    if (!view1->data || !view2->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return false;
+    }
+
+    if (view1->length != view2->length) return false;
+    return ds_mismatch(view1->data, view2->data, view1->length) == view1->length;
+}
+
+bool ds_string_view_equal_cstr(const ds_StringView *view, const char *str) {
+    if (!view || !str) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return false;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return false;
+    }
+
+    // strnlen never looks further than one byte past the view
+    if (strnlen(str, (size_t)view->length + 1) != view->length) return false;
+    return memcmp(view->data, str, view->length) == 0;
+}
+
+int ds_string_view_compare(const ds_StringView* view1, const ds_StringView* view2) {
+    if (!view1 || !view2) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return 0;
+    }
+
+    if (!view1->data || !view2->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return 0;
+    }
+
+    return ds_compare_bytes(view1->data, view1->length, view2->data, view2->length);
+}
+
+/*  NOTE:
+ *  wyhash (final version 4). inputs are read little endian, so the
+ *  values are the same on every platform and can be stored or sent
+ *  to other machines. the 128 bit variant runs two passes with
+ *  independent secrets.
+ */
+static const uint64_t ds_hash_secret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull,
+};
+
+static const uint64_t ds_hash_secret_high[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+};
+
+static inline uint64_t ds_hash_mix(uint64_t a, uint64_t b) {
+    uint64_t high;
+    uint64_t low = ds_umul128(a, b, &high);
+    return low ^ high;
+}
+
+static inline uint64_t ds_load_u32_le(const unsigned char* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+static uint64_t ds_hash_with_secret(const void* key, size_t length, uint64_t seed, const uint64_t* secret) {
+    const unsigned char* p = (const unsigned char*)key;
+    uint64_t a;
+    uint64_t b;
+
+    seed ^= ds_hash_mix(seed ^ secret[0], secret[1]);
+
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t middle = (length >> 3) << 2;
+            a = (ds_load_u32_le(p) << 32) | ds_load_u32_le(p + middle);
+            b = (ds_load_u32_le(p + length - 4) << 32) | ds_load_u32_le(p + length - 4 - middle);
+        }
+        else if (length > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t i = length;
+        if (i > 48) {
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do {
+                seed = ds_hash_mix(ds_load_u64_le((const char*)p) ^ secret[1], ds_load_u64_le((const char*)p + 8) ^ seed);
+                seed1 = ds_hash_mix(ds_load_u64_le((const char*)p + 16) ^ secret[2], ds_load_u64_le((const char*)p + 24) ^ seed1);
+                seed2 = ds_hash_mix(ds_load_u64_le((const char*)p + 32) ^ secret[3], ds_load_u64_le((const char*)p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (i > 16) {
+            seed = ds_hash_mix(ds_load_u64_le((const char*)p) ^ secret[1], ds_load_u64_le((const char*)p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = ds_load_u64_le((const char*)p + i - 16);
+        b = ds_load_u64_le((const char*)p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    a = ds_umul128(a, b, &b);
+
+    return ds_hash_mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+uint64_t ds_hash_bytes(const void* data, size_t length, uint64_t seed) {
+    if (!data && length > 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input data is NULL");
+        return 0;
+    }
+
+    return ds_hash_with_secret(data, length, seed, ds_hash_secret);
+}
+
+uint64_t ds_string_view_hash(const ds_StringView* view, uint64_t seed) {
+    if (!view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input view is NULL or has no data");
+        return 0;
+    }
+
+    return ds_hash_with_secret(view->data, view->length, seed, ds_hash_secret);
+}
+
+ds_Hash128 ds_string_view_hash128(const ds_StringView* view, uint64_t seed) {
+    ds_Hash128 hash = {0, 0};
+
+    if (!view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input view is NULL or has no data");
+        return hash;
+    }
+
+    hash.low = ds_hash_with_secret(view->data, view->length, seed, ds_hash_secret);
+    hash.high = ds_hash_with_secret(view->data, view->length, seed, ds_hash_secret_high);
+
+    return hash;
+}
+
+uint64_t ds_string_hash(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return 0;
+    }
+
+    uint64_t hash;
+    if (ds_string_cached_hash(string, &hash)) {
+        return hash;
+    }
+
+    hash = ds_hash_with_secret(ds_data(string), ds_length(string), 0, ds_hash_secret);
+    ds_string_cache_hash(string, hash);
+
+    return hash;
+}
+
+bool ds_string_view_is_empty(const ds_StringView *view) {
+    return (!view || view->length) == 0;
+}
+
+int32_t ds_string_view_find_char(const ds_StringView *view, char c) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return -1;
+    }
+
+    const char* found = ds_find_byte(view->data, view->length, c);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_rfind_char(const ds_StringView* view, char c) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return -1;
+    }
+
+    const char* found = ds_rfind_byte(view->data, view->length, c);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_find_nth_char(const ds_StringView* view, char c, size_t n) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return -1;
+    }
+
+    const char* found = ds_find_nth_byte(view->data, view->length, c, n);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+size_t ds_string_view_count_char(const ds_StringView* view, char c) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return 0;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return 0;
+    }
+
+    return ds_count_byte(view->data, view->length, c);
+}
+
+ds_ByteSet ds_byte_set_from_buffer(const char* chars, size_t length) {
+    ds_ByteSet set = {0};
+
+    if (!chars) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input chars are NULL");
+        return set;
+    }
+
+    set.nibble_lookup = true;
+    for (size_t i = 0; i < length; i++) {
+        ds_byte_set_add(&set, chars[i]);
+    }
+
+    return set;
+}
+
+ds_ByteSet ds_byte_set_from_cstr(const char* chars) {
+    if (!chars) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input chars are NULL");
+        ds_ByteSet set = {0};
+        return set;
+    }
+
+    return ds_byte_set_from_buffer(chars, strlen(chars));
+}
+
+void ds_byte_set_add(ds_ByteSet* set, char c) {
+    if (!set) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input set is NULL");
+        return;
+    }
+
+    unsigned char byte = (unsigned char)c;
+    set->bits[byte >> 6] |= 1ull << (byte & 63);
+
+    if (!set->nibble_lookup) {
+        return;
+    }
+
+    uint8_t high = byte >> 4;
+    uint8_t low = byte & 0x0f;
+
+    // a new high nibble needs one of the 8 group bits
+    if (!set->high_nibbles[high]) {
+        uint8_t used = 0;
+        for (int i = 0; i < 16; i++) used |= set->high_nibbles[i];
+        if (used == 0xff) {
+            set->nibble_lookup = false;
+            return;
+        }
+        set->high_nibbles[high] = (uint8_t)(~used & (used + 1));
+    }
+
+    set->low_nibbles[low] |= set->high_nibbles[high];
+}
+
+bool ds_byte_set_contains(const ds_ByteSet* set, char c) {
+    if (!set) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input set is NULL");
+        return false;
+    }
+
+    return ds_byte_set_has(set, c);
+}
+
+static inline bool ds_byte_set_check_input(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!view || !set) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input view or set is NULL");
+        return false;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return false;
+    }
+
+    return true;
+}
+
+int32_t ds_string_view_find_first_of(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return -1;
+    }
+
+    const char* found = ds_find_in_byte_set(view->data, view->length, set, true);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_find_first_not_of(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return -1;
+    }
+
+    const char* found = ds_find_in_byte_set(view->data, view->length, set, false);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_find_last_of(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return -1;
+    }
+
+    const char* found = ds_rfind_in_byte_set(view->data, view->length, set, true);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_find_last_not_of(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return -1;
+    }
+
+    const char* found = ds_rfind_in_byte_set(view->data, view->length, set, false);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+uint32_t ds_string_view_span(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return 0;
+    }
+
+    const char* found = ds_find_in_byte_set(view->data, view->length, set, false);
+    return found ? (uint32_t)(found - view->data) : view->length;
+}
+
+uint32_t ds_string_view_cspan(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return 0;
+    }
+
+    const char* found = ds_find_in_byte_set(view->data, view->length, set, true);
+    return found ? (uint32_t)(found - view->data) : view->length;
+}
+
+int32_t ds_string_view_find_substr(const ds_StringView *view, const ds_StringView *substr) {
+    if (!view || !substr || !view->data || !substr->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or substr is NULL or has no data");
+        return -1;
+    }
+
+    ds_Searcher searcher;
+    ds_searcher_init(&searcher, substr);
+
+    const char* found = ds_searcher_search(&searcher, view->data, view->length);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+size_t ds_searcher_init(ds_Searcher* searcher, const ds_StringView* needle) {
+    if (!searcher || !needle || !needle->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Searcher or needle is NULL or has no data");
+        return -1;
+    }
+
+    searcher->needle = *needle;
+    searcher->critical = 0;
+    searcher->period = 0;
+    searcher->memory = 0;
+
+    size_t length = needle->length;
+    if (length <= DS_SEARCHER_SHORT_NEEDLE) {
+        return 0;
+    }
+
+    // shift holds the last position + 1 of every byte, 0 for bytes not in the needle
+    const unsigned char* data = (const unsigned char*)needle->data;
+    memset(searcher->shift, 0, sizeof(searcher->shift));
+    for (size_t i = 0; i < length; i++) {
+        searcher->shift[data[i]] = (uint32_t)(i + 1);
+    }
+
+    // critical factorization, the later of the two maximal suffixes
+    size_t period;
+    size_t reverse_period;
+    size_t critical = ds_maximal_suffix(data, length, false, &period);
+    size_t reverse_critical = ds_maximal_suffix(data, length, true, &reverse_period);
+    if (reverse_critical + 1 > critical + 1) {
+        critical = reverse_critical;
+        period = reverse_period;
+    }
+
+    // periodic needles remember how much of the left half already matched
+    if (memcmp(data, data + period, critical + 1) == 0) {
+        searcher->memory = length - period;
+    }
+    else {
+        size_t right = length - critical - 1;
+        period = (critical > right ? critical : right) + 1;
+    }
+
+    searcher->critical = critical;
+    searcher->period = period;
+
+    return 0;
+}
+
+int32_t ds_searcher_find(const ds_Searcher* searcher, const ds_StringView* haystack) {
+    if (!searcher || !haystack || !haystack->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Searcher or haystack is NULL or has no data");
+        return -1;
+    }
+
+    const char* found = ds_searcher_search(searcher, haystack->data, haystack->length);
+    return found ? (int32_t)(found - haystack->data) : -1;
+}
+
+size_t ds_match_iter_init(ds_MatchIter* iter, const ds_StringView* haystack, const ds_StringView* needle, uint32_t flags) {
+    if (!iter || !haystack || !haystack->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or haystack is NULL or has no data");
+        return -1;
+    }
+
+    if (ds_searcher_init(&iter->searcher, needle) != 0) {
+        return -1;
+    }
+
+    iter->haystack = *haystack;
+    iter->position = 0;
+    iter->flags = flags;
+
+    return 0;
+}
+
+void ds_match_iter_reset(ds_MatchIter* iter, const ds_StringView* haystack) {
+    if (!iter || !haystack || !haystack->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or haystack is NULL or has no data");
+        return;
+    }
+
+    iter->haystack = *haystack;
+    iter->position = 0;
+}
+
+bool ds_match_iter_next(ds_MatchIter* iter, uint32_t* offset) {
+    if (!iter || !offset) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or offset is NULL");
+        return false;
+    }
+
+    // an empty needle matches at every offset including the end
+    size_t length = iter->haystack.length;
+    if (iter->position > length) {
+        return false;
+    }
+
+    const char* data = iter->haystack.data;
+    const char* found = ds_searcher_search(&iter->searcher, data + iter->position, length - iter->position);
+    if (!found) {
+        iter->position = (uint64_t)length + 1;
+        return false;
+    }
+
+    size_t needle_length = iter->searcher.needle.length;
+    *offset = (uint32_t)(found - data);
+    iter->position = *offset + ((iter->flags & DS_MATCH_OVERLAPPING) || needle_length == 0 ? 1 : needle_length);
+
+    return true;
+}
+
+size_t ds_string_view_find_all(const ds_StringView* view, const ds_StringView* needle, uint32_t* offsets, size_t capacity, uint32_t flags) {
+    if (!offsets && capacity > 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Offsets are NULL");
+        return 0;
+    }
+
+    ds_MatchIter iter;
+    if (ds_match_iter_init(&iter, view, needle, flags) != 0) {
+        return 0;
+    }
+
+    size_t count = 0;
+    uint32_t offset;
+    while (ds_match_iter_next(&iter, &offset)) {
+        if (count < capacity) offsets[count] = offset;
+        count++;
+    }
+
+    return count;
+}
+
+/*  NOTE:
+ *  Aho-Corasick. states are numbered breadth first, so the shallow
+ *  states every scan keeps returning to come first and get full
+ *  transition rows (as far as DS_MULTI_MATCHER_DENSE_ENTRIES allows).
+ *  deeper states keep only their trie edges and fall back along
+ *  their fail link. bytes are mapped to classes first, class 0 is
+ *  every byte that appears in no pattern and always leads to the root.
+ */
+#define DS_MULTI_MATCHER_NONE UINT32_MAX
+
+struct ds_MultiMatcher {
+    const ds_Allocator* allocator;
+    size_t size;
+    uint32_t state_count;
+    uint32_t dense_count; // states below this have a dense row
+    uint32_t class_count;
+    uint32_t pattern_count;
+    uint16_t classes[256];
+    uint32_t* dense;
+    uint32_t* fail;
+    uint32_t* edge_start; // edges of state s are [edge_start[s], edge_start[s + 1])
+    uint16_t* edge_class;
+    uint32_t* edge_target;
+    uint32_t* output_start; // same layout for the pattern ids ending in a state
+    uint32_t* outputs;
+    uint32_t* output_link; // next state on the fail chain with outputs, 0 for none
+    uint32_t* pattern_lengths;
+};
+
+static inline size_t ds_multi_matcher_align(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+static uint32_t ds_multi_matcher_edge(const ds_MultiMatcher* matcher, uint32_t state, uint32_t class_id) {
+    for (uint32_t e = matcher->edge_start[state]; e < matcher->edge_start[state + 1]; e++) {
+        if (matcher->edge_class[e] == class_id) return matcher->edge_target[e];
+    }
+
+    return DS_MULTI_MATCHER_NONE;
+}
+
+static inline uint32_t ds_multi_matcher_step(const ds_MultiMatcher* matcher, uint32_t state, uint32_t class_id) {
+    while (state >= matcher->dense_count) {
+        uint32_t next = ds_multi_matcher_edge(matcher, state, class_id);
+        if (next != DS_MULTI_MATCHER_NONE) return next;
+        state = matcher->fail[state];
+    }
+
+    return matcher->dense[(size_t)state * matcher->class_count + class_id];
+}
+
+ds_MultiMatcher* ds_init_multi_matcher(const ds_StringView* patterns, size_t count) {
+    if (!patterns && count > 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input patterns are NULL");
+        return NULL;
+    }
+
+    uint16_t classes[256] = {0};
+    uint32_t class_count = 1;
+    size_t total = 1;
+
+    for (size_t p = 0; p < count; p++) {
+        if (!patterns[p].data) {
+            DS_SET_ERROR(DS_INVALID_INPUT, "Pattern %zu has no data", p);
+            return NULL;
+        }
+        total += patterns[p].length;
+
+        for (uint32_t i = 0; i < patterns[p].length; i++) {
+            unsigned char byte = (unsigned char)patterns[p].data[i];
+            if (!classes[byte]) classes[byte] = (uint16_t)class_count++;
+        }
+    }
+
+    if (total >= UINT32_MAX || count >= UINT32_MAX) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Patterns are to big");
+        return NULL;
+    }
+
+    // scratch trie with linked child lists, renumbered breadth first below
+    const ds_Allocator* allocator = ds_global_allocator;
+    size_t scratch_size = (6 * total + count) * sizeof(uint32_t);
+    uint32_t* scratch = (uint32_t*)ds_allocator_alloc(allocator, scratch_size);
+    if (!scratch) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", scratch_size);
+        return NULL;
+    }
+
+    uint32_t* first_child = scratch;
+    uint32_t* next_sibling = first_child + total;
+    uint32_t* node_class = next_sibling + total;
+    uint32_t* order = node_class + total;
+    uint32_t* renumber = order + total;
+    uint32_t* pattern_node = renumber + total;
+    uint32_t* output_count = pattern_node + count;
+
+    uint32_t node_count = 1;
+    first_child[0] = DS_MULTI_MATCHER_NONE;
+
+    for (size_t p = 0; p < count; p++) {
+        uint32_t node = 0;
+        for (uint32_t i = 0; i < patterns[p].length; i++) {
+            uint32_t class_id = classes[(unsigned char)patterns[p].data[i]];
+            uint32_t child = first_child[node];
+            while (child != DS_MULTI_MATCHER_NONE && node_class[child] != class_id) child = next_sibling[child];
+
+            if (child == DS_MULTI_MATCHER_NONE) {
+                child = node_count++;
+                first_child[child] = DS_MULTI_MATCHER_NONE;
+                node_class[child] = class_id;
+                next_sibling[child] = first_child[node];
+                first_child[node] = child;
+            }
+            node = child;
+        }
+        pattern_node[p] = node;
+    }
+
+    uint32_t tail = 1;
+    order[0] = 0;
+    for (uint32_t head = 0; head < tail; head++) {
+        renumber[order[head]] = head;
+        for (uint32_t child = first_child[order[head]]; child != DS_MULTI_MATCHER_NONE; child = next_sibling[child]) {
+            order[tail++] = child;
+        }
+    }
+
+    // empty patterns would match everywhere, they never match instead
+    uint32_t output_total = 0;
+    memset(output_count, 0, total * sizeof(uint32_t));
+    for (size_t p = 0; p < count; p++) {
+        if (patterns[p].length > 0) output_total++;
+    }
+
+    uint32_t state_count = node_count;
+    uint32_t dense_count = DS_MULTI_MATCHER_DENSE_ENTRIES / class_count;
+    if (dense_count < 1) dense_count = 1;
+    if (dense_count > state_count) dense_count = state_count;
+
+    size_t size = ds_multi_matcher_align(sizeof(ds_MultiMatcher));
+    size_t dense_offset = size;     size += ds_multi_matcher_align((size_t)dense_count * class_count * sizeof(uint32_t));
+    size_t fail_offset = size;      size += ds_multi_matcher_align(state_count * sizeof(uint32_t));
+    size_t edge_offset = size;      size += ds_multi_matcher_align((state_count + 1) * sizeof(uint32_t));
+    size_t class_offset = size;     size += ds_multi_matcher_align(state_count * sizeof(uint16_t));
+    size_t target_offset = size;    size += ds_multi_matcher_align(state_count * sizeof(uint32_t));
+    size_t output_offset = size;    size += ds_multi_matcher_align((state_count + 1) * sizeof(uint32_t));
+    size_t outputs_offset = size;   size += ds_multi_matcher_align(output_total * sizeof(uint32_t));
+    size_t link_offset = size;      size += ds_multi_matcher_align(state_count * sizeof(uint32_t));
+    size_t length_offset = size;    size += ds_multi_matcher_align(count * sizeof(uint32_t));
+
+    char* block = (char*)ds_allocator_alloc(allocator, size);
+    if (!block) {
+        ds_allocator_free(allocator, scratch, scratch_size);
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", size);
+        return NULL;
+    }
+
+    ds_MultiMatcher* matcher = (ds_MultiMatcher*)block;
+    matcher->allocator = allocator;
+    matcher->size = size;
+    matcher->state_count = state_count;
+    matcher->dense_count = dense_count;
+    matcher->class_count = class_count;
+    matcher->pattern_count = (uint32_t)count;
+    memcpy(matcher->classes, classes, sizeof(classes));
+    matcher->dense = (uint32_t*)(block + dense_offset);
+    matcher->fail = (uint32_t*)(block + fail_offset);
+    matcher->edge_start = (uint32_t*)(block + edge_offset);
+    matcher->edge_class = (uint16_t*)(block + class_offset);
+    matcher->edge_target = (uint32_t*)(block + target_offset);
+    matcher->output_start = (uint32_t*)(block + output_offset);
+    matcher->outputs = (uint32_t*)(block + outputs_offset);
+    matcher->output_link = (uint32_t*)(block + link_offset);
+    matcher->pattern_lengths = (uint32_t*)(block + length_offset);
+
+    // edges in breadth first order, so the children of a state are contiguous
+    uint32_t edge = 0;
+    for (uint32_t state = 0; state < state_count; state++) {
+        matcher->edge_start[state] = edge;
+        for (uint32_t child = first_child[order[state]]; child != DS_MULTI_MATCHER_NONE; child = next_sibling[child]) {
+            matcher->edge_class[edge] = (uint16_t)node_class[child];
+            matcher->edge_target[edge] = renumber[child];
+            edge++;
+        }
+    }
+    matcher->edge_start[state_count] = edge;
+
+    // outputs grouped by state, ascending pattern ids within a state
+    for (size_t p = 0; p < count; p++) {
+        matcher->pattern_lengths[p] = patterns[p].length;
+        if (patterns[p].length > 0) output_count[renumber[pattern_node[p]]]++;
+    }
+    uint32_t output = 0;
+    for (uint32_t state = 0; state < state_count; state++) {
+        matcher->output_start[state] = output;
+        output += output_count[state];
+        output_count[state] = matcher->output_start[state];
+    }
+    matcher->output_start[state_count] = output;
+    for (size_t p = 0; p < count; p++) {
+        if (patterns[p].length > 0) matcher->outputs[output_count[renumber[pattern_node[p]]]++] = (uint32_t)p;
+    }
+
+    // parents come before children, so fail links are ready when needed
+    matcher->fail[0] = 0;
+    matcher->output_link[0] = 0;
+    for (uint32_t state = 0; state < state_count; state++) {
+        for (uint32_t e = matcher->edge_start[state]; e < matcher->edge_start[state + 1]; e++) {
+            uint32_t child = matcher->edge_target[e];
+            uint32_t fail = 0;
+
+            if (state != 0) {
+                uint32_t candidate = matcher->fail[state];
+                for (;;) {
+                    uint32_t next = ds_multi_matcher_edge(matcher, candidate, matcher->edge_class[e]);
+                    if (next != DS_MULTI_MATCHER_NONE) {
+                        fail = next;
+                        break;
+                    }
+                    if (candidate == 0) break;
+                    candidate = matcher->fail[candidate];
+                }
+            }
+
+            matcher->fail[child] = fail;
+            bool fail_has_output = matcher->output_start[fail + 1] != matcher->output_start[fail];
+            matcher->output_link[child] = fail_has_output ? fail : matcher->output_link[fail];
+        }
+    }
+
+    for (uint32_t state = 0; state < dense_count; state++) {
+        uint32_t* row = matcher->dense + (size_t)state * class_count;
+        const uint32_t* fail_row = matcher->dense + (size_t)matcher->fail[state] * class_count;
+
+        for (uint32_t class_id = 0; class_id < class_count; class_id++) {
+            uint32_t next = ds_multi_matcher_edge(matcher, state, class_id);
+            if (next == DS_MULTI_MATCHER_NONE) next = state == 0 ? 0 : fail_row[class_id];
+            row[class_id] = next;
+        }
+    }
+
+    ds_allocator_free(allocator, scratch, scratch_size);
+
+    return matcher;
+}
+
+void ds_free_multi_matcher(ds_MultiMatcher* matcher) {
+    if (!matcher) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input matcher is NULL");
+        return;
+    }
+
+    ds_allocator_free(matcher->allocator, matcher, matcher->size);
+}
+
+size_t ds_multi_matcher_scan(const ds_MultiMatcher* matcher, const ds_StringView* view, ds_Match* matches, size_t capacity) {
+    if (!matcher || !view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Matcher or view is NULL or has no data");
+        return 0;
+    }
+
+    if (!matches && capacity > 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Matches are NULL");
+        return 0;
+    }
+
+    const unsigned char* data = (const unsigned char*)view->data;
+    size_t count = 0;
+    uint32_t state = 0;
+
+    for (uint32_t i = 0; i < view->length; i++) {
+        uint32_t class_id = matcher->classes[data[i]];
+        if (class_id == 0) {
+            state = 0;
+            continue;
+        }
+
+        state = ds_multi_matcher_step(matcher, state, class_id);
+
+        uint32_t report = matcher->output_start[state + 1] != matcher->output_start[state] ? state : matcher->output_link[state];
+        for (; report != 0; report = matcher->output_link[report]) {
+            for (uint32_t o = matcher->output_start[report]; o < matcher->output_start[report + 1]; o++) {
+                if (count < capacity) {
+                    uint32_t pattern = matcher->outputs[o];
+                    matches[count].pattern = pattern;
+                    matches[count].offset = i + 1 - matcher->pattern_lengths[pattern];
+                }
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+bool ds_string_view_starts_with(const ds_StringView *view, const ds_StringView *prefix) {
+    if (!view || !prefix || !view->data || !prefix->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or prefix is NULL or has no data");
+        return false;
+    }
+
+    if (prefix->length == 0) return true;
+    if (prefix->length > view->length) return false;
+
+    if (memcmp(view->data, prefix->data, prefix->length) == 0) return true;
+
+    return false;
+}
+
+bool ds_string_view_ends_with(const ds_StringView *view, const ds_StringView *suffix) {
+    if (!view || !suffix || !view->data || !suffix->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or suffix is NULL or has no data");
+        return false;
+    }
+
+    if (suffix->length == 0) return true;
+    if (suffix->length > view->length) return false;
+
+    if (memcmp(view->data + view->length - suffix->length, suffix->data, suffix->length) == 0) return true;
+
+    return false;
+
+}
+
+ds_String* ds_string_from_view(const ds_StringView* view) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return NULL;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return NULL;
+    }
+
+    ds_String* string = ds_init_string_allocator_n(ds_global_allocator, view->data, view->length);
+    return string;
+}
+
+ds_StringView ds_string_view_trim_whitespace(const ds_StringView *view) {
+    ds_StringView result = {0};
+
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return result;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return result;
+    }
+
+    char data[view->length];
+    uint32_t index = 0;
+
+    for (size_t i = 0; i < view->length; i++) {
+        if (view->data[i] != ' ') {
+            data[index++] = view->data[i];
+        }
+    }
+
+    result = ds_string_view_from_buffer(data, index);
+    
+    return result;
+}
+
+void ds_string_view_print(const ds_StringView *view) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return;
+    }
+
+    printf("%s\n", view->data);
+}
+
+const char* ds_string_view_get_data(const ds_StringView* view) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return NULL;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return NULL;
+    }
+
+    return view->data;
+} 
+
+uint32_t ds_string_view_get_length(const ds_StringView* view) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return -1;
+    }
+
+    return view->length;
+}
+
+/*  NOTE:
+ *  the number parsers take the whole view, no whitespace and no trailing
+ *  characters. on a syntax error they return 0, on overflow the closest
+ *  representable value, in both cases with success set to false.
+ */
+// all 8 bytes in '0'..'9'
+static inline bool ds_is_eight_digits(uint64_t chunk) {
+    return ((chunk & 0xf0f0f0f0f0f0f0f0ull)
+        | (((chunk + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// folds 8 ascii digits into their value with three multiplies
+static inline uint32_t ds_parse_eight_digits(uint64_t chunk) {
+    chunk -= 0x3030303030303030ull;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000ff000000ffull) * (100 + (1000000ull << 32)))
+        + (((chunk >> 16) & 0x000000ff000000ffull) * (1 + (10000ull << 32)))) >> 32;
+    return (uint32_t)chunk;
+}
+
+static inline bool ds_is_digit(char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+// consumes digits and accumulates them into value, wraps on overflow
+static const char* ds_accumulate_digits(const char* p, const char* end, uint64_t* value) {
+    uint64_t result = *value;
+
+    while (end - p >= 8) {
+        uint64_t chunk = ds_load_u64_le(p);
+        if (!ds_is_eight_digits(chunk)) break;
+        result = result * 100000000 + ds_parse_eight_digits(chunk);
+        p += 8;
+    }
+
+    while (p < end && ds_is_digit(*p)) {
+        result = result * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+
+    *value = result;
+    return p;
+}
+
+static DS_RESULT ds_parse_u64(const char* p, const char* end, uint64_t* value) {
+    *value = 0;
+    if (p == end) return DS_INVALID_INPUT;
+
+    // leading zeros dont count towards the 20 digits that fit
+    while (end - p > 1 && *p == '0') p++;
+
+    uint64_t result = 0;
+    const char* digits_end = ds_accumulate_digits(p, p + (end - p < 19 ? end - p : 19), &result);
+    size_t digits = digits_end - p;
+
+    if (digits_end != end) {
+        if (digits < 19 || !ds_is_digit(*digits_end)) return DS_INVALID_INPUT;
+
+        const char* tail = digits_end + 1;
+        while (tail < end && ds_is_digit(*tail)) tail++;
+        if (tail != end) return DS_INVALID_INPUT;
+
+        uint64_t last = (uint64_t)(*digits_end - '0');
+        if (tail - digits_end > 1 || result > (UINT64_MAX - last) / 10) {
+            *value = UINT64_MAX;
+            return DS_OVERFLOW;
+        }
+        result = result * 10 + last;
+    }
+
+    *value = result;
+    return DS_OK;
+}
+
+static DS_RESULT ds_parse_i64(const char* p, const char* end, int64_t* value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t magnitude;
+    DS_RESULT result = ds_parse_u64(p, end, &magnitude);
+    if (result == DS_INVALID_INPUT) {
+        *value = 0;
+        return result;
+    }
+
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    if (result == DS_OVERFLOW || magnitude > limit) {
+        *value = negative ? INT64_MIN : INT64_MAX;
+        return DS_OVERFLOW;
+    }
+
+    *value = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return DS_OK;
+}
+
+static inline bool ds_parse_check_view(const ds_StringView* view, bool* success) {
+    if (!view || !view->data) {
+        if (success) *success = false;
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input view is NULL");
+        return false;
+    }
+
+    return true;
+}
+
+static inline void ds_parse_report(DS_RESULT result, const ds_StringView* view, bool* success) {
+    if (success) *success = result == DS_OK;
+
+    if (result == DS_OVERFLOW) {
+        DS_SET_ERROR(DS_OVERFLOW, "Value %.*s is out of range", (int)view->length, view->data);
+    }
+    else if (result != DS_OK && result != DS_ALLOC_FAIL) { // allocation failures are reported where they happen
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input %.*s is not a number", (int)view->length, view->data);
+    }
+}
+
+int64_t ds_string_view_to_i64(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0;
+    }
+
+    int64_t value;
+    ds_parse_report(ds_parse_i64(view->data, view->data + view->length, &value), view, success);
+
+    return value;
+}
+
+uint64_t ds_string_view_to_u64(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0;
+    }
+
+    const char* p = view->data;
+    const char* end = p + view->length;
+    if (p < end && *p == '+') p++;
+
+    uint64_t value;
+    ds_parse_report(ds_parse_u64(p, end, &value), view, success);
+
+    return value;
+}
+
+int32_t ds_string_view_to_int(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0;
+    }
+
+    int64_t value;
+    DS_RESULT result = ds_parse_i64(view->data, view->data + view->length, &value);
+
+    if (value > INT32_MAX) {
+        value = INT32_MAX;
+        result = DS_OVERFLOW;
+    }
+    else if (value < INT32_MIN) {
+        value = INT32_MIN;
+        result = DS_OVERFLOW;
+    }
+
+    ds_parse_report(result, view, success);
+
+    return (int32_t)value;
+}
+
+uint64_t ds_string_view_to_hex(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0;
+    }
+
+    const char* p = view->data;
+    const char* end = p + view->length;
+    if (end - p >= 2 && p[0] == '0' && (p[1] | 0x20) == 'x') p += 2;
+
+    DS_RESULT result = p < end ? DS_OK : DS_INVALID_INPUT;
+    uint64_t value = 0;
+    size_t digits = 0;
+
+    for (; p < end; p++) {
+        uint32_t digit = (unsigned char)(*p - '0');
+        if (digit >= 10) {
+            digit = (unsigned char)((*p | 0x20) - 'a');
+            if (digit >= 6) {
+                result = DS_INVALID_INPUT;
+                break;
+            }
+            digit += 10;
+        }
+
+        if (digits || digit) digits++;
+        if (digits > 16) result = DS_OVERFLOW;
+        value = (value << 4) | digit;
+    }
+
+    if (result == DS_INVALID_INPUT) value = 0;
+    else if (result == DS_OVERFLOW) value = UINT64_MAX;
+
+    ds_parse_report(result, view, success);
+
+    return value;
+}
+
+static inline bool ds_ascii_equal_nocase(const char* data, const char* lower, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if ((data[i] | 0x20) != lower[i]) return false;
+    }
+
+    return true;
+}
+
+/*  NOTE:
+ *  Eisel-Lemire: multiply the normalized decimal mantissa with a 128 bit
+ *  approximation of 10^q and take the top 54 bits. when the truncated
+ *  product is too close to a rounding boundary it gives up and the
+ *  caller falls back to strtod.
+ */
+static bool ds_eisel_lemire(uint64_t mantissa, int64_t q, bool negative, double* out) {
+    uint64_t bits = 0;
+
+    if (mantissa == 0 || q < DS_POW10_MIN_EXPONENT) {
+        bits = 0;
+    }
+    else if (q > DS_POW10_MAX_EXPONENT) {
+        bits = 0x7ffull << DS_DOUBLE_MANTISSA_BITS;
+    }
+    else {
+        uint32_t shift = 63 - (ds_bit_length_u64(mantissa) - 1);
+        mantissa <<= shift;
+        uint64_t exponent = (uint64_t)((((int64_t)217706 * q) >> 16) + 64 + DS_DOUBLE_BIAS) - shift;
+
+        const uint64_t* power = ds_pow10_mantissa[q - DS_POW10_MIN_EXPONENT];
+        uint64_t high;
+        uint64_t low = ds_umul128(mantissa, power[1], &high);
+
+        // the lower 64 bits of the power only matter near a boundary
+        if ((high & 0x1ff) == 0x1ff && low + mantissa < mantissa) {
+            uint64_t y_high;
+            uint64_t y_low = ds_umul128(mantissa, power[0], &y_high);
+            uint64_t merged_high = high;
+            uint64_t merged_low = low + y_high;
+            if (merged_low < low) merged_high++;
+            if ((merged_high & 0x1ff) == 0x1ff && merged_low + 1 == 0 && y_low + mantissa < mantissa) {
+                return false;
+            }
+            high = merged_high;
+            low = merged_low;
+        }
+
+        uint64_t msb = high >> 63;
+        uint64_t result = high >> (msb + 9);
+        exponent -= 1 ^ msb;
+
+        // exactly halfway, cannot tell which way to round
+        if (low == 0 && (high & 0x1ff) == 0 && (result & 3) == 1) {
+            return false;
+        }
+
+        result += result & 1;
+        result >>= 1;
+        if (result >> 53) {
+            result >>= 1;
+            exponent++;
+        }
+
+        // subnormals, infinity and beyond take the slow path
+        if (exponent - 1 >= 0x7ff - 1) {
+            return false;
+        }
+
+        bits = exponent << DS_DOUBLE_MANTISSA_BITS | (result & ((1ull << DS_DOUBLE_MANTISSA_BITS) - 1));
+    }
+
+    if (negative) bits |= 1ull << 63;
+    memcpy(out, &bits, sizeof(*out));
+
+    return true;
+}
+
+static const double ds_exact_powers_of_ten[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/*  NOTE:
+ *  strtod reads the decimal point of the current locale, so a
+ *  process running under de_DE would stop at every '.'. the
+ *  fallback parses in a C locale created once, with strtod_l
+ *  where it is declared and a thread local uselocale otherwise
+ */
+#if defined(_WIN32)
+typedef _locale_t ds_Locale;
+#define ds_new_c_locale() _create_locale(LC_NUMERIC, "C")
+#define ds_free_locale(locale) _free_locale(locale)
+#else
+typedef locale_t ds_Locale;
+#define ds_new_c_locale() newlocale(LC_NUMERIC_MASK, "C", (locale_t)0)
+#define ds_free_locale(locale) freelocale(locale)
+#endif
+
+static _Atomic(ds_Locale) ds_c_locale = NULL;
+
+static ds_Locale ds_get_c_locale(void) {
+    ds_Locale locale = atomic_load_explicit(&ds_c_locale, memory_order_acquire);
+    if (locale) return locale;
+
+    ds_Locale created = ds_new_c_locale();
+    if (!created) return NULL;
+
+    // another thread may have been faster, its locale wins
+    if (!atomic_compare_exchange_strong_explicit(&ds_c_locale, &locale, created,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        ds_free_locale(created);
+        return locale;
+    }
+
+    return created;
+}
+
+static double ds_strtod_c(const char* string, ds_Locale locale) {
+#if defined(_WIN32)
+    return _strtod_l(string, NULL, locale);
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__USE_GNU)
+    return strtod_l(string, NULL, locale);
+#else
+    locale_t previous = uselocale(locale);
+    double value = strtod(string, NULL);
+    uselocale(previous);
+    return value;
+#endif
+}
+
+// NUL terminated copy for strtod
+static bool ds_parse_double_fallback(const char* data, size_t length, double* value) {
+    ds_Locale locale = ds_get_c_locale();
+    if (!locale) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to create the C locale");
+        return false;
+    }
+
+    char stack_buffer[128];
+    char* buffer = length < sizeof(stack_buffer)
+        ? stack_buffer
+        : (char*)ds_allocator_alloc(ds_global_allocator, length + 1);
+    if (!buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", length + 1);
+        return false;
+    }
+
+    memcpy(buffer, data, length);
+    buffer[length] = '\0';
+    *value = ds_strtod_c(buffer, locale);
+
+    if (buffer != stack_buffer) ds_allocator_free(ds_global_allocator, buffer, length + 1);
+
+    return true;
+}
+
+static DS_RESULT ds_parse_double(const char* start, const char* end, double* value) {
+    const char* p = start;
+    *value = 0.0;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    size_t rest = end - p;
+    if ((rest == 3 || rest == 8) && ds_ascii_equal_nocase(p, "infinity", rest)) {
+        *value = negative ? -HUGE_VAL : HUGE_VAL;
+        return DS_OK;
+    }
+    if (rest == 3 && ds_ascii_equal_nocase(p, "nan", 3)) {
+        *value = negative ? -NAN : NAN;
+        return DS_OK;
+    }
+
+    uint64_t mantissa = 0;
+    const char* integer_begin = p;
+    p = ds_accumulate_digits(p, end, &mantissa);
+    size_t integer_digits = p - integer_begin;
+
+    size_t fraction_digits = 0;
+    if (p < end && *p == '.') {
+        const char* fraction_begin = ++p;
+        p = ds_accumulate_digits(p, end, &mantissa);
+        fraction_digits = p - fraction_begin;
+    }
+    const char* digits_end = p;
+
+    if (integer_digits + fraction_digits == 0) return DS_INVALID_INPUT;
+
+    int64_t exponent = 0;
+    if (p < end && (*p | 0x20) == 'e') {
+        p++;
+        bool negative_exponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative_exponent = *p == '-';
+            p++;
+        }
+        if (p == end) return DS_INVALID_INPUT;
+
+        for (; p < end && ds_is_digit(*p); p++) {
+            // anything past this is zero or infinity anyway
+            if (exponent < 100000) exponent = exponent * 10 + (*p - '0');
+        }
+        if (negative_exponent) exponent = -exponent;
+    }
+
+    if (p != end) return DS_INVALID_INPUT;
+
+    // more than 19 digits wrapped the mantissa, redo it with the first 19 significant ones
+    bool truncated = false;
+    exponent -= (int64_t)fraction_digits;
+    if (integer_digits + fraction_digits > 19) {
+        mantissa = 0;
+        exponent += (int64_t)fraction_digits;
+
+        uint32_t taken = 0;
+        bool in_fraction = false;
+        const char* s = integer_begin;
+        for (; s < digits_end && taken < 19; s++) {
+            if (*s == '.') {
+                in_fraction = true;
+                continue;
+            }
+            if (in_fraction) exponent--;
+            if (taken == 0 && *s == '0') continue;
+            mantissa = mantissa * 10 + (uint64_t)(*s - '0');
+            taken++;
+        }
+
+        for (; s < digits_end; s++) {
+            if (*s == '.') in_fraction = true;
+            else if (!in_fraction) exponent++;
+            if (*s != '0' && *s != '.') truncated = true;
+        }
+    }
+
+    // both operands exact, so one rounding gives the correct result
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+    if (!truncated && exponent >= -22 && exponent <= 22 && mantissa <= (1ull << 53)) {
+        double result = (double)mantissa;
+        result = exponent < 0 ? result / ds_exact_powers_of_ten[-exponent] : result * ds_exact_powers_of_ten[exponent];
+        *value = negative ? -result : result;
+        return DS_OK;
+    }
+#endif
+
+    double result;
+    bool done = ds_eisel_lemire(mantissa, exponent, negative, &result);
+
+    // the dropped digits only matter if they push the value into the next double
+    if (done && truncated) {
+        double upper;
+        done = ds_eisel_lemire(mantissa + 1, exponent, negative, &upper) && upper == result;
+    }
+
+    if (!done && !ds_parse_double_fallback(start, end - start, &result)) {
+        return DS_ALLOC_FAIL;
+    }
+
+    *value = result;
+    return isinf(result) ? DS_OVERFLOW : DS_OK;
+}
+
+double ds_string_view_to_double(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0.0;
+    }
+
+    double value;
+    ds_parse_report(ds_parse_double(view->data, view->data + view->length, &value), view, success);
+
+    return value;
+}
+
+static inline void ds_split_iter_start(ds_SplitIter* iter, const ds_StringView* view, uint32_t kind, uint32_t flags) {
+    iter->rest = *view;
+    iter->kind = kind;
+    iter->flags = flags;
+    iter->done = false;
+}
+
+size_t ds_split_iter_init_char(ds_SplitIter* iter, const ds_StringView* view, char delimiter, uint32_t flags) {
+    if (!iter || !view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or view is NULL or has no data");
+        return -1;
+    }
+
+    ds_split_iter_start(iter, view, DS_SPLIT_ON_CHAR, flags);
+    iter->delimiter.c = delimiter;
+
+    return 0;
+}
+
+size_t ds_split_iter_init_string(ds_SplitIter* iter, const ds_StringView* view, const ds_StringView* delimiter, uint32_t flags) {
+    if (!iter || !view || !view->data || !delimiter) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator, view or delimiter is NULL");
+        return -1;
+    }
+
+    if (delimiter->length == 0) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Delimiter is empty");
+        return -1;
+    }
+
+    if (ds_searcher_init(&iter->delimiter.searcher, delimiter) != 0) {
+        return -1;
+    }
+
+    ds_split_iter_start(iter, view, DS_SPLIT_ON_STRING, flags);
+
+    return 0;
+}
+
+size_t ds_split_iter_init_set(ds_SplitIter* iter, const ds_StringView* view, const ds_ByteSet* delimiters, uint32_t flags) {
+    if (!iter || !view || !view->data || !delimiters) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator, view or delimiters are NULL");
+        return -1;
+    }
+
+    ds_split_iter_start(iter, view, DS_SPLIT_ON_SET, flags);
+    iter->delimiter.set = *delimiters;
+
+    return 0;
+}
+
+bool ds_split_iter_next(ds_SplitIter* iter, ds_StringView* token) {
+    if (!iter || !token) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or token is NULL");
+        return false;
+    }
+
+    while (!iter->done) {
+        const char* data = iter->rest.data;
+        size_t length = iter->rest.length;
+        const char* found;
+        size_t delimiter_length = 1;
+
+        switch (iter->kind) {
+            case DS_SPLIT_ON_CHAR:
+                found = ds_find_byte(data, length, iter->delimiter.c);
+                break;
+            case DS_SPLIT_ON_SET:
+                found = ds_find_in_byte_set(data, length, &iter->delimiter.set, true);
+                break;
+            default:
+                found = ds_searcher_search(&iter->delimiter.searcher, data, length);
+                delimiter_length = iter->delimiter.searcher.needle.length;
+                break;
+        }
+
+        ds_StringView next = { data, (uint32_t)(found ? (size_t)(found - data) : length) };
+        if (found) {
+            iter->rest.data = found + delimiter_length;
+            iter->rest.length = (uint32_t)(length - next.length - delimiter_length);
+        }
+        else {
+            iter->rest.data = data + length;
+            iter->rest.length = 0;
+            iter->done = true;
+        }
+
+        if (next.length > 0 || !(iter->flags & DS_SPLIT_SKIP_EMPTY)) {
+            *token = next;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// drains the iterator, a copy counts the tokens first so the array is allocated once at its exact size
+static ds_StringViewArray* ds_split_iter_collect_into(const ds_Allocator* allocator, ds_SplitIter* iter) {
+    ds_SplitIter counter = *iter;
+    ds_StringView token;
+
+    uint32_t count = 0;
+    while (ds_split_iter_next(&counter, &token)) count++;
+
+    // views live right behind the array header so one allocation is enough
+    size_t size = sizeof(ds_StringViewArray) + count * sizeof(ds_StringView);
+    ds_StringViewArray* array = (ds_StringViewArray*)ds_allocator_alloc(allocator, size);
+    if (!array) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string view array failed");
+        return NULL;
+    }
+
+    array->views = (ds_StringView*)(array + 1);
+    array->count = 0;
+    array->capacity = count;
+    array->allocator = allocator;
+
+    while (array->count < count && ds_split_iter_next(iter, &token)) {
+        array->views[array->count++] = token;
+    }
+
+    return array;
+}
+
+ds_StringViewArray* ds_split_iter_collect(ds_SplitIter* iter) {
+    if (!iter) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input iterator is NULL");
+        return NULL;
+    }
+
+    return ds_split_iter_collect_into(ds_global_allocator, iter);
+}
+
+void ds_small_view_array_init(ds_SmallViewArray* array) {
+    ds_small_view_array_init_allocator(array, ds_global_allocator);
+}
+
+void ds_small_view_array_init_allocator(ds_SmallViewArray* array, const ds_Allocator* allocator) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return;
+    }
+
+    array->count = 0;
+    array->capacity = DS_STACK_CAPACITY;
+    array->allocator = allocator;
+}
+
+void ds_small_view_array_deinit(ds_SmallViewArray* array) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return;
+    }
+
+    if (ds_small_view_array_is_heap(array)) {
+        ds_allocator_free(array->allocator, array->heap_views, array->capacity * sizeof(ds_StringView));
+    }
+
+    array->count = 0;
+    array->capacity = DS_STACK_CAPACITY;
+}
+
+size_t ds_small_view_array_reserve(ds_SmallViewArray* array, size_t capacity) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return -1;
+    }
+
+    size_t current = ds_small_view_array_is_heap(array) ? array->capacity : DS_SMALL_VIEW_ARRAY_CAPACITY;
+    if (capacity <= current) {
+        return 0;
+    }
+
+    if (capacity > UINT32_MAX) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested capacity %zu is to big", capacity);
+        return -1;
+    }
+
+    ds_StringView* views;
+    if (ds_small_view_array_is_heap(array)) {
+        views = (ds_StringView*)ds_allocator_realloc(array->allocator, array->heap_views,
+                array->capacity * sizeof(ds_StringView), capacity * sizeof(ds_StringView));
+    }
+    else {
+        views = (ds_StringView*)ds_allocator_alloc(array->allocator, capacity * sizeof(ds_StringView));
+        if (views) memcpy(views, array->inline_views, array->count * sizeof(ds_StringView));
+    }
+
+    if (!views) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "View array allocation failed");
+        return -1;
+    }
+
+    array->heap_views = views;
+    array->capacity = (uint32_t)capacity;
+
+    return 0;
+}
+
+size_t ds_small_view_array_push(ds_SmallViewArray* array, const ds_StringView* view) {
+    if (!array || !view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array or view is NULL");
+        return -1;
+    }
+
+    size_t capacity = ds_small_view_array_is_heap(array) ? array->capacity : DS_SMALL_VIEW_ARRAY_CAPACITY;
+    if (array->count == capacity) {
+        double grown = (double)capacity * ds_growth_factor;
+        if (grown > UINT32_MAX) grown = UINT32_MAX;
+        if (ds_small_view_array_reserve(array, (size_t)grown > capacity ? (size_t)grown : capacity + 1) != 0) {
+            return -1;
+        }
+    }
+
+    ds_small_view_array_data(array)[array->count++] = *view;
+
+    return 0;
+}
+
+void ds_small_view_array_clear(ds_SmallViewArray* array) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return;
+    }
+
+    array->count = 0;
+}
+
+size_t ds_split_iter_append(ds_SplitIter* iter, ds_SmallViewArray* array) {
+    if (!iter || !array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input iterator or array is NULL");
+        return -1;
+    }
+
+    ds_StringView token;
+    while (ds_split_iter_next(iter, &token)) {
+        if (ds_small_view_array_push(array, &token) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static ds_StringViewArray* ds_string_view_split_into(const ds_Allocator* allocator, const ds_StringView* view, char split) {
+    ds_SplitIter iter;
+    if (ds_split_iter_init_char(&iter, view, split, 0) != 0) {
+        return NULL;
+    }
+
+    return ds_split_iter_collect_into(allocator, &iter);
+}
+
+ds_StringViewArray* ds_string_view_split(const ds_StringView* view, char split) {
+    return ds_string_view_split_into(ds_global_allocator, view, split);
+}
+
+void ds_free_string_view_array(ds_StringViewArray* array) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return;
+    }
+
+    if (array->views != (ds_StringView*)(array + 1)) {
+        ds_allocator_free(array->allocator, array->views, array->capacity * sizeof(ds_StringView));
+        ds_allocator_free(array->allocator, array, sizeof(ds_StringViewArray));
+    }
+    else {
+        ds_allocator_free(array->allocator, array, sizeof(ds_StringViewArray) + array->capacity * sizeof(ds_StringView));
+    }
+}
+
+/*  NOTE:
+ *  swiss table. every slot has a control byte that is EMPTY, DELETED
+ *  or the low 7 bits of the hash, and a probe compares a whole group
+ *  of 16 control bytes at once. the full hash, the length and the
+ *  first 4 bytes of the key sit next to the key pointer, so the key
+ *  itself is only read when all of them agree. groups are aligned and
+ *  visited in triangular order, which reaches every group of a power
+ *  of two table. the hash is ds_string_view_hash with seed 0, so
+ *  ds_String keys reuse their cached hash.
+ */
+#define DS_MAP_GROUP 16
+#define DS_MAP_EMPTY ((uint8_t)0x80)
+#define DS_MAP_DELETED ((uint8_t)0xfe)
+
+typedef struct {
+    uint64_t hash;
+    uint32_t length;
+    uint32_t prefix; // first 4 bytes of the key, zero padded
+    char* key; // NUL terminated copy owned by the map
+    void* value;
+} ds_MapEntry;
+
+struct ds_Map {
+    const ds_Allocator* allocator;
+    ds_MapEntry* entries;
+    uint8_t* control; // capacity bytes right after the entries, same allocation
+    size_t capacity;
+    size_t count;
+    size_t deleted;
+};
+
+// one bit per control byte of the group that equals tag
+static inline uint32_t ds_map_group_match(const uint8_t* control, uint8_t tag) {
+#if defined(DS_SIMD_SSE2)
+    return ds_match_mask16((const char*)control, _mm_set1_epi8((char)tag));
+#else
+    uint64_t pattern = ds_broadcast_byte((char)tag);
+    uint64_t low = ds_zero_byte_mask(ds_load_u64_le((const char*)control) ^ pattern) >> 7;
+    uint64_t high = ds_zero_byte_mask(ds_load_u64_le((const char*)control + 8) ^ pattern) >> 7;
+    return (uint32_t)((low * 0x0102040810204080ull) >> 56) | (uint32_t)((high * 0x0102040810204080ull) >> 56) << 8;
+#endif
+}
+
+// EMPTY and DELETED are the only control bytes with the high bit set
+static inline uint32_t ds_map_group_free(const uint8_t* control) {
+#if defined(DS_SIMD_SSE2)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)control));
+#else
+    uint64_t low = (ds_load_u64_le((const char*)control) & 0x8080808080808080ull) >> 7;
+    uint64_t high = (ds_load_u64_le((const char*)control + 8) & 0x8080808080808080ull) >> 7;
+    return (uint32_t)((low * 0x0102040810204080ull) >> 56) | (uint32_t)((high * 0x0102040810204080ull) >> 56) << 8;
+#endif
+}
+
+static inline uint32_t ds_map_prefix(const char* key, size_t length) {
+    uint32_t prefix = 0;
+    if (length > 0) memcpy(&prefix, key, length < sizeof(prefix) ? length : sizeof(prefix));
+    return prefix;
+}
+
+static inline size_t ds_map_table_size(size_t capacity) {
+    return capacity * (sizeof(ds_MapEntry) + 1);
+}
+
+static ds_MapEntry* ds_map_find(const ds_Map* map, const char* key, size_t length, uint64_t hash) {
+    if (map->capacity == 0) return NULL;
+
+    size_t group_mask = map->capacity / DS_MAP_GROUP - 1;
+    size_t group = (size_t)(hash >> 7) & group_mask;
+    uint8_t tag = (uint8_t)(hash & 0x7f);
+    uint32_t prefix = ds_map_prefix(key, length);
+
+    for (size_t step = 1;; step++) {
+        const uint8_t* control = map->control + group * DS_MAP_GROUP;
+
+        for (uint32_t match = ds_map_group_match(control, tag); match; match &= match - 1) {
+            ds_MapEntry* entry = &map->entries[group * DS_MAP_GROUP + ds_count_trailing_zeros(match)];
+            if (entry->hash == hash && entry->length == length && entry->prefix == prefix
+                && ds_mismatch(entry->key, key, length) == length) {
+                return entry;
+            }
+        }
+
+        // a group with an empty slot was never full, so the key cant be further along
+        if (ds_map_group_match(control, DS_MAP_EMPTY)) return NULL;
+
+        group = (group + step) & group_mask;
+    }
+}
+
+// the load limit keeps at least one slot in eight free, so this always ends
+static size_t ds_map_free_slot(const ds_Map* map, uint64_t hash) {
+    size_t group_mask = map->capacity / DS_MAP_GROUP - 1;
+    size_t group = (size_t)(hash >> 7) & group_mask;
+
+    for (size_t step = 1;; step++) {
+        uint32_t free_slots = ds_map_group_free(map->control + group * DS_MAP_GROUP);
+        if (free_slots) return group * DS_MAP_GROUP + ds_count_trailing_zeros(free_slots);
+
+        group = (group + step) & group_mask;
+    }
+}
+
+// moves every entry into a fresh table by its stored hash, this also drops the tombstones
+static size_t ds_map_rehash(ds_Map* map, size_t capacity) {
+    ds_MapEntry* entries = (ds_MapEntry*)ds_allocator_alloc(map->allocator, ds_map_table_size(capacity));
+    if (!entries) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", ds_map_table_size(capacity));
+        return -1;
+    }
+
+    ds_MapEntry* old_entries = map->entries;
+    uint8_t* old_control = map->control;
+    size_t old_capacity = map->capacity;
+
+    map->entries = entries;
+    map->control = (uint8_t*)(entries + capacity);
+    map->capacity = capacity;
+    map->deleted = 0;
+    memset(map->control, DS_MAP_EMPTY, capacity);
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_control[i] & 0x80) continue;
+
+        size_t slot = ds_map_free_slot(map, old_entries[i].hash);
+        map->control[slot] = old_control[i];
+        map->entries[slot] = old_entries[i];
+    }
+
+    if (old_entries) {
+        ds_allocator_free(map->allocator, old_entries, ds_map_table_size(old_capacity));
+    }
+
+    return 0;
+}
+
+// smallest table that holds count entries under the 7/8 load limit
+static size_t ds_map_capacity_for(size_t count) {
+    size_t capacity = DS_MAP_GROUP;
+    while (capacity / 8 * 7 < count) capacity *= 2;
+    return capacity;
+}
+
+static size_t ds_map_insert_hashed(ds_Map* map, const char* key, size_t length, uint64_t hash, void* value) {
+    ds_MapEntry* entry = ds_map_find(map, key, length, hash);
+    if (entry) {
+        entry->value = value;
+        return 0;
+    }
+
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Key length %zu is to big", length);
+        return -1;
+    }
+
+    if (map->count + map->deleted >= map->capacity / 8 * 7) {
+        // mostly tombstones, rehashing at the same size is enough
+        size_t capacity = ds_map_capacity_for(map->count + 1);
+        if (capacity < map->capacity) capacity = map->capacity;
+        if (ds_map_rehash(map, capacity) != 0) {
+            return -1;
+        }
+    }
+
+    char* copy = (char*)ds_allocator_alloc(map->allocator, length + 1);
+    if (!copy) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", length + 1);
+        return -1;
+    }
+    if (length > 0) memcpy(copy, key, length);
+    copy[length] = '\0';
+
+    size_t slot = ds_map_free_slot(map, hash);
+    if (map->control[slot] == DS_MAP_DELETED) map->deleted--;
+
+    map->control[slot] = (uint8_t)(hash & 0x7f);
+    map->entries[slot].hash = hash;
+    map->entries[slot].length = (uint32_t)length;
+    map->entries[slot].prefix = ds_map_prefix(key, length);
+    map->entries[slot].key = copy;
+    map->entries[slot].value = value;
+    map->count++;
+
+    return 0;
+}
+
+ds_Map* ds_init_map(void) {
+    return ds_init_map_allocator(ds_global_allocator);
+}
+
+ds_Map* ds_init_map_allocator(const ds_Allocator* allocator) {
+    ds_Map* map = (ds_Map*)ds_allocator_alloc(allocator, sizeof(ds_Map));
+    if (!map) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", sizeof(ds_Map));
+        return NULL;
+    }
+
+    map->allocator = allocator;
+    map->entries = NULL;
+    map->control = NULL;
+    map->capacity = 0;
+    map->count = 0;
+    map->deleted = 0;
 
-char ds_pop(ds_String* string) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+    return map;
+}
+
+void ds_free_map(ds_Map* map) {
+    if (!map) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map is NULL");
+        return;
     }
-    
-    if (string->length == 0) {
-        DS_SET_ERROR(DS_INVALID_LENGTH, "Length of the string going under 0");
-        return -1;
+
+    ds_map_clear(map);
+    if (map->entries) {
+        ds_allocator_free(map->allocator, map->entries, ds_map_table_size(map->capacity));
     }
-    
-    char c = -1;
+    ds_allocator_free(map->allocator, map, sizeof(ds_Map));
+}
 
-    if (ds_is_stack(string)) {
-        c = string->stack_data[string->length - 1];
-        string->stack_data[string->length - 1] = '\0';
-        string->length--;
+void ds_map_clear(ds_Map* map) {
+    if (!map) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map is NULL");
+        return;
     }
-    else if (ds_has_valid_heap_data(string) && ds_has_sticky_heap(string)) {
-        c = string->heap_data[string->length - 1];
-        string->heap_data[string->length - 1] = '\0';
-        string->length--;
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->control[i] & 0x80) continue;
+        ds_allocator_free(map->allocator, map->entries[i].key, map->entries[i].length + 1);
     }
-    else if (ds_has_valid_heap_data(string)) {
-        c = string->heap_data[string->length - 1];
 
-        if (string->length <= DS_SMALL_STRING_CAPACITY) {
-            char* heap_buffer = string->heap_data;
-            memcpy(string->stack_data, heap_buffer, string->length);
-            string->stack_data[string->length - 1] = '\0';
-        }
-        else {
-            string->heap_data[string->length - 1] = '\0';
-        }
+    if (map->capacity > 0) memset(map->control, DS_MAP_EMPTY, map->capacity);
+    map->count = 0;
+    map->deleted = 0;
+}
 
-        string->length--;
+size_t ds_map_count(const ds_Map* map) {
+    if (!map) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map is NULL");
+        return 0;
     }
 
-    return c;
-
+    return map->count;
 }
 
-size_t ds_pop_n(ds_String* string, size_t n) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input String is NULL");
+size_t ds_map_reserve(ds_Map* map, size_t count) {
+    if (!map) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map is NULL");
         return -1;
     }
 
-    if (((int32_t)string->length) - (int32_t)n < 0) {
-        DS_SET_ERROR(DS_INVALID_LENGTH, "Length - n < 0");
+    size_t capacity = ds_map_capacity_for(count);
+    if (capacity <= map->capacity) return 0;
+
+    return ds_map_rehash(map, capacity);
+}
+
+size_t ds_map_insert(ds_Map* map, ds_String* key, void* value) {
+    if (!map || !key) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
         return -1;
     }
 
-    // move to stack
-    if ((ds_is_heap(string) && string->length <= DS_SMALL_STRING_CAPACITY && !ds_has_sticky_heap(string))
-            || ds_is_stack(string)) {
-        string->length -= n;
-        
-        if (ds_is_heap(string)) {
-            string->heap_data[string->length] = '\0';
-            ds_move_dsstring_to_stack(string);
-        }
-        else {
-            string->stack_data[string->length] = '\0';
-        }
-    }
-    else {
-        string->length -= n;
-        string->heap_data[string->length] = '\0';
-    }
-    
-    return 0;
+    return ds_map_insert_hashed(map, ds_data(key), ds_length(key), ds_string_hash(key), value);
 }
 
-size_t ds_reserve(ds_String *string, size_t n) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+size_t ds_map_insert_view(ds_Map* map, const ds_StringView* key, void* value) {
+    if (!map || !key || !key->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
         return -1;
     }
-        
-    if (ds_is_stack(string)) {
-        ds_move_dstring_to_heap(string);
+
+    return ds_map_insert_hashed(map, key->data, key->length, ds_string_view_hash(key, 0), value);
+}
+
+void** ds_map_get(const ds_Map* map, const ds_StringView* key) {
+    if (!map || !key || !key->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return NULL;
     }
 
-    char* heap_buffer = (char*)realloc(string->heap_data, string->capacity + n);
-    if (!heap_buffer) {
-        DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
-        return -1;
+    ds_MapEntry* entry = ds_map_find(map, key->data, key->length, ds_string_view_hash(key, 0));
+    return entry ? &entry->value : NULL;
+}
+
+void** ds_map_get_cstr(const ds_Map* map, const char* key) {
+    if (!map || !key) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return NULL;
     }
 
-    string->heap_data = heap_buffer;
-    string->capacity += n;
+    size_t length = strlen(key);
+    ds_MapEntry* entry = ds_map_find(map, key, length, ds_hash_bytes(key, length, 0));
+    return entry ? &entry->value : NULL;
+}
 
-    return 0;
+void** ds_map_get_string(const ds_Map* map, ds_String* key) {
+    if (!map || !key) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return NULL;
+    }
+
+    ds_MapEntry* entry = ds_map_find(map, ds_data(key), ds_length(key), ds_string_hash(key));
+    return entry ? &entry->value : NULL;
 }
 
-size_t ds_clear(ds_String* string) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+bool ds_map_remove(ds_Map* map, const ds_StringView* key) {
+    if (!map || !key || !key->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return false;
     }
 
-    if (ds_is_stack(string)) {
-        string->stack_data[0] = '\0';
+    ds_MapEntry* entry = ds_map_find(map, key->data, key->length, ds_string_view_hash(key, 0));
+    if (!entry) return false;
+
+    size_t slot = (size_t)(entry - map->entries);
+    ds_allocator_free(map->allocator, entry->key, entry->length + 1);
+
+    // probes stop at a group with an empty slot, so only a full group needs a tombstone
+    if (ds_map_group_match(map->control + (slot & ~(size_t)(DS_MAP_GROUP - 1)), DS_MAP_EMPTY)) {
+        map->control[slot] = DS_MAP_EMPTY;
     }
     else {
-        string->heap_data[0] = '\0';
+        map->control[slot] = DS_MAP_DELETED;
+        map->deleted++;
     }
+    map->count--;
 
-    string->length = 0;
-
-    return 0;
+    return true;
 }
 
-bool ds_equal(ds_String* string0, ds_String* string1) {
-    if (!string0 || !string1) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+bool ds_map_next(const ds_Map* map, size_t* cursor, ds_StringView* key, void** value) {
+    if (!map || !cursor) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or cursor is NULL");
         return false;
     }
 
-    if (string0->length != string1->length) {
-        return false;
-    }
+    for (size_t i = *cursor; i < map->capacity; i++) {
+        if (map->control[i] & 0x80) continue;
 
-    if (ds_is_stack(string0) && ds_is_stack(string1)) {
-        for (int i = 0; i < string0->length; i++) {
-            if (string0->stack_data[i] != string1->stack_data[i]) return false;
-        }
+        if (key) *key = ds_string_view_from_buffer(map->entries[i].key, map->entries[i].length);
+        if (value) *value = map->entries[i].value;
+        *cursor = i + 1;
         return true;
     }
 
-    else if (ds_is_stack(string0) && ds_is_heap(string1)) {
-        for (int i = 0; i < string0->length; i++) {
-            if (string0->stack_data[i] != string1->heap_data[i]) return false;
-        }
-        return true;
-    }
+    *cursor = map->capacity;
+    return false;
+}
 
-    else if (ds_is_heap(string0) && ds_is_stack(string1)) {
-        for (int i = 0; i < string0->length; i++) {
-            if (string0->heap_data[i] != string1->stack_data[i]) return false;
-        }
-        return true;
+/*  NOTE:
+ *  the intern table is split into DS_INTERN_SHARDS shards by the top
+ *  bits of the hash. lookups of strings that are already interned take
+ *  no lock: slots only ever go from NULL to a finished entry, and a
+ *  grown table is published whole while the old one stays alive until
+ *  the intern table is freed, so a reader never sees freed memory.
+ *  inserts take the shard lock and re-probe. ids are handed out from
+ *  one counter and resolve through segments that double in size, so
+ *  they never move either.
+ */
+#define DS_INTERN_SHARD_BITS 6
+#define DS_INTERN_SHARDS (1u << DS_INTERN_SHARD_BITS)
+#define DS_INTERN_MIN_SLOTS 64
+#define DS_INTERN_SEGMENT_BITS 10
+#define DS_INTERN_SEGMENTS (32 - DS_INTERN_SEGMENT_BITS + 1)
+
+// the string has to come first, ds_intern_id casts back to the entry
+typedef struct {
+    ds_String string;
+    uint64_t hash;
+    const char* data;
+    uint32_t length;
+    uint32_t id;
+} ds_InternEntry;
+
+typedef struct ds_InternSlots ds_InternSlots;
+struct ds_InternSlots {
+    ds_InternSlots* retired; // the smaller tables this one replaced
+    size_t capacity;
+    _Atomic(ds_InternEntry*) slots[];
+};
+
+typedef struct {
+    atomic_int locked;
+    _Atomic(ds_InternSlots*) slots;
+    size_t count;
+    ds_Arena* arena; // entries never move or die before the table
+    char padding[32]; // keeps the hot fields of neighbouring shards apart
+} ds_InternShard;
+
+struct ds_InternTable {
+    ds_InternShard shards[DS_INTERN_SHARDS];
+    atomic_uint next_id;
+    _Atomic(ds_InternEntry**) segments[DS_INTERN_SEGMENTS];
+    const ds_Allocator* allocator; // slots, segments and the table itself, the default table uses malloc
+};
+
+static ds_InternTable ds_default_intern_table;
+
+static inline void ds_cpu_relax(void) {
+#if defined(DS_SIMD_SSE2)
+    _mm_pause();
+#endif
+}
+
+// the critical sections are a probe and maybe one allocation, a spin lock is enough
+static void ds_intern_lock(ds_InternShard* shard) {
+    for (;;) {
+        if (!atomic_exchange_explicit(&shard->locked, 1, memory_order_acquire)) return;
+        while (atomic_load_explicit(&shard->locked, memory_order_relaxed)) ds_cpu_relax();
     }
+}
 
-    else if (ds_is_heap(string0) && ds_is_heap(string1)) {
-        for (int i = 0; i < string0->length; i++) {
-            if (string0->heap_data[i] != string1->heap_data[i]) return false;
-        }
-        return true;
+static void ds_intern_unlock(ds_InternShard* shard) {
+    atomic_store_explicit(&shard->locked, 0, memory_order_release);
+}
+
+// segment 0 holds the first 2^DS_INTERN_SEGMENT_BITS ids, every later one as many as all before it
+static inline uint32_t ds_intern_segment(uint32_t id, uint32_t* offset, uint32_t* size) {
+    uint32_t block = id >> DS_INTERN_SEGMENT_BITS;
+    if (block == 0) {
+        *offset = id;
+        *size = 1u << DS_INTERN_SEGMENT_BITS;
+        return 0;
     }
-    
-    DS_SET_ERROR(DS_REACHED_UNINTENTIONAL_CONTROL_BLOCK, "Reached unententionally end of a function");
-    return false;
+
+    uint32_t segment = ds_bit_length_u64(block);
+    *size = (1u << DS_INTERN_SEGMENT_BITS) << (segment - 1);
+    *offset = id - *size;
+    return segment;
 }
 
-size_t ds_set(ds_String* string, const char* literal) {
-    if (!string || !literal) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+static ds_InternEntry** ds_intern_segment_entries(ds_InternTable* table, uint32_t segment, uint32_t size) {
+    ds_InternEntry** entries = atomic_load_explicit(&table->segments[segment], memory_order_acquire);
+    if (entries) return entries;
+
+    size_t bytes = (size_t)size * sizeof(ds_InternEntry*);
+    ds_InternEntry** fresh = (ds_InternEntry**)ds_allocator_alloc(table->allocator, bytes);
+    if (!fresh) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", bytes);
+        return NULL;
     }
+    memset(fresh, 0, bytes);
 
-    size_t lit_length = strlen(literal);
+    // shards race for the same segment, the loser frees its copy
+    if (!atomic_compare_exchange_strong_explicit(&table->segments[segment], &entries, fresh,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        ds_allocator_free(table->allocator, fresh, bytes);
+        return entries;
+    }
+
+    return fresh;
+}
 
-    if (lit_length <= DS_SMALL_STRING_CAPACITY) {
-        // move to stack
-        if (ds_is_heap(string) && !ds_has_sticky_heap(string)) {
-            free(string->heap_data);
-            string->heap_data = NULL;
-            ds_set_is_stack(string);
-            string->capacity = DS_STACK_CAPACITY;
+/*  NOTE:
+ *  an id is only taken once its segment exists, so publishing
+ *  it cant fail and every id below next_id resolves. the counter
+ *  stops at UINT32_MAX, which ds_intern_id uses as the error value
+ */
+static size_t ds_intern_take_id(ds_InternTable* table, ds_InternEntry* entry) {
+    uint32_t id = atomic_load_explicit(&table->next_id, memory_order_relaxed);
+    uint32_t offset, size, segment;
+    ds_InternEntry** entries;
+
+    do {
+        if (id == UINT32_MAX) {
+            DS_SET_ERROR(DS_OVERFLOW, "Intern table ran out of ids");
+            return -1;
         }
-        memcpy(string->stack_data, literal, lit_length + 1);
-    }
-    else {
-        if (ds_is_stack(string)) {
-            ds_move_dstring_to_heap(string);
+
+        segment = ds_intern_segment(id, &offset, &size);
+        entries = ds_intern_segment_entries(table, segment, size);
+        if (!entries) return -1;
+    } while (!atomic_compare_exchange_weak_explicit(&table->next_id, &id, id + 1,
+                                                    memory_order_relaxed, memory_order_relaxed));
+
+    entry->id = id;
+    _Atomic(ds_InternEntry*)* slot = (_Atomic(ds_InternEntry*)*)&entries[offset];
+    atomic_store_explicit(slot, entry, memory_order_release);
+
+    return 0;
+}
+
+// the entry with this content, or NULL and the empty slot it would go into
+static ds_InternEntry* ds_intern_probe(ds_InternSlots* slots, const char* data, size_t length, uint64_t hash, size_t* empty) {
+    size_t mask = slots->capacity - 1;
+
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+        ds_InternEntry* entry = atomic_load_explicit(&slots->slots[i], memory_order_acquire);
+        if (!entry) {
+            if (empty) *empty = i;
+            return NULL;
         }
 
-        while (string->capacity <= lit_length + 1) {
-            string->capacity *= 2;
-            char* heap_buffer = (char*)realloc(string->heap_data, string->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
-                return -1;
-            }
-            string->heap_data = heap_buffer;
+        if (entry->hash == hash && entry->length == length && ds_mismatch(entry->data, data, length) == length) {
+            return entry;
         }
-        memcpy(string->heap_data, literal, lit_length + 1);
     }
-    
-    string->length = lit_length; 
+}
 
-    return 0;
+// called with the shard lock held, readers keep using the old slots until the new ones are published
+static inline size_t ds_intern_slots_size(size_t capacity) {
+    return sizeof(ds_InternSlots) + capacity * sizeof(ds_InternEntry*);
 }
 
-/*  NOTE:
- *  this function can ignore flags of
- *  the string because it is cloning the 
- *  argument string with its flags
- */
-size_t ds_clone(ds_String* string, ds_String* clone) {
-    if (!string || !clone) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+static ds_InternSlots* ds_intern_grow(ds_InternTable* table, ds_InternShard* shard, ds_InternSlots* old) {
+    size_t capacity = old ? old->capacity * 2 : DS_INTERN_MIN_SLOTS;
+    ds_InternSlots* slots = (ds_InternSlots*)ds_allocator_alloc(table->allocator, ds_intern_slots_size(capacity));
+    if (!slots) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", ds_intern_slots_size(capacity));
+        return NULL;
     }
+    memset(slots, 0, ds_intern_slots_size(capacity));
+
+    slots->retired = old;
+    slots->capacity = capacity;
 
-    if (ds_is_stack(string) && ds_is_stack(clone)) {
-        memcpy(string->stack_data, clone->stack_data, clone->length + 1);
+    for (size_t i = 0; old && i < old->capacity; i++) {
+        ds_InternEntry* entry = atomic_load_explicit(&old->slots[i], memory_order_relaxed);
+        if (!entry) continue;
+
+        size_t j = (size_t)entry->hash & (capacity - 1);
+        while (atomic_load_explicit(&slots->slots[j], memory_order_relaxed)) j = (j + 1) & (capacity - 1);
+        atomic_store_explicit(&slots->slots[j], entry, memory_order_relaxed);
     }
-    else if (ds_is_stack(string) && ds_is_heap(clone)) {
-        ds_move_dstring_to_heap(string);
-        if (string->capacity != clone->capacity) {
-            char* heap_buffer = (char*)realloc(string->heap_data, clone->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
-                return -1;
-            }
-            string->heap_data = heap_buffer;
-            string->capacity = clone->capacity;
-        }
-        memcpy(string->heap_data, clone->heap_data, clone->length + 1);
+
+    atomic_store_explicit(&shard->slots, slots, memory_order_release);
+
+    return slots;
+}
+
+static ds_InternEntry* ds_intern_new_entry(ds_InternShard* shard, const ds_StringView* view, uint64_t hash) {
+    if (!shard->arena) {
+        shard->arena = ds_init_arena(0);
+        if (!shard->arena) return NULL;
     }
-    else if (ds_is_heap(string) && ds_is_stack(clone)) {
-        ds_clear(string);
-        ds_move_dsstring_to_stack(string);
-        memcpy(string->stack_data, clone->stack_data, clone->length + 1);
-    }
-    else if (ds_is_heap(string) && ds_is_heap(clone)) {
-        if (string->capacity != clone->capacity) {
-            char* heap_buffer = (char*)realloc(string->heap_data, clone->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
-                return -1;
-            }
-            string->heap_data = heap_buffer;
-            string->capacity = clone->capacity;
-        }
-        memcpy(string->heap_data, clone->heap_data, clone->length + 1);
+
+    size_t size = sizeof(ds_InternEntry);
+    if (view->length > DS_SMALL_STRING_CAPACITY) size += view->length + 1;
+
+    ds_InternEntry* entry = (ds_InternEntry*)ds_arena_alloc(shard->arena, size);
+    if (!entry) return NULL;
+
+    ds_string_reset(&entry->string);
+    if (view->length <= DS_SMALL_STRING_CAPACITY) {
+        memcpy(entry->string.stack_data, view->data, view->length);
+        entry->string.stack_data[view->length] = '\0';
+        ds_set_length(&entry->string, view->length);
+    }
+    else {
+        char* data = (char*)(entry + 1);
+        memcpy(data, view->data, view->length);
+        data[view->length] = '\0';
+        // the bytes live in the shard arena, clones borrow them and writes copy them out
+        ds_string_set_borrowed_buffer(&entry->string, data, view->length, view->length + 1);
     }
+    ds_string_cache_hash(&entry->string, hash);
 
-    string->length = clone->length;
-    string->flags = clone->flags;
+    entry->hash = hash;
+    entry->data = ds_data(&entry->string);
+    entry->length = view->length;
 
-    return 0;
+    return entry;
 }
 
-size_t ds_trim_whitespace(ds_String* string) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+ds_InternTable* ds_init_intern_table(void) {
+    return ds_init_intern_table_allocator(ds_global_allocator);
+}
+
+ds_InternTable* ds_init_intern_table_allocator(const ds_Allocator* allocator) {
+    ds_InternTable* table = (ds_InternTable*)ds_allocator_alloc(allocator, sizeof(ds_InternTable));
+    if (!table) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", sizeof(ds_InternTable));
+        return NULL;
     }
+    memset(table, 0, sizeof(ds_InternTable));
+    table->allocator = allocator;
 
-    char* data = ds_is_heap(string) ? string->heap_data : string->stack_data;
+    return table;
+}
 
-    size_t write = 0;
-    for (size_t read = 0; read < string->length; read++) {
-        if (!isspace((unsigned char)data[read])) {
-            data[write++] = data[read];
+void ds_free_intern_table(ds_InternTable* table) {
+    if (!table) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input table is NULL");
+        return;
+    }
+
+    for (size_t s = 0; s < DS_INTERN_SHARDS; s++) {
+        ds_InternSlots* slots = atomic_load_explicit(&table->shards[s].slots, memory_order_relaxed);
+        while (slots) {
+            ds_InternSlots* retired = slots->retired;
+            ds_allocator_free(table->allocator, slots, ds_intern_slots_size(slots->capacity));
+            slots = retired;
+        }
+
+        if (table->shards[s].arena) {
+            ds_free_arena(table->shards[s].arena);
         }
     }
 
-    data[write] = '\0';
-    string->length = write;
-    
-    return 0;
-}
+    for (size_t i = 0; i < DS_INTERN_SEGMENTS; i++) {
+        ds_InternEntry** entries = atomic_load_explicit(&table->segments[i], memory_order_relaxed);
+        if (!entries) continue;
 
-size_t ds_trim_whitespace_flags(ds_String* string, uint32_t flags) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+        uint32_t size = (1u << DS_INTERN_SEGMENT_BITS) << (i ? i - 1 : 0);
+        ds_allocator_free(table->allocator, entries, (size_t)size * sizeof(ds_InternEntry*));
     }
 
-    if (flags & DS_ALL) {
-        return ds_trim_whitespace(string);
+    if (table != &ds_default_intern_table) {
+        ds_allocator_free(table->allocator, table, sizeof(ds_InternTable));
+    }
+}
+
+const ds_String* ds_intern_table_intern(ds_InternTable* table, const ds_StringView* view) {
+    if (!table || !view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input table or view is NULL");
+        return NULL;
     }
 
-    char* data = ds_is_heap(string) ? string->heap_data : string->stack_data;
+    uint64_t hash = ds_string_view_hash(view, 0);
+    ds_InternShard* shard = &table->shards[hash >> (64 - DS_INTERN_SHARD_BITS)];
 
-    size_t start = 0, end = string->length;
+    ds_InternSlots* slots = atomic_load_explicit(&shard->slots, memory_order_acquire);
+    if (slots) {
+        ds_InternEntry* entry = ds_intern_probe(slots, view->data, view->length, hash, NULL);
+        if (entry) return &entry->string;
+    }
 
-    if (flags & DS_FRONT) {
-        while (start < end && isspace((unsigned char)data[start])) {
-            start++;
+    ds_intern_lock(shard);
+
+    // another thread may have added it or grown the table in the meantime
+    size_t empty = 0;
+    slots = atomic_load_explicit(&shard->slots, memory_order_relaxed);
+    if (slots) {
+        ds_InternEntry* entry = ds_intern_probe(slots, view->data, view->length, hash, &empty);
+        if (entry) {
+            ds_intern_unlock(shard);
+            return &entry->string;
         }
     }
 
-    if (flags & DS_BACK) {
-        while (end > start && isspace((unsigned char)data[end - 1])) {
-            end--;
+    // half full at most, so probes stay short and always find an empty slot
+    if (!slots || (shard->count + 1) * 2 > slots->capacity) {
+        slots = ds_intern_grow(table, shard, slots);
+        if (!slots) {
+            ds_intern_unlock(shard);
+            return NULL;
         }
+        ds_intern_probe(slots, view->data, view->length, hash, &empty);
     }
 
-    size_t delta_length = end - start;
-    if (start > 0 && delta_length > 0) {
-        memmove(data, data + start, delta_length);
+    ds_InternEntry* entry = ds_intern_new_entry(shard, view, hash);
+    if (!entry) {
+        ds_intern_unlock(shard);
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate the interned string");
+        return NULL;
     }
-    data[delta_length] = '\0';
-    string->length = delta_length;
 
-    return 0;
+    // the id resolves before anyone can find the entry
+    if (ds_intern_take_id(table, entry) != 0) {
+        ds_intern_unlock(shard);
+        return NULL;
+    }
+    atomic_store_explicit(&slots->slots[empty], entry, memory_order_release);
+    shard->count++;
+
+    ds_intern_unlock(shard);
+
+    return &entry->string;
 }
 
-ds_String* ds_split(ds_String* string, char seperator) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+const ds_String* ds_intern_table_lookup(ds_InternTable* table, uint32_t id) {
+    if (!table) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input table is NULL");
         return NULL;
     }
 
-    char* data = ds_is_heap(string) ? string->heap_data : string->stack_data;
-
-    size_t start;
-    for (start = 0; start < string->length && data[start] != seperator; start++);
-    if (start != string->length) {
-        ds_String* cut = ds_init_string("");
-        ds_clone(cut, string);
-        char* c_data = ds_is_heap(cut) ? cut->heap_data : cut->stack_data;
-        memcpy(c_data, data + start + 1, string->length - start + 1);
-        data[start] = '\0';
-        return cut;
+    if (id >= atomic_load_explicit(&table->next_id, memory_order_relaxed)) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Id %u was never handed out", id);
+        return NULL;
     }
 
-    return NULL;
+    uint32_t offset, size;
+    uint32_t segment = ds_intern_segment(id, &offset, &size);
+    ds_InternEntry** entries = atomic_load_explicit(&table->segments[segment], memory_order_acquire);
+    if (!entries) return NULL;
+
+    ds_InternEntry* entry = atomic_load_explicit((_Atomic(ds_InternEntry*)*)&entries[offset], memory_order_acquire);
+    return entry ? &entry->string : NULL;
 }
 
-ds_StringView ds_string_view_from_cstr(const char *str) {
-    ds_StringView view = {0};
+size_t ds_intern_table_count(ds_InternTable* table) {
+    if (!table) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input table is NULL");
+        return 0;
+    }
 
-    if (!str) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return view;
+    size_t count = 0;
+    for (size_t s = 0; s < DS_INTERN_SHARDS; s++) {
+        ds_intern_lock(&table->shards[s]);
+        count += table->shards[s].count;
+        ds_intern_unlock(&table->shards[s]);
     }
 
-    view.data = str;
-    view.length = strlen(str);
+    return count;
+}
 
-    return view;
+const ds_String* ds_intern(const ds_StringView* view) {
+    return ds_intern_table_intern(&ds_default_intern_table, view);
 }
 
-ds_StringView ds_string_view_from_string(ds_String *string) {
-    ds_StringView view = {0};
+const ds_String* ds_intern_lookup(uint32_t id) {
+    return ds_intern_table_lookup(&ds_default_intern_table, id);
+}
 
-    if (!string) {
+uint32_t ds_intern_id(const ds_String* interned) {
+    if (!interned) {
         DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return view;
+        return UINT32_MAX;
     }
 
-    view.data = ds_string_get_data(string);
-    view.length = string->length;
+    return ((const ds_InternEntry*)interned)->id;
+}
 
-    return view;
+static void ds_mapped_file_set(ds_MappedFile* file, void* address, size_t size, bool mapped) {
+    file->address = address;
+    file->data = address ? (const char*)address : "";
+    file->size = size;
+    file->mapped = mapped;
+    file->view.data = file->data;
+    file->view.length = size <= DS_MAX_CAPACITY ? (uint32_t)size : 0;
 }
 
-ds_StringView ds_string_view_from_buffer(const char *data, uint32_t length) {
-    ds_StringView view = {0};
+// bytes that fit behind length without growing, the terminator excluded
+static inline size_t ds_string_room(ds_String* string, size_t length) {
+    return (ds_is_stack(string) ? DS_SMALL_STRING_CAPACITY : ds_capacity(string) - 1) - length;
+}
 
-    if (!data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input buffer is NULL");
-        return view;
+#ifdef DS_HAS_MMAP
+
+// reads an fd that cant be mapped into a heap buffer, ds_unmap_file frees it
+static size_t ds_map_file_read(ds_MappedFile* file, int fd, const char* path) {
+    size_t capacity = 4096;
+    size_t size = 0;
+    char* buffer = (char*)malloc(capacity);
+    if (!buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "File buffer allocation failed");
+        return -1;
     }
 
-    view.data = data;
-    view.length = length;
+    for (;;) {
+        if (size == capacity) {
+            char* grown = (char*)realloc(buffer, capacity * 2);
+            if (!grown) {
+                DS_SET_ERROR(DS_ALLOC_FAIL, "File buffer reallocation failed");
+                free(buffer);
+                return -1;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
 
-    return view;
+        ssize_t got = read(fd, buffer + size, capacity - size);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            DS_SET_ERROR(DS_ERROR, "Failed to read %s: %s", path, strerror(errno));
+            free(buffer);
+            return -1;
+        }
+        if (got == 0) break;
+        size += (size_t)got;
+    }
+
+    if (!size) {
+        free(buffer);
+        buffer = NULL;
+    }
+    ds_mapped_file_set(file, buffer, size, false);
+
+    return 0;
 }
 
-ds_StringView ds_string_view_from_substr(const ds_StringView *view, uint32_t start, uint32_t length) {
-    ds_StringView lview = {0};
+size_t ds_map_file(ds_MappedFile* file, const char* path, uint32_t flags) {
+    if (!file || !path) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input is NULL");
+        return -1;
+    }
 
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return lview;
+    memset(file, 0, sizeof(*file));
+    ds_mapped_file_set(file, NULL, 0, false);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to open %s: %s", path, strerror(errno));
+        return -1;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return lview;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to stat %s: %s", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    if (!S_ISREG(info.st_mode)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "%s is not a regular file", path);
+        close(fd);
+        return -1;
     }
 
-    if (start >= view->length) {
-        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
-        return lview;
+    // procfs and sysfs files report no size but have content, mmap refuses empty ranges anyway
+    size_t size = (size_t)info.st_size;
+    if (size == 0) {
+        size_t result = ds_map_file_read(file, fd, path);
+        close(fd);
+        return result;
     }
 
-    uint32_t available_length = view->length - start;
-    uint32_t actual_length = (length > available_length) ? available_length : length;
+    void* address = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps its own reference to the file
+    if (address == MAP_FAILED) {
+        DS_SET_ERROR(DS_ERROR, "Failed to map %s: %s", path, strerror(errno));
+        return -1;
+    }
 
-    lview.data = view->data + start;
-    lview.length = actual_length;
+    // only hints, a kernel that ignores them still gives a valid mapping. huge pages
+    // for page cache files need CONFIG_READ_ONLY_THP_FOR_FS, without it this is a no-op
+#ifdef MADV_HUGEPAGE
+    if (flags & DS_FILE_HUGE_PAGES) madvise(address, size, MADV_HUGEPAGE);
+#endif
+    if (flags & DS_FILE_SEQUENTIAL) madvise(address, size, MADV_SEQUENTIAL);
+    if (flags & DS_FILE_WILLNEED) madvise(address, size, MADV_WILLNEED);
 
-    return lview;
+    ds_mapped_file_set(file, address, size, true);
+    return 0;
 }
 
-ds_StringView ds_string_view_from_substr_to_end(const ds_StringView *view, uint32_t start) {
-    ds_StringView lview = {0};
-
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return lview;
+/*  NOTE:
+ *  regular files are sized by fstat and read straight into
+ *  the empty string, so the content is copied once, by the kernel.
+ *  a file that grew since the fstat still ends up complete,
+ *  the buffer only grows if the one byte probe at the
+ *  expected end actually finds more
+ */
+static size_t ds_read_file_into(ds_String* string, const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to open %s: %s", path, strerror(errno));
+        return -1;
     }
 
-    if (start >= view->length) {
-        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
-        return lview;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to stat %s: %s", path, strerror(errno));
+        close(fd);
+        return -1;
     }
 
-    lview.data = view->data + start;
-    lview.length = view->length - start;
+    // pipes and procfs files report no size, those grow while they are read
+    size_t expected = S_ISREG(info.st_mode) ? (size_t)info.st_size : 0;
+    if (expected >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "File %s is to big for a string", path);
+        close(fd);
+        return -1;
+    }
 
-    return lview;
-}
+    if (ds_string_grow(string, expected, true) != 0) {
+        close(fd);
+        return -1;
+    }
 
-ds_StringView ds_string_view_from_string_substr(ds_String *string, uint32_t start, uint32_t length) {
-    ds_StringView view;
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
 
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return view;
+    size_t length = 0;
+    size_t result = 0;
+    for (;;) {
+        size_t room = ds_string_room(string, length);
+        char probe;
+        ssize_t got = room ? read(fd, ds_data(string) + length, room) : read(fd, &probe, 1);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            DS_SET_ERROR(DS_ERROR, "Failed to read %s: %s", path, strerror(errno));
+            result = -1;
+            break;
+        }
+        if (got == 0) break;
+
+        if (!room) {
+            // growing copies length chars, so they have to be counted first
+            ds_data(string)[length] = '\0';
+            ds_set_length(string, length);
+            if (ds_string_grow(string, length + 1, false) != 0) {
+                result = -1;
+                break;
+            }
+            ds_data(string)[length] = probe;
+        }
+        length += (size_t)got;
     }
 
-    if (start >= string->length) {
-        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
-        return view;
-    }
+    close(fd);
+    ds_data(string)[length] = '\0';
+    ds_set_length(string, length);
 
-    uint32_t available_length = string->length - start;
-    uint32_t actual_length = (length > available_length) ? available_length : length;
+    return result;
+}
 
-    view.data = ds_string_get_data(string) + start;
-    view.length = actual_length;
+#else
 
-    return view;
-}
+size_t ds_map_file(ds_MappedFile* file, const char* path, uint32_t flags) {
+    (void)flags;
+    if (!file || !path) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input is NULL");
+        return -1;
+    }
 
-ds_StringView ds_string_view_from_string_substr_to_end(ds_String *string, uint32_t start) {
-    ds_StringView view = {0};
+    memset(file, 0, sizeof(*file));
+    ds_mapped_file_set(file, NULL, 0, false);
 
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return view;
+    FILE* stream = fopen(path, "rb");
+    if (!stream) {
+        DS_SET_ERROR(DS_ERROR, "Failed to open %s", path);
+        return -1;
     }
 
-    if (start >= string->length) {
-        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
-        return view;
+    long size = fseek(stream, 0, SEEK_END) == 0 ? ftell(stream) : -1;
+    if (size < 0 || fseek(stream, 0, SEEK_SET) != 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to size %s", path);
+        fclose(stream);
+        return -1;
+    }
+    if (size == 0) {
+        fclose(stream);
+        return 0;
     }
 
-    view.data = ds_string_get_data(string) + start;
-    view.length = string->length - start;
+    char* buffer = (char*)malloc((size_t)size);
+    if (!buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "File buffer allocation failed");
+        fclose(stream);
+        return -1;
+    }
 
-    return view;
+    size_t got = fread(buffer, 1, (size_t)size, stream);
+    fclose(stream);
+    ds_mapped_file_set(file, buffer, got, false);
 
+    return 0;
 }
 
-bool ds_string_view_equal(const ds_StringView *view1, const ds_StringView *view2) {
-    if (!view1 || !view2) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return false;
+static size_t ds_read_file_into(ds_String* string, const char* path) {
+    FILE* stream = fopen(path, "rb");
+    if (!stream) {
+        DS_SET_ERROR(DS_ERROR, "Failed to open %s", path);
+        return -1;
     }
 
-    if (!view1->data || !view2->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return false;
+    long expected = fseek(stream, 0, SEEK_END) == 0 ? ftell(stream) : 0;
+    if (expected < 0 || fseek(stream, 0, SEEK_SET) != 0) expected = 0;
+    if ((size_t)expected >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "File %s is to big for a string", path);
+        fclose(stream);
+        return -1;
     }
 
-    if (view1->length != view2->length) return false;
-    return memcmp(view1->data, view2->data, view1->length) == 0;
-}
+    if (ds_string_grow(string, (size_t)expected, true) != 0) {
+        fclose(stream);
+        return -1;
+    }
 
-bool ds_string_view_equal_cstr(const ds_StringView *view, const char *str) {
-    if (!view || !str) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return false;
+    size_t length = 0;
+    size_t result = 0;
+    for (;;) {
+        size_t room = ds_string_room(string, length);
+        if (!room) {
+            ds_data(string)[length] = '\0';
+            ds_set_length(string, length);
+            if (ds_string_grow(string, length + 1, false) != 0) {
+                result = -1;
+                break;
+            }
+            room = ds_string_room(string, length);
+        }
+        size_t got = fread(ds_data(string) + length, 1, room, stream);
+        length += got;
+        if (got < room) break;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return false;
+    if (ferror(stream)) {
+        DS_SET_ERROR(DS_ERROR, "Failed to read %s", path);
+        result = -1;
     }
+    fclose(stream);
+    ds_data(string)[length] = '\0';
+    ds_set_length(string, length);
 
-    if (view->length != strlen(str)) return false;
-    return memcmp(view->data, str, view->length) == 0;
+    return result;
 }
 
-bool ds_string_view_is_empty(const ds_StringView *view) {
-    return (!view || view->length) == 0;
-}
+#endif
 
-int32_t ds_string_view_find_char(const ds_StringView *view, char c) {
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+// the file goes into a fresh string, so a failed read leaves the old content alone
+size_t ds_read_file(ds_String* string, const char* path) {
+    if (!string || !path) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input is NULL");
         return -1;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return false;
+    ds_String fresh;
+    ds_string_reset(&fresh);
+    ds_string_set_allocator(&fresh, ds_string_allocator(string));
+
+    if (ds_read_file_into(&fresh, path) != 0) {
+        ds_string_deinit(&fresh);
+        return -1;
     }
 
-    for (size_t i = 0; i < view->length; i++) {
-        if (view->data[i] == c) return (int32_t)i;
+    bool sticky = ds_has_sticky_heap(string);
+    ds_string_deinit(string);
+    *string = fresh;
+    if (sticky) ds_set_sticky_heap(string);
+
+    return 0;
+}
+
+void ds_unmap_file(ds_MappedFile* file) {
+    if (!file) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input file is NULL");
+        return;
     }
 
+#ifdef DS_HAS_MMAP
+    if (file->mapped) munmap(file->address, file->size);
+    else free(file->address);
+#else
+    free(file->address);
+#endif
+
+    ds_mapped_file_set(file, NULL, 0, false);
+}
+
+// one read, retried when a signal interrupts it. -1 with errno set on failure
+static ptrdiff_t ds_read_fd(int fd, char* buffer, size_t size) {
+#if defined(DS_HAS_MMAP)
+    ssize_t got;
+    do {
+        got = read(fd, buffer, size);
+    } while (got < 0 && errno == EINTR);
+    return got;
+#elif defined(_WIN32)
+    return _read(fd, buffer, size > INT32_MAX ? INT32_MAX : (unsigned)size);
+#else
+    (void)fd; (void)buffer; (void)size;
+    errno = ENOSYS;
     return -1;
+#endif
 }
 
-int32_t ds_string_view_find_substr(const ds_StringView *view, const ds_StringView *substr) {
-    if (!view || !substr || !view->data || !substr->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or substr is NULL or has no data");
+size_t ds_line_reader_init(ds_LineReader* reader, int fd, size_t capacity, uint32_t flags) {
+    if (!reader) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input reader is NULL");
         return -1;
     }
-
-    if (substr->length == 0) {
-        return 0;
+    if (fd < 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Invalid file descriptor %d", fd);
+        return -1;
     }
 
-    if (substr->length > view->length) {
+    memset(reader, 0, sizeof(*reader));
+    reader->capacity = capacity ? capacity : DS_LINE_READER_DEFAULT_CAPACITY;
+    if (reader->capacity > DS_MAX_CAPACITY) reader->capacity = DS_MAX_CAPACITY; // lines have to fit into a view
+    reader->fd = fd;
+    reader->flags = flags;
+    reader->allocator = ds_global_allocator;
+
+    reader->buffer = (char*)ds_allocator_alloc(reader->allocator, reader->capacity);
+    if (!reader->buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Line buffer allocation failed");
         return -1;
     }
 
-    for (size_t i = 0; i < view->length - substr->length; i++) {
-        if (memcmp(view->data + i, substr->data, substr->length) == 0) {
-            return (int32_t)i;
-        }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL); // fails harmlessly on pipes and sockets
+#endif
+
+    return 0;
+}
+
+void ds_line_reader_deinit(ds_LineReader* reader) {
+    if (!reader) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input reader is NULL");
+        return;
     }
 
-    return -1;
+    if (reader->buffer) ds_allocator_free(reader->allocator, reader->buffer, reader->capacity);
+    reader->buffer = NULL;
+    reader->capacity = reader->start = reader->end = reader->scanned = 0;
+    reader->eof = true;
 }
 
-bool ds_string_view_starts_with(const ds_StringView *view, const ds_StringView *prefix) {
-    if (!view || !prefix || !view->data || !prefix->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or prefix is NULL or has no data");
+/*  NOTE:
+ *  every byte is scanned for a newline once, scanned remembers
+ *  how far the partial line at the end of the buffer got. when
+ *  the buffer runs out the partial line is moved to the front
+ *  and the rest is refilled, so only a line that fills the whole
+ *  buffer makes it grow
+ */
+bool ds_line_reader_next(ds_LineReader* reader, ds_StringView* line) {
+    if (!reader || !line) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input is NULL");
         return false;
     }
 
-    if (prefix->length == 0) return true;
-    if (prefix->length > view->length) return false;
+    for (;;) {
+        char* data = reader->buffer + reader->start;
+        size_t available = reader->end - reader->start;
+
+        const char* newline = ds_find_byte(data + reader->scanned, available - reader->scanned, '\n');
+        if (newline) {
+            size_t length = (size_t)(newline - data);
+            reader->start += length + 1;
+            reader->scanned = 0;
+            if ((reader->flags & DS_LINE_STRIP_CR) && length && data[length - 1] == '\r') length--;
+            *line = ds_string_view_from_buffer(data, (uint32_t)length);
+            return true;
+        }
+        reader->scanned = available;
 
-    if (memcmp(view->data, prefix->data, prefix->length) == 0) return true;
+        if (reader->eof) {
+            if (!available) return false;
 
-    return false;
+            reader->start = reader->end;
+            reader->scanned = 0;
+            *line = ds_string_view_from_buffer(data, (uint32_t)available);
+            return true;
+        }
+
+        if (reader->start) {
+            memmove(reader->buffer, data, available);
+            reader->start = 0;
+            reader->end = available;
+        }
+        else if (reader->end == reader->capacity) {
+            if (reader->capacity >= DS_MAX_CAPACITY) {
+                DS_SET_ERROR(DS_INVALID_LENGTH, "Line is to long for a view");
+                reader->eof = true;
+                return false;
+            }
+
+            size_t new_capacity = reader->capacity * 2;
+            if (new_capacity > DS_MAX_CAPACITY) new_capacity = DS_MAX_CAPACITY;
+            char* buffer = (char*)ds_allocator_realloc(reader->allocator, reader->buffer, reader->capacity, new_capacity);
+            if (!buffer) {
+                DS_SET_ERROR(DS_ALLOC_FAIL, "Line buffer reallocation failed");
+                reader->eof = true;
+                return false;
+            }
+            reader->buffer = buffer;
+            reader->capacity = new_capacity;
+        }
+
+        ptrdiff_t got = ds_read_fd(reader->fd, reader->buffer + reader->end, reader->capacity - reader->end);
+        if (got < 0) {
+            reader->error = errno;
+            reader->eof = true;
+            DS_SET_ERROR(DS_ERROR, "Failed to read fd %d: %s", reader->fd, strerror(reader->error));
+            return false;
+        }
+        if (got == 0) reader->eof = true;
+        reader->end += (size_t)got;
+    }
 }
 
-bool ds_string_view_ends_with(const ds_StringView *view, const ds_StringView *suffix) {
-    if (!view || !suffix || !view->data || !suffix->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or suffix is NULL or has no data");
-        return false;
+struct ds_ArenaBlock {
+    ds_ArenaBlock* next;
+    size_t capacity;
+    size_t used;
+    size_t last; // offset of the newest allocation, lets realloc grow in place
+    char data[];
+};
+
+static inline size_t ds_arena_align(size_t size) {
+    return (size + DS_ARENA_ALIGNMENT - 1) & ~((size_t)DS_ARENA_ALIGNMENT - 1);
+}
+
+static ds_ArenaBlock* ds_arena_new_block(size_t capacity) {
+    ds_ArenaBlock* block = (ds_ArenaBlock*)malloc(sizeof(ds_ArenaBlock) + capacity);
+    if (!block) {
+        return NULL;
     }
 
-    if (suffix->length == 0) return true;
-    if (suffix->length > view->length) return false;
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    block->last = 0;
 
-    if (memcmp(view->data + view->length - suffix->length, suffix->data, suffix->length) == 0) return true;
+    return block;
+}
 
-    return false;
+static void* ds_arena_allocator_alloc(void* context, size_t size) {
+    return ds_arena_alloc((ds_Arena*)context, size);
+}
 
+static void* ds_arena_allocator_realloc(void* context, void* ptr, size_t old_size, size_t new_size) {
+    return ds_arena_realloc((ds_Arena*)context, ptr, old_size, new_size);
 }
 
-ds_String* ds_string_from_view(const ds_StringView* view) {
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+static void ds_arena_allocator_free(void* context, void* ptr, size_t size) {
+    (void)context; (void)ptr; (void)size;
+}
+
+static size_t ds_arena_allocator_usable_size(void* context, void* ptr, size_t size) {
+    (void)context; (void)ptr;
+    return ds_arena_align(size);
+}
+
+ds_Arena* ds_init_arena(size_t block_size) {
+    ds_Arena* arena = (ds_Arena*)malloc(sizeof(ds_Arena));
+    if (!arena) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from arena failed");
         return NULL;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return NULL;
+    arena->head = NULL;
+    arena->block_size = block_size ? ds_arena_align(block_size) : DS_ARENA_DEFAULT_BLOCK_SIZE;
+    arena->allocator.alloc = ds_arena_allocator_alloc;
+    arena->allocator.realloc = ds_arena_allocator_realloc;
+    arena->allocator.free = ds_arena_allocator_free;
+    arena->allocator.context = arena;
+    arena->allocator.usable_size = ds_arena_allocator_usable_size;
+
+    return arena;
+}
+
+void ds_free_arena(ds_Arena* arena) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return;
     }
 
-    ds_String* string = ds_init_string(view->data);
-    return string;
+    ds_ArenaBlock* block = arena->head;
+    while (block) {
+        ds_ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
 }
 
-ds_StringView ds_string_view_trim_whitespace(const ds_StringView *view) {
-    ds_StringView result = {0};
+void ds_arena_reset(ds_Arena* arena) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return;
+    }
 
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return result;
+    // keep one regular block around so the next batch doesnt hit malloc
+    ds_ArenaBlock* keep = NULL;
+    ds_ArenaBlock* block = arena->head;
+    while (block) {
+        ds_ArenaBlock* next = block->next;
+        if (!keep && block->capacity == arena->block_size) {
+            keep = block;
+        }
+        else {
+            free(block);
+        }
+        block = next;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return result;
+    if (keep) {
+        keep->next = NULL;
+        keep->used = 0;
+        keep->last = 0;
+    }
+    arena->head = keep;
+}
+
+void* ds_arena_alloc(ds_Arena* arena, size_t size) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return NULL;
     }
 
-    char data[view->length];
-    uint32_t index = 0;
+    size_t aligned = ds_arena_align(size);
+    ds_ArenaBlock* block = arena->head;
 
-    for (size_t i = 0; i < view->length; i++) {
-        if (view->data[i] != ' ') {
-            data[index++] = view->data[i];
+    if (!block || block->capacity - block->used < aligned) {
+        // oversized requests get their own block behind the current one
+        if (aligned > arena->block_size) {
+            ds_ArenaBlock* big = ds_arena_new_block(aligned);
+            if (!big) {
+                DS_SET_ERROR(DS_ALLOC_FAIL, "Arena block allocation failed");
+                return NULL;
+            }
+            big->used = aligned;
+            if (block) {
+                big->next = block->next;
+                block->next = big;
+            }
+            else {
+                arena->head = big;
+            }
+            return big->data;
+        }
+
+        block = ds_arena_new_block(arena->block_size);
+        if (!block) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Arena block allocation failed");
+            return NULL;
         }
+        block->next = arena->head;
+        arena->head = block;
     }
 
-    result = ds_string_view_from_buffer(data, index);
-    
-    return result;
+    block->last = block->used;
+    block->used += aligned;
+
+    return block->data + block->last;
 }
 
-void ds_string_view_print(const ds_StringView *view) {
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return;
+void* ds_arena_realloc(ds_Arena* arena, void* ptr, size_t old_size, size_t new_size) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return NULL;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return;
+    if (!ptr) {
+        return ds_arena_alloc(arena, new_size);
     }
 
-    printf("%s\n", view->data);
-}
+    // newest allocation of the current block can just be bumped
+    ds_ArenaBlock* block = arena->head;
+    if (block && (char*)ptr == block->data + block->last
+            && ds_arena_align(new_size) <= block->capacity - block->last) {
+        block->used = block->last + ds_arena_align(new_size);
+        return ptr;
+    }
 
-const char* ds_string_view_get_data(const ds_StringView* view) {
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+    if (new_size <= old_size) {
+        return ptr;
+    }
+
+    void* new_ptr = ds_arena_alloc(arena, new_size);
+    if (!new_ptr) {
         return NULL;
     }
+    memcpy(new_ptr, ptr, old_size);
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+    return new_ptr;
+}
+
+const ds_Allocator* ds_arena_allocator(ds_Arena* arena) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
         return NULL;
     }
 
-    return view->data;
-} 
+    return &arena->allocator;
+}
 
-uint32_t ds_string_view_get_length(const ds_StringView* view) {
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+ds_String* ds_init_string_arena(ds_Arena* arena, const char* literal) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
         return NULL;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+    return ds_init_string_allocator(&arena->allocator, literal);
+}
+
+ds_StringViewArray* ds_string_view_split_arena(ds_Arena* arena, const ds_StringView* view, char split) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
         return NULL;
     }
 
-    return view->length;
+    return ds_string_view_split_into(&arena->allocator, view, split);
 }
 
 #endif
@@ -2,8 +2,28 @@
 #ifndef DRINGS_H
 #define DRINGS_H 
 
+// DS_COMPACT_STRING selects a 24 byte ds_String with 23 inline chars
+#ifdef DS_COMPACT_STRING
+#define DS_SMALL_STRING_CAPACITY 23
+#else
 #define DS_SMALL_STRING_CAPACITY 15
+#endif
 #define DS_STACK_CAPACITY 0
+#define DS_MAX_CAPACITY UINT32_MAX
+#define DS_DEFAULT_GROWTH_FACTOR 2.0
+#define DS_DOUBLE_MAX_LENGTH 32
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DS_PRINTF_FORMAT(format_index, args_index) __attribute__((format(printf, format_index, args_index)))
+#else
+#define DS_PRINTF_FORMAT(format_index, args_index)
+#endif
+#define DS_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define DS_ARENA_ALIGNMENT 16
+#define DS_SEARCHER_SHORT_NEEDLE 32 // longer needles use Two-Way
+#define DS_SMALL_VIEW_ARRAY_CAPACITY 8
+#define DS_MULTI_MATCHER_DENSE_ENTRIES (16 * 1024) // budget for full transition rows
+#define DS_LINE_READER_DEFAULT_CAPACITY (256 * 1024)
 
 #include <stdio.h>
 #include <string.h> 
@@ -11,6 +31,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <stdarg.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,6 +51,7 @@ typedef enum {
     DS_INVALID_INPUT = -4,
     DS_INVALID_LENGTH = -5,
     DS_REACHED_UNINTENTIONAL_CONTROL_BLOCK = -6,
+    DS_OVERFLOW = -7,
 } DS_RESULT;
 
 typedef enum {
@@ -37,6 +59,8 @@ typedef enum {
     DS_OWNS_MEM = 0x2,
     DS_READ_ONLY = 0x4,
     DS_STICKY_HEAP = 0x8,
+    DS_HASH_CACHED = 0x10, // heap_hash is valid, cleared by ds_set_length
+    DS_SHARED = 0x20, // heap_data points into a refcounted block, see ds_clone
 } DS_FLAG;
 
 typedef enum {
@@ -45,27 +69,225 @@ typedef enum {
     DS_ALL = 0x4,
 } DS_TRIM_FLAG;
 
+typedef enum {
+    DS_MATCH_OVERLAPPING = 0x1, // next search starts one byte after a match instead of behind it
+} DS_MATCH_FLAG;
+
+typedef enum {
+    DS_SPLIT_SKIP_EMPTY = 0x1,
+} DS_SPLIT_FLAG;
+
+typedef enum {
+    DS_SPLIT_ON_CHAR,
+    DS_SPLIT_ON_STRING,
+    DS_SPLIT_ON_SET,
+} DS_SPLIT_KIND;
+
+// hints for ds_map_file, ignored where the platform has no equivalent
+typedef enum {
+    DS_FILE_SEQUENTIAL = 0x1, // read ahead aggressively and drop pages behind the reader
+    DS_FILE_WILLNEED = 0x2, // start paging the whole file in right away
+    DS_FILE_HUGE_PAGES = 0x4, // best effort, file mappings only get huge pages with read only THP for the page cache (CONFIG_READ_ONLY_THP_FOR_FS)
+} DS_FILE_FLAG;
+
+typedef enum {
+    DS_LINE_STRIP_CR = 0x1, // \r\n endings lose the \r as well
+} DS_LINE_FLAG;
+
+// sizes are passed back to realloc/free so sized allocators dont need a lookup.
+// usable_size is optional and reports the real size of a block so growth can use the slack
+typedef struct {
+    void* (*alloc)(void* context, size_t size);
+    void* (*realloc)(void* context, void* ptr, size_t old_size, size_t new_size);
+    void  (*free)(void* context, void* ptr, size_t size);
+    void* context;
+    size_t (*usable_size)(void* context, void* ptr, size_t size);
+} ds_Allocator;
+
+typedef struct ds_ArenaBlock ds_ArenaBlock;
+
+// bump allocator, everything is released at once with ds_arena_reset
+typedef struct {
+    ds_ArenaBlock* head;
+    size_t block_size;
+    ds_Allocator allocator; // hands out arena memory, free is a no-op
+} ds_Arena;
+
+#ifdef DS_COMPACT_STRING
+
+/*  NOTE:
+ *  the last byte is shared between both modes. stack strings keep
+ *  DS_SMALL_STRING_CAPACITY - length there, so a full small string
+ *  is terminated by it. heap strings keep DS_COMPACT_HEAP_MARK | flags.
+ *  stack strings carry no flags, heap strings are always sticky and
+ *  every string uses the global allocator.
+ */
+#define DS_COMPACT_HEAP_MARK 0x80
+
+typedef struct {
+    union {
+        char stack_data[DS_SMALL_STRING_CAPACITY + 1];
+        struct {
+            char* heap_data;
+            uint32_t heap_length;
+            uint32_t capacity;
+            char reserved[DS_SMALL_STRING_CAPACITY - sizeof(char*) - 2 * sizeof(uint32_t)];
+            uint8_t flags;
+        };
+    };
+} ds_String;
+
+typedef char ds_compact_string_size_check[sizeof(ds_String) == DS_SMALL_STRING_CAPACITY + 1 ? 1 : -1];
+
+#ifdef __cplusplus
+// C++ has no array designators, the empty string is built at runtime there
+static inline ds_String ds_string_compact_init(void) {
+    ds_String string;
+    memset(&string, 0, sizeof(string));
+    string.stack_data[DS_SMALL_STRING_CAPACITY] = DS_SMALL_STRING_CAPACITY;
+    return string;
+}
+#define DS_STRING_INIT ds_string_compact_init()
+#else
+#define DS_STRING_INIT { { .stack_data = { [DS_SMALL_STRING_CAPACITY] = DS_SMALL_STRING_CAPACITY } } }
+#endif
+
+#else
+
 typedef struct {
     uint32_t length;
     uint32_t capacity;
     uint32_t flags;
+    const ds_Allocator* allocator; // NULL uses malloc/realloc/free directly
     union {
         char stack_data[DS_SMALL_STRING_CAPACITY + 1]; 
-        char* heap_data;
+        struct {
+            char* heap_data;
+            uint64_t heap_hash; // ds_string_hash of heap strings, see DS_HASH_CACHED
+        };
     };
 } ds_String;
 
+#define DS_STRING_INIT {0}
+
+#endif
+
 typedef struct {
     const char* data;
     uint32_t length;
 } ds_StringView;
 
+// view of a string literal with its length known at compile time, ds_append_view(s, &DS_LIT("abc"))
+#define DS_LIT(literal) ((ds_StringView){ (literal), (uint32_t)(sizeof(literal) - 1) })
+
+// DS_CONCAT(string, DS_LIT("key="), view, DS_LIT(";"))
+#define DS_CONCAT(string, ...) \
+    ds_concat((string), (const ds_StringView[]){ __VA_ARGS__ }, \
+            sizeof((const ds_StringView[]){ __VA_ARGS__ }) / sizeof(ds_StringView))
+
+// 256 bit membership bitmap, the nibble tables drive the SIMD search
+// and are only valid while the set has at most 8 distinct high nibbles
+typedef struct {
+    uint64_t bits[4];
+    uint8_t low_nibbles[16];
+    uint8_t high_nibbles[16];
+    bool nibble_lookup;
+} ds_ByteSet;
+
+// preprocessed needle, it points into the needle so the needle has to outlive it
+typedef struct {
+    ds_StringView needle;
+    size_t critical; // Two-Way factorization, only set up for long needles
+    size_t period;
+    size_t memory;
+    uint32_t shift[256];
+} ds_Searcher;
+
+// yields the offsets of every match of a needle, reset to walk another haystack with the same needle
+typedef struct {
+    ds_Searcher searcher;
+    ds_StringView haystack;
+    uint64_t position; // next offset to search from, past the end once done
+    uint32_t flags;
+} ds_MatchIter;
+
+// lazy tokenizer, the tokens point into the view and nothing is allocated
+typedef struct {
+    ds_StringView rest;
+    uint32_t kind; // DS_SPLIT_KIND
+    uint32_t flags;
+    bool done;
+    union {
+        char c;
+        ds_ByteSet set;
+        ds_Searcher searcher;
+    } delimiter;
+} ds_SplitIter;
+
+typedef struct {
+    uint64_t low;
+    uint64_t high;
+} ds_Hash128;
+
+typedef struct {
+    uint32_t pattern; // index into the patterns the matcher was built from
+    uint32_t offset;
+} ds_Match;
+
+// compiled set of patterns, matches all of them in one pass
+typedef struct ds_MultiMatcher ds_MultiMatcher;
+
+// string keyed hash map, keys are copied in and values are opaque pointers
+typedef struct ds_Map ds_Map;
+
+// canonical strings, one per distinct content
+typedef struct ds_InternTable ds_InternTable;
+
+// read only file contents. view covers the whole file as long as it fits
+// into a view (DS_MAX_CAPACITY bytes), bigger files are only reachable through data and size
+typedef struct {
+    ds_StringView view;
+    const char* data;
+    size_t size;
+    void* address; // start of the mapping, or of the buffer the file was read into
+    bool mapped;
+} ds_MappedFile;
+
+// reads an fd in big chunks and hands out the lines in place. a line only
+// stays valid until the next call, the buffer grows only for a line longer than itself
+typedef struct {
+    char* buffer;
+    size_t capacity;
+    size_t start; // first byte not handed out yet
+    size_t end; // behind the last byte read
+    size_t scanned; // bytes after start already known to hold no newline
+    int fd;
+    int error; // errno of a failed read, 0 otherwise
+    uint32_t flags;
+    bool eof;
+    const ds_Allocator* allocator;
+} ds_LineReader;
+
 typedef struct {
     ds_StringView* views;
     uint32_t count;
     uint32_t capacity;
+    const ds_Allocator* allocator;
 } ds_StringViewArray;
 
+// the first DS_SMALL_VIEW_ARRAY_CAPACITY views live inline, capacity is DS_STACK_CAPACITY until it spills
+typedef struct {
+    uint32_t count;
+    uint32_t capacity;
+    const ds_Allocator* allocator;
+    union {
+        ds_StringView inline_views[DS_SMALL_VIEW_ARRAY_CAPACITY];
+        ds_StringView* heap_views;
+    };
+} ds_SmallViewArray;
+
+#define DS_SMALL_VIEW_ARRAY_INIT {0}
+
 typedef struct {
     DS_RESULT error_code;
     const char* function_name;
@@ -76,40 +298,119 @@ typedef struct {
 
 // construct
 ds_String*      ds_init_string(const char* string);
+ds_String*      ds_init_string_n(const char* data, size_t length); // data doesnt need to be NUL terminated
+ds_String*      ds_init_string_allocator(const ds_Allocator* allocator, const char* string);
 void            ds_free_string(ds_String* string);
 
+// construct into caller owned storage (stack, structs, arrays), no header allocation.
+// a ds_String set to DS_STRING_INIT is a valid empty string as well (using malloc)
+size_t          ds_string_init_inplace(ds_String* string, const char* literal);
+size_t          ds_string_init_inplace_n(ds_String* string, const char* data, size_t length);
+size_t          ds_string_init_inplace_allocator(ds_String* string, const ds_Allocator* allocator, const char* literal);
+void            ds_string_deinit(ds_String* string); // frees the buffer, not the ds_String itself
+
+// allocator used by every string created afterwards, NULL restores malloc.
+// compact strings dont store their allocator, so with DS_COMPACT_STRING it can
+// only be set before the first string is created and later calls fail
+void            ds_set_allocator(const ds_Allocator* allocator);
+const ds_Allocator* ds_get_allocator();
+
+// heap capacity is multiplied by this when an append runs out of space
+void            ds_set_growth_factor(double factor);
+double          ds_get_growth_factor();
+
 // methods
 const char*     ds_to_c_str(ds_String* string);
 void            ds_append(ds_String* string, const char* literal);
+void            ds_append_n(ds_String* string, const char* data, size_t n);
+void            ds_append_view(ds_String* string, const ds_StringView* view);
 void            ds_append_dstring(ds_String* string, ds_String* append);
+void            ds_concat(ds_String* string, const ds_StringView* parts, size_t n); // one grow for all parts, parts may view string itself
+size_t          ds_appendf(ds_String* string, const char* format, ...) DS_PRINTF_FORMAT(2, 3);
+size_t          ds_vappendf(ds_String* string, const char* format, va_list args);
+size_t          ds_append_i64(ds_String* string, int64_t value);
+size_t          ds_append_u64(ds_String* string, uint64_t value);
+size_t          ds_append_double(ds_String* string, double value); // shortest text that parses back to value
 
 char            ds_pop(ds_String* string);
 size_t          ds_pop_n(ds_String* string, size_t n);
 
-size_t          ds_reserve(ds_String* string, size_t n);
+size_t          ds_reserve(ds_String* string, size_t n); // same as ds_reserve_exact
+size_t          ds_reserve_exact(ds_String* string, size_t n); // room for n chars, no extra
+size_t          ds_reserve_at_least(ds_String* string, size_t n); // room for n chars, grown by the growth factor
 size_t          ds_clear(ds_String* string);
-bool            ds_equal(ds_String* string0, ds_String* string1); // true if equal
+bool            ds_equal(const ds_String* string0, const ds_String* string1); // true if equal
+int             ds_compare(const ds_String* string0, const ds_String* string1); // <0, 0, >0 in memcmp order
+uint64_t        ds_string_hash(ds_String* string); // unseeded, heap strings cache it until the next change
 size_t          ds_set(ds_String* string, const char* literal);
+size_t          ds_set_n(ds_String* string, const char* data, size_t n);
+size_t          ds_set_view(ds_String* string, const ds_StringView* view);
+// string becomes a copy of clone. heap strings share one refcounted buffer until either side changes
 size_t          ds_clone(ds_String* string, ds_String* clone);
+size_t          ds_clone_substr(ds_String* string, ds_String* source, size_t start, size_t length); // shares like ds_clone
+
+// borrowed strings read external memory that has to outlive them, the first change copies it.
+// adopt takes over a buffer from the global allocator, release hands the buffer back out
+ds_String*      ds_string_wrap(const char* data, size_t length);
+ds_String*      ds_string_wrap_cstr(const char* literal); // ds_to_c_str can use the terminator in place
+size_t          ds_string_wrap_inplace(ds_String* string, const char* data, size_t length);
+ds_String*      ds_string_adopt(char* data, size_t length, size_t capacity); // capacity has to leave room for the terminator
+size_t          ds_string_adopt_inplace(ds_String* string, char* data, size_t length, size_t capacity);
+char*           ds_string_release(ds_String* string, size_t* length, size_t* capacity); // capacity can be NULL, string is left empty
 size_t          ds_trim_whitespace(ds_String* string);
 size_t          ds_trim_whitespace_flags(ds_String* string, uint32_t flags);
 ds_String*      ds_split(ds_String* string, char c); // returns split up string from first occurance
 
 // string view
 ds_StringView   ds_string_view_from_cstr(const char* str);
-ds_StringView   ds_string_view_from_string(ds_String* string);
+ds_StringView   ds_string_view_from_string(const ds_String* string);
 ds_StringView   ds_string_view_from_buffer(const char* data, uint32_t length);
 ds_StringView   ds_string_view_from_substr(const ds_StringView* view, uint32_t start, uint32_t length);
 ds_StringView   ds_string_view_from_substr_to_end(const ds_StringView* view, uint32_t start);
-ds_StringView   ds_string_view_from_string_substr(ds_String* string, uint32_t start, uint32_t length);
-ds_StringView   ds_string_view_from_string_substr_to_end(ds_String* string, uint32_t start);
+ds_StringView   ds_string_view_from_string_substr(const ds_String* string, uint32_t start, uint32_t length);
+ds_StringView   ds_string_view_from_string_substr_to_end(const ds_String* string, uint32_t start);
 
 bool            ds_string_view_equal(const ds_StringView* view1, const ds_StringView* view2);
 bool            ds_string_view_equal_cstr(const ds_StringView* view, const char* str);
+int             ds_string_view_compare(const ds_StringView* view1, const ds_StringView* view2); // <0, 0, >0 in memcmp order
+
+// hashing, wyhash class, the same value on every platform
+uint64_t        ds_hash_bytes(const void* data, size_t length, uint64_t seed);
+uint64_t        ds_string_view_hash(const ds_StringView* view, uint64_t seed); // seed 0 matches ds_string_hash
+ds_Hash128      ds_string_view_hash128(const ds_StringView* view, uint64_t seed);
 bool            ds_string_view_is_empty(const ds_StringView* view);
 
 int32_t         ds_string_view_find_char(const ds_StringView* view, char c);
+int32_t         ds_string_view_rfind_char(const ds_StringView* view, char c); // last occurrence
+int32_t         ds_string_view_find_nth_char(const ds_StringView* view, char c, size_t n); // n counts from 0
+size_t          ds_string_view_count_char(const ds_StringView* view, char c);
+
+// byte sets, build once and search many views with them
+ds_ByteSet      ds_byte_set_from_cstr(const char* chars);
+ds_ByteSet      ds_byte_set_from_buffer(const char* chars, size_t length);
+void            ds_byte_set_add(ds_ByteSet* set, char c);
+bool            ds_byte_set_contains(const ds_ByteSet* set, char c);
+
+int32_t         ds_string_view_find_first_of(const ds_StringView* view, const ds_ByteSet* set);
+int32_t         ds_string_view_find_first_not_of(const ds_StringView* view, const ds_ByteSet* set);
+int32_t         ds_string_view_find_last_of(const ds_StringView* view, const ds_ByteSet* set);
+int32_t         ds_string_view_find_last_not_of(const ds_StringView* view, const ds_ByteSet* set);
+uint32_t        ds_string_view_span(const ds_StringView* view, const ds_ByteSet* set); // length of the prefix inside the set
+uint32_t        ds_string_view_cspan(const ds_StringView* view, const ds_ByteSet* set); // length of the prefix outside the set
 int32_t         ds_string_view_find_substr(const ds_StringView* view, const ds_StringView* substr);
+size_t          ds_searcher_init(ds_Searcher* searcher, const ds_StringView* needle);
+int32_t         ds_searcher_find(const ds_Searcher* searcher, const ds_StringView* haystack);
+
+size_t          ds_match_iter_init(ds_MatchIter* iter, const ds_StringView* haystack, const ds_StringView* needle, uint32_t flags);
+void            ds_match_iter_reset(ds_MatchIter* iter, const ds_StringView* haystack);
+bool            ds_match_iter_next(ds_MatchIter* iter, uint32_t* offset); // false once there are no more matches
+// writes up to capacity offsets and returns the number of matches, which can be bigger than capacity
+size_t          ds_string_view_find_all(const ds_StringView* view, const ds_StringView* needle, uint32_t* offsets, size_t capacity, uint32_t flags);
+
+// multi pattern, every (pattern, offset) is reported ordered by where the match ends. empty patterns never match
+ds_MultiMatcher* ds_init_multi_matcher(const ds_StringView* patterns, size_t count);
+void            ds_free_multi_matcher(ds_MultiMatcher* matcher);
+size_t          ds_multi_matcher_scan(const ds_MultiMatcher* matcher, const ds_StringView* view, ds_Match* matches, size_t capacity); // returns the number of matches, can be bigger than capacity
 
 bool            ds_string_view_starts_with(const ds_StringView* view, const ds_StringView* prefix);
 bool            ds_string_view_ends_with(const ds_StringView* view, const ds_StringView* suffix);
@@ -121,14 +422,85 @@ void            ds_string_view_print(const ds_StringView* view);
 const char*     ds_string_view_get_data(const ds_StringView* view);
 uint32_t        ds_string_view_get_length(const ds_StringView* view);
 
+// the whole view has to be the number, out of range values are clamped and report DS_OVERFLOW
 int32_t         ds_string_view_to_int(const ds_StringView* view, bool* success);
-double          ds_string_view_to_double(const ds_StringView* view, bool* success);
+int64_t         ds_string_view_to_i64(const ds_StringView* view, bool* success);
+uint64_t        ds_string_view_to_u64(const ds_StringView* view, bool* success);
+uint64_t        ds_string_view_to_hex(const ds_StringView* view, bool* success); // optional 0x prefix
+double          ds_string_view_to_double(const ds_StringView* view, bool* success); // also inf, infinity and nan
+
+size_t          ds_split_iter_init_char(ds_SplitIter* iter, const ds_StringView* view, char delimiter, uint32_t flags);
+size_t          ds_split_iter_init_string(ds_SplitIter* iter, const ds_StringView* view, const ds_StringView* delimiter, uint32_t flags);
+size_t          ds_split_iter_init_set(ds_SplitIter* iter, const ds_StringView* view, const ds_ByteSet* delimiters, uint32_t flags);
+bool            ds_split_iter_next(ds_SplitIter* iter, ds_StringView* token); // false once the view is used up
+ds_StringViewArray* ds_split_iter_collect(ds_SplitIter* iter); // remaining tokens in one exact size allocation
+size_t          ds_split_iter_append(ds_SplitIter* iter, ds_SmallViewArray* array); // pushes the remaining tokens
+
+// small view array, clear keeps the storage so a reused array stops allocating
+void            ds_small_view_array_init(ds_SmallViewArray* array);
+void            ds_small_view_array_init_allocator(ds_SmallViewArray* array, const ds_Allocator* allocator); // ds_arena_allocator for arena backing
+void            ds_small_view_array_deinit(ds_SmallViewArray* array);
+size_t          ds_small_view_array_reserve(ds_SmallViewArray* array, size_t capacity);
+size_t          ds_small_view_array_push(ds_SmallViewArray* array, const ds_StringView* view);
+void            ds_small_view_array_clear(ds_SmallViewArray* array);
 
 ds_StringViewArray* ds_string_view_split(const ds_StringView* view, char split);
 void            ds_free_string_view_array(ds_StringViewArray* array);
 
+// map, lookups take a view, a C string or a ds_String without copying the key.
+// the returned value slot stays valid until the next insert or remove
+ds_Map*         ds_init_map(void);
+ds_Map*         ds_init_map_allocator(const ds_Allocator* allocator);
+void            ds_free_map(ds_Map* map);
+void            ds_map_clear(ds_Map* map); // keeps the table
+size_t          ds_map_count(const ds_Map* map);
+size_t          ds_map_reserve(ds_Map* map, size_t count);
+size_t          ds_map_insert(ds_Map* map, ds_String* key, void* value); // replaces the value of an existing key
+size_t          ds_map_insert_view(ds_Map* map, const ds_StringView* key, void* value);
+void**          ds_map_get(const ds_Map* map, const ds_StringView* key); // NULL if the key is missing
+void**          ds_map_get_cstr(const ds_Map* map, const char* key);
+void**          ds_map_get_string(const ds_Map* map, ds_String* key); // uses the cached hash of heap strings
+bool            ds_map_remove(ds_Map* map, const ds_StringView* key);
+bool            ds_map_next(const ds_Map* map, size_t* cursor, ds_StringView* key, void** value); // cursor starts at 0, order is unspecified
+
+// interning, safe to call from any thread. interned strings live as long as their table,
+// must not be changed or freed, and equal contents give the same pointer. they are always
+// terminated, so ds_cdata is a C string for them. ds_string_view_hash(view, 0) gives the
+// value ds_string_hash would, without writing the hash cache other threads read
+const ds_String* ds_intern(const ds_StringView* view); // process wide table
+const ds_String* ds_intern_lookup(uint32_t id);
+uint32_t        ds_intern_id(const ds_String* interned); // dense, in the order strings were first seen
+ds_InternTable* ds_init_intern_table(void); // uses the global allocator
+ds_InternTable* ds_init_intern_table_allocator(const ds_Allocator* allocator); // for the table and its slots, entries live in arenas
+void            ds_free_intern_table(ds_InternTable* table); // no other thread may use the table anymore
+const ds_String* ds_intern_table_intern(ds_InternTable* table, const ds_StringView* view);
+const ds_String* ds_intern_table_lookup(ds_InternTable* table, uint32_t id); // NULL for ids not handed out yet
+size_t          ds_intern_table_count(ds_InternTable* table);
+
+// files. a mapping is not NUL terminated and stays valid until ds_unmap_file,
+// files without a size (procfs) and systems without mmap get the file read into memory instead
+size_t          ds_map_file(ds_MappedFile* file, const char* path, uint32_t flags); // flags are DS_FILE_FLAG
+void            ds_unmap_file(ds_MappedFile* file);
+size_t          ds_read_file(ds_String* string, const char* path); // replaces the content on success only, one allocation for regular files
+
+// line reader, lines come without the \n and the last one may lack it in the file as well
+size_t          ds_line_reader_init(ds_LineReader* reader, int fd, size_t capacity, uint32_t flags); // 0 for DS_LINE_READER_DEFAULT_CAPACITY, flags are DS_LINE_FLAG
+void            ds_line_reader_deinit(ds_LineReader* reader); // leaves the fd open
+bool            ds_line_reader_next(ds_LineReader* reader, ds_StringView* line); // false at the end or after a failed read (error is set)
+
+// arena
+ds_Arena*       ds_init_arena(size_t block_size); // 0 for DS_ARENA_DEFAULT_BLOCK_SIZE
+void            ds_free_arena(ds_Arena* arena);
+void            ds_arena_reset(ds_Arena* arena); // invalidates every string allocated from the arena
+void*           ds_arena_alloc(ds_Arena* arena, size_t size);
+void*           ds_arena_realloc(ds_Arena* arena, void* ptr, size_t old_size, size_t new_size);
+const ds_Allocator* ds_arena_allocator(ds_Arena* arena);
+
+ds_String*      ds_init_string_arena(ds_Arena* arena, const char* string);
+ds_StringViewArray* ds_string_view_split_arena(ds_Arena* arena, const ds_StringView* view, char split);
+
 // Erroc management
-static ds_ErrorInfo ds_last_error = {0};
+static ds_ErrorInfo ds_last_error = {DS_OK};
 static bool ds_error_login_enabled = true;
 
 void ds_default_error_callback(const ds_ErrorInfo* error);
@@ -155,40 +527,254 @@ void ds_clear_last_error();
 const char* ds_error_string(DS_RESULT result);
 
 // helper
+#ifdef DS_COMPACT_STRING
+
+static inline bool ds_is_heap(const ds_String* string) {
+    return (string->flags & DS_COMPACT_HEAP_MARK) != 0;
+}
+
+static inline size_t ds_length(const ds_String* string) {
+    return ds_is_heap(string) ? string->heap_length
+        : (uint32_t)(DS_SMALL_STRING_CAPACITY - (uint8_t)string->stack_data[DS_SMALL_STRING_CAPACITY]);
+}
+
+static inline void ds_set_length(ds_String* string, size_t length) {
+    if (ds_is_heap(string)) string->heap_length = length;
+    else string->stack_data[DS_SMALL_STRING_CAPACITY] = (char)(DS_SMALL_STRING_CAPACITY - length);
+}
+
+static inline size_t ds_capacity(const ds_String* string) {
+    return ds_is_heap(string) ? string->capacity : DS_STACK_CAPACITY;
+}
+
+static inline void ds_set_capacity(ds_String* string, size_t capacity) {
+    if (ds_is_heap(string)) string->capacity = capacity;
+}
+
+// the caller sets the length right after switching modes
+static inline void ds_set_is_heap(ds_String* string) {
+    if (!ds_is_heap(string)) string->flags = DS_COMPACT_HEAP_MARK | DS_IS_HEAP | DS_STICKY_HEAP;
+}
+
+static inline void ds_set_is_stack(ds_String* string) {
+    string->stack_data[DS_SMALL_STRING_CAPACITY] = DS_SMALL_STRING_CAPACITY;
+}
+
+static inline void ds_set_sticky_heap(ds_String* string) {
+    if (ds_is_heap(string)) string->flags |= DS_STICKY_HEAP;
+}
+
+static inline bool ds_has_sticky_heap(const ds_String* string) {
+    return ds_is_heap(string) && (string->flags & DS_STICKY_HEAP) != 0;
+}
+
+static inline bool ds_is_shared(const ds_String* string) {
+    return ds_is_heap(string) && (string->flags & DS_SHARED) != 0;
+}
+
+static inline void ds_set_shared(ds_String* string, bool shared) {
+    if (!ds_is_heap(string)) return;
+    string->flags = shared ? string->flags | DS_SHARED : string->flags & ~DS_SHARED;
+}
+
+static inline bool ds_is_read_only(const ds_String* string) {
+    return ds_is_heap(string) && (string->flags & DS_READ_ONLY) != 0;
+}
+
+static inline bool ds_owns_memory(const ds_String* string) {
+    return ds_is_heap(string) && (string->flags & DS_OWNS_MEM) != 0;
+}
+
+// owned buffers are writable and freed with the string, borrowed ones are neither
+static inline void ds_set_owns_memory(ds_String* string, bool owned) {
+    if (!ds_is_heap(string)) return;
+    string->flags = owned ? (string->flags | DS_OWNS_MEM) & ~DS_READ_ONLY : (string->flags | DS_READ_ONLY) & ~DS_OWNS_MEM;
+}
+
+// turns raw storage into an empty stack string
+static inline void ds_string_reset(ds_String* string) {
+    string->stack_data[0] = '\0';
+    string->stack_data[DS_SMALL_STRING_CAPACITY] = DS_SMALL_STRING_CAPACITY;
+}
+
+// the global allocator, from here on ds_set_allocator refuses to swap it
+const ds_Allocator* ds_compact_string_allocator(void);
+
+static inline const ds_Allocator* ds_string_allocator(const ds_String* string) {
+    (void)string;
+    return ds_compact_string_allocator();
+}
+
+static inline void ds_string_set_allocator(ds_String* string, const ds_Allocator* allocator) {
+    (void)string; (void)allocator;
+}
+
+// no room for a hash in the compact layout
+static inline bool ds_string_cached_hash(const ds_String* string, uint64_t* hash) {
+    (void)string; (void)hash;
+    return false;
+}
+
+static inline void ds_string_cache_hash(ds_String* string, uint64_t hash) {
+    (void)string; (void)hash;
+}
+
+#else
+
 static inline bool ds_is_heap(const ds_String* string) {
     return (string->flags & DS_IS_HEAP) != 0;
 }
 
-static inline bool ds_is_stack(const ds_String* string) {
-    return (string->flags & DS_IS_HEAP) == 0;
+static inline size_t ds_length(const ds_String* string) {
+    return string->length;
 }
 
-static inline bool ds_is_empty(const ds_String* string) {
-    return string->length == 0;
+// every change to the content goes through here, so this is where the cached hash dies
+static inline void ds_set_length(ds_String* string, size_t length) {
+    string->length = length;
+    string->flags &= ~DS_HASH_CACHED;
 }
 
-static inline char* ds_data(ds_String* string) {
-    return ds_is_heap(string) ? string->heap_data : string->stack_data;
+static inline size_t ds_capacity(const ds_String* string) {
+    return string->capacity;
+}
+
+static inline void ds_set_capacity(ds_String* string, size_t capacity) {
+    string->capacity = capacity;
 }
 
 static inline void ds_set_is_heap(ds_String* string) {
-    string->flags |= DS_IS_HEAP;
+    string->flags = (string->flags | DS_IS_HEAP) & ~DS_HASH_CACHED;
 }
 
 static inline void ds_set_is_stack(ds_String* string) {
-    string->flags &= ~DS_IS_HEAP;
+    string->flags &= ~(DS_IS_HEAP | DS_OWNS_MEM | DS_READ_ONLY | DS_HASH_CACHED | DS_SHARED);
 }
 
 static inline void ds_set_sticky_heap(ds_String* string) {
     string->flags |= DS_STICKY_HEAP;
 }
 
+static inline bool ds_has_sticky_heap(const ds_String* string) {
+    return (string->flags & DS_STICKY_HEAP) != 0;
+}
+
+static inline bool ds_is_shared(const ds_String* string) {
+    return (string->flags & DS_SHARED) != 0;
+}
+
+static inline void ds_set_shared(ds_String* string, bool shared) {
+    string->flags = shared ? string->flags | DS_SHARED : string->flags & ~DS_SHARED;
+}
+
+static inline bool ds_is_read_only(const ds_String* string) {
+    return (string->flags & DS_READ_ONLY) != 0;
+}
+
+static inline bool ds_owns_memory(const ds_String* string) {
+    return (string->flags & DS_OWNS_MEM) != 0;
+}
+
+// owned buffers are writable and freed with the string, borrowed ones are neither
+static inline void ds_set_owns_memory(ds_String* string, bool owned) {
+    string->flags = owned ? (string->flags | DS_OWNS_MEM) & ~DS_READ_ONLY : (string->flags | DS_READ_ONLY) & ~DS_OWNS_MEM;
+}
+
+// turns raw storage into an empty stack string
+static inline void ds_string_reset(ds_String* string) {
+    string->length = 0;
+    string->capacity = DS_STACK_CAPACITY;
+    string->flags = 0;
+    string->stack_data[0] = '\0';
+}
+
+static inline const ds_Allocator* ds_string_allocator(const ds_String* string) {
+    return string->allocator;
+}
+
+static inline void ds_string_set_allocator(ds_String* string, const ds_Allocator* allocator) {
+    string->allocator = allocator;
+}
+
+static inline bool ds_string_cached_hash(const ds_String* string, uint64_t* hash) {
+    if (!(string->flags & DS_HASH_CACHED)) return false;
+    *hash = string->heap_hash;
+    return true;
+}
+
+// stack strings are short enough to rehash
+static inline void ds_string_cache_hash(ds_String* string, uint64_t hash) {
+    if (!ds_is_heap(string)) return;
+    string->heap_hash = hash;
+    string->flags |= DS_HASH_CACHED;
+}
+
+#endif
+
+static inline bool ds_is_stack(const ds_String* string) {
+    return !ds_is_heap(string);
+}
+
+static inline bool ds_is_empty(const ds_String* string) {
+    return ds_length(string) == 0;
+}
+
+// shared strings must not be written through this, and a shared substring is only terminated after ds_to_c_str
+static inline char* ds_data(ds_String* string) {
+    return ds_is_heap(string) ? string->heap_data : string->stack_data;
+}
+
+// read only access, a shared substring is not terminated so use it with ds_length
+static inline const char* ds_cdata(const ds_String* string) {
+    return ds_is_heap(string) ? string->heap_data : string->stack_data;
+}
+
 static inline bool ds_has_valid_heap_data(const ds_String* string) {
     return (ds_is_heap(string) && string->heap_data);
 }
 
-static inline bool ds_has_sticky_heap(const ds_String* string) {
-    return (string->flags & DS_STICKY_HEAP) != 0;
+static inline void* ds_allocator_alloc(const ds_Allocator* allocator, size_t size) {
+    return allocator ? allocator->alloc(allocator->context, size) : malloc(size);
+}
+
+static inline void* ds_allocator_realloc(const ds_Allocator* allocator, void* ptr, size_t old_size, size_t new_size) {
+    return allocator ? allocator->realloc(allocator->context, ptr, old_size, new_size) : realloc(ptr, new_size);
+}
+
+static inline void ds_allocator_free(const ds_Allocator* allocator, void* ptr, size_t size) {
+    if (allocator) allocator->free(allocator->context, ptr, size);
+    else free(ptr);
+}
+
+static inline void* ds_string_alloc_buffer(ds_String* string, size_t size) {
+    return ds_allocator_alloc(ds_string_allocator(string), size);
+}
+
+static inline void* ds_string_realloc_buffer(ds_String* string, void* ptr, size_t old_size, size_t new_size) {
+    return ds_allocator_realloc(ds_string_allocator(string), ptr, old_size, new_size);
+}
+
+static inline void ds_string_free_buffer(ds_String* string, void* ptr, size_t size) {
+    ds_allocator_free(ds_string_allocator(string), ptr, size);
+}
+
+// switches a stack string over to an already filled heap buffer
+static inline void ds_string_set_heap_buffer(ds_String* string, char* buffer, size_t length, size_t capacity) {
+    string->heap_data = buffer;
+    ds_set_is_heap(string);
+    ds_set_length(string, length);
+    ds_set_capacity(string, capacity);
+    ds_set_owns_memory(string, true);
+}
+
+// points the string at memory it doesnt own. capacity is how many bytes can be read,
+// only if it is past length does ds_to_c_str look for a terminator there
+static inline void ds_string_set_borrowed_buffer(ds_String* string, const char* data, size_t length, size_t readable) {
+    string->heap_data = (char*)data;
+    ds_set_is_heap(string);
+    ds_set_length(string, length);
+    ds_set_capacity(string, readable);
+    ds_set_owns_memory(string, false);
 }
 
 static inline size_t ds_move_dstring_to_heap(ds_String* string) {
@@ -197,40 +783,32 @@ static inline size_t ds_move_dstring_to_heap(ds_String* string) {
         return -1;
     }
 
-    string->capacity = string->length + 1;
-    char* heap_buffer = (char*)malloc(string->capacity);
+    size_t length = ds_length(string);
+    char* heap_buffer = (char*)ds_string_alloc_buffer(string, length + 1);
     if (!heap_buffer) {
         DS_SET_ERROR(DS_ALLOC_FAIL, "Couldnt allocate heap buffer");
         return -1;
     }
 
-    memcpy(heap_buffer, string->stack_data, string->length + 1);
-    string->heap_data = heap_buffer;
-    ds_set_is_heap(string);
+    memcpy(heap_buffer, string->stack_data, length + 1);
+    ds_string_set_heap_buffer(string, heap_buffer, length, length + 1);
 
     return 0;
 }
 
-static inline size_t ds_move_dsstring_to_stack(ds_String* string) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
-    }
-
-    if (string->length > DS_SMALL_STRING_CAPACITY) {
-        DS_SET_ERROR(DS_INVALID_LENGTH, "Input string is to big for stack");
-        return -1;
-    }
+// releases the heap buffer through its owner, so shared and borrowed strings are safe to pass
+size_t ds_move_dsstring_to_stack(ds_String* string);
 
-    memcpy(string->stack_data, string->heap_data, string->length + 1);
-    string->capacity = DS_STACK_CAPACITY;
-    ds_set_is_stack(string);
+static inline char* ds_string_get_data(ds_String* string) {
+    return ds_data(string);
+}
 
-    return 0;
+static inline bool ds_small_view_array_is_heap(const ds_SmallViewArray* array) {
+    return array->capacity != DS_STACK_CAPACITY;
 }
 
-static inline char* ds_string_get_data(ds_String* string) {
-    return ds_is_heap(string) ? string->heap_data : string->stack_data;
+static inline ds_StringView* ds_small_view_array_data(ds_SmallViewArray* array) {
+    return ds_small_view_array_is_heap(array) ? array->heap_views : array->inline_views;
 }
 
 // private
@@ -1,5 +1,79 @@
 
 #include "../include/drings/drings.h"
+#include "drings_tables.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdatomic.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define malloc_usable_size malloc_size
+#endif
+
+// files are mapped where there is mmap and read with stdio everywhere else
+#include <errno.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DS_HAS_MMAP
+#elif defined(_WIN32)
+#include <io.h>
+#endif
+
+// number parsing falls back to strtod pinned to the C locale
+#include <locale.h>
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#include <xlocale.h>
+#endif
+
+// vector paths are picked at compile time, everything else goes word at a time
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DS_SIMD_AVX2
+#define DS_SIMD_SSSE3
+#define DS_SIMD_SSE2
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define DS_SIMD_SSSE3
+#define DS_SIMD_SSE2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DS_SIMD_SSE2
+#endif
+
+static const ds_Allocator* ds_global_allocator = NULL;
+static double ds_growth_factor = DS_DEFAULT_GROWTH_FACTOR;
+
+#ifdef DS_COMPACT_STRING
+// set once a string has used the global allocator, its buffers have to go back to the same one
+static atomic_bool ds_global_allocator_used;
+
+const ds_Allocator* ds_compact_string_allocator(void) {
+    if (!atomic_load_explicit(&ds_global_allocator_used, memory_order_relaxed)) {
+        atomic_store_explicit(&ds_global_allocator_used, true, memory_order_relaxed);
+    }
+    return ds_global_allocator;
+}
+#endif
+
+void ds_set_allocator(const ds_Allocator* allocator) {
+#ifdef DS_COMPACT_STRING
+    if (allocator != ds_global_allocator && atomic_load_explicit(&ds_global_allocator_used, memory_order_relaxed)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Compact strings already use the global allocator, it cant be changed anymore");
+        return;
+    }
+#endif
+    ds_global_allocator = allocator;
+}
+
+const ds_Allocator* ds_get_allocator() {
+    return ds_global_allocator;
+}
 
 void ds_set_error_callback(ds_ErrorCallback callback) {
     if (callback) ds_error_callback = callback;
@@ -30,6 +104,7 @@ const char* ds_error_string(DS_RESULT result) {
         case DS_INVALID_INPUT:  return "Invalid function input";
         case DS_INVALID_LENGTH: return "Invalid Length";
         case DS_REACHED_UNINTENTIONAL_CONTROL_BLOCK: return "Unintentional control block reached";
+        case DS_OVERFLOW:       return "Value out of range";
         default:                return "Unkown Error";
     }
 }
@@ -44,803 +119,5227 @@ void ds_default_error_callback(const ds_ErrorInfo *error) {
             );
 }
 
-ds_String* ds_init_string(const char* literal) {
-    if (!literal) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input String in NULL");
-        return NULL;
-    }
-
-    ds_String* string = (ds_String*)malloc(sizeof(ds_String));
-    if (!string) {
-        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string failed");
-        return NULL;
-    }
-    
-    size_t lit_length = strlen(literal);
-    
-    // small enoguh for stack?
-    if (lit_length <= DS_SMALL_STRING_CAPACITY) {
-        memcpy(string->stack_data, literal, lit_length + 1);
-        string->length = lit_length;
-        string->capacity = DS_STACK_CAPACITY;
-        ds_set_is_stack(string);
-    }
-    // on the heap
-    else {
-        string->heap_data = (char*)malloc(lit_length + 1);
-        memcpy(string->heap_data, literal, lit_length + 1);
-        string->length = lit_length;
-        string->capacity = lit_length + 1;
-        ds_set_is_heap(string);
+static size_t ds_usable_size(const ds_Allocator* allocator, void* ptr, size_t size) {
+    if (allocator) {
+        return allocator->usable_size ? allocator->usable_size(allocator->context, ptr, size) : size;
     }
-
-    ds_set_sticky_heap(string);
-
-    return string;
+#if defined(__GLIBC__) || defined(__APPLE__)
+    size_t usable = malloc_usable_size(ptr);
+    return usable > size ? usable : size;
+#else
+    return size;
+#endif
 }
 
-void ds_free_string(ds_String* string)  {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return;
-    }
-
+/*  NOTE:
+ *  shared strings point into a refcounted block. the header sits in
+ *  the slack after the terminator of the string that was shared
+ *  first, and the capacity field of every sharer holds the distance
+ *  from its data to the header, so substrings find it as well. the
+ *  sharers only read, every mutator calls ds_string_make_writable
+ *  first, which copies the bytes out or, for the last owner, slides
+ *  them to the front of the block and takes it over. borrowed strings
+ *  (DS_READ_ONLY without DS_OWNS_MEM) go through the same path.
+ */
+typedef struct {
+    atomic_size_t references;
+    char* block; // start of the allocation
+    size_t size; // size of the allocation, handed back to the allocator
+} ds_SharedHeader;
+
+static inline ds_SharedHeader* ds_shared_header(const ds_String* string) {
+    return (ds_SharedHeader*)(string->heap_data + ds_capacity(string));
+}
 
-    if (ds_is_heap(string)) {
-        free(string->heap_data);
-        string->heap_data = NULL;
+// the last reference frees the block
+static void ds_shared_release(ds_String* string) {
+    ds_SharedHeader* header = ds_shared_header(string);
+    if (atomic_fetch_sub_explicit(&header->references, 1, memory_order_acq_rel) == 1) {
+        ds_string_free_buffer(string, header->block, header->size);
     }
-    free(string);
-    string = NULL;
 }
 
-const char* ds_to_c_str(ds_String* string) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return NULL;
-    }
-   
-    if (ds_has_valid_heap_data(string)) {
-        return string->heap_data;
+static void ds_string_release_buffer(ds_String* string) {
+    if (ds_is_shared(string)) {
+        ds_shared_release(string);
     }
-    else {
-        return string->stack_data;
+    else if (ds_owns_memory(string)) {
+        ds_string_free_buffer(string, string->heap_data, ds_capacity(string));
     }
 }
 
-void ds_append(ds_String *string, const char *literal) {
-    if (!literal || !string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
-        return;
-    }
+static inline bool ds_string_needs_detach(const ds_String* string) {
+    return ds_is_shared(string) || ds_is_read_only(string);
+}
 
-    size_t lit_length = strlen(literal);
-    
-    if (string->length + lit_length <= DS_SMALL_STRING_CAPACITY && ds_is_stack(string)) {
-        memcpy(string->stack_data + string->length, literal, lit_length + 1);
-        string->length += lit_length;
+// puts the header behind the terminator of a plain heap string, reallocating only if the slack is too small
+static ds_SharedHeader* ds_string_make_shared(ds_String* string) {
+    if (ds_is_shared(string)) {
+        return ds_shared_header(string);
     }
-    else if (ds_is_stack(string)) {
-        char* heap_buffer = (char*)malloc(string->length + lit_length + 1);
-        if (!heap_buffer) {
-            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer allocation failed");
-            return;
+
+    size_t length = ds_length(string);
+    size_t capacity = ds_capacity(string);
+    size_t offset = (length + _Alignof(ds_SharedHeader)) & ~(size_t)(_Alignof(ds_SharedHeader) - 1);
+
+    if (offset + sizeof(ds_SharedHeader) > capacity) {
+        const ds_Allocator* allocator = ds_string_allocator(string);
+        size_t new_capacity = offset + sizeof(ds_SharedHeader);
+        char* buffer = (char*)ds_allocator_realloc(allocator, string->heap_data, capacity, new_capacity);
+        if (!buffer) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
+            return NULL;
         }
-        memcpy(heap_buffer, string->stack_data, string->length);
-        memcpy(heap_buffer + string->length, literal, lit_length + 1);
-        string->heap_data = heap_buffer;
-        string->length += lit_length;
-        string->capacity = string->length + 1;
-        ds_set_is_heap(string);
+        string->heap_data = buffer;
+        capacity = ds_usable_size(allocator, buffer, new_capacity);
     }
-    else {
-        while (string->capacity <= string->length + lit_length + 1) {
-            string->capacity *= 2;
-            char* heap_buffer = (char*)realloc(string->heap_data, string->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Failed heap buffer reallocation");
-                return;
-            }
-            string->heap_data = heap_buffer;
-        }
-        memcpy(string->heap_data + string->length, literal, lit_length + 1);
-        string->length += lit_length;
-     }
+
+    ds_SharedHeader* header = (ds_SharedHeader*)(string->heap_data + offset);
+    atomic_init(&header->references, 1);
+    header->block = string->heap_data;
+    header->size = capacity;
+
+    ds_set_capacity(string, offset);
+    ds_set_shared(string, true);
+
+    return header;
 }
 
-void ds_append_dstring(ds_String *string, ds_String *append) {
-    if (!string || !append) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
-        return;
-    }
-    
-    if (string->length + append->length <= DS_SMALL_STRING_CAPACITY && ds_is_stack(string) && ds_is_stack(append)) {
-        memcpy(string->stack_data + string->length, append->stack_data, append->length + 1);
-        string->length += append->length;
+// gives a shared or borrowed string its own buffer with room for at least length chars
+static size_t ds_string_detach(ds_String* string, size_t length) {
+    size_t old_length = ds_length(string);
+    if (length < old_length) length = old_length;
+
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested length %zu is to big", length);
+        return -1;
     }
-    else if (ds_is_stack(string) && ds_is_stack(append)) {
-        size_t new_length = string->length + append->length;
-        char* heap_buffer = (char*)malloc(string->length + new_length + 1);
-        if (!heap_buffer) {
-            DS_SET_ERROR(DS_ALLOC_FAIL, "Failed heap buffer allocation");
-            return;
-        }
-        memcpy(heap_buffer, string->stack_data, string->length);
-        memcpy(heap_buffer + string->length, append->stack_data, append->length + 1);
-        string->heap_data = heap_buffer;
-        string->capacity = new_length + 1;
-        string->length = new_length;
-        ds_set_is_heap(string);
-    }
-    else if (ds_is_heap(string)) {
-        size_t new_length = string->length + append->length;
-        char* heap_buffer = NULL;
-        while (string->capacity <= new_length + 1) {
-            string->capacity *= 2;
-            heap_buffer = (char*)realloc(string->heap_data, string->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Failed heap buffer reallocation");
-                return;
-            }
-        }
 
-        if (heap_buffer) {
-            memcpy(heap_buffer, string->heap_data, string->length);
-            string->heap_data = heap_buffer; 
+    // nobody else can see the block anymore, so it is ours to write
+    if (ds_is_shared(string)) {
+        ds_SharedHeader* header = ds_shared_header(string);
+        if (atomic_load_explicit(&header->references, memory_order_acquire) == 1
+                && length < header->size && header->size <= DS_MAX_CAPACITY) {
+            char* block = header->block;
+            size_t size = header->size;
+            memmove(block, string->heap_data, old_length);
+            block[old_length] = '\0';
+            ds_string_set_heap_buffer(string, block, old_length, size);
+            ds_set_shared(string, false);
+            return 0;
         }
+    }
 
-        if (ds_is_stack(append)) {
-            memcpy(string->heap_data + string->length, append->stack_data, append->length + 1);
-        }
-        else {
-            memcpy(string->heap_data + string->length, append->heap_data, append->length + 1);
-        }
-        string->length = new_length;
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    char* buffer = (char*)ds_allocator_alloc(allocator, length + 1);
+    if (!buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer allocation failed");
+        return -1;
     }
+    size_t capacity = ds_usable_size(allocator, buffer, length + 1);
+    if (capacity > DS_MAX_CAPACITY) capacity = DS_MAX_CAPACITY;
+
+    memcpy(buffer, string->heap_data, old_length);
+    buffer[old_length] = '\0';
+    ds_string_release_buffer(string);
+    ds_string_set_heap_buffer(string, buffer, old_length, capacity);
+    ds_set_shared(string, false);
+
+    return 0;
 }
 
+// every mutator calls this before it writes to the buffer
+static inline size_t ds_string_make_writable(ds_String* string) {
+    return ds_string_needs_detach(string) ? ds_string_detach(string, ds_length(string)) : 0;
+}
 
-char ds_pop(ds_String* string) {
+// offset of data inside the chars of string, SIZE_MAX if it points somewhere else.
+// compared as integers, a relational compare of unrelated pointers is undefined
+static inline size_t ds_string_inner_offset(const ds_String* string, const char* data) {
+    uintptr_t begin = (uintptr_t)ds_data((ds_String*)string);
+    uintptr_t position = (uintptr_t)data;
+    return position >= begin && position <= begin + ds_length(string) ? (size_t)(position - begin) : SIZE_MAX;
+}
+
+// a shared substring isnt terminated, so only length chars are copied
+size_t ds_move_dsstring_to_stack(ds_String* string) {
     if (!string) {
         DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
         return -1;
     }
-    
-    if (string->length == 0) {
-        DS_SET_ERROR(DS_INVALID_LENGTH, "Length of the string going under 0");
+
+    if (ds_is_stack(string)) return 0;
+
+    size_t length = ds_length(string);
+    if (length > DS_SMALL_STRING_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Input string is to big for stack");
         return -1;
     }
-    
-    char c = -1;
 
-    if (ds_is_stack(string)) {
-        c = string->stack_data[string->length - 1];
-        string->stack_data[string->length - 1] = '\0';
-        string->length--;
-    }
-    else if (ds_has_valid_heap_data(string) && ds_has_sticky_heap(string)) {
-        c = string->heap_data[string->length - 1];
-        string->heap_data[string->length - 1] = '\0';
-        string->length--;
-    }
-    else if (ds_has_valid_heap_data(string)) {
-        c = string->heap_data[string->length - 1];
+    // stack_data overlaps heap_data, the buffer is let go before it is overwritten
+    char content[DS_SMALL_STRING_CAPACITY + 1];
+    memcpy(content, string->heap_data, length);
+    ds_string_release_buffer(string);
 
-        if (string->length <= DS_SMALL_STRING_CAPACITY) {
-            char* heap_buffer = string->heap_data;
-            memcpy(string->stack_data, heap_buffer, string->length);
-            string->stack_data[string->length - 1] = '\0';
-        }
-        else {
-            string->heap_data[string->length - 1] = '\0';
-        }
+    ds_set_is_stack(string);
+    ds_set_capacity(string, DS_STACK_CAPACITY);
+    memcpy(string->stack_data, content, length);
+    string->stack_data[length] = '\0';
+    ds_set_length(string, length);
 
-        string->length--;
+    return 0;
+}
+
+/*  NOTE:
+ *  every growth path ends up here. the target capacity is
+ *  computed once, so there is at most one (re)allocation.
+ *  exact skips the growth factor, the slack malloc hands
+ *  out anyway is always taken
+ */
+static size_t ds_string_grow(ds_String* string, size_t length, bool exact) {
+    if (ds_string_needs_detach(string)) {
+        return ds_string_detach(string, length);
     }
 
-    return c;
+    size_t capacity = ds_capacity(string);
 
-}
+    if (ds_is_stack(string) ? length <= DS_SMALL_STRING_CAPACITY : length < capacity) {
+        return 0;
+    }
 
-size_t ds_pop_n(ds_String* string, size_t n) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input String is NULL");
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested length %zu is to big", length);
         return -1;
     }
 
-    if (((int32_t)string->length) - (int32_t)n < 0) {
-        DS_SET_ERROR(DS_INVALID_LENGTH, "Length - n < 0");
-        return -1;
+    size_t new_capacity = length + 1;
+    if (!exact) {
+        size_t base = ds_is_stack(string) ? DS_SMALL_STRING_CAPACITY + 1 : capacity;
+        double grown = (double)base * ds_growth_factor;
+        if (grown > DS_MAX_CAPACITY) grown = DS_MAX_CAPACITY;
+        if ((size_t)grown > new_capacity) new_capacity = (size_t)grown;
     }
 
-    // move to stack
-    if ((ds_is_heap(string) && string->length <= DS_SMALL_STRING_CAPACITY && !ds_has_sticky_heap(string))
-            || ds_is_stack(string)) {
-        string->length -= n;
-        
-        if (ds_is_heap(string)) {
-            string->heap_data[string->length] = '\0';
-            ds_move_dsstring_to_stack(string);
-        }
-        else {
-            string->stack_data[string->length] = '\0';
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    char* heap_buffer;
+
+    if (ds_is_heap(string)) {
+        heap_buffer = (char*)ds_allocator_realloc(allocator, string->heap_data, capacity, new_capacity);
+        if (!heap_buffer) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
+            return -1;
         }
+        new_capacity = ds_usable_size(allocator, heap_buffer, new_capacity);
+        if (new_capacity > DS_MAX_CAPACITY) new_capacity = DS_MAX_CAPACITY;
+        string->heap_data = heap_buffer;
+        ds_set_capacity(string, new_capacity);
     }
     else {
-        string->length -= n;
-        string->heap_data[string->length] = '\0';
+        size_t old_length = ds_length(string);
+        heap_buffer = (char*)ds_allocator_alloc(allocator, new_capacity);
+        if (!heap_buffer) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer allocation failed");
+            return -1;
+        }
+        new_capacity = ds_usable_size(allocator, heap_buffer, new_capacity);
+        if (new_capacity > DS_MAX_CAPACITY) new_capacity = DS_MAX_CAPACITY;
+        memcpy(heap_buffer, string->stack_data, old_length + 1);
+        ds_string_set_heap_buffer(string, heap_buffer, old_length, new_capacity);
     }
-    
+
     return 0;
 }
 
-size_t ds_reserve(ds_String *string, size_t n) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
-    }
-        
-    if (ds_is_stack(string)) {
-        ds_move_dstring_to_heap(string);
+void ds_set_growth_factor(double factor) {
+    if (factor <= 1.0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Growth factor %f has to be bigger than 1", factor);
+        return;
     }
 
-    char* heap_buffer = (char*)realloc(string->heap_data, string->capacity + n);
-    if (!heap_buffer) {
-        DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
-        return -1;
-    }
+    ds_growth_factor = factor;
+}
 
-    string->heap_data = heap_buffer;
-    string->capacity += n;
+double ds_get_growth_factor() {
+    return ds_growth_factor;
+}
 
-    return 0;
+// little endian load, so the lowest set bit belongs to the first byte
+static inline uint64_t ds_load_u64_le(const char* data) {
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
 }
 
-size_t ds_clear(ds_String* string) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+static inline uint32_t ds_count_trailing_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    uint32_t count = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        count++;
     }
+    return count;
+#endif
+}
 
-    if (ds_is_stack(string)) {
-        string->stack_data[0] = '\0';
-    }
-    else {
-        string->heap_data[0] = '\0';
+static inline uint32_t ds_bit_length_u64(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return value ? 64 - __builtin_clzll(value) : 0;
+#else
+    uint32_t bits = 0;
+    while (value) {
+        bits++;
+        value >>= 1;
     }
-
-    string->length = 0;
-
-    return 0;
+    return bits;
+#endif
 }
 
-bool ds_equal(ds_String* string0, ds_String* string1) {
-    if (!string0 || !string1) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return false;
-    }
+// index of the first byte that differs, length if there is none
+static size_t ds_mismatch(const char* a, const char* b, size_t length) {
+    size_t i = 0;
 
-    if (string0->length != string1->length) {
-        return false;
+#if defined(DS_SIMD_AVX2)
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (mask) return i + ds_count_trailing_zeros(mask);
     }
-
-    if (ds_is_stack(string0) && ds_is_stack(string1)) {
-        for (int i = 0; i < string0->length; i++) {
-            if (string0->stack_data[i] != string1->stack_data[i]) return false;
-        }
-        return true;
+#endif
+
+#if defined(DS_SIMD_SSE2)
+    for (; i + 16 <= length; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        uint32_t mask = 0xffff ^ (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+        if (mask) return i + ds_count_trailing_zeros(mask);
     }
+#endif
 
-    else if (ds_is_stack(string0) && ds_is_heap(string1)) {
-        for (int i = 0; i < string0->length; i++) {
-            if (string0->stack_data[i] != string1->heap_data[i]) return false;
-        }
-        return true;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t difference = ds_load_u64_le(a + i) ^ ds_load_u64_le(b + i);
+        if (difference) return i + (ds_count_trailing_zeros(difference) >> 3);
     }
 
-    else if (ds_is_heap(string0) && ds_is_stack(string1)) {
-        for (int i = 0; i < string0->length; i++) {
-            if (string0->heap_data[i] != string1->stack_data[i]) return false;
-        }
-        return true;
+    for (; i < length; i++) {
+        if (a[i] != b[i]) return i;
     }
 
-    else if (ds_is_heap(string0) && ds_is_heap(string1)) {
-        for (int i = 0; i < string0->length; i++) {
-            if (string0->heap_data[i] != string1->heap_data[i]) return false;
-        }
-        return true;
-    }
-    
-    DS_SET_ERROR(DS_REACHED_UNINTENTIONAL_CONTROL_BLOCK, "Reached unententionally end of a function");
-    return false;
+    return length;
 }
 
-size_t ds_set(ds_String* string, const char* literal) {
-    if (!string || !literal) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+// memcmp order, a prefix sorts before the longer string
+static int ds_compare_bytes(const char* a, size_t a_length, const char* b, size_t b_length) {
+    size_t length = a_length < b_length ? a_length : b_length;
+    size_t i = ds_mismatch(a, b, length);
+
+    if (i < length) {
+        return (unsigned char)a[i] < (unsigned char)b[i] ? -1 : 1;
     }
 
-    size_t lit_length = strlen(literal);
+    return (a_length > b_length) - (a_length < b_length);
+}
 
-    if (lit_length <= DS_SMALL_STRING_CAPACITY) {
-        // move to stack
-        if (ds_is_heap(string) && !ds_has_sticky_heap(string)) {
-            free(string->heap_data);
-            string->heap_data = NULL;
-            ds_set_is_stack(string);
-            string->capacity = DS_STACK_CAPACITY;
-        }
-        memcpy(string->stack_data, literal, lit_length + 1);
-    }
-    else {
-        if (ds_is_stack(string)) {
-            ds_move_dstring_to_heap(string);
-        }
+static inline uint32_t ds_count_ones(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(value);
+#else
+    uint32_t count = 0;
+    for (; value; value &= value - 1) count++;
+    return count;
+#endif
+}
 
-        while (string->capacity <= lit_length + 1) {
-            string->capacity *= 2;
-            char* heap_buffer = (char*)realloc(string->heap_data, string->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
-                return -1;
-            }
-            string->heap_data = heap_buffer;
-        }
-        memcpy(string->heap_data, literal, lit_length + 1);
+static inline uint32_t ds_highest_bit(uint64_t value) {
+    return ds_bit_length_u64(value) - 1;
+}
+
+static inline uint64_t ds_broadcast_byte(char c) {
+    return 0x0101010101010101ull * (unsigned char)c;
+}
+
+// 0x80 in every zero byte of word. exact, so it can be scanned from either end
+static inline uint64_t ds_zero_byte_mask(uint64_t word) {
+    const uint64_t low_bits = 0x7f7f7f7f7f7f7f7full;
+    return ~(((word & low_bits) + low_bits) | word | low_bits);
+}
+
+#if defined(DS_SIMD_SSE2)
+static inline uint32_t ds_match_mask16(const char* data, __m128i needle) {
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)data), needle));
+}
+#endif
+
+#if defined(DS_SIMD_AVX2)
+static inline uint32_t ds_match_mask32(const char* data, __m256i needle) {
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)data), needle));
+}
+#endif
+
+// one bit per byte of data[0..64) that equals c
+static inline uint64_t ds_match_mask64(const char* data, char c) {
+#if defined(DS_SIMD_AVX2)
+    __m256i needle = _mm256_set1_epi8(c);
+    return ds_match_mask32(data, needle) | (uint64_t)ds_match_mask32(data + 32, needle) << 32;
+#elif defined(DS_SIMD_SSE2)
+    __m128i needle = _mm_set1_epi8(c);
+    return ds_match_mask16(data, needle)
+        | (uint64_t)ds_match_mask16(data + 16, needle) << 16
+        | (uint64_t)ds_match_mask16(data + 32, needle) << 32
+        | (uint64_t)ds_match_mask16(data + 48, needle) << 48;
+#else
+    uint64_t pattern = ds_broadcast_byte(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 8; i++) {
+        uint64_t bytes = ds_zero_byte_mask(ds_load_u64_le(data + i * 8) ^ pattern) >> 7;
+        // gathers the lowest bit of each byte into the top byte
+        mask |= ((bytes * 0x0102040810204080ull) >> 56) << (i * 8);
     }
-    
-    string->length = lit_length; 
+    return mask;
+#endif
+}
 
-    return 0;
+// cheaper than ds_match_mask64 when most blocks dont match: one movemask for all 64 bytes
+static inline bool ds_block_has_byte(const char* data, char c) {
+#if defined(DS_SIMD_AVX2)
+    __m256i needle = _mm256_set1_epi8(c);
+    __m256i first = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)data), needle);
+    __m256i second = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + 32)), needle);
+    return _mm256_movemask_epi8(_mm256_or_si256(first, second)) != 0;
+#elif defined(DS_SIMD_SSE2)
+    __m128i needle = _mm_set1_epi8(c);
+    __m128i matches = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)data), needle),
+                     _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), needle)),
+        _mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), needle),
+                     _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), needle)));
+    return _mm_movemask_epi8(matches) != 0;
+#else
+    uint64_t pattern = ds_broadcast_byte(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 8; i++) {
+        mask |= ds_zero_byte_mask(ds_load_u64_le(data + i * 8) ^ pattern);
+    }
+    return mask != 0;
+#endif
 }
 
 /*  NOTE:
- *  this function can ignore flags of
- *  the string because it is cloning the 
- *  argument string with its flags
+ *  the byte scanners below run 64 bytes per step with unaligned loads.
+ *  once less than a vector is left they reload the last full vector
+ *  overlapping what was already scanned and mask the seen part off,
+ *  short inputs go word at a time.
  */
-size_t ds_clone(ds_String* string, ds_String* clone) {
-    if (!string || !clone) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+static const char* ds_find_byte(const char* data, size_t length, char c) {
+    size_t i = 0;
+
+    for (; i + 64 <= length; i += 64) {
+        if (ds_block_has_byte(data + i, c)) {
+            return data + i + ds_count_trailing_zeros(ds_match_mask64(data + i, c));
+        }
     }
 
-    if (ds_is_stack(string) && ds_is_stack(clone)) {
-        memcpy(string->stack_data, clone->stack_data, clone->length + 1);
+#if defined(DS_SIMD_SSE2)
+    __m128i needle16 = _mm_set1_epi8(c);
+    for (; i + 16 <= length; i += 16) {
+        uint32_t mask = ds_match_mask16(data + i, needle16);
+        if (mask) return data + i + ds_count_trailing_zeros(mask);
     }
-    else if (ds_is_stack(string) && ds_is_heap(clone)) {
-        ds_move_dstring_to_heap(string);
-        if (string->capacity != clone->capacity) {
-            char* heap_buffer = (char*)realloc(string->heap_data, clone->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
-                return -1;
-            }
-            string->heap_data = heap_buffer;
-            string->capacity = clone->capacity;
-        }
-        memcpy(string->heap_data, clone->heap_data, clone->length + 1);
+    if (i < length && length >= 16) {
+        uint32_t mask = ds_match_mask16(data + length - 16, needle16) >> (16 - (length - i));
+        return mask ? data + i + ds_count_trailing_zeros(mask) : NULL;
     }
-    else if (ds_is_heap(string) && ds_is_stack(clone)) {
-        ds_clear(string);
-        ds_move_dsstring_to_stack(string);
-        memcpy(string->stack_data, clone->stack_data, clone->length + 1);
-    }
-    else if (ds_is_heap(string) && ds_is_heap(clone)) {
-        if (string->capacity != clone->capacity) {
-            char* heap_buffer = (char*)realloc(string->heap_data, clone->capacity);
-            if (!heap_buffer) {
-                DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer reallocation failed");
-                return -1;
-            }
-            string->heap_data = heap_buffer;
-            string->capacity = clone->capacity;
-        }
-        memcpy(string->heap_data, clone->heap_data, clone->length + 1);
+#endif
+
+    uint64_t pattern = ds_broadcast_byte(c);
+    for (; i + 8 <= length; i += 8) {
+        uint64_t mask = ds_zero_byte_mask(ds_load_u64_le(data + i) ^ pattern);
+        if (mask) return data + i + (ds_count_trailing_zeros(mask) >> 3);
     }
 
-    string->length = clone->length;
-    string->flags = clone->flags;
+    for (; i < length; i++) {
+        if (data[i] == c) return data + i;
+    }
 
-    return 0;
+    return NULL;
 }
 
-size_t ds_trim_whitespace(ds_String* string) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
-    }
-
-    char* data = ds_is_heap(string) ? string->heap_data : string->stack_data;
+static const char* ds_rfind_byte(const char* data, size_t length, char c) {
+    size_t end = length;
 
-    size_t write = 0;
-    for (size_t read = 0; read < string->length; read++) {
-        if (!isspace((unsigned char)data[read])) {
-            data[write++] = data[read];
+    for (; end >= 64; end -= 64) {
+        if (ds_block_has_byte(data + end - 64, c)) {
+            return data + end - 64 + ds_highest_bit(ds_match_mask64(data + end - 64, c));
         }
     }
 
-    data[write] = '\0';
-    string->length = write;
-    
-    return 0;
-}
+#if defined(DS_SIMD_SSE2)
+    __m128i needle16 = _mm_set1_epi8(c);
+    for (; end >= 16; end -= 16) {
+        uint32_t mask = ds_match_mask16(data + end - 16, needle16);
+        if (mask) return data + end - 16 + ds_highest_bit(mask);
+    }
+    if (end > 0 && length >= 16) {
+        uint32_t mask = ds_match_mask16(data, needle16) & ((1u << end) - 1);
+        return mask ? data + ds_highest_bit(mask) : NULL;
+    }
+#endif
 
-size_t ds_trim_whitespace_flags(ds_String* string, uint32_t flags) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return -1;
+    uint64_t pattern = ds_broadcast_byte(c);
+    for (; end >= 8; end -= 8) {
+        uint64_t mask = ds_zero_byte_mask(ds_load_u64_le(data + end - 8) ^ pattern);
+        if (mask) return data + end - 8 + (ds_highest_bit(mask) >> 3);
     }
 
-    if (flags & DS_ALL) {
-        return ds_trim_whitespace(string);
+    while (end > 0) {
+        end--;
+        if (data[end] == c) return data + end;
     }
 
-    char* data = ds_is_heap(string) ? string->heap_data : string->stack_data;
+    return NULL;
+}
 
-    size_t start = 0, end = string->length;
+static size_t ds_count_byte(const char* data, size_t length, char c) {
+    size_t count = 0;
+    size_t i = 0;
+
+    /*  NOTE:
+     *  matches are summed per byte lane (cmpeq gives -1, so subtract)
+     *  and folded with sad every 255 vectors before a lane overflows
+     */
+#if defined(DS_SIMD_AVX2)
+    __m256i needle32 = _mm256_set1_epi8(c);
+    while (i + 32 <= length) {
+        size_t blocks = (length - i) / 32;
+        if (blocks > 255) blocks = 255;
+
+        __m256i lanes = _mm256_setzero_si256();
+        for (size_t block = 0; block < blocks; block++, i += 32) {
+            __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+            lanes = _mm256_sub_epi8(lanes, _mm256_cmpeq_epi8(chunk, needle32));
+        }
 
-    if (flags & DS_FRONT) {
-        while (start < end && isspace((unsigned char)data[start])) {
-            start++;
+        __m256i sums = _mm256_sad_epu8(lanes, _mm256_setzero_si256());
+        count += (size_t)_mm256_extract_epi64(sums, 0) + (size_t)_mm256_extract_epi64(sums, 1)
+            + (size_t)_mm256_extract_epi64(sums, 2) + (size_t)_mm256_extract_epi64(sums, 3);
+    }
+#endif
+
+#if defined(DS_SIMD_SSE2)
+    __m128i needle16 = _mm_set1_epi8(c);
+    while (i + 16 <= length) {
+        size_t blocks = (length - i) / 16;
+        if (blocks > 255) blocks = 255;
+
+        __m128i lanes = _mm_setzero_si128();
+        for (size_t block = 0; block < blocks; block++, i += 16) {
+            __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+            lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(chunk, needle16));
         }
+
+        __m128i sums = _mm_sad_epu8(lanes, _mm_setzero_si128());
+        count += (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+    if (i < length && length >= 16) {
+        return count + ds_count_ones(ds_match_mask16(data + length - 16, needle16) >> (16 - (length - i)));
     }
+#endif
 
-    if (flags & DS_BACK) {
-        while (end > start && isspace((unsigned char)data[end - 1])) {
-            end--;
-        }
+    uint64_t pattern = ds_broadcast_byte(c);
+    for (; i + 8 <= length; i += 8) {
+        count += ds_count_ones(ds_zero_byte_mask(ds_load_u64_le(data + i) ^ pattern));
     }
 
-    size_t delta_length = end - start;
-    if (start > 0 && delta_length > 0) {
-        memmove(data, data + start, delta_length);
+    for (; i < length; i++) {
+        count += data[i] == c;
     }
-    data[delta_length] = '\0';
-    string->length = delta_length;
 
-    return 0;
+    return count;
 }
 
-ds_String* ds_split(ds_String* string, char seperator) {
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return NULL;
-    }
+// n counts from 0, whole 64 byte blocks are skipped by their popcount
+static const char* ds_find_nth_byte(const char* data, size_t length, char c, size_t n) {
+    size_t i = 0;
+
+    for (; i + 64 <= length; i += 64) {
+        uint64_t mask = ds_match_mask64(data + i, c);
+        size_t matches = ds_count_ones(mask);
+        if (n >= matches) {
+            n -= matches;
+            continue;
+        }
 
-    char* data = ds_is_heap(string) ? string->heap_data : string->stack_data;
+        for (; n > 0; n--) mask &= mask - 1;
+        return data + i + ds_count_trailing_zeros(mask);
+    }
 
-    size_t start;
-    for (start = 0; start < string->length && data[start] != seperator; start++);
-    if (start != string->length) {
-        ds_String* cut = ds_init_string("");
-        ds_clone(cut, string);
-        char* c_data = ds_is_heap(cut) ? cut->heap_data : cut->stack_data;
-        memcpy(c_data, data + start + 1, string->length - start + 1);
-        data[start] = '\0';
-        return cut;
+    for (; i < length; i++) {
+        if (data[i] == c && n-- == 0) return data + i;
     }
 
     return NULL;
 }
 
-ds_StringView ds_string_view_from_cstr(const char *str) {
-    ds_StringView view = {0};
-
-    if (!str) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return view;
-    }
-
-    view.data = str;
-    view.length = strlen(str);
+/*  NOTE:
+ *  nibble lookup: every distinct high nibble in the set gets one of 8
+ *  bits. low_nibbles[lo] holds the bits of the high nibbles that appear
+ *  with lo, high_nibbles[hi] the bit of hi. a byte is in the set when
+ *  both lookups share a bit, that is two pshufb and an and per vector.
+ */
+#if defined(DS_SIMD_SSSE3)
+static inline uint32_t ds_byte_set_mask16(const char* data, __m128i low_table, __m128i high_table) {
+    __m128i chunk = _mm_loadu_si128((const __m128i*)data);
+    __m128i nibble = _mm_set1_epi8(0x0f);
+    __m128i low = _mm_shuffle_epi8(low_table, _mm_and_si128(chunk, nibble));
+    __m128i high = _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble));
+    __m128i miss = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+    return 0xffff ^ (uint32_t)_mm_movemask_epi8(miss);
+}
+#endif
 
-    return view;
+static inline bool ds_byte_set_has(const ds_ByteSet* set, char c) {
+    unsigned char byte = (unsigned char)c;
+    return (set->bits[byte >> 6] >> (byte & 63)) & 1;
 }
 
-ds_StringView ds_string_view_from_string(ds_String *string) {
-    ds_StringView view = {0};
+// first byte that is (member) or is not (!member) in the set
+static const char* ds_find_in_byte_set(const char* data, size_t length, const ds_ByteSet* set, bool member) {
+    size_t i = 0;
 
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return view;
+#if defined(DS_SIMD_SSSE3)
+    if (set->nibble_lookup && length >= 16) {
+        __m128i low_table = _mm_loadu_si128((const __m128i*)set->low_nibbles);
+        __m128i high_table = _mm_loadu_si128((const __m128i*)set->high_nibbles);
+        uint32_t flip = member ? 0 : 0xffff;
+
+        for (; i + 16 <= length; i += 16) {
+            uint32_t mask = ds_byte_set_mask16(data + i, low_table, high_table) ^ flip;
+            if (mask) return data + i + ds_count_trailing_zeros(mask);
+        }
+        if (i < length) {
+            uint32_t mask = (ds_byte_set_mask16(data + length - 16, low_table, high_table) ^ flip) >> (16 - (length - i));
+            if (mask) return data + i + ds_count_trailing_zeros(mask);
+        }
+        return NULL;
     }
+#endif
 
-    view.data = ds_string_get_data(string);
-    view.length = string->length;
+    for (; i < length; i++) {
+        if (ds_byte_set_has(set, data[i]) == member) return data + i;
+    }
 
-    return view;
+    return NULL;
 }
 
-ds_StringView ds_string_view_from_buffer(const char *data, uint32_t length) {
-    ds_StringView view = {0};
+static const char* ds_rfind_in_byte_set(const char* data, size_t length, const ds_ByteSet* set, bool member) {
+    size_t end = length;
 
-    if (!data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input buffer is NULL");
-        return view;
+#if defined(DS_SIMD_SSSE3)
+    if (set->nibble_lookup && length >= 16) {
+        __m128i low_table = _mm_loadu_si128((const __m128i*)set->low_nibbles);
+        __m128i high_table = _mm_loadu_si128((const __m128i*)set->high_nibbles);
+        uint32_t flip = member ? 0 : 0xffff;
+
+        for (; end >= 16; end -= 16) {
+            uint32_t mask = ds_byte_set_mask16(data + end - 16, low_table, high_table) ^ flip;
+            if (mask) return data + end - 16 + ds_highest_bit(mask);
+        }
+        if (end > 0) {
+            uint32_t mask = (ds_byte_set_mask16(data, low_table, high_table) ^ flip) & ((1u << end) - 1);
+            if (mask) return data + ds_highest_bit(mask);
+        }
+        return NULL;
     }
+#endif
 
-    view.data = data;
-    view.length = length;
+    while (end > 0) {
+        end--;
+        if (ds_byte_set_has(set, data[end]) == member) return data + end;
+    }
 
-    return view;
+    return NULL;
 }
 
-ds_StringView ds_string_view_from_substr(const ds_StringView *view, uint32_t start, uint32_t length) {
-    ds_StringView lview = {0};
-
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return lview;
+/*  NOTE:
+ *  short needles: scan for positions where the first and the last
+ *  byte of the needle both match, a whole vector at a time, and only
+ *  compare the middle there. long needles: Two-Way (Crochemore-Perrin)
+ *  with a last byte shift table, linear in the worst case.
+ */
+static const char* ds_search_short(const ds_Searcher* searcher, const char* haystack, size_t length) {
+    const char* needle = searcher->needle.data;
+    size_t needle_length = searcher->needle.length;
+    size_t last = needle_length - 1;
+    size_t i = 0;
+
+#if defined(DS_SIMD_AVX2)
+    __m256i first32 = _mm256_set1_epi8(needle[0]);
+    __m256i last32 = _mm256_set1_epi8(needle[last]);
+    for (; i + last + 32 <= length; i += 32) {
+        uint32_t mask = ds_match_mask32(haystack + i, first32) & ds_match_mask32(haystack + i + last, last32);
+        for (; mask; mask &= mask - 1) {
+            size_t position = i + ds_count_trailing_zeros(mask);
+            if (memcmp(haystack + position + 1, needle + 1, needle_length - 2) == 0) return haystack + position;
+        }
     }
-
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return lview;
+#endif
+
+#if defined(DS_SIMD_SSE2)
+    __m128i first16 = _mm_set1_epi8(needle[0]);
+    __m128i last16 = _mm_set1_epi8(needle[last]);
+    for (; i + last + 16 <= length; i += 16) {
+        uint32_t mask = ds_match_mask16(haystack + i, first16) & ds_match_mask16(haystack + i + last, last16);
+        for (; mask; mask &= mask - 1) {
+            size_t position = i + ds_count_trailing_zeros(mask);
+            if (memcmp(haystack + position + 1, needle + 1, needle_length - 2) == 0) return haystack + position;
+        }
+    }
+#endif
+
+    uint64_t first_pattern = ds_broadcast_byte(needle[0]);
+    uint64_t last_pattern = ds_broadcast_byte(needle[last]);
+    for (; i + last + 8 <= length; i += 8) {
+        uint64_t mask = ds_zero_byte_mask(ds_load_u64_le(haystack + i) ^ first_pattern)
+            & ds_zero_byte_mask(ds_load_u64_le(haystack + i + last) ^ last_pattern);
+        for (; mask; mask &= mask - 1) {
+            size_t position = i + (ds_count_trailing_zeros(mask) >> 3);
+            if (memcmp(haystack + position + 1, needle + 1, needle_length - 2) == 0) return haystack + position;
+        }
     }
 
-    if (start >= view->length) {
-        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
-        return lview;
+    for (; i + last < length; i++) {
+        if (haystack[i] == needle[0] && haystack[i + last] == needle[last]
+            && memcmp(haystack + i + 1, needle + 1, needle_length - 2) == 0) {
+            return haystack + i;
+        }
     }
 
-    uint32_t available_length = view->length - start;
-    uint32_t actual_length = (length > available_length) ? available_length : length;
+    return NULL;
+}
 
-    lview.data = view->data + start;
-    lview.length = actual_length;
+static const char* ds_search_two_way(const ds_Searcher* searcher, const char* haystack, size_t length) {
+    const unsigned char* needle = (const unsigned char*)searcher->needle.data;
+    const unsigned char* h = (const unsigned char*)haystack;
+    const unsigned char* end = h + length;
+    size_t needle_length = searcher->needle.length;
+    size_t critical = searcher->critical;
+    size_t memory = 0;
+
+    while ((size_t)(end - h) >= needle_length) {
+        // the last byte decides how far we can jump
+        size_t shift = searcher->shift[h[needle_length - 1]];
+        if (shift != needle_length) {
+            size_t k = needle_length - shift;
+            h += k < memory ? memory : k;
+            memory = 0;
+            continue;
+        }
 
-    return lview;
-}
+        // right half first, then the left half
+        size_t k = critical + 1 > memory ? critical + 1 : memory;
+        while (k < needle_length && needle[k] == h[k]) k++;
+        if (k < needle_length) {
+            h += k - critical;
+            memory = 0;
+            continue;
+        }
 
-ds_StringView ds_string_view_from_substr_to_end(const ds_StringView *view, uint32_t start) {
-    ds_StringView lview = {0};
+        for (k = critical + 1; k > memory && needle[k - 1] == h[k - 1]; k--);
+        if (k <= memory) return (const char*)h;
 
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return lview;
+        h += searcher->period;
+        memory = searcher->memory;
     }
 
-    if (start >= view->length) {
-        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
-        return lview;
+    return NULL;
+}
+
+// maximal suffix of needle under < or > with its period, the start is returned one too low
+static size_t ds_maximal_suffix(const unsigned char* needle, size_t length, bool reverse, size_t* period) {
+    size_t suffix = (size_t)-1;
+    size_t j = 0;
+    size_t k = 1;
+    size_t p = 1;
+
+    while (j + k < length) {
+        unsigned char a = needle[suffix + k];
+        unsigned char b = needle[j + k];
+        if (a == b) {
+            if (k == p) {
+                j += p;
+                k = 1;
+            }
+            else {
+                k++;
+            }
+        }
+        else if (reverse ? a < b : a > b) {
+            j += k;
+            k = 1;
+            p = j - suffix;
+        }
+        else {
+            suffix = j++;
+            k = p = 1;
+        }
     }
 
-    lview.data = view->data + start;
-    lview.length = view->length - start;
+    *period = p;
+    return suffix;
+}
 
-    return lview;
+static const char* ds_searcher_search(const ds_Searcher* searcher, const char* haystack, size_t length) {
+    size_t needle_length = searcher->needle.length;
+
+    if (needle_length == 0) return haystack;
+    if (needle_length > length) return NULL;
+    if (needle_length == 1) return ds_find_byte(haystack, length, searcher->needle.data[0]);
+    if (needle_length <= DS_SEARCHER_SHORT_NEEDLE) return ds_search_short(searcher, haystack, length);
+
+    return ds_search_two_way(searcher, haystack, length);
 }
 
-ds_StringView ds_string_view_from_string_substr(ds_String *string, uint32_t start, uint32_t length) {
-    ds_StringView view;
+static ds_String* ds_init_string_allocator_n(const ds_Allocator* allocator, const char* data, size_t length);
+static size_t ds_string_init_inplace_allocator_n(ds_String* string, const ds_Allocator* allocator, const char* data, size_t length);
 
-    if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return view;
+ds_String* ds_init_string(const char* literal) {
+    if (!literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input String in NULL");
+        return NULL;
     }
 
-    if (start >= string->length) {
-        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
-        return view;
-    }
+    return ds_init_string_allocator_n(ds_global_allocator, literal, strlen(literal));
+}
 
-    uint32_t available_length = string->length - start;
-    uint32_t actual_length = (length > available_length) ? available_length : length;
+ds_String* ds_init_string_n(const char* data, size_t length) {
+    return ds_init_string_allocator_n(ds_global_allocator, data, length);
+}
 
-    view.data = ds_string_get_data(string) + start;
-    view.length = actual_length;
+ds_String* ds_init_string_allocator(const ds_Allocator* allocator, const char* literal) {
+    if (!literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input String in NULL");
+        return NULL;
+    }
 
-    return view;
+    return ds_init_string_allocator_n(allocator, literal, strlen(literal));
 }
 
-ds_StringView ds_string_view_from_string_substr_to_end(ds_String *string, uint32_t start) {
-    ds_StringView view = {0};
+static ds_String* ds_init_string_allocator_n(const ds_Allocator* allocator, const char* data, size_t length) {
+    if (!data && length) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input String in NULL");
+        return NULL;
+    }
 
+    ds_String* string = (ds_String*)ds_allocator_alloc(allocator, sizeof(ds_String));
     if (!string) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return view;
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string failed");
+        return NULL;
     }
 
-    if (start >= string->length) {
-        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
-        return view;
+    if (ds_string_init_inplace_allocator_n(string, allocator, data, length) != 0) {
+        ds_allocator_free(allocator, string, sizeof(ds_String));
+        return NULL;
     }
 
-    view.data = ds_string_get_data(string) + start;
-    view.length = string->length - start;
-
-    return view;
-
+    return string;
 }
 
-bool ds_string_view_equal(const ds_StringView *view1, const ds_StringView *view2) {
-    if (!view1 || !view2) {
+void ds_free_string(ds_String* string)  {
+    if (!string) {
         DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return false;
-    }
-
-    if (!view1->data || !view2->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return false;
+        return;
     }
 
-    if (view1->length != view2->length) return false;
-    return memcmp(view1->data, view2->data, view1->length) == 0;
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    ds_string_deinit(string);
+    ds_allocator_free(allocator, string, sizeof(ds_String));
+    string = NULL;
 }
 
-bool ds_string_view_equal_cstr(const ds_StringView *view, const char *str) {
-    if (!view || !str) {
+size_t ds_string_init_inplace(ds_String* string, const char* literal) {
+    if (!string || !literal) {
         DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return false;
-    }
-
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return false;
+        return -1;
     }
 
-    if (view->length != strlen(str)) return false;
-    return memcmp(view->data, str, view->length) == 0;
+    return ds_string_init_inplace_allocator_n(string, ds_global_allocator, literal, strlen(literal));
 }
 
-bool ds_string_view_is_empty(const ds_StringView *view) {
-    return (!view || view->length) == 0;
+size_t ds_string_init_inplace_n(ds_String* string, const char* data, size_t length) {
+    return ds_string_init_inplace_allocator_n(string, ds_global_allocator, data, length);
 }
 
-int32_t ds_string_view_find_char(const ds_StringView *view, char c) {
-    if (!view) {
+size_t ds_string_init_inplace_allocator(ds_String* string, const ds_Allocator* allocator, const char* literal) {
+    if (!string || !literal) {
         DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
         return -1;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return false;
-    }
-
-    for (size_t i = 0; i < view->length; i++) {
-        if (view->data[i] == c) return (int32_t)i;
-    }
-
-    return -1;
+    return ds_string_init_inplace_allocator_n(string, allocator, literal, strlen(literal));
 }
 
-int32_t ds_string_view_find_substr(const ds_StringView *view, const ds_StringView *substr) {
-    if (!view || !substr || !view->data || !substr->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or substr is NULL or has no data");
+static size_t ds_string_init_inplace_allocator_n(ds_String* string, const ds_Allocator* allocator, const char* data, size_t length) {
+    if (!string || (!data && length)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
         return -1;
     }
 
-    if (substr->length == 0) {
-        return 0;
+#ifdef DS_COMPACT_STRING
+    if (allocator != ds_compact_string_allocator()) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Compact strings only support the global allocator");
+        return -1;
     }
+#endif
 
-    if (substr->length > view->length) {
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested length %zu is to big", length);
         return -1;
     }
 
-    for (size_t i = 0; i < view->length - substr->length; i++) {
-        if (memcmp(view->data + i, substr->data, substr->length) == 0) {
-            return (int32_t)i;
+    ds_string_reset(string);
+    ds_string_set_allocator(string, allocator);
+    
+    // small enoguh for stack?
+    if (length <= DS_SMALL_STRING_CAPACITY) {
+        memcpy(string->stack_data, data, length);
+        string->stack_data[length] = '\0';
+        ds_set_length(string, length);
+    }
+    // on the heap
+    else {
+        char* heap_buffer = (char*)ds_allocator_alloc(allocator, length + 1);
+        if (!heap_buffer) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Heap buffer allocation failed");
+            return -1;
         }
+        memcpy(heap_buffer, data, length);
+        heap_buffer[length] = '\0';
+        ds_string_set_heap_buffer(string, heap_buffer, length, length + 1);
     }
 
-    return -1;
+    ds_set_sticky_heap(string);
+
+    return 0;
 }
 
-bool ds_string_view_starts_with(const ds_StringView *view, const ds_StringView *prefix) {
-    if (!view || !prefix || !view->data || !prefix->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or prefix is NULL or has no data");
-        return false;
+void ds_string_deinit(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return;
     }
 
-    if (prefix->length == 0) return true;
-    if (prefix->length > view->length) return false;
-
-    if (memcmp(view->data, prefix->data, prefix->length) == 0) return true;
+    if (ds_is_heap(string)) {
+        ds_string_release_buffer(string);
+    }
 
-    return false;
+    // leave an empty stack string behind so it can be reused
+    ds_string_reset(string);
 }
 
-bool ds_string_view_ends_with(const ds_StringView *view, const ds_StringView *suffix) {
-    if (!view || !suffix || !view->data || !suffix->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or suffix is NULL or has no data");
-        return false;
+static size_t ds_string_wrap_readable(ds_String* string, const char* data, size_t length, size_t readable) {
+    if (!string || (!data && length)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or data is NULL");
+        return -1;
     }
 
-    if (suffix->length == 0) return true;
-    if (suffix->length > view->length) return false;
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested length %zu is to big", length);
+        return -1;
+    }
 
-    if (memcmp(view->data + view->length - suffix->length, suffix->data, suffix->length) == 0) return true;
+    ds_string_reset(string);
+    ds_string_set_allocator(string, ds_global_allocator);
 
-    return false;
+    if (data) {
+        ds_string_set_borrowed_buffer(string, data, length, readable);
+    }
 
+    return 0;
 }
 
-ds_String* ds_string_from_view(const ds_StringView* view) {
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+static ds_String* ds_init_string_wrap(const char* data, size_t length, size_t readable) {
+    ds_String* string = (ds_String*)ds_allocator_alloc(ds_global_allocator, sizeof(ds_String));
+    if (!string) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string failed");
         return NULL;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+    if (ds_string_wrap_readable(string, data, length, readable) != 0) {
+        ds_allocator_free(ds_global_allocator, string, sizeof(ds_String));
         return NULL;
     }
 
-    ds_String* string = ds_init_string(view->data);
     return string;
 }
 
-ds_StringView ds_string_view_trim_whitespace(const ds_StringView *view) {
-    ds_StringView result = {0};
+ds_String* ds_string_wrap(const char* data, size_t length) {
+    return ds_init_string_wrap(data, length, length);
+}
 
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return result;
+ds_String* ds_string_wrap_cstr(const char* literal) {
+    if (!literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input literal is NULL");
+        return NULL;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
-        return result;
-    }
+    size_t length = strlen(literal);
+    return ds_init_string_wrap(literal, length, length + 1);
+}
 
-    char data[view->length];
-    uint32_t index = 0;
+size_t ds_string_wrap_inplace(ds_String* string, const char* data, size_t length) {
+    return ds_string_wrap_readable(string, data, length, length);
+}
 
-    for (size_t i = 0; i < view->length; i++) {
-        if (view->data[i] != ' ') {
-            data[index++] = view->data[i];
-        }
+size_t ds_string_adopt_inplace(ds_String* string, char* data, size_t length, size_t capacity) {
+    if (!string || !data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or data is NULL");
+        return -1;
     }
 
-    result = ds_string_view_from_buffer(data, index);
-    
-    return result;
+    if (capacity <= length || capacity > DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Capacity %zu cant hold %zu chars and the terminator", capacity, length);
+        return -1;
+    }
+
+    ds_string_reset(string);
+    ds_string_set_allocator(string, ds_global_allocator);
+
+    data[length] = '\0';
+    ds_string_set_heap_buffer(string, data, length, capacity);
+
+    return 0;
 }
 
-void ds_string_view_print(const ds_StringView *view) {
-    if (!view) {
+ds_String* ds_string_adopt(char* data, size_t length, size_t capacity) {
+    ds_String* string = (ds_String*)ds_allocator_alloc(ds_global_allocator, sizeof(ds_String));
+    if (!string) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string failed");
+        return NULL;
+    }
+
+    if (ds_string_adopt_inplace(string, data, length, capacity) != 0) {
+        ds_allocator_free(ds_global_allocator, string, sizeof(ds_String));
+        return NULL;
+    }
+
+    return string;
+}
+
+/*  NOTE:
+ *  an owned heap buffer is handed out as is. stack strings and
+ *  borrowed memory are copied, shared buffers are detached first
+ *  (which is free for the last owner). either way the buffer comes
+ *  from the allocator of the string and belongs to the caller.
+ */
+char* ds_string_release(ds_String* string, size_t* length, size_t* capacity) {
+    if (!string || !length) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or length is NULL");
+        return NULL;
+    }
+
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    size_t string_length = ds_length(string);
+    size_t buffer_capacity;
+    char* buffer;
+
+    if (ds_is_heap(string)) {
+        if (ds_string_make_writable(string) != 0) {
+            return NULL;
+        }
+        buffer = string->heap_data;
+        buffer_capacity = ds_capacity(string);
+    }
+    else {
+        buffer_capacity = string_length + 1;
+        buffer = (char*)ds_allocator_alloc(allocator, buffer_capacity);
+        if (!buffer) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", buffer_capacity);
+            return NULL;
+        }
+        memcpy(buffer, string->stack_data, string_length + 1);
+    }
+
+    ds_string_reset(string);
+    ds_string_set_allocator(string, allocator);
+
+    *length = string_length;
+    if (capacity) *capacity = buffer_capacity;
+
+    return buffer;
+}
+
+const char* ds_to_c_str(ds_String* string) {
+    if (!string) {
         DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return NULL;
+    }
+   
+    // a shared substring can end in the middle of its block, borrowed memory might not be terminated at all
+    size_t length = ds_length(string);
+    if (ds_string_needs_detach(string) && (length >= ds_capacity(string) || string->heap_data[length] != '\0')) {
+        if (ds_string_make_writable(string) != 0) {
+            return NULL;
+        }
+    }
+
+    if (ds_has_valid_heap_data(string)) {
+        return string->heap_data;
+    }
+    else {
+        return string->stack_data;
+    }
+}
+
+void ds_append(ds_String *string, const char *literal) {
+    if (!literal || !string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
         return;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+    ds_append_n(string, literal, strlen(literal));
+}
+
+void ds_append_n(ds_String* string, const char* data, size_t n) {
+    if (!string || (!data && n)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
         return;
     }
 
-    printf("%s\n", view->data);
+    size_t length = ds_length(string);
+
+    // data may be a piece of string itself, growing can move or free it
+    size_t offset = ds_string_inner_offset(string, data);
+    if (offset != SIZE_MAX && offset + n > length) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Data runs past the end of the string");
+        return;
+    }
+
+    if (ds_string_grow(string, length + n, false) != 0) {
+        return;
+    }
+
+    char* string_data = ds_data(string);
+    if (offset != SIZE_MAX) data = string_data + offset;
+    memcpy(string_data + length, data, n);
+    string_data[length + n] = '\0';
+    ds_set_length(string, length + n);
 }
 
-const char* ds_string_view_get_data(const ds_StringView* view) {
-    if (!view) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
-        return NULL;
+void ds_append_view(ds_String* string, const ds_StringView* view) {
+    if (!string || !view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or view is NULL");
+        return;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+    ds_append_n(string, view->data, view->length);
+}
+
+size_t ds_appendf(ds_String* string, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    size_t result = ds_vappendf(string, format, args);
+    va_end(args);
+
+    return result;
+}
+
+/*  NOTE:
+ *  formats straight into the spare capacity. if it doesnt fit
+ *  vsnprintf told us the exact length, so one grow and one
+ *  more pass are always enough
+ */
+size_t ds_vappendf(ds_String* string, const char* format, va_list args) {
+    if (!string || !format) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or format is NULL");
+        return -1;
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+
+    size_t length = ds_length(string);
+    size_t spare = (ds_is_heap(string) ? ds_capacity(string) : DS_SMALL_STRING_CAPACITY + 1) - length;
+
+    va_list retry;
+    va_copy(retry, args);
+    int written = vsnprintf(ds_data(string) + length, spare, format, args);
+
+    if (written < 0) {
+        va_end(retry);
+        ds_data(string)[length] = '\0';
+        DS_SET_ERROR(DS_INVALID_INPUT, "Invalid format string");
+        return -1;
+    }
+
+    if ((size_t)written >= spare) {
+        // a truncated pass can clobber the compact length byte
+        ds_data(string)[length] = '\0';
+        ds_set_length(string, length);
+
+        if (ds_string_grow(string, length + written, false) != 0) {
+            va_end(retry);
+            return -1;
+        }
+        vsnprintf(ds_data(string) + length, (size_t)written + 1, format, retry);
+    }
+    va_end(retry);
+
+    ds_set_length(string, length + written);
+
+    return 0;
+}
+
+static const char ds_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// index 0 is 0 so that ds_count_digits_u64(0) == 1
+static const uint64_t ds_digit_thresholds[20] = {
+    0ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull,
+};
+
+// log10 estimate from the bit length, corrected with one compare
+static inline uint32_t ds_count_digits_u64(uint64_t value) {
+    uint32_t t = (ds_bit_length_u64(value | 1) * 1233) >> 12;
+    return t - (value < ds_digit_thresholds[t]) + 1;
+}
+
+// writes exactly ds_count_digits_u64(value) chars, no terminator
+static size_t ds_write_u64(char* out, uint64_t value) {
+    size_t digits = ds_count_digits_u64(value);
+    char* write = out + digits;
+
+    while (value >= 100) {
+        uint32_t pair = (uint32_t)(value % 100) * 2;
+        value /= 100;
+        write -= 2;
+        write[0] = ds_digit_pairs[pair];
+        write[1] = ds_digit_pairs[pair + 1];
+    }
+
+    if (value >= 10) {
+        uint32_t pair = (uint32_t)value * 2;
+        write -= 2;
+        write[0] = ds_digit_pairs[pair];
+        write[1] = ds_digit_pairs[pair + 1];
+    }
+    else {
+        *--write = (char)('0' + value);
+    }
+
+    return digits;
+}
+
+// makes room for max_length more chars and returns where they go
+static char* ds_append_begin(ds_String* string, size_t max_length) {
+    size_t length = ds_length(string);
+    if (ds_string_grow(string, length + max_length, false) != 0) {
         return NULL;
     }
 
-    return view->data;
-} 
+    return ds_data(string) + length;
+}
 
-uint32_t ds_string_view_get_length(const ds_StringView* view) {
-    if (!view) {
+static void ds_append_end(ds_String* string, size_t written) {
+    size_t length = ds_length(string) + written;
+    ds_data(string)[length] = '\0';
+    ds_set_length(string, length);
+}
+
+size_t ds_append_u64(ds_String* string, uint64_t value) {
+    if (!string) {
         DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
         return -1;
     }
 
-    if (!view->data) {
-        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+    char* write = ds_append_begin(string, 20);
+    if (!write) {
         return -1;
     }
 
-    return view->length;
+    ds_append_end(string, ds_write_u64(write, value));
+
+    return 0;
+}
+
+size_t ds_append_i64(ds_String* string, int64_t value) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    char* write = ds_append_begin(string, 20);
+    if (!write) {
+        return -1;
+    }
+
+    size_t written = 0;
+    uint64_t magnitude = (uint64_t)value;
+    if (value < 0) {
+        write[written++] = '-';
+        magnitude = 0 - magnitude;
+    }
+
+    written += ds_write_u64(write + written, magnitude);
+    ds_append_end(string, written);
+
+    return 0;
+}
+
+/*  NOTE:
+ *  shortest round trip double to decimal conversion, this is
+ *  Ulf Adams' Ryu (d2s) on top of the tables in drings_tables.h.
+ *  it finds the shortest digit string inside the rounding interval
+ *  of the double and prefers the one closest to the exact value
+ */
+#define DS_DOUBLE_MANTISSA_BITS 52
+#define DS_DOUBLE_EXPONENT_BITS 11
+#define DS_DOUBLE_BIAS 1023
+
+static inline uint64_t ds_umul128(uint64_t a, uint64_t b, uint64_t* high) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    *high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (uint32_t)lo_lo;
+#endif
+}
+
+static inline uint64_t ds_shiftright128(uint64_t low, uint64_t high, uint32_t dist) {
+    return (high << (64 - dist)) | (low >> dist);
+}
+
+static inline uint64_t ds_mul_shift64(uint64_t m, const uint64_t* mul, int32_t j) {
+    uint64_t high0;
+    ds_umul128(m, mul[0], &high0);
+    uint64_t high1;
+    uint64_t low1 = ds_umul128(m, mul[1], &high1);
+    uint64_t sum = high0 + low1;
+    if (sum < high0) high1++;
+    return ds_shiftright128(sum, high1, (uint32_t)(j - 64));
+}
+
+static inline int32_t ds_pow5bits(int32_t e) {
+    return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+static inline uint32_t ds_log10_pow2(int32_t e) {
+    return ((uint32_t)e * 78913) >> 18;
+}
+
+static inline uint32_t ds_log10_pow5(int32_t e) {
+    return ((uint32_t)e * 732923) >> 20;
+}
+
+static inline bool ds_multiple_of_pow5(uint64_t value, uint32_t p) {
+    uint32_t count = 0;
+    while (value % 5 == 0) {
+        value /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+static inline bool ds_multiple_of_pow2(uint64_t value, uint32_t p) {
+    return (value & ((1ull << p) - 1)) == 0;
+}
+
+// decimal mantissa and exponent of a finite, non zero double
+static void ds_double_to_decimal(uint64_t ieee_mantissa, uint32_t ieee_exponent, uint64_t* mantissa, int32_t* exponent) {
+    int32_t e2;
+    uint64_t m2;
+    if (ieee_exponent == 0) {
+        e2 = 1 - DS_DOUBLE_BIAS - DS_DOUBLE_MANTISSA_BITS - 2;
+        m2 = ieee_mantissa;
+    }
+    else {
+        e2 = (int32_t)ieee_exponent - DS_DOUBLE_BIAS - DS_DOUBLE_MANTISSA_BITS - 2;
+        m2 = (1ull << DS_DOUBLE_MANTISSA_BITS) | ieee_mantissa;
+    }
+    bool accept_bounds = (m2 & 1) == 0;
+
+    // the interval of valid representations is [mm, mp] around mv, scaled by 4
+    uint64_t mv = 4 * m2;
+    uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+    uint64_t vr, vp, vm;
+    int32_t e10;
+    bool vm_trailing_zeros = false;
+    bool vr_trailing_zeros = false;
+
+    if (e2 >= 0) {
+        uint32_t q = ds_log10_pow2(e2) - (e2 > 3);
+        e10 = (int32_t)q;
+        int32_t k = DS_POW5_INV_BITCOUNT + ds_pow5bits((int32_t)q) - 1;
+        int32_t i = -e2 + (int32_t)q + k;
+        vr = ds_mul_shift64(mv, ds_pow5_inv_split[q], i);
+        vp = ds_mul_shift64(mv + 2, ds_pow5_inv_split[q], i);
+        vm = ds_mul_shift64(mv - 1 - mm_shift, ds_pow5_inv_split[q], i);
+        if (q <= 21) {
+            if (mv % 5 == 0) {
+                vr_trailing_zeros = ds_multiple_of_pow5(mv, q);
+            }
+            else if (accept_bounds) {
+                vm_trailing_zeros = ds_multiple_of_pow5(mv - 1 - mm_shift, q);
+            }
+            else {
+                vp -= ds_multiple_of_pow5(mv + 2, q);
+            }
+        }
+    }
+    else {
+        uint32_t q = ds_log10_pow5(-e2) - (-e2 > 1);
+        e10 = (int32_t)q + e2;
+        int32_t i = -e2 - (int32_t)q;
+        int32_t k = ds_pow5bits(i) - DS_POW5_BITCOUNT;
+        int32_t j = (int32_t)q - k;
+        vr = ds_mul_shift64(mv, ds_pow5_split[i], j);
+        vp = ds_mul_shift64(mv + 2, ds_pow5_split[i], j);
+        vm = ds_mul_shift64(mv - 1 - mm_shift, ds_pow5_split[i], j);
+        if (q <= 1) {
+            vr_trailing_zeros = true;
+            if (accept_bounds) {
+                vm_trailing_zeros = mm_shift == 1;
+            }
+            else {
+                vp--;
+            }
+        }
+        else if (q < 63) {
+            vr_trailing_zeros = ds_multiple_of_pow2(mv, q);
+        }
+    }
+
+    // drop digits while the interval still contains a shorter number
+    int32_t removed = 0;
+    uint8_t last_removed_digit = 0;
+    uint64_t output;
+
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        while (vp / 10 > vm / 10) {
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed_digit == 0;
+            last_removed_digit = (uint8_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_trailing_zeros) {
+            while (vm % 10 == 0) {
+                vr_trailing_zeros &= last_removed_digit == 0;
+                last_removed_digit = (uint8_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        // round half to even if the exact value is ...50..0
+        if (vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+            last_removed_digit = 4;
+        }
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed_digit >= 5);
+    }
+    else {
+        bool round_up = false;
+        if (vp / 100 > vm / 100) {
+            round_up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            round_up = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+
+    *mantissa = output;
+    *exponent = e10 + removed;
+}
+
+// shortest round trip representation, fixed notation for 1e-7 < |value| < 1e21
+static size_t ds_write_double(char* out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    bool sign = (bits >> 63) != 0;
+    uint64_t ieee_mantissa = bits & ((1ull << DS_DOUBLE_MANTISSA_BITS) - 1);
+    uint32_t ieee_exponent = (uint32_t)((bits >> DS_DOUBLE_MANTISSA_BITS) & ((1u << DS_DOUBLE_EXPONENT_BITS) - 1));
+
+    char* write = out;
+
+    if (ieee_exponent == (1u << DS_DOUBLE_EXPONENT_BITS) - 1) {
+        if (ieee_mantissa) {
+            memcpy(write, "nan", 3);
+            return 3;
+        }
+        if (sign) *write++ = '-';
+        memcpy(write, "inf", 3);
+        return (size_t)(write - out) + 3;
+    }
+
+    if (sign) *write++ = '-';
+
+    if (ieee_exponent == 0 && ieee_mantissa == 0) {
+        *write++ = '0';
+        return (size_t)(write - out);
+    }
+
+    uint64_t mantissa;
+    int32_t exponent;
+    ds_double_to_decimal(ieee_mantissa, ieee_exponent, &mantissa, &exponent);
+
+    char digits[20];
+    int32_t count = (int32_t)ds_write_u64(digits, mantissa);
+    // position of the decimal point relative to the first digit
+    int32_t point = count + exponent;
+
+    if (point > 21 || point <= -6) {
+        *write++ = digits[0];
+        if (count > 1) {
+            *write++ = '.';
+            memcpy(write, digits + 1, count - 1);
+            write += count - 1;
+        }
+        *write++ = 'e';
+        int32_t e = point - 1;
+        if (e < 0) {
+            *write++ = '-';
+            e = -e;
+        }
+        else {
+            *write++ = '+';
+        }
+        write += ds_write_u64(write, (uint64_t)e);
+    }
+    else if (point <= 0) {
+        *write++ = '0';
+        *write++ = '.';
+        memset(write, '0', -point);
+        write += -point;
+        memcpy(write, digits, count);
+        write += count;
+    }
+    else if (point >= count) {
+        memcpy(write, digits, count);
+        write += count;
+        memset(write, '0', point - count);
+        write += point - count;
+    }
+    else {
+        memcpy(write, digits, point);
+        write += point;
+        *write++ = '.';
+        memcpy(write, digits + point, count - point);
+        write += count - point;
+    }
+
+    return (size_t)(write - out);
+}
+
+size_t ds_append_double(ds_String* string, double value) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    char* write = ds_append_begin(string, DS_DOUBLE_MAX_LENGTH);
+    if (!write) {
+        return -1;
+    }
+
+    ds_append_end(string, ds_write_double(write, value));
+
+    return 0;
+}
+
+void ds_concat(ds_String* string, const ds_StringView* parts, size_t n) {
+    if (!string || (!parts && n)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or parts are NULL");
+        return;
+    }
+
+    size_t length = ds_length(string);
+    size_t total = length;
+    for (size_t i = 0; i < n; i++) {
+        total += parts[i].length;
+    }
+
+    // parts may be views into string itself, those are found again after growing
+    uintptr_t old_begin = (uintptr_t)ds_data(string);
+
+    if (ds_string_grow(string, total, false) != 0) {
+        return;
+    }
+
+    char* begin = ds_data(string);
+    char* write = begin + length;
+    for (size_t i = 0; i < n; i++) {
+        const char* data = parts[i].data;
+        uintptr_t position = (uintptr_t)data;
+        if (position >= old_begin && position + parts[i].length <= old_begin + length) {
+            data = begin + (position - old_begin);
+        }
+        memcpy(write, data, parts[i].length);
+        write += parts[i].length;
+    }
+    *write = '\0';
+    ds_set_length(string, total);
+}
+
+void ds_append_dstring(ds_String *string, ds_String *append) {
+    if (!string || !append) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string in NULL");
+        return;
+    }
+
+    size_t length = ds_length(string);
+    size_t append_length = ds_length(append);
+
+    if (ds_string_grow(string, length + append_length, false) != 0) {
+        return;
+    }
+
+    // append may be string itself, so only read its data after growing
+    char* data = ds_data(string);
+    memcpy(data + length, ds_data(append), append_length);
+    data[length + append_length] = '\0';
+    ds_set_length(string, length + append_length);
 }
 
+
+char ds_pop(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    size_t length = ds_length(string);
+    
+    if (length == 0) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Length of the string going under 0");
+        return -1;
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+    
+    char c = -1;
+
+    if (ds_is_stack(string)) {
+        c = string->stack_data[length - 1];
+        string->stack_data[length - 1] = '\0';
+        ds_set_length(string, length - 1);
+    }
+    else if (ds_has_valid_heap_data(string) && ds_has_sticky_heap(string)) {
+        c = string->heap_data[length - 1];
+        string->heap_data[length - 1] = '\0';
+        ds_set_length(string, length - 1);
+    }
+    else if (ds_has_valid_heap_data(string)) {
+        c = string->heap_data[length - 1];
+        string->heap_data[length - 1] = '\0';
+        ds_set_length(string, length - 1);
+
+        if (length - 1 <= DS_SMALL_STRING_CAPACITY) {
+            ds_move_dsstring_to_stack(string);
+        }
+    }
+
+    return c;
+
+}
+
+size_t ds_pop_n(ds_String* string, size_t n) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input String is NULL");
+        return -1;
+    }
+
+    size_t length = ds_length(string);
+
+    if (n > length) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Length - n < 0");
+        return -1;
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+
+    // move to stack
+    if ((ds_is_heap(string) && length - n <= DS_SMALL_STRING_CAPACITY && !ds_has_sticky_heap(string))
+            || ds_is_stack(string)) {
+        ds_data(string)[length - n] = '\0';
+        ds_set_length(string, length - n);
+        
+        if (ds_is_heap(string)) {
+            ds_move_dsstring_to_stack(string);
+        }
+    }
+    else {
+        string->heap_data[length - n] = '\0';
+        ds_set_length(string, length - n);
+    }
+    
+    return 0;
+}
+
+size_t ds_reserve(ds_String *string, size_t n) {
+    return ds_reserve_exact(string, n);
+}
+
+size_t ds_reserve_exact(ds_String* string, size_t n) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    return ds_string_grow(string, n, true);
+}
+
+size_t ds_reserve_at_least(ds_String* string, size_t n) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    return ds_string_grow(string, n, false);
+}
+
+size_t ds_clear(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    // a shared or borrowed buffer is let go instead of copied
+    if (ds_string_needs_detach(string)) {
+        ds_string_release_buffer(string);
+        ds_set_is_stack(string);
+        ds_set_capacity(string, DS_STACK_CAPACITY);
+    }
+
+    ds_data(string)[0] = '\0';
+    ds_set_length(string, 0);
+
+    return 0;
+}
+
+bool ds_equal(const ds_String* string0, const ds_String* string1) {
+    if (!string0 || !string1) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return false;
+    }
+
+    size_t length = ds_length(string0);
+
+    if (length != ds_length(string1)) {
+        return false;
+    }
+
+    return ds_mismatch(ds_cdata(string0), ds_cdata(string1), length) == length;
+}
+
+int ds_compare(const ds_String* string0, const ds_String* string1) {
+    if (!string0 || !string1) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return 0;
+    }
+
+    return ds_compare_bytes(ds_cdata(string0), ds_length(string0), ds_cdata(string1), ds_length(string1));
+}
+
+size_t ds_set(ds_String* string, const char* literal) {
+    if (!string || !literal) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    return ds_set_n(string, literal, strlen(literal));
+}
+
+size_t ds_set_n(ds_String* string, const char* data, size_t n) {
+    if (!string || (!data && n)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    // a piece of string itself is cut out in place, the buffer cant be let go before it is read
+    size_t offset = ds_string_inner_offset(string, data);
+    if (offset != SIZE_MAX) {
+        if (offset + n > ds_length(string)) {
+            DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Data runs past the end of the string");
+            return -1;
+        }
+        if (ds_string_make_writable(string) != 0) {
+            return -1;
+        }
+
+        char* string_data = ds_data(string);
+        memmove(string_data, string_data + offset, n);
+        string_data[n] = '\0';
+        ds_set_length(string, n);
+
+        if (n <= DS_SMALL_STRING_CAPACITY && ds_is_heap(string) && !ds_has_sticky_heap(string)) {
+            return ds_move_dsstring_to_stack(string);
+        }
+        return 0;
+    }
+
+    // move to stack, sticky heap strings keep their buffer
+    if (n <= DS_SMALL_STRING_CAPACITY && ds_is_heap(string) && !ds_has_sticky_heap(string)) {
+        ds_string_release_buffer(string);
+        ds_set_is_stack(string);
+        ds_set_capacity(string, DS_STACK_CAPACITY);
+    }
+
+    if (ds_string_grow(string, n, false) != 0) {
+        return -1;
+    }
+
+    char* string_data = ds_data(string);
+    memcpy(string_data, data, n);
+    string_data[n] = '\0';
+    ds_set_length(string, n);
+
+    return 0;
+}
+
+size_t ds_set_view(ds_String* string, const ds_StringView* view) {
+    if (!string || !view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string or view is NULL");
+        return -1;
+    }
+
+    return ds_set_n(string, view->data, view->length);
+}
+
+static inline bool ds_string_is_borrowed(const ds_String* string) {
+    return ds_is_read_only(string) && !ds_owns_memory(string);
+}
+
+// borrowed memory can be borrowed again, owned buffers are only shared between strings of one allocator
+static inline bool ds_string_can_share(ds_String* string, ds_String* source) {
+    if (string == source || !ds_is_heap(source)) return false;
+    if (ds_string_is_borrowed(source)) return true;
+    return !ds_is_read_only(source) && ds_string_allocator(string) == ds_string_allocator(source);
+}
+
+// string ends up pointing at the buffer of source, which gains a reference if it is owned
+static size_t ds_string_share_from(ds_String* string, ds_String* source) {
+    if (!ds_string_is_borrowed(source)) {
+        ds_SharedHeader* header = ds_string_make_shared(source);
+        if (!header) {
+            return -1;
+        }
+        atomic_fetch_add_explicit(&header->references, 1, memory_order_relaxed);
+    }
+
+    if (ds_is_heap(string)) {
+        ds_string_release_buffer(string);
+    }
+
+    const ds_Allocator* allocator = ds_string_allocator(string);
+    *string = *source;
+    ds_string_set_allocator(string, allocator);
+
+    return 0;
+}
+
+/*  NOTE:
+ *  this function can ignore flags of
+ *  the string because it is cloning the 
+ *  argument string with its flags
+ */
+size_t ds_clone(ds_String* string, ds_String* clone) {
+    if (!string || !clone) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    // heap strings only bump the refcount, the copy happens on the first write
+    if (ds_string_can_share(string, clone)) {
+        return ds_string_share_from(string, clone);
+    }
+
+    size_t clone_length = ds_length(clone);
+
+    if (ds_is_heap(string) && ds_is_stack(clone)) {
+        ds_clear(string);
+        if (ds_is_heap(string)) {
+            ds_move_dsstring_to_stack(string);
+        }
+    }
+
+    if (ds_string_grow(string, clone_length, true) != 0) {
+        return -1;
+    }
+
+    // clone can be a shared substring without a terminator
+    char* data = ds_data(string);
+    memcpy(data, ds_data(clone), clone_length);
+    data[clone_length] = '\0';
+    ds_set_length(string, clone_length);
+    if (ds_has_sticky_heap(clone)) {
+        ds_set_sticky_heap(string);
+    }
+
+    return 0;
+}
+
+size_t ds_clone_substr(ds_String* string, ds_String* source, size_t start, size_t length) {
+    if (!string || !source) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    size_t source_length = ds_length(source);
+    if (start > source_length || length > source_length - start) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Substring [%zu, %zu) is outside of the string", start, start + length);
+        return -1;
+    }
+
+    // short substrings fit inline and are cheaper to copy
+    if (length > DS_SMALL_STRING_CAPACITY && ds_string_can_share(string, source)) {
+        if (ds_string_share_from(string, source) != 0) {
+            return -1;
+        }
+        string->heap_data += start;
+        ds_set_capacity(string, ds_capacity(source) - start);
+        ds_set_length(string, length);
+
+        return 0;
+    }
+
+    if (string == source) {
+        if (ds_string_make_writable(string) != 0) {
+            return -1;
+        }
+        char* data = ds_data(string);
+        memmove(data, data + start, length);
+        data[length] = '\0';
+        ds_set_length(string, length);
+
+        return 0;
+    }
+
+    return ds_set_n(string, ds_data(source) + start, length);
+}
+
+size_t ds_trim_whitespace(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+
+    char* data = ds_data(string);
+    size_t length = ds_length(string);
+
+    size_t write = 0;
+    for (size_t read = 0; read < length; read++) {
+        if (!isspace((unsigned char)data[read])) {
+            data[write++] = data[read];
+        }
+    }
+
+    data[write] = '\0';
+    ds_set_length(string, write);
+    
+    return 0;
+}
+
+size_t ds_trim_whitespace_flags(ds_String* string, uint32_t flags) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (flags & DS_ALL) {
+        return ds_trim_whitespace(string);
+    }
+
+    if (ds_string_make_writable(string) != 0) {
+        return -1;
+    }
+
+    char* data = ds_data(string);
+
+    size_t start = 0, end = ds_length(string);
+
+    if (flags & DS_FRONT) {
+        while (start < end && isspace((unsigned char)data[start])) {
+            start++;
+        }
+    }
+
+    if (flags & DS_BACK) {
+        while (end > start && isspace((unsigned char)data[end - 1])) {
+            end--;
+        }
+    }
+
+    size_t delta_length = end - start;
+    if (start > 0 && delta_length > 0) {
+        memmove(data, data + start, delta_length);
+    }
+    data[delta_length] = '\0';
+    ds_set_length(string, delta_length);
+
+    return 0;
+}
+
+ds_String* ds_split(ds_String* string, char seperator) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return NULL;
+    }
+
+    char* data = ds_data(string);
+    size_t length = ds_length(string);
+
+    const char* found = ds_find_byte(data, length, seperator);
+    if (!found) {
+        return NULL;
+    }
+    size_t start = found - data;
+
+    if (ds_string_make_writable(string) != 0) {
+        return NULL;
+    }
+    data = ds_data(string);
+
+    // only the tail is copied
+    ds_String* cut = ds_init_string_allocator_n(ds_string_allocator(string), data + start + 1, length - start - 1);
+    if (!cut) {
+        return NULL;
+    }
+
+    data[start] = '\0';
+    ds_set_length(string, start);
+
+    return cut;
+}
+
+ds_StringView ds_string_view_from_cstr(const char *str) {
+    ds_StringView view = {0};
+
+    if (!str) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return view;
+    }
+
+    view.data = str;
+    view.length = strlen(str);
+
+    return view;
+}
+
+ds_StringView ds_string_view_from_string(const ds_String* string) {
+    ds_StringView view = {0};
+
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return view;
+    }
+
+    view.data = ds_cdata(string);
+    view.length = ds_length(string);
+
+    return view;
+}
+
+ds_StringView ds_string_view_from_buffer(const char *data, uint32_t length) {
+    ds_StringView view = {0};
+
+    if (!data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input buffer is NULL");
+        return view;
+    }
+
+    view.data = data;
+    view.length = length;
+
+    return view;
+}
+
+ds_StringView ds_string_view_from_substr(const ds_StringView *view, uint32_t start, uint32_t length) {
+    ds_StringView lview = {0};
+
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return lview;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return lview;
+    }
+
+    if (start >= view->length) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
+        return lview;
+    }
+
+    uint32_t available_length = view->length - start;
+    uint32_t actual_length = (length > available_length) ? available_length : length;
+
+    lview.data = view->data + start;
+    lview.length = actual_length;
+
+    return lview;
+}
+
+ds_StringView ds_string_view_from_substr_to_end(const ds_StringView *view, uint32_t start) {
+    ds_StringView lview = {0};
+
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return lview;
+    }
+
+    if (start >= view->length) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
+        return lview;
+    }
+
+    lview.data = view->data + start;
+    lview.length = view->length - start;
+
+    return lview;
+}
+
+ds_StringView ds_string_view_from_string_substr(const ds_String* string, uint32_t start, uint32_t length) {
+    ds_StringView view = {0};
+
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return view;
+    }
+
+    if (start >= ds_length(string)) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
+        return view;
+    }
+
+    uint32_t available_length = ds_length(string) - start;
+    uint32_t actual_length = (length > available_length) ? available_length : length;
+
+    view.data = ds_cdata(string) + start;
+    view.length = actual_length;
+
+    return view;
+}
+
+ds_StringView ds_string_view_from_string_substr_to_end(const ds_String* string, uint32_t start) {
+    ds_StringView view = {0};
+
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return view;
+    }
+
+    if (start >= ds_length(string)) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Start Index %u >= string length", start);
+        return view;
+    }
+
+    view.data = ds_cdata(string) + start;
+    view.length = ds_length(string) - start;
+
+    return view;
+
+}
+
+bool ds_string_view_equal(const ds_StringView *view1, const ds_StringView *view2) {
+    if (!view1 || !view2) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return false;
+    }
+
+    if (!view1->data || !view2->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return false;
+    }
+
+    if (view1->length != view2->length) return false;
+    return ds_mismatch(view1->data, view2->data, view1->length) == view1->length;
+}
+
+bool ds_string_view_equal_cstr(const ds_StringView *view, const char *str) {
+    if (!view || !str) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return false;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return false;
+    }
+
+    // strnlen never looks further than one byte past the view
+    if (strnlen(str, (size_t)view->length + 1) != view->length) return false;
+    return memcmp(view->data, str, view->length) == 0;
+}
+
+int ds_string_view_compare(const ds_StringView* view1, const ds_StringView* view2) {
+    if (!view1 || !view2) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return 0;
+    }
+
+    if (!view1->data || !view2->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return 0;
+    }
+
+    return ds_compare_bytes(view1->data, view1->length, view2->data, view2->length);
+}
+
+/*  NOTE:
+ *  wyhash (final version 4). inputs are read little endian, so the
+ *  values are the same on every platform and can be stored or sent
+ *  to other machines. the 128 bit variant runs two passes with
+ *  independent secrets.
+ */
+static const uint64_t ds_hash_secret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull,
+};
+
+static const uint64_t ds_hash_secret_high[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+};
+
+static inline uint64_t ds_hash_mix(uint64_t a, uint64_t b) {
+    uint64_t high;
+    uint64_t low = ds_umul128(a, b, &high);
+    return low ^ high;
+}
+
+static inline uint64_t ds_load_u32_le(const unsigned char* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+static uint64_t ds_hash_with_secret(const void* key, size_t length, uint64_t seed, const uint64_t* secret) {
+    const unsigned char* p = (const unsigned char*)key;
+    uint64_t a;
+    uint64_t b;
+
+    seed ^= ds_hash_mix(seed ^ secret[0], secret[1]);
+
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t middle = (length >> 3) << 2;
+            a = (ds_load_u32_le(p) << 32) | ds_load_u32_le(p + middle);
+            b = (ds_load_u32_le(p + length - 4) << 32) | ds_load_u32_le(p + length - 4 - middle);
+        }
+        else if (length > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t i = length;
+        if (i > 48) {
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do {
+                seed = ds_hash_mix(ds_load_u64_le((const char*)p) ^ secret[1], ds_load_u64_le((const char*)p + 8) ^ seed);
+                seed1 = ds_hash_mix(ds_load_u64_le((const char*)p + 16) ^ secret[2], ds_load_u64_le((const char*)p + 24) ^ seed1);
+                seed2 = ds_hash_mix(ds_load_u64_le((const char*)p + 32) ^ secret[3], ds_load_u64_le((const char*)p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (i > 16) {
+            seed = ds_hash_mix(ds_load_u64_le((const char*)p) ^ secret[1], ds_load_u64_le((const char*)p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = ds_load_u64_le((const char*)p + i - 16);
+        b = ds_load_u64_le((const char*)p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    a = ds_umul128(a, b, &b);
+
+    return ds_hash_mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+uint64_t ds_hash_bytes(const void* data, size_t length, uint64_t seed) {
+    if (!data && length > 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input data is NULL");
+        return 0;
+    }
+
+    return ds_hash_with_secret(data, length, seed, ds_hash_secret);
+}
+
+uint64_t ds_string_view_hash(const ds_StringView* view, uint64_t seed) {
+    if (!view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input view is NULL or has no data");
+        return 0;
+    }
+
+    return ds_hash_with_secret(view->data, view->length, seed, ds_hash_secret);
+}
+
+ds_Hash128 ds_string_view_hash128(const ds_StringView* view, uint64_t seed) {
+    ds_Hash128 hash = {0, 0};
+
+    if (!view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input view is NULL or has no data");
+        return hash;
+    }
+
+    hash.low = ds_hash_with_secret(view->data, view->length, seed, ds_hash_secret);
+    hash.high = ds_hash_with_secret(view->data, view->length, seed, ds_hash_secret_high);
+
+    return hash;
+}
+
+uint64_t ds_string_hash(ds_String* string) {
+    if (!string) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return 0;
+    }
+
+    uint64_t hash;
+    if (ds_string_cached_hash(string, &hash)) {
+        return hash;
+    }
+
+    hash = ds_hash_with_secret(ds_data(string), ds_length(string), 0, ds_hash_secret);
+    ds_string_cache_hash(string, hash);
+
+    return hash;
+}
+
+bool ds_string_view_is_empty(const ds_StringView *view) {
+    return (!view || view->length) == 0;
+}
+
+int32_t ds_string_view_find_char(const ds_StringView *view, char c) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return -1;
+    }
+
+    const char* found = ds_find_byte(view->data, view->length, c);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_rfind_char(const ds_StringView* view, char c) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return -1;
+    }
+
+    const char* found = ds_rfind_byte(view->data, view->length, c);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_find_nth_char(const ds_StringView* view, char c, size_t n) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return -1;
+    }
+
+    const char* found = ds_find_nth_byte(view->data, view->length, c, n);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+size_t ds_string_view_count_char(const ds_StringView* view, char c) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return 0;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return 0;
+    }
+
+    return ds_count_byte(view->data, view->length, c);
+}
+
+ds_ByteSet ds_byte_set_from_buffer(const char* chars, size_t length) {
+    ds_ByteSet set = {0};
+
+    if (!chars) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input chars are NULL");
+        return set;
+    }
+
+    set.nibble_lookup = true;
+    for (size_t i = 0; i < length; i++) {
+        ds_byte_set_add(&set, chars[i]);
+    }
+
+    return set;
+}
+
+ds_ByteSet ds_byte_set_from_cstr(const char* chars) {
+    if (!chars) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input chars are NULL");
+        ds_ByteSet set = {0};
+        return set;
+    }
+
+    return ds_byte_set_from_buffer(chars, strlen(chars));
+}
+
+void ds_byte_set_add(ds_ByteSet* set, char c) {
+    if (!set) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input set is NULL");
+        return;
+    }
+
+    unsigned char byte = (unsigned char)c;
+    set->bits[byte >> 6] |= 1ull << (byte & 63);
+
+    if (!set->nibble_lookup) {
+        return;
+    }
+
+    uint8_t high = byte >> 4;
+    uint8_t low = byte & 0x0f;
+
+    // a new high nibble needs one of the 8 group bits
+    if (!set->high_nibbles[high]) {
+        uint8_t used = 0;
+        for (int i = 0; i < 16; i++) used |= set->high_nibbles[i];
+        if (used == 0xff) {
+            set->nibble_lookup = false;
+            return;
+        }
+        set->high_nibbles[high] = (uint8_t)(~used & (used + 1));
+    }
+
+    set->low_nibbles[low] |= set->high_nibbles[high];
+}
+
+bool ds_byte_set_contains(const ds_ByteSet* set, char c) {
+    if (!set) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input set is NULL");
+        return false;
+    }
+
+    return ds_byte_set_has(set, c);
+}
+
+static inline bool ds_byte_set_check_input(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!view || !set) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input view or set is NULL");
+        return false;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return false;
+    }
+
+    return true;
+}
+
+int32_t ds_string_view_find_first_of(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return -1;
+    }
+
+    const char* found = ds_find_in_byte_set(view->data, view->length, set, true);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_find_first_not_of(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return -1;
+    }
+
+    const char* found = ds_find_in_byte_set(view->data, view->length, set, false);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_find_last_of(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return -1;
+    }
+
+    const char* found = ds_rfind_in_byte_set(view->data, view->length, set, true);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+int32_t ds_string_view_find_last_not_of(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return -1;
+    }
+
+    const char* found = ds_rfind_in_byte_set(view->data, view->length, set, false);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+uint32_t ds_string_view_span(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return 0;
+    }
+
+    const char* found = ds_find_in_byte_set(view->data, view->length, set, false);
+    return found ? (uint32_t)(found - view->data) : view->length;
+}
+
+uint32_t ds_string_view_cspan(const ds_StringView* view, const ds_ByteSet* set) {
+    if (!ds_byte_set_check_input(view, set)) {
+        return 0;
+    }
+
+    const char* found = ds_find_in_byte_set(view->data, view->length, set, true);
+    return found ? (uint32_t)(found - view->data) : view->length;
+}
+
+int32_t ds_string_view_find_substr(const ds_StringView *view, const ds_StringView *substr) {
+    if (!view || !substr || !view->data || !substr->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or substr is NULL or has no data");
+        return -1;
+    }
+
+    ds_Searcher searcher;
+    ds_searcher_init(&searcher, substr);
+
+    const char* found = ds_searcher_search(&searcher, view->data, view->length);
+    return found ? (int32_t)(found - view->data) : -1;
+}
+
+size_t ds_searcher_init(ds_Searcher* searcher, const ds_StringView* needle) {
+    if (!searcher || !needle || !needle->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Searcher or needle is NULL or has no data");
+        return -1;
+    }
+
+    searcher->needle = *needle;
+    searcher->critical = 0;
+    searcher->period = 0;
+    searcher->memory = 0;
+
+    size_t length = needle->length;
+    if (length <= DS_SEARCHER_SHORT_NEEDLE) {
+        return 0;
+    }
+
+    // shift holds the last position + 1 of every byte, 0 for bytes not in the needle
+    const unsigned char* data = (const unsigned char*)needle->data;
+    memset(searcher->shift, 0, sizeof(searcher->shift));
+    for (size_t i = 0; i < length; i++) {
+        searcher->shift[data[i]] = (uint32_t)(i + 1);
+    }
+
+    // critical factorization, the later of the two maximal suffixes
+    size_t period;
+    size_t reverse_period;
+    size_t critical = ds_maximal_suffix(data, length, false, &period);
+    size_t reverse_critical = ds_maximal_suffix(data, length, true, &reverse_period);
+    if (reverse_critical + 1 > critical + 1) {
+        critical = reverse_critical;
+        period = reverse_period;
+    }
+
+    // periodic needles remember how much of the left half already matched
+    if (memcmp(data, data + period, critical + 1) == 0) {
+        searcher->memory = length - period;
+    }
+    else {
+        size_t right = length - critical - 1;
+        period = (critical > right ? critical : right) + 1;
+    }
+
+    searcher->critical = critical;
+    searcher->period = period;
+
+    return 0;
+}
+
+int32_t ds_searcher_find(const ds_Searcher* searcher, const ds_StringView* haystack) {
+    if (!searcher || !haystack || !haystack->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Searcher or haystack is NULL or has no data");
+        return -1;
+    }
+
+    const char* found = ds_searcher_search(searcher, haystack->data, haystack->length);
+    return found ? (int32_t)(found - haystack->data) : -1;
+}
+
+size_t ds_match_iter_init(ds_MatchIter* iter, const ds_StringView* haystack, const ds_StringView* needle, uint32_t flags) {
+    if (!iter || !haystack || !haystack->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or haystack is NULL or has no data");
+        return -1;
+    }
+
+    if (ds_searcher_init(&iter->searcher, needle) != 0) {
+        return -1;
+    }
+
+    iter->haystack = *haystack;
+    iter->position = 0;
+    iter->flags = flags;
+
+    return 0;
+}
+
+void ds_match_iter_reset(ds_MatchIter* iter, const ds_StringView* haystack) {
+    if (!iter || !haystack || !haystack->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or haystack is NULL or has no data");
+        return;
+    }
+
+    iter->haystack = *haystack;
+    iter->position = 0;
+}
+
+bool ds_match_iter_next(ds_MatchIter* iter, uint32_t* offset) {
+    if (!iter || !offset) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or offset is NULL");
+        return false;
+    }
+
+    // an empty needle matches at every offset including the end
+    size_t length = iter->haystack.length;
+    if (iter->position > length) {
+        return false;
+    }
+
+    const char* data = iter->haystack.data;
+    const char* found = ds_searcher_search(&iter->searcher, data + iter->position, length - iter->position);
+    if (!found) {
+        iter->position = (uint64_t)length + 1;
+        return false;
+    }
+
+    size_t needle_length = iter->searcher.needle.length;
+    *offset = (uint32_t)(found - data);
+    iter->position = *offset + ((iter->flags & DS_MATCH_OVERLAPPING) || needle_length == 0 ? 1 : needle_length);
+
+    return true;
+}
+
+size_t ds_string_view_find_all(const ds_StringView* view, const ds_StringView* needle, uint32_t* offsets, size_t capacity, uint32_t flags) {
+    if (!offsets && capacity > 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Offsets are NULL");
+        return 0;
+    }
+
+    ds_MatchIter iter;
+    if (ds_match_iter_init(&iter, view, needle, flags) != 0) {
+        return 0;
+    }
+
+    size_t count = 0;
+    uint32_t offset;
+    while (ds_match_iter_next(&iter, &offset)) {
+        if (count < capacity) offsets[count] = offset;
+        count++;
+    }
+
+    return count;
+}
+
+/*  NOTE:
+ *  Aho-Corasick. states are numbered breadth first, so the shallow
+ *  states every scan keeps returning to come first and get full
+ *  transition rows (as far as DS_MULTI_MATCHER_DENSE_ENTRIES allows).
+ *  deeper states keep only their trie edges and fall back along
+ *  their fail link. bytes are mapped to classes first, class 0 is
+ *  every byte that appears in no pattern and always leads to the root.
+ */
+#define DS_MULTI_MATCHER_NONE UINT32_MAX
+
+struct ds_MultiMatcher {
+    const ds_Allocator* allocator;
+    size_t size;
+    uint32_t state_count;
+    uint32_t dense_count; // states below this have a dense row
+    uint32_t class_count;
+    uint32_t pattern_count;
+    uint16_t classes[256];
+    uint32_t* dense;
+    uint32_t* fail;
+    uint32_t* edge_start; // edges of state s are [edge_start[s], edge_start[s + 1])
+    uint16_t* edge_class;
+    uint32_t* edge_target;
+    uint32_t* output_start; // same layout for the pattern ids ending in a state
+    uint32_t* outputs;
+    uint32_t* output_link; // next state on the fail chain with outputs, 0 for none
+    uint32_t* pattern_lengths;
+};
+
+static inline size_t ds_multi_matcher_align(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+static uint32_t ds_multi_matcher_edge(const ds_MultiMatcher* matcher, uint32_t state, uint32_t class_id) {
+    for (uint32_t e = matcher->edge_start[state]; e < matcher->edge_start[state + 1]; e++) {
+        if (matcher->edge_class[e] == class_id) return matcher->edge_target[e];
+    }
+
+    return DS_MULTI_MATCHER_NONE;
+}
+
+static inline uint32_t ds_multi_matcher_step(const ds_MultiMatcher* matcher, uint32_t state, uint32_t class_id) {
+    while (state >= matcher->dense_count) {
+        uint32_t next = ds_multi_matcher_edge(matcher, state, class_id);
+        if (next != DS_MULTI_MATCHER_NONE) return next;
+        state = matcher->fail[state];
+    }
+
+    return matcher->dense[(size_t)state * matcher->class_count + class_id];
+}
+
+ds_MultiMatcher* ds_init_multi_matcher(const ds_StringView* patterns, size_t count) {
+    if (!patterns && count > 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input patterns are NULL");
+        return NULL;
+    }
+
+    uint16_t classes[256] = {0};
+    uint32_t class_count = 1;
+    size_t total = 1;
+
+    for (size_t p = 0; p < count; p++) {
+        if (!patterns[p].data) {
+            DS_SET_ERROR(DS_INVALID_INPUT, "Pattern %zu has no data", p);
+            return NULL;
+        }
+        total += patterns[p].length;
+
+        for (uint32_t i = 0; i < patterns[p].length; i++) {
+            unsigned char byte = (unsigned char)patterns[p].data[i];
+            if (!classes[byte]) classes[byte] = (uint16_t)class_count++;
+        }
+    }
+
+    if (total >= UINT32_MAX || count >= UINT32_MAX) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Patterns are to big");
+        return NULL;
+    }
+
+    // scratch trie with linked child lists, renumbered breadth first below
+    const ds_Allocator* allocator = ds_global_allocator;
+    size_t scratch_size = (6 * total + count) * sizeof(uint32_t);
+    uint32_t* scratch = (uint32_t*)ds_allocator_alloc(allocator, scratch_size);
+    if (!scratch) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", scratch_size);
+        return NULL;
+    }
+
+    uint32_t* first_child = scratch;
+    uint32_t* next_sibling = first_child + total;
+    uint32_t* node_class = next_sibling + total;
+    uint32_t* order = node_class + total;
+    uint32_t* renumber = order + total;
+    uint32_t* pattern_node = renumber + total;
+    uint32_t* output_count = pattern_node + count;
+
+    uint32_t node_count = 1;
+    first_child[0] = DS_MULTI_MATCHER_NONE;
+
+    for (size_t p = 0; p < count; p++) {
+        uint32_t node = 0;
+        for (uint32_t i = 0; i < patterns[p].length; i++) {
+            uint32_t class_id = classes[(unsigned char)patterns[p].data[i]];
+            uint32_t child = first_child[node];
+            while (child != DS_MULTI_MATCHER_NONE && node_class[child] != class_id) child = next_sibling[child];
+
+            if (child == DS_MULTI_MATCHER_NONE) {
+                child = node_count++;
+                first_child[child] = DS_MULTI_MATCHER_NONE;
+                node_class[child] = class_id;
+                next_sibling[child] = first_child[node];
+                first_child[node] = child;
+            }
+            node = child;
+        }
+        pattern_node[p] = node;
+    }
+
+    uint32_t tail = 1;
+    order[0] = 0;
+    for (uint32_t head = 0; head < tail; head++) {
+        renumber[order[head]] = head;
+        for (uint32_t child = first_child[order[head]]; child != DS_MULTI_MATCHER_NONE; child = next_sibling[child]) {
+            order[tail++] = child;
+        }
+    }
+
+    // empty patterns would match everywhere, they never match instead
+    uint32_t output_total = 0;
+    memset(output_count, 0, total * sizeof(uint32_t));
+    for (size_t p = 0; p < count; p++) {
+        if (patterns[p].length > 0) output_total++;
+    }
+
+    uint32_t state_count = node_count;
+    uint32_t dense_count = DS_MULTI_MATCHER_DENSE_ENTRIES / class_count;
+    if (dense_count < 1) dense_count = 1;
+    if (dense_count > state_count) dense_count = state_count;
+
+    size_t size = ds_multi_matcher_align(sizeof(ds_MultiMatcher));
+    size_t dense_offset = size;     size += ds_multi_matcher_align((size_t)dense_count * class_count * sizeof(uint32_t));
+    size_t fail_offset = size;      size += ds_multi_matcher_align(state_count * sizeof(uint32_t));
+    size_t edge_offset = size;      size += ds_multi_matcher_align((state_count + 1) * sizeof(uint32_t));
+    size_t class_offset = size;     size += ds_multi_matcher_align(state_count * sizeof(uint16_t));
+    size_t target_offset = size;    size += ds_multi_matcher_align(state_count * sizeof(uint32_t));
+    size_t output_offset = size;    size += ds_multi_matcher_align((state_count + 1) * sizeof(uint32_t));
+    size_t outputs_offset = size;   size += ds_multi_matcher_align(output_total * sizeof(uint32_t));
+    size_t link_offset = size;      size += ds_multi_matcher_align(state_count * sizeof(uint32_t));
+    size_t length_offset = size;    size += ds_multi_matcher_align(count * sizeof(uint32_t));
+
+    char* block = (char*)ds_allocator_alloc(allocator, size);
+    if (!block) {
+        ds_allocator_free(allocator, scratch, scratch_size);
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", size);
+        return NULL;
+    }
+
+    ds_MultiMatcher* matcher = (ds_MultiMatcher*)block;
+    matcher->allocator = allocator;
+    matcher->size = size;
+    matcher->state_count = state_count;
+    matcher->dense_count = dense_count;
+    matcher->class_count = class_count;
+    matcher->pattern_count = (uint32_t)count;
+    memcpy(matcher->classes, classes, sizeof(classes));
+    matcher->dense = (uint32_t*)(block + dense_offset);
+    matcher->fail = (uint32_t*)(block + fail_offset);
+    matcher->edge_start = (uint32_t*)(block + edge_offset);
+    matcher->edge_class = (uint16_t*)(block + class_offset);
+    matcher->edge_target = (uint32_t*)(block + target_offset);
+    matcher->output_start = (uint32_t*)(block + output_offset);
+    matcher->outputs = (uint32_t*)(block + outputs_offset);
+    matcher->output_link = (uint32_t*)(block + link_offset);
+    matcher->pattern_lengths = (uint32_t*)(block + length_offset);
+
+    // edges in breadth first order, so the children of a state are contiguous
+    uint32_t edge = 0;
+    for (uint32_t state = 0; state < state_count; state++) {
+        matcher->edge_start[state] = edge;
+        for (uint32_t child = first_child[order[state]]; child != DS_MULTI_MATCHER_NONE; child = next_sibling[child]) {
+            matcher->edge_class[edge] = (uint16_t)node_class[child];
+            matcher->edge_target[edge] = renumber[child];
+            edge++;
+        }
+    }
+    matcher->edge_start[state_count] = edge;
+
+    // outputs grouped by state, ascending pattern ids within a state
+    for (size_t p = 0; p < count; p++) {
+        matcher->pattern_lengths[p] = patterns[p].length;
+        if (patterns[p].length > 0) output_count[renumber[pattern_node[p]]]++;
+    }
+    uint32_t output = 0;
+    for (uint32_t state = 0; state < state_count; state++) {
+        matcher->output_start[state] = output;
+        output += output_count[state];
+        output_count[state] = matcher->output_start[state];
+    }
+    matcher->output_start[state_count] = output;
+    for (size_t p = 0; p < count; p++) {
+        if (patterns[p].length > 0) matcher->outputs[output_count[renumber[pattern_node[p]]]++] = (uint32_t)p;
+    }
+
+    // parents come before children, so fail links are ready when needed
+    matcher->fail[0] = 0;
+    matcher->output_link[0] = 0;
+    for (uint32_t state = 0; state < state_count; state++) {
+        for (uint32_t e = matcher->edge_start[state]; e < matcher->edge_start[state + 1]; e++) {
+            uint32_t child = matcher->edge_target[e];
+            uint32_t fail = 0;
+
+            if (state != 0) {
+                uint32_t candidate = matcher->fail[state];
+                for (;;) {
+                    uint32_t next = ds_multi_matcher_edge(matcher, candidate, matcher->edge_class[e]);
+                    if (next != DS_MULTI_MATCHER_NONE) {
+                        fail = next;
+                        break;
+                    }
+                    if (candidate == 0) break;
+                    candidate = matcher->fail[candidate];
+                }
+            }
+
+            matcher->fail[child] = fail;
+            bool fail_has_output = matcher->output_start[fail + 1] != matcher->output_start[fail];
+            matcher->output_link[child] = fail_has_output ? fail : matcher->output_link[fail];
+        }
+    }
+
+    for (uint32_t state = 0; state < dense_count; state++) {
+        uint32_t* row = matcher->dense + (size_t)state * class_count;
+        const uint32_t* fail_row = matcher->dense + (size_t)matcher->fail[state] * class_count;
+
+        for (uint32_t class_id = 0; class_id < class_count; class_id++) {
+            uint32_t next = ds_multi_matcher_edge(matcher, state, class_id);
+            if (next == DS_MULTI_MATCHER_NONE) next = state == 0 ? 0 : fail_row[class_id];
+            row[class_id] = next;
+        }
+    }
+
+    ds_allocator_free(allocator, scratch, scratch_size);
+
+    return matcher;
+}
+
+void ds_free_multi_matcher(ds_MultiMatcher* matcher) {
+    if (!matcher) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input matcher is NULL");
+        return;
+    }
+
+    ds_allocator_free(matcher->allocator, matcher, matcher->size);
+}
+
+size_t ds_multi_matcher_scan(const ds_MultiMatcher* matcher, const ds_StringView* view, ds_Match* matches, size_t capacity) {
+    if (!matcher || !view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Matcher or view is NULL or has no data");
+        return 0;
+    }
+
+    if (!matches && capacity > 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Matches are NULL");
+        return 0;
+    }
+
+    const unsigned char* data = (const unsigned char*)view->data;
+    size_t count = 0;
+    uint32_t state = 0;
+
+    for (uint32_t i = 0; i < view->length; i++) {
+        uint32_t class_id = matcher->classes[data[i]];
+        if (class_id == 0) {
+            state = 0;
+            continue;
+        }
+
+        state = ds_multi_matcher_step(matcher, state, class_id);
+
+        uint32_t report = matcher->output_start[state + 1] != matcher->output_start[state] ? state : matcher->output_link[state];
+        for (; report != 0; report = matcher->output_link[report]) {
+            for (uint32_t o = matcher->output_start[report]; o < matcher->output_start[report + 1]; o++) {
+                if (count < capacity) {
+                    uint32_t pattern = matcher->outputs[o];
+                    matches[count].pattern = pattern;
+                    matches[count].offset = i + 1 - matcher->pattern_lengths[pattern];
+                }
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+bool ds_string_view_starts_with(const ds_StringView *view, const ds_StringView *prefix) {
+    if (!view || !prefix || !view->data || !prefix->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or prefix is NULL or has no data");
+        return false;
+    }
+
+    if (prefix->length == 0) return true;
+    if (prefix->length > view->length) return false;
+
+    if (memcmp(view->data, prefix->data, prefix->length) == 0) return true;
+
+    return false;
+}
+
+bool ds_string_view_ends_with(const ds_StringView *view, const ds_StringView *suffix) {
+    if (!view || !suffix || !view->data || !suffix->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "StringView or suffix is NULL or has no data");
+        return false;
+    }
+
+    if (suffix->length == 0) return true;
+    if (suffix->length > view->length) return false;
+
+    if (memcmp(view->data + view->length - suffix->length, suffix->data, suffix->length) == 0) return true;
+
+    return false;
+
+}
+
+ds_String* ds_string_from_view(const ds_StringView* view) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return NULL;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return NULL;
+    }
+
+    ds_String* string = ds_init_string_allocator_n(ds_global_allocator, view->data, view->length);
+    return string;
+}
+
+ds_StringView ds_string_view_trim_whitespace(const ds_StringView *view) {
+    ds_StringView result = {0};
+
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return result;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return result;
+    }
+
+    char data[view->length];
+    uint32_t index = 0;
+
+    for (size_t i = 0; i < view->length; i++) {
+        if (view->data[i] != ' ') {
+            data[index++] = view->data[i];
+        }
+    }
+
+    result = ds_string_view_from_buffer(data, index);
+    
+    return result;
+}
+
+void ds_string_view_print(const ds_StringView *view) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return;
+    }
+
+    printf("%s\n", view->data);
+}
+
+const char* ds_string_view_get_data(const ds_StringView* view) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return NULL;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return NULL;
+    }
+
+    return view->data;
+} 
+
+uint32_t ds_string_view_get_length(const ds_StringView* view) {
+    if (!view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return -1;
+    }
+
+    if (!view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string data is NULL");
+        return -1;
+    }
+
+    return view->length;
+}
+
+/*  NOTE:
+ *  the number parsers take the whole view, no whitespace and no trailing
+ *  characters. on a syntax error they return 0, on overflow the closest
+ *  representable value, in both cases with success set to false.
+ */
+// all 8 bytes in '0'..'9'
+static inline bool ds_is_eight_digits(uint64_t chunk) {
+    return ((chunk & 0xf0f0f0f0f0f0f0f0ull)
+        | (((chunk + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// folds 8 ascii digits into their value with three multiplies
+static inline uint32_t ds_parse_eight_digits(uint64_t chunk) {
+    chunk -= 0x3030303030303030ull;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000ff000000ffull) * (100 + (1000000ull << 32)))
+        + (((chunk >> 16) & 0x000000ff000000ffull) * (1 + (10000ull << 32)))) >> 32;
+    return (uint32_t)chunk;
+}
+
+static inline bool ds_is_digit(char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+// consumes digits and accumulates them into value, wraps on overflow
+static const char* ds_accumulate_digits(const char* p, const char* end, uint64_t* value) {
+    uint64_t result = *value;
+
+    while (end - p >= 8) {
+        uint64_t chunk = ds_load_u64_le(p);
+        if (!ds_is_eight_digits(chunk)) break;
+        result = result * 100000000 + ds_parse_eight_digits(chunk);
+        p += 8;
+    }
+
+    while (p < end && ds_is_digit(*p)) {
+        result = result * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+
+    *value = result;
+    return p;
+}
+
+static DS_RESULT ds_parse_u64(const char* p, const char* end, uint64_t* value) {
+    *value = 0;
+    if (p == end) return DS_INVALID_INPUT;
+
+    // leading zeros dont count towards the 20 digits that fit
+    while (end - p > 1 && *p == '0') p++;
+
+    uint64_t result = 0;
+    const char* digits_end = ds_accumulate_digits(p, p + (end - p < 19 ? end - p : 19), &result);
+    size_t digits = digits_end - p;
+
+    if (digits_end != end) {
+        if (digits < 19 || !ds_is_digit(*digits_end)) return DS_INVALID_INPUT;
+
+        const char* tail = digits_end + 1;
+        while (tail < end && ds_is_digit(*tail)) tail++;
+        if (tail != end) return DS_INVALID_INPUT;
+
+        uint64_t last = (uint64_t)(*digits_end - '0');
+        if (tail - digits_end > 1 || result > (UINT64_MAX - last) / 10) {
+            *value = UINT64_MAX;
+            return DS_OVERFLOW;
+        }
+        result = result * 10 + last;
+    }
+
+    *value = result;
+    return DS_OK;
+}
+
+static DS_RESULT ds_parse_i64(const char* p, const char* end, int64_t* value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t magnitude;
+    DS_RESULT result = ds_parse_u64(p, end, &magnitude);
+    if (result == DS_INVALID_INPUT) {
+        *value = 0;
+        return result;
+    }
+
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    if (result == DS_OVERFLOW || magnitude > limit) {
+        *value = negative ? INT64_MIN : INT64_MAX;
+        return DS_OVERFLOW;
+    }
+
+    *value = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return DS_OK;
+}
+
+static inline bool ds_parse_check_view(const ds_StringView* view, bool* success) {
+    if (!view || !view->data) {
+        if (success) *success = false;
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input view is NULL");
+        return false;
+    }
+
+    return true;
+}
+
+static inline void ds_parse_report(DS_RESULT result, const ds_StringView* view, bool* success) {
+    if (success) *success = result == DS_OK;
+
+    if (result == DS_OVERFLOW) {
+        DS_SET_ERROR(DS_OVERFLOW, "Value %.*s is out of range", (int)view->length, view->data);
+    }
+    else if (result != DS_OK && result != DS_ALLOC_FAIL) { // allocation failures are reported where they happen
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input %.*s is not a number", (int)view->length, view->data);
+    }
+}
+
+int64_t ds_string_view_to_i64(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0;
+    }
+
+    int64_t value;
+    ds_parse_report(ds_parse_i64(view->data, view->data + view->length, &value), view, success);
+
+    return value;
+}
+
+uint64_t ds_string_view_to_u64(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0;
+    }
+
+    const char* p = view->data;
+    const char* end = p + view->length;
+    if (p < end && *p == '+') p++;
+
+    uint64_t value;
+    ds_parse_report(ds_parse_u64(p, end, &value), view, success);
+
+    return value;
+}
+
+int32_t ds_string_view_to_int(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0;
+    }
+
+    int64_t value;
+    DS_RESULT result = ds_parse_i64(view->data, view->data + view->length, &value);
+
+    if (value > INT32_MAX) {
+        value = INT32_MAX;
+        result = DS_OVERFLOW;
+    }
+    else if (value < INT32_MIN) {
+        value = INT32_MIN;
+        result = DS_OVERFLOW;
+    }
+
+    ds_parse_report(result, view, success);
+
+    return (int32_t)value;
+}
+
+uint64_t ds_string_view_to_hex(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0;
+    }
+
+    const char* p = view->data;
+    const char* end = p + view->length;
+    if (end - p >= 2 && p[0] == '0' && (p[1] | 0x20) == 'x') p += 2;
+
+    DS_RESULT result = p < end ? DS_OK : DS_INVALID_INPUT;
+    uint64_t value = 0;
+    size_t digits = 0;
+
+    for (; p < end; p++) {
+        uint32_t digit = (unsigned char)(*p - '0');
+        if (digit >= 10) {
+            digit = (unsigned char)((*p | 0x20) - 'a');
+            if (digit >= 6) {
+                result = DS_INVALID_INPUT;
+                break;
+            }
+            digit += 10;
+        }
+
+        if (digits || digit) digits++;
+        if (digits > 16) result = DS_OVERFLOW;
+        value = (value << 4) | digit;
+    }
+
+    if (result == DS_INVALID_INPUT) value = 0;
+    else if (result == DS_OVERFLOW) value = UINT64_MAX;
+
+    ds_parse_report(result, view, success);
+
+    return value;
+}
+
+static inline bool ds_ascii_equal_nocase(const char* data, const char* lower, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if ((data[i] | 0x20) != lower[i]) return false;
+    }
+
+    return true;
+}
+
+/*  NOTE:
+ *  Eisel-Lemire: multiply the normalized decimal mantissa with a 128 bit
+ *  approximation of 10^q and take the top 54 bits. when the truncated
+ *  product is too close to a rounding boundary it gives up and the
+ *  caller falls back to strtod.
+ */
+static bool ds_eisel_lemire(uint64_t mantissa, int64_t q, bool negative, double* out) {
+    uint64_t bits = 0;
+
+    if (mantissa == 0 || q < DS_POW10_MIN_EXPONENT) {
+        bits = 0;
+    }
+    else if (q > DS_POW10_MAX_EXPONENT) {
+        bits = 0x7ffull << DS_DOUBLE_MANTISSA_BITS;
+    }
+    else {
+        uint32_t shift = 63 - (ds_bit_length_u64(mantissa) - 1);
+        mantissa <<= shift;
+        uint64_t exponent = (uint64_t)((((int64_t)217706 * q) >> 16) + 64 + DS_DOUBLE_BIAS) - shift;
+
+        const uint64_t* power = ds_pow10_mantissa[q - DS_POW10_MIN_EXPONENT];
+        uint64_t high;
+        uint64_t low = ds_umul128(mantissa, power[1], &high);
+
+        // the lower 64 bits of the power only matter near a boundary
+        if ((high & 0x1ff) == 0x1ff && low + mantissa < mantissa) {
+            uint64_t y_high;
+            uint64_t y_low = ds_umul128(mantissa, power[0], &y_high);
+            uint64_t merged_high = high;
+            uint64_t merged_low = low + y_high;
+            if (merged_low < low) merged_high++;
+            if ((merged_high & 0x1ff) == 0x1ff && merged_low + 1 == 0 && y_low + mantissa < mantissa) {
+                return false;
+            }
+            high = merged_high;
+            low = merged_low;
+        }
+
+        uint64_t msb = high >> 63;
+        uint64_t result = high >> (msb + 9);
+        exponent -= 1 ^ msb;
+
+        // exactly halfway, cannot tell which way to round
+        if (low == 0 && (high & 0x1ff) == 0 && (result & 3) == 1) {
+            return false;
+        }
+
+        result += result & 1;
+        result >>= 1;
+        if (result >> 53) {
+            result >>= 1;
+            exponent++;
+        }
+
+        // subnormals, infinity and beyond take the slow path
+        if (exponent - 1 >= 0x7ff - 1) {
+            return false;
+        }
+
+        bits = exponent << DS_DOUBLE_MANTISSA_BITS | (result & ((1ull << DS_DOUBLE_MANTISSA_BITS) - 1));
+    }
+
+    if (negative) bits |= 1ull << 63;
+    memcpy(out, &bits, sizeof(*out));
+
+    return true;
+}
+
+static const double ds_exact_powers_of_ten[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/*  NOTE:
+ *  strtod reads the decimal point of the current locale, so a
+ *  process running under de_DE would stop at every '.'. the
+ *  fallback parses in a C locale created once, with strtod_l
+ *  where it is declared and a thread local uselocale otherwise
+ */
+#if defined(_WIN32)
+typedef _locale_t ds_Locale;
+#define ds_new_c_locale() _create_locale(LC_NUMERIC, "C")
+#define ds_free_locale(locale) _free_locale(locale)
+#else
+typedef locale_t ds_Locale;
+#define ds_new_c_locale() newlocale(LC_NUMERIC_MASK, "C", (locale_t)0)
+#define ds_free_locale(locale) freelocale(locale)
+#endif
+
+static _Atomic(ds_Locale) ds_c_locale = NULL;
+
+static ds_Locale ds_get_c_locale(void) {
+    ds_Locale locale = atomic_load_explicit(&ds_c_locale, memory_order_acquire);
+    if (locale) return locale;
+
+    ds_Locale created = ds_new_c_locale();
+    if (!created) return NULL;
+
+    // another thread may have been faster, its locale wins
+    if (!atomic_compare_exchange_strong_explicit(&ds_c_locale, &locale, created,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        ds_free_locale(created);
+        return locale;
+    }
+
+    return created;
+}
+
+static double ds_strtod_c(const char* string, ds_Locale locale) {
+#if defined(_WIN32)
+    return _strtod_l(string, NULL, locale);
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__USE_GNU)
+    return strtod_l(string, NULL, locale);
+#else
+    locale_t previous = uselocale(locale);
+    double value = strtod(string, NULL);
+    uselocale(previous);
+    return value;
+#endif
+}
+
+// NUL terminated copy for strtod
+static bool ds_parse_double_fallback(const char* data, size_t length, double* value) {
+    ds_Locale locale = ds_get_c_locale();
+    if (!locale) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to create the C locale");
+        return false;
+    }
+
+    char stack_buffer[128];
+    char* buffer = length < sizeof(stack_buffer)
+        ? stack_buffer
+        : (char*)ds_allocator_alloc(ds_global_allocator, length + 1);
+    if (!buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", length + 1);
+        return false;
+    }
+
+    memcpy(buffer, data, length);
+    buffer[length] = '\0';
+    *value = ds_strtod_c(buffer, locale);
+
+    if (buffer != stack_buffer) ds_allocator_free(ds_global_allocator, buffer, length + 1);
+
+    return true;
+}
+
+static DS_RESULT ds_parse_double(const char* start, const char* end, double* value) {
+    const char* p = start;
+    *value = 0.0;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    size_t rest = end - p;
+    if ((rest == 3 || rest == 8) && ds_ascii_equal_nocase(p, "infinity", rest)) {
+        *value = negative ? -HUGE_VAL : HUGE_VAL;
+        return DS_OK;
+    }
+    if (rest == 3 && ds_ascii_equal_nocase(p, "nan", 3)) {
+        *value = negative ? -NAN : NAN;
+        return DS_OK;
+    }
+
+    uint64_t mantissa = 0;
+    const char* integer_begin = p;
+    p = ds_accumulate_digits(p, end, &mantissa);
+    size_t integer_digits = p - integer_begin;
+
+    size_t fraction_digits = 0;
+    if (p < end && *p == '.') {
+        const char* fraction_begin = ++p;
+        p = ds_accumulate_digits(p, end, &mantissa);
+        fraction_digits = p - fraction_begin;
+    }
+    const char* digits_end = p;
+
+    if (integer_digits + fraction_digits == 0) return DS_INVALID_INPUT;
+
+    int64_t exponent = 0;
+    if (p < end && (*p | 0x20) == 'e') {
+        p++;
+        bool negative_exponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative_exponent = *p == '-';
+            p++;
+        }
+        if (p == end) return DS_INVALID_INPUT;
+
+        for (; p < end && ds_is_digit(*p); p++) {
+            // anything past this is zero or infinity anyway
+            if (exponent < 100000) exponent = exponent * 10 + (*p - '0');
+        }
+        if (negative_exponent) exponent = -exponent;
+    }
+
+    if (p != end) return DS_INVALID_INPUT;
+
+    // more than 19 digits wrapped the mantissa, redo it with the first 19 significant ones
+    bool truncated = false;
+    exponent -= (int64_t)fraction_digits;
+    if (integer_digits + fraction_digits > 19) {
+        mantissa = 0;
+        exponent += (int64_t)fraction_digits;
+
+        uint32_t taken = 0;
+        bool in_fraction = false;
+        const char* s = integer_begin;
+        for (; s < digits_end && taken < 19; s++) {
+            if (*s == '.') {
+                in_fraction = true;
+                continue;
+            }
+            if (in_fraction) exponent--;
+            if (taken == 0 && *s == '0') continue;
+            mantissa = mantissa * 10 + (uint64_t)(*s - '0');
+            taken++;
+        }
+
+        for (; s < digits_end; s++) {
+            if (*s == '.') in_fraction = true;
+            else if (!in_fraction) exponent++;
+            if (*s != '0' && *s != '.') truncated = true;
+        }
+    }
+
+    // both operands exact, so one rounding gives the correct result
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+    if (!truncated && exponent >= -22 && exponent <= 22 && mantissa <= (1ull << 53)) {
+        double result = (double)mantissa;
+        result = exponent < 0 ? result / ds_exact_powers_of_ten[-exponent] : result * ds_exact_powers_of_ten[exponent];
+        *value = negative ? -result : result;
+        return DS_OK;
+    }
+#endif
+
+    double result;
+    bool done = ds_eisel_lemire(mantissa, exponent, negative, &result);
+
+    // the dropped digits only matter if they push the value into the next double
+    if (done && truncated) {
+        double upper;
+        done = ds_eisel_lemire(mantissa + 1, exponent, negative, &upper) && upper == result;
+    }
+
+    if (!done && !ds_parse_double_fallback(start, end - start, &result)) {
+        return DS_ALLOC_FAIL;
+    }
+
+    *value = result;
+    return isinf(result) ? DS_OVERFLOW : DS_OK;
+}
+
+double ds_string_view_to_double(const ds_StringView* view, bool* success) {
+    if (!ds_parse_check_view(view, success)) {
+        return 0.0;
+    }
+
+    double value;
+    ds_parse_report(ds_parse_double(view->data, view->data + view->length, &value), view, success);
+
+    return value;
+}
+
+static inline void ds_split_iter_start(ds_SplitIter* iter, const ds_StringView* view, uint32_t kind, uint32_t flags) {
+    iter->rest = *view;
+    iter->kind = kind;
+    iter->flags = flags;
+    iter->done = false;
+}
+
+size_t ds_split_iter_init_char(ds_SplitIter* iter, const ds_StringView* view, char delimiter, uint32_t flags) {
+    if (!iter || !view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or view is NULL or has no data");
+        return -1;
+    }
+
+    ds_split_iter_start(iter, view, DS_SPLIT_ON_CHAR, flags);
+    iter->delimiter.c = delimiter;
+
+    return 0;
+}
+
+size_t ds_split_iter_init_string(ds_SplitIter* iter, const ds_StringView* view, const ds_StringView* delimiter, uint32_t flags) {
+    if (!iter || !view || !view->data || !delimiter) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator, view or delimiter is NULL");
+        return -1;
+    }
+
+    if (delimiter->length == 0) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Delimiter is empty");
+        return -1;
+    }
+
+    if (ds_searcher_init(&iter->delimiter.searcher, delimiter) != 0) {
+        return -1;
+    }
+
+    ds_split_iter_start(iter, view, DS_SPLIT_ON_STRING, flags);
+
+    return 0;
+}
+
+size_t ds_split_iter_init_set(ds_SplitIter* iter, const ds_StringView* view, const ds_ByteSet* delimiters, uint32_t flags) {
+    if (!iter || !view || !view->data || !delimiters) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator, view or delimiters are NULL");
+        return -1;
+    }
+
+    ds_split_iter_start(iter, view, DS_SPLIT_ON_SET, flags);
+    iter->delimiter.set = *delimiters;
+
+    return 0;
+}
+
+bool ds_split_iter_next(ds_SplitIter* iter, ds_StringView* token) {
+    if (!iter || !token) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Iterator or token is NULL");
+        return false;
+    }
+
+    while (!iter->done) {
+        const char* data = iter->rest.data;
+        size_t length = iter->rest.length;
+        const char* found;
+        size_t delimiter_length = 1;
+
+        switch (iter->kind) {
+            case DS_SPLIT_ON_CHAR:
+                found = ds_find_byte(data, length, iter->delimiter.c);
+                break;
+            case DS_SPLIT_ON_SET:
+                found = ds_find_in_byte_set(data, length, &iter->delimiter.set, true);
+                break;
+            default:
+                found = ds_searcher_search(&iter->delimiter.searcher, data, length);
+                delimiter_length = iter->delimiter.searcher.needle.length;
+                break;
+        }
+
+        ds_StringView next = { data, (uint32_t)(found ? (size_t)(found - data) : length) };
+        if (found) {
+            iter->rest.data = found + delimiter_length;
+            iter->rest.length = (uint32_t)(length - next.length - delimiter_length);
+        }
+        else {
+            iter->rest.data = data + length;
+            iter->rest.length = 0;
+            iter->done = true;
+        }
+
+        if (next.length > 0 || !(iter->flags & DS_SPLIT_SKIP_EMPTY)) {
+            *token = next;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// drains the iterator, a copy counts the tokens first so the array is allocated once at its exact size
+static ds_StringViewArray* ds_split_iter_collect_into(const ds_Allocator* allocator, ds_SplitIter* iter) {
+    ds_SplitIter counter = *iter;
+    ds_StringView token;
+
+    uint32_t count = 0;
+    while (ds_split_iter_next(&counter, &token)) count++;
+
+    // views live right behind the array header so one allocation is enough
+    size_t size = sizeof(ds_StringViewArray) + count * sizeof(ds_StringView);
+    ds_StringViewArray* array = (ds_StringViewArray*)ds_allocator_alloc(allocator, size);
+    if (!array) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from string view array failed");
+        return NULL;
+    }
+
+    array->views = (ds_StringView*)(array + 1);
+    array->count = 0;
+    array->capacity = count;
+    array->allocator = allocator;
+
+    while (array->count < count && ds_split_iter_next(iter, &token)) {
+        array->views[array->count++] = token;
+    }
+
+    return array;
+}
+
+ds_StringViewArray* ds_split_iter_collect(ds_SplitIter* iter) {
+    if (!iter) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input iterator is NULL");
+        return NULL;
+    }
+
+    return ds_split_iter_collect_into(ds_global_allocator, iter);
+}
+
+void ds_small_view_array_init(ds_SmallViewArray* array) {
+    ds_small_view_array_init_allocator(array, ds_global_allocator);
+}
+
+void ds_small_view_array_init_allocator(ds_SmallViewArray* array, const ds_Allocator* allocator) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return;
+    }
+
+    array->count = 0;
+    array->capacity = DS_STACK_CAPACITY;
+    array->allocator = allocator;
+}
+
+void ds_small_view_array_deinit(ds_SmallViewArray* array) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return;
+    }
+
+    if (ds_small_view_array_is_heap(array)) {
+        ds_allocator_free(array->allocator, array->heap_views, array->capacity * sizeof(ds_StringView));
+    }
+
+    array->count = 0;
+    array->capacity = DS_STACK_CAPACITY;
+}
+
+size_t ds_small_view_array_reserve(ds_SmallViewArray* array, size_t capacity) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return -1;
+    }
+
+    size_t current = ds_small_view_array_is_heap(array) ? array->capacity : DS_SMALL_VIEW_ARRAY_CAPACITY;
+    if (capacity <= current) {
+        return 0;
+    }
+
+    if (capacity > UINT32_MAX) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Requested capacity %zu is to big", capacity);
+        return -1;
+    }
+
+    ds_StringView* views;
+    if (ds_small_view_array_is_heap(array)) {
+        views = (ds_StringView*)ds_allocator_realloc(array->allocator, array->heap_views,
+                array->capacity * sizeof(ds_StringView), capacity * sizeof(ds_StringView));
+    }
+    else {
+        views = (ds_StringView*)ds_allocator_alloc(array->allocator, capacity * sizeof(ds_StringView));
+        if (views) memcpy(views, array->inline_views, array->count * sizeof(ds_StringView));
+    }
+
+    if (!views) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "View array allocation failed");
+        return -1;
+    }
+
+    array->heap_views = views;
+    array->capacity = (uint32_t)capacity;
+
+    return 0;
+}
+
+size_t ds_small_view_array_push(ds_SmallViewArray* array, const ds_StringView* view) {
+    if (!array || !view) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array or view is NULL");
+        return -1;
+    }
+
+    size_t capacity = ds_small_view_array_is_heap(array) ? array->capacity : DS_SMALL_VIEW_ARRAY_CAPACITY;
+    if (array->count == capacity) {
+        double grown = (double)capacity * ds_growth_factor;
+        if (grown > UINT32_MAX) grown = UINT32_MAX;
+        if (ds_small_view_array_reserve(array, (size_t)grown > capacity ? (size_t)grown : capacity + 1) != 0) {
+            return -1;
+        }
+    }
+
+    ds_small_view_array_data(array)[array->count++] = *view;
+
+    return 0;
+}
+
+void ds_small_view_array_clear(ds_SmallViewArray* array) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return;
+    }
+
+    array->count = 0;
+}
+
+size_t ds_split_iter_append(ds_SplitIter* iter, ds_SmallViewArray* array) {
+    if (!iter || !array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input iterator or array is NULL");
+        return -1;
+    }
+
+    ds_StringView token;
+    while (ds_split_iter_next(iter, &token)) {
+        if (ds_small_view_array_push(array, &token) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static ds_StringViewArray* ds_string_view_split_into(const ds_Allocator* allocator, const ds_StringView* view, char split) {
+    ds_SplitIter iter;
+    if (ds_split_iter_init_char(&iter, view, split, 0) != 0) {
+        return NULL;
+    }
+
+    return ds_split_iter_collect_into(allocator, &iter);
+}
+
+ds_StringViewArray* ds_string_view_split(const ds_StringView* view, char split) {
+    return ds_string_view_split_into(ds_global_allocator, view, split);
+}
+
+void ds_free_string_view_array(ds_StringViewArray* array) {
+    if (!array) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input array is NULL");
+        return;
+    }
+
+    if (array->views != (ds_StringView*)(array + 1)) {
+        ds_allocator_free(array->allocator, array->views, array->capacity * sizeof(ds_StringView));
+        ds_allocator_free(array->allocator, array, sizeof(ds_StringViewArray));
+    }
+    else {
+        ds_allocator_free(array->allocator, array, sizeof(ds_StringViewArray) + array->capacity * sizeof(ds_StringView));
+    }
+}
+
+/*  NOTE:
+ *  swiss table. every slot has a control byte that is EMPTY, DELETED
+ *  or the low 7 bits of the hash, and a probe compares a whole group
+ *  of 16 control bytes at once. the full hash, the length and the
+ *  first 4 bytes of the key sit next to the key pointer, so the key
+ *  itself is only read when all of them agree. groups are aligned and
+ *  visited in triangular order, which reaches every group of a power
+ *  of two table. the hash is ds_string_view_hash with seed 0, so
+ *  ds_String keys reuse their cached hash.
+ */
+#define DS_MAP_GROUP 16
+#define DS_MAP_EMPTY ((uint8_t)0x80)
+#define DS_MAP_DELETED ((uint8_t)0xfe)
+
+typedef struct {
+    uint64_t hash;
+    uint32_t length;
+    uint32_t prefix; // first 4 bytes of the key, zero padded
+    char* key; // NUL terminated copy owned by the map
+    void* value;
+} ds_MapEntry;
+
+struct ds_Map {
+    const ds_Allocator* allocator;
+    ds_MapEntry* entries;
+    uint8_t* control; // capacity bytes right after the entries, same allocation
+    size_t capacity;
+    size_t count;
+    size_t deleted;
+};
+
+// one bit per control byte of the group that equals tag
+static inline uint32_t ds_map_group_match(const uint8_t* control, uint8_t tag) {
+#if defined(DS_SIMD_SSE2)
+    return ds_match_mask16((const char*)control, _mm_set1_epi8((char)tag));
+#else
+    uint64_t pattern = ds_broadcast_byte((char)tag);
+    uint64_t low = ds_zero_byte_mask(ds_load_u64_le((const char*)control) ^ pattern) >> 7;
+    uint64_t high = ds_zero_byte_mask(ds_load_u64_le((const char*)control + 8) ^ pattern) >> 7;
+    return (uint32_t)((low * 0x0102040810204080ull) >> 56) | (uint32_t)((high * 0x0102040810204080ull) >> 56) << 8;
+#endif
+}
+
+// EMPTY and DELETED are the only control bytes with the high bit set
+static inline uint32_t ds_map_group_free(const uint8_t* control) {
+#if defined(DS_SIMD_SSE2)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)control));
+#else
+    uint64_t low = (ds_load_u64_le((const char*)control) & 0x8080808080808080ull) >> 7;
+    uint64_t high = (ds_load_u64_le((const char*)control + 8) & 0x8080808080808080ull) >> 7;
+    return (uint32_t)((low * 0x0102040810204080ull) >> 56) | (uint32_t)((high * 0x0102040810204080ull) >> 56) << 8;
+#endif
+}
+
+static inline uint32_t ds_map_prefix(const char* key, size_t length) {
+    uint32_t prefix = 0;
+    if (length > 0) memcpy(&prefix, key, length < sizeof(prefix) ? length : sizeof(prefix));
+    return prefix;
+}
+
+static inline size_t ds_map_table_size(size_t capacity) {
+    return capacity * (sizeof(ds_MapEntry) + 1);
+}
+
+static ds_MapEntry* ds_map_find(const ds_Map* map, const char* key, size_t length, uint64_t hash) {
+    if (map->capacity == 0) return NULL;
+
+    size_t group_mask = map->capacity / DS_MAP_GROUP - 1;
+    size_t group = (size_t)(hash >> 7) & group_mask;
+    uint8_t tag = (uint8_t)(hash & 0x7f);
+    uint32_t prefix = ds_map_prefix(key, length);
+
+    for (size_t step = 1;; step++) {
+        const uint8_t* control = map->control + group * DS_MAP_GROUP;
+
+        for (uint32_t match = ds_map_group_match(control, tag); match; match &= match - 1) {
+            ds_MapEntry* entry = &map->entries[group * DS_MAP_GROUP + ds_count_trailing_zeros(match)];
+            if (entry->hash == hash && entry->length == length && entry->prefix == prefix
+                && ds_mismatch(entry->key, key, length) == length) {
+                return entry;
+            }
+        }
+
+        // a group with an empty slot was never full, so the key cant be further along
+        if (ds_map_group_match(control, DS_MAP_EMPTY)) return NULL;
+
+        group = (group + step) & group_mask;
+    }
+}
+
+// the load limit keeps at least one slot in eight free, so this always ends
+static size_t ds_map_free_slot(const ds_Map* map, uint64_t hash) {
+    size_t group_mask = map->capacity / DS_MAP_GROUP - 1;
+    size_t group = (size_t)(hash >> 7) & group_mask;
+
+    for (size_t step = 1;; step++) {
+        uint32_t free_slots = ds_map_group_free(map->control + group * DS_MAP_GROUP);
+        if (free_slots) return group * DS_MAP_GROUP + ds_count_trailing_zeros(free_slots);
+
+        group = (group + step) & group_mask;
+    }
+}
+
+// moves every entry into a fresh table by its stored hash, this also drops the tombstones
+static size_t ds_map_rehash(ds_Map* map, size_t capacity) {
+    ds_MapEntry* entries = (ds_MapEntry*)ds_allocator_alloc(map->allocator, ds_map_table_size(capacity));
+    if (!entries) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", ds_map_table_size(capacity));
+        return -1;
+    }
+
+    ds_MapEntry* old_entries = map->entries;
+    uint8_t* old_control = map->control;
+    size_t old_capacity = map->capacity;
+
+    map->entries = entries;
+    map->control = (uint8_t*)(entries + capacity);
+    map->capacity = capacity;
+    map->deleted = 0;
+    memset(map->control, DS_MAP_EMPTY, capacity);
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_control[i] & 0x80) continue;
+
+        size_t slot = ds_map_free_slot(map, old_entries[i].hash);
+        map->control[slot] = old_control[i];
+        map->entries[slot] = old_entries[i];
+    }
+
+    if (old_entries) {
+        ds_allocator_free(map->allocator, old_entries, ds_map_table_size(old_capacity));
+    }
+
+    return 0;
+}
+
+// smallest table that holds count entries under the 7/8 load limit
+static size_t ds_map_capacity_for(size_t count) {
+    size_t capacity = DS_MAP_GROUP;
+    while (capacity / 8 * 7 < count) capacity *= 2;
+    return capacity;
+}
+
+static size_t ds_map_insert_hashed(ds_Map* map, const char* key, size_t length, uint64_t hash, void* value) {
+    ds_MapEntry* entry = ds_map_find(map, key, length, hash);
+    if (entry) {
+        entry->value = value;
+        return 0;
+    }
+
+    if (length >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "Key length %zu is to big", length);
+        return -1;
+    }
+
+    if (map->count + map->deleted >= map->capacity / 8 * 7) {
+        // mostly tombstones, rehashing at the same size is enough
+        size_t capacity = ds_map_capacity_for(map->count + 1);
+        if (capacity < map->capacity) capacity = map->capacity;
+        if (ds_map_rehash(map, capacity) != 0) {
+            return -1;
+        }
+    }
+
+    char* copy = (char*)ds_allocator_alloc(map->allocator, length + 1);
+    if (!copy) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", length + 1);
+        return -1;
+    }
+    if (length > 0) memcpy(copy, key, length);
+    copy[length] = '\0';
+
+    size_t slot = ds_map_free_slot(map, hash);
+    if (map->control[slot] == DS_MAP_DELETED) map->deleted--;
+
+    map->control[slot] = (uint8_t)(hash & 0x7f);
+    map->entries[slot].hash = hash;
+    map->entries[slot].length = (uint32_t)length;
+    map->entries[slot].prefix = ds_map_prefix(key, length);
+    map->entries[slot].key = copy;
+    map->entries[slot].value = value;
+    map->count++;
+
+    return 0;
+}
+
+ds_Map* ds_init_map(void) {
+    return ds_init_map_allocator(ds_global_allocator);
+}
+
+ds_Map* ds_init_map_allocator(const ds_Allocator* allocator) {
+    ds_Map* map = (ds_Map*)ds_allocator_alloc(allocator, sizeof(ds_Map));
+    if (!map) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", sizeof(ds_Map));
+        return NULL;
+    }
+
+    map->allocator = allocator;
+    map->entries = NULL;
+    map->control = NULL;
+    map->capacity = 0;
+    map->count = 0;
+    map->deleted = 0;
+
+    return map;
+}
+
+void ds_free_map(ds_Map* map) {
+    if (!map) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map is NULL");
+        return;
+    }
+
+    ds_map_clear(map);
+    if (map->entries) {
+        ds_allocator_free(map->allocator, map->entries, ds_map_table_size(map->capacity));
+    }
+    ds_allocator_free(map->allocator, map, sizeof(ds_Map));
+}
+
+void ds_map_clear(ds_Map* map) {
+    if (!map) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map is NULL");
+        return;
+    }
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->control[i] & 0x80) continue;
+        ds_allocator_free(map->allocator, map->entries[i].key, map->entries[i].length + 1);
+    }
+
+    if (map->capacity > 0) memset(map->control, DS_MAP_EMPTY, map->capacity);
+    map->count = 0;
+    map->deleted = 0;
+}
+
+size_t ds_map_count(const ds_Map* map) {
+    if (!map) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map is NULL");
+        return 0;
+    }
+
+    return map->count;
+}
+
+size_t ds_map_reserve(ds_Map* map, size_t count) {
+    if (!map) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map is NULL");
+        return -1;
+    }
+
+    size_t capacity = ds_map_capacity_for(count);
+    if (capacity <= map->capacity) return 0;
+
+    return ds_map_rehash(map, capacity);
+}
+
+size_t ds_map_insert(ds_Map* map, ds_String* key, void* value) {
+    if (!map || !key) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return -1;
+    }
+
+    return ds_map_insert_hashed(map, ds_data(key), ds_length(key), ds_string_hash(key), value);
+}
+
+size_t ds_map_insert_view(ds_Map* map, const ds_StringView* key, void* value) {
+    if (!map || !key || !key->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return -1;
+    }
+
+    return ds_map_insert_hashed(map, key->data, key->length, ds_string_view_hash(key, 0), value);
+}
+
+void** ds_map_get(const ds_Map* map, const ds_StringView* key) {
+    if (!map || !key || !key->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return NULL;
+    }
+
+    ds_MapEntry* entry = ds_map_find(map, key->data, key->length, ds_string_view_hash(key, 0));
+    return entry ? &entry->value : NULL;
+}
+
+void** ds_map_get_cstr(const ds_Map* map, const char* key) {
+    if (!map || !key) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return NULL;
+    }
+
+    size_t length = strlen(key);
+    ds_MapEntry* entry = ds_map_find(map, key, length, ds_hash_bytes(key, length, 0));
+    return entry ? &entry->value : NULL;
+}
+
+void** ds_map_get_string(const ds_Map* map, ds_String* key) {
+    if (!map || !key) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return NULL;
+    }
+
+    ds_MapEntry* entry = ds_map_find(map, ds_data(key), ds_length(key), ds_string_hash(key));
+    return entry ? &entry->value : NULL;
+}
+
+bool ds_map_remove(ds_Map* map, const ds_StringView* key) {
+    if (!map || !key || !key->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or key is NULL");
+        return false;
+    }
+
+    ds_MapEntry* entry = ds_map_find(map, key->data, key->length, ds_string_view_hash(key, 0));
+    if (!entry) return false;
+
+    size_t slot = (size_t)(entry - map->entries);
+    ds_allocator_free(map->allocator, entry->key, entry->length + 1);
+
+    // probes stop at a group with an empty slot, so only a full group needs a tombstone
+    if (ds_map_group_match(map->control + (slot & ~(size_t)(DS_MAP_GROUP - 1)), DS_MAP_EMPTY)) {
+        map->control[slot] = DS_MAP_EMPTY;
+    }
+    else {
+        map->control[slot] = DS_MAP_DELETED;
+        map->deleted++;
+    }
+    map->count--;
+
+    return true;
+}
+
+bool ds_map_next(const ds_Map* map, size_t* cursor, ds_StringView* key, void** value) {
+    if (!map || !cursor) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input map or cursor is NULL");
+        return false;
+    }
+
+    for (size_t i = *cursor; i < map->capacity; i++) {
+        if (map->control[i] & 0x80) continue;
+
+        if (key) *key = ds_string_view_from_buffer(map->entries[i].key, map->entries[i].length);
+        if (value) *value = map->entries[i].value;
+        *cursor = i + 1;
+        return true;
+    }
+
+    *cursor = map->capacity;
+    return false;
+}
+
+/*  NOTE:
+ *  the intern table is split into DS_INTERN_SHARDS shards by the top
+ *  bits of the hash. lookups of strings that are already interned take
+ *  no lock: slots only ever go from NULL to a finished entry, and a
+ *  grown table is published whole while the old one stays alive until
+ *  the intern table is freed, so a reader never sees freed memory.
+ *  inserts take the shard lock and re-probe. ids are handed out from
+ *  one counter and resolve through segments that double in size, so
+ *  they never move either.
+ */
+#define DS_INTERN_SHARD_BITS 6
+#define DS_INTERN_SHARDS (1u << DS_INTERN_SHARD_BITS)
+#define DS_INTERN_MIN_SLOTS 64
+#define DS_INTERN_SEGMENT_BITS 10
+#define DS_INTERN_SEGMENTS (32 - DS_INTERN_SEGMENT_BITS + 1)
+
+// the string has to come first, ds_intern_id casts back to the entry
+typedef struct {
+    ds_String string;
+    uint64_t hash;
+    const char* data;
+    uint32_t length;
+    uint32_t id;
+} ds_InternEntry;
+
+typedef struct ds_InternSlots ds_InternSlots;
+struct ds_InternSlots {
+    ds_InternSlots* retired; // the smaller tables this one replaced
+    size_t capacity;
+    _Atomic(ds_InternEntry*) slots[];
+};
+
+typedef struct {
+    atomic_int locked;
+    _Atomic(ds_InternSlots*) slots;
+    size_t count;
+    ds_Arena* arena; // entries never move or die before the table
+    char padding[32]; // keeps the hot fields of neighbouring shards apart
+} ds_InternShard;
+
+struct ds_InternTable {
+    ds_InternShard shards[DS_INTERN_SHARDS];
+    atomic_uint next_id;
+    _Atomic(ds_InternEntry**) segments[DS_INTERN_SEGMENTS];
+    const ds_Allocator* allocator; // slots, segments and the table itself, the default table uses malloc
+};
+
+static ds_InternTable ds_default_intern_table;
+
+static inline void ds_cpu_relax(void) {
+#if defined(DS_SIMD_SSE2)
+    _mm_pause();
+#endif
+}
+
+// the critical sections are a probe and maybe one allocation, a spin lock is enough
+static void ds_intern_lock(ds_InternShard* shard) {
+    for (;;) {
+        if (!atomic_exchange_explicit(&shard->locked, 1, memory_order_acquire)) return;
+        while (atomic_load_explicit(&shard->locked, memory_order_relaxed)) ds_cpu_relax();
+    }
+}
+
+static void ds_intern_unlock(ds_InternShard* shard) {
+    atomic_store_explicit(&shard->locked, 0, memory_order_release);
+}
+
+// segment 0 holds the first 2^DS_INTERN_SEGMENT_BITS ids, every later one as many as all before it
+static inline uint32_t ds_intern_segment(uint32_t id, uint32_t* offset, uint32_t* size) {
+    uint32_t block = id >> DS_INTERN_SEGMENT_BITS;
+    if (block == 0) {
+        *offset = id;
+        *size = 1u << DS_INTERN_SEGMENT_BITS;
+        return 0;
+    }
+
+    uint32_t segment = ds_bit_length_u64(block);
+    *size = (1u << DS_INTERN_SEGMENT_BITS) << (segment - 1);
+    *offset = id - *size;
+    return segment;
+}
+
+static ds_InternEntry** ds_intern_segment_entries(ds_InternTable* table, uint32_t segment, uint32_t size) {
+    ds_InternEntry** entries = atomic_load_explicit(&table->segments[segment], memory_order_acquire);
+    if (entries) return entries;
+
+    size_t bytes = (size_t)size * sizeof(ds_InternEntry*);
+    ds_InternEntry** fresh = (ds_InternEntry**)ds_allocator_alloc(table->allocator, bytes);
+    if (!fresh) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", bytes);
+        return NULL;
+    }
+    memset(fresh, 0, bytes);
+
+    // shards race for the same segment, the loser frees its copy
+    if (!atomic_compare_exchange_strong_explicit(&table->segments[segment], &entries, fresh,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        ds_allocator_free(table->allocator, fresh, bytes);
+        return entries;
+    }
+
+    return fresh;
+}
+
+/*  NOTE:
+ *  an id is only taken once its segment exists, so publishing
+ *  it cant fail and every id below next_id resolves. the counter
+ *  stops at UINT32_MAX, which ds_intern_id uses as the error value
+ */
+static size_t ds_intern_take_id(ds_InternTable* table, ds_InternEntry* entry) {
+    uint32_t id = atomic_load_explicit(&table->next_id, memory_order_relaxed);
+    uint32_t offset, size, segment;
+    ds_InternEntry** entries;
+
+    do {
+        if (id == UINT32_MAX) {
+            DS_SET_ERROR(DS_OVERFLOW, "Intern table ran out of ids");
+            return -1;
+        }
+
+        segment = ds_intern_segment(id, &offset, &size);
+        entries = ds_intern_segment_entries(table, segment, size);
+        if (!entries) return -1;
+    } while (!atomic_compare_exchange_weak_explicit(&table->next_id, &id, id + 1,
+                                                    memory_order_relaxed, memory_order_relaxed));
+
+    entry->id = id;
+    _Atomic(ds_InternEntry*)* slot = (_Atomic(ds_InternEntry*)*)&entries[offset];
+    atomic_store_explicit(slot, entry, memory_order_release);
+
+    return 0;
+}
+
+// the entry with this content, or NULL and the empty slot it would go into
+static ds_InternEntry* ds_intern_probe(ds_InternSlots* slots, const char* data, size_t length, uint64_t hash, size_t* empty) {
+    size_t mask = slots->capacity - 1;
+
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+        ds_InternEntry* entry = atomic_load_explicit(&slots->slots[i], memory_order_acquire);
+        if (!entry) {
+            if (empty) *empty = i;
+            return NULL;
+        }
+
+        if (entry->hash == hash && entry->length == length && ds_mismatch(entry->data, data, length) == length) {
+            return entry;
+        }
+    }
+}
+
+// called with the shard lock held, readers keep using the old slots until the new ones are published
+static inline size_t ds_intern_slots_size(size_t capacity) {
+    return sizeof(ds_InternSlots) + capacity * sizeof(ds_InternEntry*);
+}
+
+static ds_InternSlots* ds_intern_grow(ds_InternTable* table, ds_InternShard* shard, ds_InternSlots* old) {
+    size_t capacity = old ? old->capacity * 2 : DS_INTERN_MIN_SLOTS;
+    ds_InternSlots* slots = (ds_InternSlots*)ds_allocator_alloc(table->allocator, ds_intern_slots_size(capacity));
+    if (!slots) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", ds_intern_slots_size(capacity));
+        return NULL;
+    }
+    memset(slots, 0, ds_intern_slots_size(capacity));
+
+    slots->retired = old;
+    slots->capacity = capacity;
+
+    for (size_t i = 0; old && i < old->capacity; i++) {
+        ds_InternEntry* entry = atomic_load_explicit(&old->slots[i], memory_order_relaxed);
+        if (!entry) continue;
+
+        size_t j = (size_t)entry->hash & (capacity - 1);
+        while (atomic_load_explicit(&slots->slots[j], memory_order_relaxed)) j = (j + 1) & (capacity - 1);
+        atomic_store_explicit(&slots->slots[j], entry, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&shard->slots, slots, memory_order_release);
+
+    return slots;
+}
+
+static ds_InternEntry* ds_intern_new_entry(ds_InternShard* shard, const ds_StringView* view, uint64_t hash) {
+    if (!shard->arena) {
+        shard->arena = ds_init_arena(0);
+        if (!shard->arena) return NULL;
+    }
+
+    size_t size = sizeof(ds_InternEntry);
+    if (view->length > DS_SMALL_STRING_CAPACITY) size += view->length + 1;
+
+    ds_InternEntry* entry = (ds_InternEntry*)ds_arena_alloc(shard->arena, size);
+    if (!entry) return NULL;
+
+    ds_string_reset(&entry->string);
+    if (view->length <= DS_SMALL_STRING_CAPACITY) {
+        memcpy(entry->string.stack_data, view->data, view->length);
+        entry->string.stack_data[view->length] = '\0';
+        ds_set_length(&entry->string, view->length);
+    }
+    else {
+        char* data = (char*)(entry + 1);
+        memcpy(data, view->data, view->length);
+        data[view->length] = '\0';
+        // the bytes live in the shard arena, clones borrow them and writes copy them out
+        ds_string_set_borrowed_buffer(&entry->string, data, view->length, view->length + 1);
+    }
+    ds_string_cache_hash(&entry->string, hash);
+
+    entry->hash = hash;
+    entry->data = ds_data(&entry->string);
+    entry->length = view->length;
+
+    return entry;
+}
+
+ds_InternTable* ds_init_intern_table(void) {
+    return ds_init_intern_table_allocator(ds_global_allocator);
+}
+
+ds_InternTable* ds_init_intern_table_allocator(const ds_Allocator* allocator) {
+    ds_InternTable* table = (ds_InternTable*)ds_allocator_alloc(allocator, sizeof(ds_InternTable));
+    if (!table) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate %zu bytes", sizeof(ds_InternTable));
+        return NULL;
+    }
+    memset(table, 0, sizeof(ds_InternTable));
+    table->allocator = allocator;
+
+    return table;
+}
+
+void ds_free_intern_table(ds_InternTable* table) {
+    if (!table) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input table is NULL");
+        return;
+    }
+
+    for (size_t s = 0; s < DS_INTERN_SHARDS; s++) {
+        ds_InternSlots* slots = atomic_load_explicit(&table->shards[s].slots, memory_order_relaxed);
+        while (slots) {
+            ds_InternSlots* retired = slots->retired;
+            ds_allocator_free(table->allocator, slots, ds_intern_slots_size(slots->capacity));
+            slots = retired;
+        }
+
+        if (table->shards[s].arena) {
+            ds_free_arena(table->shards[s].arena);
+        }
+    }
+
+    for (size_t i = 0; i < DS_INTERN_SEGMENTS; i++) {
+        ds_InternEntry** entries = atomic_load_explicit(&table->segments[i], memory_order_relaxed);
+        if (!entries) continue;
+
+        uint32_t size = (1u << DS_INTERN_SEGMENT_BITS) << (i ? i - 1 : 0);
+        ds_allocator_free(table->allocator, entries, (size_t)size * sizeof(ds_InternEntry*));
+    }
+
+    if (table != &ds_default_intern_table) {
+        ds_allocator_free(table->allocator, table, sizeof(ds_InternTable));
+    }
+}
+
+const ds_String* ds_intern_table_intern(ds_InternTable* table, const ds_StringView* view) {
+    if (!table || !view || !view->data) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input table or view is NULL");
+        return NULL;
+    }
+
+    uint64_t hash = ds_string_view_hash(view, 0);
+    ds_InternShard* shard = &table->shards[hash >> (64 - DS_INTERN_SHARD_BITS)];
+
+    ds_InternSlots* slots = atomic_load_explicit(&shard->slots, memory_order_acquire);
+    if (slots) {
+        ds_InternEntry* entry = ds_intern_probe(slots, view->data, view->length, hash, NULL);
+        if (entry) return &entry->string;
+    }
+
+    ds_intern_lock(shard);
+
+    // another thread may have added it or grown the table in the meantime
+    size_t empty = 0;
+    slots = atomic_load_explicit(&shard->slots, memory_order_relaxed);
+    if (slots) {
+        ds_InternEntry* entry = ds_intern_probe(slots, view->data, view->length, hash, &empty);
+        if (entry) {
+            ds_intern_unlock(shard);
+            return &entry->string;
+        }
+    }
+
+    // half full at most, so probes stay short and always find an empty slot
+    if (!slots || (shard->count + 1) * 2 > slots->capacity) {
+        slots = ds_intern_grow(table, shard, slots);
+        if (!slots) {
+            ds_intern_unlock(shard);
+            return NULL;
+        }
+        ds_intern_probe(slots, view->data, view->length, hash, &empty);
+    }
+
+    ds_InternEntry* entry = ds_intern_new_entry(shard, view, hash);
+    if (!entry) {
+        ds_intern_unlock(shard);
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Failed to allocate the interned string");
+        return NULL;
+    }
+
+    // the id resolves before anyone can find the entry
+    if (ds_intern_take_id(table, entry) != 0) {
+        ds_intern_unlock(shard);
+        return NULL;
+    }
+    atomic_store_explicit(&slots->slots[empty], entry, memory_order_release);
+    shard->count++;
+
+    ds_intern_unlock(shard);
+
+    return &entry->string;
+}
+
+const ds_String* ds_intern_table_lookup(ds_InternTable* table, uint32_t id) {
+    if (!table) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input table is NULL");
+        return NULL;
+    }
+
+    if (id >= atomic_load_explicit(&table->next_id, memory_order_relaxed)) {
+        DS_SET_ERROR(DS_OUT_OF_BOUNDS, "Id %u was never handed out", id);
+        return NULL;
+    }
+
+    uint32_t offset, size;
+    uint32_t segment = ds_intern_segment(id, &offset, &size);
+    ds_InternEntry** entries = atomic_load_explicit(&table->segments[segment], memory_order_acquire);
+    if (!entries) return NULL;
+
+    ds_InternEntry* entry = atomic_load_explicit((_Atomic(ds_InternEntry*)*)&entries[offset], memory_order_acquire);
+    return entry ? &entry->string : NULL;
+}
+
+size_t ds_intern_table_count(ds_InternTable* table) {
+    if (!table) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input table is NULL");
+        return 0;
+    }
+
+    size_t count = 0;
+    for (size_t s = 0; s < DS_INTERN_SHARDS; s++) {
+        ds_intern_lock(&table->shards[s]);
+        count += table->shards[s].count;
+        ds_intern_unlock(&table->shards[s]);
+    }
+
+    return count;
+}
+
+const ds_String* ds_intern(const ds_StringView* view) {
+    return ds_intern_table_intern(&ds_default_intern_table, view);
+}
+
+const ds_String* ds_intern_lookup(uint32_t id) {
+    return ds_intern_table_lookup(&ds_default_intern_table, id);
+}
+
+uint32_t ds_intern_id(const ds_String* interned) {
+    if (!interned) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input string is NULL");
+        return UINT32_MAX;
+    }
+
+    return ((const ds_InternEntry*)interned)->id;
+}
+
+static void ds_mapped_file_set(ds_MappedFile* file, void* address, size_t size, bool mapped) {
+    file->address = address;
+    file->data = address ? (const char*)address : "";
+    file->size = size;
+    file->mapped = mapped;
+    file->view.data = file->data;
+    file->view.length = size <= DS_MAX_CAPACITY ? (uint32_t)size : 0;
+}
+
+// bytes that fit behind length without growing, the terminator excluded
+static inline size_t ds_string_room(ds_String* string, size_t length) {
+    return (ds_is_stack(string) ? DS_SMALL_STRING_CAPACITY : ds_capacity(string) - 1) - length;
+}
+
+#ifdef DS_HAS_MMAP
+
+// reads an fd that cant be mapped into a heap buffer, ds_unmap_file frees it
+static size_t ds_map_file_read(ds_MappedFile* file, int fd, const char* path) {
+    size_t capacity = 4096;
+    size_t size = 0;
+    char* buffer = (char*)malloc(capacity);
+    if (!buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "File buffer allocation failed");
+        return -1;
+    }
+
+    for (;;) {
+        if (size == capacity) {
+            char* grown = (char*)realloc(buffer, capacity * 2);
+            if (!grown) {
+                DS_SET_ERROR(DS_ALLOC_FAIL, "File buffer reallocation failed");
+                free(buffer);
+                return -1;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
+
+        ssize_t got = read(fd, buffer + size, capacity - size);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            DS_SET_ERROR(DS_ERROR, "Failed to read %s: %s", path, strerror(errno));
+            free(buffer);
+            return -1;
+        }
+        if (got == 0) break;
+        size += (size_t)got;
+    }
+
+    if (!size) {
+        free(buffer);
+        buffer = NULL;
+    }
+    ds_mapped_file_set(file, buffer, size, false);
+
+    return 0;
+}
+
+size_t ds_map_file(ds_MappedFile* file, const char* path, uint32_t flags) {
+    if (!file || !path) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input is NULL");
+        return -1;
+    }
+
+    memset(file, 0, sizeof(*file));
+    ds_mapped_file_set(file, NULL, 0, false);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to open %s: %s", path, strerror(errno));
+        return -1;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to stat %s: %s", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    if (!S_ISREG(info.st_mode)) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "%s is not a regular file", path);
+        close(fd);
+        return -1;
+    }
+
+    // procfs and sysfs files report no size but have content, mmap refuses empty ranges anyway
+    size_t size = (size_t)info.st_size;
+    if (size == 0) {
+        size_t result = ds_map_file_read(file, fd, path);
+        close(fd);
+        return result;
+    }
+
+    void* address = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps its own reference to the file
+    if (address == MAP_FAILED) {
+        DS_SET_ERROR(DS_ERROR, "Failed to map %s: %s", path, strerror(errno));
+        return -1;
+    }
+
+    // only hints, a kernel that ignores them still gives a valid mapping. huge pages
+    // for page cache files need CONFIG_READ_ONLY_THP_FOR_FS, without it this is a no-op
+#ifdef MADV_HUGEPAGE
+    if (flags & DS_FILE_HUGE_PAGES) madvise(address, size, MADV_HUGEPAGE);
+#endif
+    if (flags & DS_FILE_SEQUENTIAL) madvise(address, size, MADV_SEQUENTIAL);
+    if (flags & DS_FILE_WILLNEED) madvise(address, size, MADV_WILLNEED);
+
+    ds_mapped_file_set(file, address, size, true);
+    return 0;
+}
+
+/*  NOTE:
+ *  regular files are sized by fstat and read straight into
+ *  the empty string, so the content is copied once, by the kernel.
+ *  a file that grew since the fstat still ends up complete,
+ *  the buffer only grows if the one byte probe at the
+ *  expected end actually finds more
+ */
+static size_t ds_read_file_into(ds_String* string, const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to open %s: %s", path, strerror(errno));
+        return -1;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to stat %s: %s", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    // pipes and procfs files report no size, those grow while they are read
+    size_t expected = S_ISREG(info.st_mode) ? (size_t)info.st_size : 0;
+    if (expected >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "File %s is to big for a string", path);
+        close(fd);
+        return -1;
+    }
+
+    if (ds_string_grow(string, expected, true) != 0) {
+        close(fd);
+        return -1;
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    size_t length = 0;
+    size_t result = 0;
+    for (;;) {
+        size_t room = ds_string_room(string, length);
+        char probe;
+        ssize_t got = room ? read(fd, ds_data(string) + length, room) : read(fd, &probe, 1);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            DS_SET_ERROR(DS_ERROR, "Failed to read %s: %s", path, strerror(errno));
+            result = -1;
+            break;
+        }
+        if (got == 0) break;
+
+        if (!room) {
+            // growing copies length chars, so they have to be counted first
+            ds_data(string)[length] = '\0';
+            ds_set_length(string, length);
+            if (ds_string_grow(string, length + 1, false) != 0) {
+                result = -1;
+                break;
+            }
+            ds_data(string)[length] = probe;
+        }
+        length += (size_t)got;
+    }
+
+    close(fd);
+    ds_data(string)[length] = '\0';
+    ds_set_length(string, length);
+
+    return result;
+}
+
+#else
+
+size_t ds_map_file(ds_MappedFile* file, const char* path, uint32_t flags) {
+    (void)flags;
+    if (!file || !path) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input is NULL");
+        return -1;
+    }
+
+    memset(file, 0, sizeof(*file));
+    ds_mapped_file_set(file, NULL, 0, false);
+
+    FILE* stream = fopen(path, "rb");
+    if (!stream) {
+        DS_SET_ERROR(DS_ERROR, "Failed to open %s", path);
+        return -1;
+    }
+
+    long size = fseek(stream, 0, SEEK_END) == 0 ? ftell(stream) : -1;
+    if (size < 0 || fseek(stream, 0, SEEK_SET) != 0) {
+        DS_SET_ERROR(DS_ERROR, "Failed to size %s", path);
+        fclose(stream);
+        return -1;
+    }
+    if (size == 0) {
+        fclose(stream);
+        return 0;
+    }
+
+    char* buffer = (char*)malloc((size_t)size);
+    if (!buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "File buffer allocation failed");
+        fclose(stream);
+        return -1;
+    }
+
+    size_t got = fread(buffer, 1, (size_t)size, stream);
+    fclose(stream);
+    ds_mapped_file_set(file, buffer, got, false);
+
+    return 0;
+}
+
+static size_t ds_read_file_into(ds_String* string, const char* path) {
+    FILE* stream = fopen(path, "rb");
+    if (!stream) {
+        DS_SET_ERROR(DS_ERROR, "Failed to open %s", path);
+        return -1;
+    }
+
+    long expected = fseek(stream, 0, SEEK_END) == 0 ? ftell(stream) : 0;
+    if (expected < 0 || fseek(stream, 0, SEEK_SET) != 0) expected = 0;
+    if ((size_t)expected >= DS_MAX_CAPACITY) {
+        DS_SET_ERROR(DS_INVALID_LENGTH, "File %s is to big for a string", path);
+        fclose(stream);
+        return -1;
+    }
+
+    if (ds_string_grow(string, (size_t)expected, true) != 0) {
+        fclose(stream);
+        return -1;
+    }
+
+    size_t length = 0;
+    size_t result = 0;
+    for (;;) {
+        size_t room = ds_string_room(string, length);
+        if (!room) {
+            ds_data(string)[length] = '\0';
+            ds_set_length(string, length);
+            if (ds_string_grow(string, length + 1, false) != 0) {
+                result = -1;
+                break;
+            }
+            room = ds_string_room(string, length);
+        }
+        size_t got = fread(ds_data(string) + length, 1, room, stream);
+        length += got;
+        if (got < room) break;
+    }
+
+    if (ferror(stream)) {
+        DS_SET_ERROR(DS_ERROR, "Failed to read %s", path);
+        result = -1;
+    }
+    fclose(stream);
+    ds_data(string)[length] = '\0';
+    ds_set_length(string, length);
+
+    return result;
+}
+
+#endif
+
+// the file goes into a fresh string, so a failed read leaves the old content alone
+size_t ds_read_file(ds_String* string, const char* path) {
+    if (!string || !path) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input is NULL");
+        return -1;
+    }
+
+    ds_String fresh;
+    ds_string_reset(&fresh);
+    ds_string_set_allocator(&fresh, ds_string_allocator(string));
+
+    if (ds_read_file_into(&fresh, path) != 0) {
+        ds_string_deinit(&fresh);
+        return -1;
+    }
+
+    bool sticky = ds_has_sticky_heap(string);
+    ds_string_deinit(string);
+    *string = fresh;
+    if (sticky) ds_set_sticky_heap(string);
+
+    return 0;
+}
+
+void ds_unmap_file(ds_MappedFile* file) {
+    if (!file) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input file is NULL");
+        return;
+    }
+
+#ifdef DS_HAS_MMAP
+    if (file->mapped) munmap(file->address, file->size);
+    else free(file->address);
+#else
+    free(file->address);
+#endif
+
+    ds_mapped_file_set(file, NULL, 0, false);
+}
+
+// one read, retried when a signal interrupts it. -1 with errno set on failure
+static ptrdiff_t ds_read_fd(int fd, char* buffer, size_t size) {
+#if defined(DS_HAS_MMAP)
+    ssize_t got;
+    do {
+        got = read(fd, buffer, size);
+    } while (got < 0 && errno == EINTR);
+    return got;
+#elif defined(_WIN32)
+    return _read(fd, buffer, size > INT32_MAX ? INT32_MAX : (unsigned)size);
+#else
+    (void)fd; (void)buffer; (void)size;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+size_t ds_line_reader_init(ds_LineReader* reader, int fd, size_t capacity, uint32_t flags) {
+    if (!reader) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input reader is NULL");
+        return -1;
+    }
+    if (fd < 0) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Invalid file descriptor %d", fd);
+        return -1;
+    }
+
+    memset(reader, 0, sizeof(*reader));
+    reader->capacity = capacity ? capacity : DS_LINE_READER_DEFAULT_CAPACITY;
+    if (reader->capacity > DS_MAX_CAPACITY) reader->capacity = DS_MAX_CAPACITY; // lines have to fit into a view
+    reader->fd = fd;
+    reader->flags = flags;
+    reader->allocator = ds_global_allocator;
+
+    reader->buffer = (char*)ds_allocator_alloc(reader->allocator, reader->capacity);
+    if (!reader->buffer) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Line buffer allocation failed");
+        return -1;
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL); // fails harmlessly on pipes and sockets
+#endif
+
+    return 0;
+}
+
+void ds_line_reader_deinit(ds_LineReader* reader) {
+    if (!reader) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input reader is NULL");
+        return;
+    }
+
+    if (reader->buffer) ds_allocator_free(reader->allocator, reader->buffer, reader->capacity);
+    reader->buffer = NULL;
+    reader->capacity = reader->start = reader->end = reader->scanned = 0;
+    reader->eof = true;
+}
+
+/*  NOTE:
+ *  every byte is scanned for a newline once, scanned remembers
+ *  how far the partial line at the end of the buffer got. when
+ *  the buffer runs out the partial line is moved to the front
+ *  and the rest is refilled, so only a line that fills the whole
+ *  buffer makes it grow
+ */
+bool ds_line_reader_next(ds_LineReader* reader, ds_StringView* line) {
+    if (!reader || !line) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input is NULL");
+        return false;
+    }
+
+    for (;;) {
+        char* data = reader->buffer + reader->start;
+        size_t available = reader->end - reader->start;
+
+        const char* newline = ds_find_byte(data + reader->scanned, available - reader->scanned, '\n');
+        if (newline) {
+            size_t length = (size_t)(newline - data);
+            reader->start += length + 1;
+            reader->scanned = 0;
+            if ((reader->flags & DS_LINE_STRIP_CR) && length && data[length - 1] == '\r') length--;
+            *line = ds_string_view_from_buffer(data, (uint32_t)length);
+            return true;
+        }
+        reader->scanned = available;
+
+        if (reader->eof) {
+            if (!available) return false;
+
+            reader->start = reader->end;
+            reader->scanned = 0;
+            *line = ds_string_view_from_buffer(data, (uint32_t)available);
+            return true;
+        }
+
+        if (reader->start) {
+            memmove(reader->buffer, data, available);
+            reader->start = 0;
+            reader->end = available;
+        }
+        else if (reader->end == reader->capacity) {
+            if (reader->capacity >= DS_MAX_CAPACITY) {
+                DS_SET_ERROR(DS_INVALID_LENGTH, "Line is to long for a view");
+                reader->eof = true;
+                return false;
+            }
+
+            size_t new_capacity = reader->capacity * 2;
+            if (new_capacity > DS_MAX_CAPACITY) new_capacity = DS_MAX_CAPACITY;
+            char* buffer = (char*)ds_allocator_realloc(reader->allocator, reader->buffer, reader->capacity, new_capacity);
+            if (!buffer) {
+                DS_SET_ERROR(DS_ALLOC_FAIL, "Line buffer reallocation failed");
+                reader->eof = true;
+                return false;
+            }
+            reader->buffer = buffer;
+            reader->capacity = new_capacity;
+        }
+
+        ptrdiff_t got = ds_read_fd(reader->fd, reader->buffer + reader->end, reader->capacity - reader->end);
+        if (got < 0) {
+            reader->error = errno;
+            reader->eof = true;
+            DS_SET_ERROR(DS_ERROR, "Failed to read fd %d: %s", reader->fd, strerror(reader->error));
+            return false;
+        }
+        if (got == 0) reader->eof = true;
+        reader->end += (size_t)got;
+    }
+}
+
+struct ds_ArenaBlock {
+    ds_ArenaBlock* next;
+    size_t capacity;
+    size_t used;
+    size_t last; // offset of the newest allocation, lets realloc grow in place
+    char data[];
+};
+
+static inline size_t ds_arena_align(size_t size) {
+    return (size + DS_ARENA_ALIGNMENT - 1) & ~((size_t)DS_ARENA_ALIGNMENT - 1);
+}
+
+static ds_ArenaBlock* ds_arena_new_block(size_t capacity) {
+    ds_ArenaBlock* block = (ds_ArenaBlock*)malloc(sizeof(ds_ArenaBlock) + capacity);
+    if (!block) {
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    block->last = 0;
+
+    return block;
+}
+
+static void* ds_arena_allocator_alloc(void* context, size_t size) {
+    return ds_arena_alloc((ds_Arena*)context, size);
+}
+
+static void* ds_arena_allocator_realloc(void* context, void* ptr, size_t old_size, size_t new_size) {
+    return ds_arena_realloc((ds_Arena*)context, ptr, old_size, new_size);
+}
+
+static void ds_arena_allocator_free(void* context, void* ptr, size_t size) {
+    (void)context; (void)ptr; (void)size;
+}
+
+static size_t ds_arena_allocator_usable_size(void* context, void* ptr, size_t size) {
+    (void)context; (void)ptr;
+    return ds_arena_align(size);
+}
+
+ds_Arena* ds_init_arena(size_t block_size) {
+    ds_Arena* arena = (ds_Arena*)malloc(sizeof(ds_Arena));
+    if (!arena) {
+        DS_SET_ERROR(DS_ALLOC_FAIL, "Allocation from arena failed");
+        return NULL;
+    }
+
+    arena->head = NULL;
+    arena->block_size = block_size ? ds_arena_align(block_size) : DS_ARENA_DEFAULT_BLOCK_SIZE;
+    arena->allocator.alloc = ds_arena_allocator_alloc;
+    arena->allocator.realloc = ds_arena_allocator_realloc;
+    arena->allocator.free = ds_arena_allocator_free;
+    arena->allocator.context = arena;
+    arena->allocator.usable_size = ds_arena_allocator_usable_size;
+
+    return arena;
+}
+
+void ds_free_arena(ds_Arena* arena) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return;
+    }
+
+    ds_ArenaBlock* block = arena->head;
+    while (block) {
+        ds_ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+void ds_arena_reset(ds_Arena* arena) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return;
+    }
+
+    // keep one regular block around so the next batch doesnt hit malloc
+    ds_ArenaBlock* keep = NULL;
+    ds_ArenaBlock* block = arena->head;
+    while (block) {
+        ds_ArenaBlock* next = block->next;
+        if (!keep && block->capacity == arena->block_size) {
+            keep = block;
+        }
+        else {
+            free(block);
+        }
+        block = next;
+    }
+
+    if (keep) {
+        keep->next = NULL;
+        keep->used = 0;
+        keep->last = 0;
+    }
+    arena->head = keep;
+}
+
+void* ds_arena_alloc(ds_Arena* arena, size_t size) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return NULL;
+    }
+
+    size_t aligned = ds_arena_align(size);
+    ds_ArenaBlock* block = arena->head;
+
+    if (!block || block->capacity - block->used < aligned) {
+        // oversized requests get their own block behind the current one
+        if (aligned > arena->block_size) {
+            ds_ArenaBlock* big = ds_arena_new_block(aligned);
+            if (!big) {
+                DS_SET_ERROR(DS_ALLOC_FAIL, "Arena block allocation failed");
+                return NULL;
+            }
+            big->used = aligned;
+            if (block) {
+                big->next = block->next;
+                block->next = big;
+            }
+            else {
+                arena->head = big;
+            }
+            return big->data;
+        }
+
+        block = ds_arena_new_block(arena->block_size);
+        if (!block) {
+            DS_SET_ERROR(DS_ALLOC_FAIL, "Arena block allocation failed");
+            return NULL;
+        }
+        block->next = arena->head;
+        arena->head = block;
+    }
+
+    block->last = block->used;
+    block->used += aligned;
+
+    return block->data + block->last;
+}
+
+void* ds_arena_realloc(ds_Arena* arena, void* ptr, size_t old_size, size_t new_size) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return NULL;
+    }
+
+    if (!ptr) {
+        return ds_arena_alloc(arena, new_size);
+    }
+
+    // newest allocation of the current block can just be bumped
+    ds_ArenaBlock* block = arena->head;
+    if (block && (char*)ptr == block->data + block->last
+            && ds_arena_align(new_size) <= block->capacity - block->last) {
+        block->used = block->last + ds_arena_align(new_size);
+        return ptr;
+    }
+
+    if (new_size <= old_size) {
+        return ptr;
+    }
+
+    void* new_ptr = ds_arena_alloc(arena, new_size);
+    if (!new_ptr) {
+        return NULL;
+    }
+    memcpy(new_ptr, ptr, old_size);
+
+    return new_ptr;
+}
+
+const ds_Allocator* ds_arena_allocator(ds_Arena* arena) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return NULL;
+    }
+
+    return &arena->allocator;
+}
+
+ds_String* ds_init_string_arena(ds_Arena* arena, const char* literal) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return NULL;
+    }
+
+    return ds_init_string_allocator(&arena->allocator, literal);
+}
+
+ds_StringViewArray* ds_string_view_split_arena(ds_Arena* arena, const ds_StringView* view, char split) {
+    if (!arena) {
+        DS_SET_ERROR(DS_INVALID_INPUT, "Input arena is NULL");
+        return NULL;
+    }
+
+    return ds_string_view_split_into(&arena->allocator, view, split);
+}
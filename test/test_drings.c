@@ -0,0 +1,651 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <drings/drings.h>
+
+// cross checks against libc and naive reference code, run with make test
+
+static int failures = 0;
+
+#define CHECK(condition, ...) \
+    do { \
+        if (!(condition)) { \
+            failures++; \
+            fprintf(stderr, "%s:%d: ", __FILE__, __LINE__); \
+            fprintf(stderr, __VA_ARGS__); \
+            fprintf(stderr, "\n"); \
+        } \
+    } while (0)
+
+static uint64_t next_random(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static bool same_double(double a, double b) {
+    if (isnan(a) || isnan(b)) return isnan(a) && isnan(b);
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static void check_i64(const char* text) {
+    bool success;
+    ds_StringView view = ds_string_view_from_cstr(text);
+    int64_t value = ds_string_view_to_i64(&view, &success);
+
+    errno = 0;
+    char* end;
+    long long expected = strtoll(text, &end, 10);
+    bool valid = *text && *end == '\0' && end != text;
+
+    CHECK(success == (valid && errno != ERANGE), "i64 %s: success %d", text, success);
+    if (valid) CHECK(value == expected, "i64 %s: %" PRId64 " != %lld", text, value, expected);
+}
+
+static void check_u64(const char* text) {
+    bool success;
+    ds_StringView view = ds_string_view_from_cstr(text);
+    uint64_t value = ds_string_view_to_u64(&view, &success);
+
+    errno = 0;
+    unsigned long long expected = strtoull(text, NULL, 10);
+    if (errno != ERANGE) CHECK(success && value == expected, "u64 %s: %" PRIu64 " != %llu", text, value, expected);
+    else CHECK(!success && value == UINT64_MAX, "u64 %s should overflow", text);
+}
+
+static void check_double(const char* text) {
+    bool success;
+    ds_StringView view = ds_string_view_from_cstr(text);
+    double value = ds_string_view_to_double(&view, &success);
+    double expected = strtod(text, NULL);
+
+    CHECK(same_double(value, expected), "double %s: %.17g != %.17g", text, value, expected);
+    CHECK(success == !isinf(expected), "double %s: success %d", text, success);
+}
+
+static void test_integers(void) {
+    const char* edges[] = {
+        "0", "-0", "+7", "9223372036854775807", "-9223372036854775808", "9223372036854775808",
+        "-9223372036854775809", "18446744073709551615", "000000000000000000000123", "12a", "-", "+", "",
+    };
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+        check_i64(edges[i]);
+    }
+    check_u64("18446744073709551615");
+    check_u64("18446744073709551616");
+
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    char text[32];
+    for (int i = 0; i < 200000; i++) {
+        uint64_t r = next_random(&state);
+        int64_t value = (int64_t)(r >> (r % 64));
+        if (r & 1) value = -value;
+        snprintf(text, sizeof(text), "%" PRId64, value);
+        check_i64(text);
+        snprintf(text, sizeof(text), "%" PRIu64, r >> (r % 64));
+        check_u64(text);
+    }
+}
+
+static void test_doubles(void) {
+    const char* edges[] = {
+        "0", "-0", "1", "0.1", "2.2250738585072014e-308", "2.2250738585072011e-308", "4.9406564584124654e-324",
+        "2.4703282292062327e-324", "2.4703282292062328e-324", "1.7976931348623157e308", "1.7976931348623159e308",
+        "1e-400", "1e400", "9007199254740993", "9007199254740993.0000000000000000001",
+        "0.1000000000000000055511151231257827021181583404541015625", "123456789012345678901234567890e-10",
+        "7.2057594037927933e16", "1e23", "8.5e-323",
+    };
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+        check_double(edges[i]);
+    }
+
+    uint64_t state = 0x2545f4914f6cdd1dull;
+    char text[128];
+    for (int i = 0; i < 200000; i++) {
+        uint64_t bits = next_random(&state);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (isnan(value) || isinf(value)) continue;
+
+        int precision = (int)(next_random(&state) % 20);
+        snprintf(text, sizeof(text), "%.*g", precision, value);
+        check_double(text);
+        snprintf(text, sizeof(text), "%.17g", value);
+        check_double(text);
+
+        // more digits than fit into 64 bits force the slow path
+        uint64_t r = next_random(&state);
+        int length = snprintf(text, sizeof(text), "%" PRIu64 "%" PRIu64 ".%" PRIu64 "e%d",
+                              r, next_random(&state), next_random(&state) % 1000, (int)(r % 700) - 360);
+        if (length < (int)sizeof(text)) check_double(text);
+    }
+}
+
+// whatever ds_append_double prints has to parse back to the same bits, with libc and with drings
+static void test_double_round_trip(void) {
+    uint64_t state = 0x853c49e6748fea9bull;
+    ds_String* text = ds_init_string("");
+
+    for (int i = 0; i < 200000; i++) {
+        uint64_t bits = next_random(&state);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (isnan(value) || isinf(value)) continue;
+
+        ds_clear(text);
+        ds_append_double(text, value);
+
+        bool success;
+        ds_StringView view = ds_string_view_from_string(text);
+        CHECK(same_double(ds_string_view_to_double(&view, &success), value) && success,
+              "round trip %s", ds_to_c_str(text));
+        CHECK(same_double(strtod(ds_to_c_str(text), NULL), value), "strtod round trip %s", ds_to_c_str(text));
+    }
+
+    ds_free_string(text);
+}
+
+static int32_t naive_find(const char* haystack, size_t length, const char* needle, size_t needle_length) {
+    for (size_t i = 0; i + needle_length <= length; i++) {
+        if (memcmp(haystack + i, needle, needle_length) == 0) return (int32_t)i;
+    }
+    return -1;
+}
+
+// small alphabets make periodic needles and near misses, which is where Two-Way earns its keep
+static void test_find_substr(void) {
+    uint64_t state = 0xda942042e4dd58b5ull;
+    char haystack[600];
+    char needle[80];
+
+    for (int i = 0; i < 100000; i++) {
+        size_t alphabet = 2 + next_random(&state) % 3;
+        size_t length = next_random(&state) % sizeof(haystack);
+        for (size_t j = 0; j < length; j++) haystack[j] = (char)('a' + next_random(&state) % alphabet);
+
+        size_t needle_length = next_random(&state) % sizeof(needle);
+        if (needle_length > length || next_random(&state) % 2) {
+            for (size_t j = 0; j < needle_length; j++) needle[j] = (char)('a' + next_random(&state) % alphabet);
+        }
+        else {
+            memcpy(needle, haystack + next_random(&state) % (length - needle_length + 1), needle_length);
+        }
+
+        ds_StringView view = ds_string_view_from_buffer(haystack, (uint32_t)length);
+        ds_StringView substr = ds_string_view_from_buffer(needle, (uint32_t)needle_length);
+        int32_t found = ds_string_view_find_substr(&view, &substr);
+        int32_t expected = naive_find(haystack, length, needle, needle_length);
+        CHECK(found == expected, "find %.*s in %.*s: %d != %d",
+              (int)needle_length, needle, (int)length, haystack, found, expected);
+    }
+}
+
+#define LONG_TEXT "a heap string that is long enough to never fit inline"
+
+static void test_copy_on_write(void) {
+    ds_String* source = ds_init_string(LONG_TEXT);
+
+    // changing either side copies, the other one keeps its content
+    ds_String clone = DS_STRING_INIT;
+    ds_clone(&clone, source);
+    ds_append(&clone, "!");
+    CHECK(strcmp(ds_to_c_str(source), LONG_TEXT) == 0, "source changed by appending to a clone");
+    CHECK(strcmp(ds_to_c_str(&clone), LONG_TEXT "!") == 0, "clone lost the append");
+
+    ds_clone(&clone, source);
+    CHECK(ds_pop(source) == 'e', "pop on a shared string");
+    CHECK(strcmp(ds_to_c_str(&clone), LONG_TEXT) == 0, "clone changed by a pop on the source");
+
+    // shared substrings arent terminated, pop_n below the inline size moves them to the stack
+    ds_String part = DS_STRING_INIT;
+    ds_clone_substr(&part, source, 2, 30);
+    CHECK(strcmp(ds_to_c_str(&part), "heap string that is long enoug") == 0, "substring %s", ds_to_c_str(&part));
+    ds_pop_n(&part, 26);
+    CHECK(strcmp(ds_to_c_str(&part), "heap") == 0, "pop_n on a substring gave %s", ds_to_c_str(&part));
+
+    ds_clone_substr(&part, source, 2, 30);
+    CHECK(ds_move_dsstring_to_stack(&part) != 0, "a 30 char substring cant go to the stack");
+    ds_clone_substr(&part, source, 2, 4);
+    CHECK(ds_move_dsstring_to_stack(&part) == 0 && strcmp(ds_to_c_str(&part), "heap") == 0, "substring to stack");
+
+    // releasing a shared string hands out a private copy
+    ds_clone(&clone, source);
+    size_t length;
+    char* buffer = ds_string_release(&clone, &length, NULL);
+    CHECK(buffer && length == strlen(LONG_TEXT) - 1 && memcmp(buffer, LONG_TEXT, length) == 0, "released buffer");
+    free(buffer);
+    CHECK(ds_length(&clone) == 0, "release leaves the string empty");
+    CHECK(memcmp(ds_to_c_str(source), LONG_TEXT, strlen(LONG_TEXT) - 1) == 0, "source changed by a release");
+
+    ds_string_deinit(&clone);
+    ds_string_deinit(&part);
+    ds_free_string(source);
+}
+
+static void test_borrowed(void) {
+    static const char text[] = LONG_TEXT;
+
+    // borrowed memory is never written or freed by the string
+    ds_String* wrapped = ds_string_wrap_cstr(text);
+    CHECK(ds_to_c_str(wrapped) == text, "wrapped cstr should be used in place");
+    ds_pop(wrapped);
+    ds_append(wrapped, "?");
+    CHECK(strcmp(ds_to_c_str(wrapped), "a heap string that is long enough to never fit inlin?") == 0, "wrapped %s", ds_to_c_str(wrapped));
+    CHECK(strcmp(text, LONG_TEXT) == 0, "borrowed memory was written");
+    ds_free_string(wrapped);
+
+    wrapped = ds_string_wrap(text, 6);
+    ds_String clone = DS_STRING_INIT;
+    ds_clone(&clone, wrapped);
+    ds_pop_n(wrapped, 2);
+    CHECK(strcmp(ds_to_c_str(wrapped), "a he") == 0 && strcmp(ds_to_c_str(&clone), "a heap") == 0, "clone of a borrowed string");
+    CHECK(ds_move_dsstring_to_stack(wrapped) == 0 && strcmp(ds_to_c_str(wrapped), "a he") == 0, "borrowed to stack");
+    ds_string_deinit(&clone);
+    ds_free_string(wrapped);
+
+    // adopted buffers belong to the string until they are released again
+    char* owned = malloc(64);
+    memcpy(owned, text, 40);
+    ds_String* adopted = ds_string_adopt(owned, 40, 64);
+    ds_append(adopted, "!");
+    CHECK(ds_length(adopted) == 41 && ds_data(adopted)[40] == '!', "append to an adopted buffer");
+    size_t length, capacity;
+    char* released = ds_string_release(adopted, &length, &capacity);
+    CHECK(released && length == 41 && capacity >= 42, "release of an adopted buffer");
+    free(released);
+    ds_free_string(adopted);
+}
+
+// the source of an append or set may be the string itself, growing must not pull it away
+static void test_self_append(void) {
+    for (size_t length = 1; length < 80; length += 7) {
+        char expected[200];
+        for (size_t i = 0; i < length; i++) expected[i] = (char)('a' + i % 26);
+
+        ds_String* string = ds_init_string_n(expected, length);
+        ds_append_n(string, ds_to_c_str(string), length);
+        memcpy(expected + length, expected, length);
+        CHECK(ds_length(string) == 2 * length && memcmp(ds_data(string), expected, 2 * length) == 0,
+              "self append of %zu chars", length);
+
+        ds_StringView tail = ds_string_view_from_string_substr(string, 1, (uint32_t)length);
+        ds_append_view(string, &tail);
+        CHECK(ds_length(string) == 3 * length && memcmp(ds_data(string) + 2 * length, expected + 1, length) == 0,
+              "self append of a view of %zu chars", length);
+
+        ds_StringView head = ds_string_view_from_string_substr(string, 0, (uint32_t)length);
+        ds_concat(string, (ds_StringView[]){ head, DS_LIT("-"), head }, 3);
+        CHECK(ds_length(string) == 5 * length + 1 && memcmp(ds_data(string) + 3 * length, expected, length) == 0
+              && memcmp(ds_data(string) + 4 * length + 1, expected, length) == 0, "self concat of %zu chars", length);
+        ds_pop_n(string, 2 * length + 1);
+
+        ds_set_n(string, ds_data(string) + 1, length);
+        CHECK(ds_length(string) == length && memcmp(ds_data(string), expected + 1, length) == 0,
+              "self set of %zu chars", length);
+
+        ds_free_string(string);
+    }
+}
+
+static void test_files(void) {
+    char path[] = "/tmp/drings_test_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd >= 0, "mkstemp failed");
+    if (fd < 0) return;
+
+    char content[10000];
+    for (size_t i = 0; i < sizeof(content); i++) content[i] = (i % 61 == 60) ? '\n' : (char)('a' + i % 26);
+    CHECK(write(fd, content, sizeof(content)) == (ssize_t)sizeof(content), "write failed");
+    close(fd);
+
+    ds_MappedFile file;
+    CHECK(ds_map_file(&file, path, DS_FILE_SEQUENTIAL) == 0 && file.size == sizeof(content)
+          && file.view.length == sizeof(content) && memcmp(file.data, content, sizeof(content)) == 0, "mapped file");
+    ds_unmap_file(&file);
+
+    ds_String* string = ds_init_string("old content");
+    CHECK(ds_read_file(string, path) == 0 && ds_length(string) == sizeof(content)
+          && memcmp(ds_data(string), content, sizeof(content)) == 0, "read file");
+    CHECK(ds_read_file(string, "/tmp") != 0 && ds_length(string) == sizeof(content), "failed read keeps the content");
+    remove(path);
+
+    // procfs reports a size of 0 for files that do have content
+    if (ds_read_file(string, "/proc/self/status") == 0) {
+        CHECK(ds_map_file(&file, "/proc/self/status", 0) == 0 && file.size > 0
+              && memcmp(file.data, "Name:", 5) == 0, "mapping a procfs file");
+        ds_unmap_file(&file);
+    }
+
+    ds_free_string(string);
+}
+
+// keys are "key-<n>", the reference holds n + 1 for present keys and 0 otherwise
+#define MAP_KEYS 700
+
+static void test_map(void) {
+    uint64_t state = 0x5eed;
+    uintptr_t reference[MAP_KEYS] = {0};
+    size_t count = 0;
+    char buffer[32];
+
+    ds_Map* map = ds_init_map();
+    CHECK(map != NULL, "ds_init_map failed");
+    if (!map) return;
+
+    for (int i = 0; i < 50000; i++) {
+        uint64_t random = next_random(&state);
+        uint32_t n = (uint32_t)(random % MAP_KEYS);
+        snprintf(buffer, sizeof(buffer), "key-%u", n);
+        ds_StringView key = ds_string_view_from_cstr(buffer);
+
+        switch ((random >> 32) % 4) {
+        case 0:
+        case 1: {
+            uintptr_t value = (random >> 40) + 1;
+            CHECK(ds_map_insert_view(map, &key, (void*)value) == 0, "insert %s failed", buffer);
+            if (!reference[n]) count++;
+            reference[n] = value;
+            break;
+        }
+        case 2: {
+            bool removed = ds_map_remove(map, &key);
+            CHECK(removed == (reference[n] != 0), "remove %s gave %d", buffer, removed);
+            if (reference[n]) count--;
+            reference[n] = 0;
+            break;
+        }
+        default: {
+            void** slot = ds_map_get(map, &key);
+            if (reference[n]) {
+                CHECK(slot && (uintptr_t)*slot == reference[n], "get %s gave the wrong value", buffer);
+            }
+            else {
+                CHECK(slot == NULL, "get %s found a removed key", buffer);
+            }
+            break;
+        }
+        }
+
+        CHECK(ds_map_count(map) == count, "count %zu, expected %zu", ds_map_count(map), count);
+    }
+
+    // every key shows up exactly once with its value
+    bool seen[MAP_KEYS] = {0};
+    size_t cursor = 0, visited = 0;
+    ds_StringView key;
+    void* value;
+    while (ds_map_next(map, &cursor, &key, &value)) {
+        unsigned n;
+        CHECK(key.length < sizeof(buffer), "iterated key is too long");
+        if (key.length >= sizeof(buffer)) break;
+        memcpy(buffer, key.data, key.length);
+        buffer[key.length] = '\0';
+
+        CHECK(sscanf(buffer, "key-%u", &n) == 1 && n < MAP_KEYS, "iterated unknown key %s", buffer);
+        if (n >= MAP_KEYS) continue;
+        CHECK(!seen[n], "iterated %s twice", buffer);
+        CHECK(reference[n] && (uintptr_t)value == reference[n], "iterated %s with the wrong value", buffer);
+        seen[n] = true;
+        visited++;
+    }
+    CHECK(visited == count, "iterated %zu keys, expected %zu", visited, count);
+
+    ds_map_clear(map);
+    CHECK(ds_map_count(map) == 0, "clear left %zu keys", ds_map_count(map));
+    cursor = 0;
+    CHECK(!ds_map_next(map, &cursor, &key, &value), "cleared map still iterates");
+
+    ds_free_map(map);
+}
+
+#define INTERN_THREADS 4
+#define INTERN_NAMES 5000
+
+typedef struct {
+    ds_InternTable* table;
+    unsigned start;
+    const ds_String* interned[INTERN_NAMES];
+} InternWork;
+
+static void* intern_names(void* argument) {
+    InternWork* work = (InternWork*)argument;
+    char buffer[32];
+
+    // every thread walks the names from a different start so they race on the same inserts
+    for (unsigned i = 0; i < INTERN_NAMES; i++) {
+        unsigned n = (work->start + i) % INTERN_NAMES;
+        snprintf(buffer, sizeof(buffer), "name-%u-with-some-padding", n);
+        ds_StringView view = ds_string_view_from_cstr(buffer);
+        work->interned[n] = ds_intern_table_intern(work->table, &view);
+    }
+
+    return NULL;
+}
+
+static void test_intern_threads(void) {
+    ds_InternTable* table = ds_init_intern_table();
+    CHECK(table != NULL, "ds_init_intern_table failed");
+    if (!table) return;
+
+    static InternWork work[INTERN_THREADS];
+    pthread_t threads[INTERN_THREADS];
+    for (unsigned t = 0; t < INTERN_THREADS; t++) {
+        work[t].table = table;
+        work[t].start = t * (INTERN_NAMES / INTERN_THREADS);
+        pthread_create(&threads[t], NULL, intern_names, &work[t]);
+    }
+    for (unsigned t = 0; t < INTERN_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    CHECK(ds_intern_table_count(table) == INTERN_NAMES, "count %zu, expected %d", ds_intern_table_count(table), INTERN_NAMES);
+
+    // ids are dense, so each one below the count has to map back to exactly one name
+    bool seen[INTERN_NAMES] = {0};
+    char buffer[32];
+    for (unsigned n = 0; n < INTERN_NAMES; n++) {
+        const ds_String* interned = work[0].interned[n];
+        CHECK(interned != NULL, "name %u was not interned", n);
+        if (!interned) continue;
+
+        for (unsigned t = 1; t < INTERN_THREADS; t++) {
+            CHECK(work[t].interned[n] == interned, "threads got different pointers for name %u", n);
+        }
+
+        snprintf(buffer, sizeof(buffer), "name-%u-with-some-padding", n);
+        CHECK(strcmp(ds_cdata(interned), buffer) == 0, "name %u has the wrong content", n);
+
+        uint32_t id = ds_intern_id(interned);
+        CHECK(id < INTERN_NAMES && !seen[id], "name %u got a bad or repeated id %u", n, id);
+        if (id < INTERN_NAMES) seen[id] = true;
+        CHECK(ds_intern_table_lookup(table, id) == interned, "id %u does not resolve to name %u", id, n);
+
+        // interning again after the race hands out the same string
+        ds_StringView view = ds_string_view_from_cstr(buffer);
+        CHECK(ds_intern_table_intern(table, &view) == interned, "name %u moved", n);
+    }
+    CHECK(ds_intern_table_lookup(table, INTERN_NAMES) == NULL, "an id past the count resolved");
+
+    ds_free_intern_table(table);
+}
+
+#define ARENA_STRINGS 200
+
+static void test_arena(void) {
+    // small blocks so strings spill over block ends and some outgrow a block
+    ds_Arena* arena = ds_init_arena(256);
+    CHECK(arena != NULL, "ds_init_arena failed");
+    if (!arena) return;
+
+#ifdef DS_COMPACT_STRING
+    // compact strings only take the global allocator
+    CHECK(ds_init_string_arena(arena, "x") == NULL, "compact string accepted an arena");
+#else
+    for (int round = 0; round < 2; round++) {
+        ds_String* strings[ARENA_STRINGS];
+        char expected[ARENA_STRINGS][64];
+
+        for (int i = 0; i < ARENA_STRINGS; i++) {
+            snprintf(expected[i], sizeof(expected[i]), "s%d", i);
+            strings[i] = ds_init_string_arena(arena, expected[i]);
+            CHECK(strings[i] != NULL, "arena string %d failed", i);
+        }
+
+        // grow every other string past the inline capacity, reallocating inside the arena
+        for (int i = 0; i < ARENA_STRINGS; i += 2) {
+            if (!strings[i]) continue;
+            for (int j = 0; j < 4; j++) {
+                ds_append(strings[i], "-0123456789");
+                strncat(expected[i], "-0123456789", sizeof(expected[i]) - strlen(expected[i]) - 1);
+            }
+        }
+
+        for (int i = 0; i < ARENA_STRINGS; i++) {
+            if (!strings[i]) continue;
+            CHECK(ds_length(strings[i]) == strlen(expected[i]) && strcmp(ds_to_c_str(strings[i]), expected[i]) == 0,
+                  "arena string %d is \"%s\", expected \"%s\"", i, ds_to_c_str(strings[i]), expected[i]);
+        }
+
+        // one string bigger than a whole block
+        ds_String* big = ds_init_string_arena(arena, "");
+        for (int j = 0; big && j < 100; j++) ds_append(big, "0123456789");
+        CHECK(big && ds_length(big) == 1000, "big arena string has the wrong length");
+
+        for (int i = 0; i < ARENA_STRINGS; i += 3) {
+            if (strings[i]) ds_free_string(strings[i]);
+        }
+
+        ds_StringView text = ds_string_view_from_cstr("a,bb,,ccc");
+        ds_StringViewArray* parts = ds_string_view_split_arena(arena, &text, ',');
+        CHECK(parts && parts->count == 4, "arena split gave the wrong count");
+        if (parts && parts->count == 4) {
+            CHECK(parts->views[1].length == 2 && memcmp(parts->views[1].data, "bb", 2) == 0, "arena split part 1 is wrong");
+            CHECK(parts->views[2].length == 0, "arena split part 2 is not empty");
+        }
+
+        // the second round reuses the blocks
+        ds_arena_reset(arena);
+    }
+#endif
+
+    ds_free_arena(arena);
+}
+
+typedef struct {
+    int fd;
+    const char* data;
+    size_t length;
+} PipeWrite;
+
+// writes in tiny random pieces so the reader sees lines split across reads
+static void* write_pipe(void* argument) {
+    PipeWrite* work = (PipeWrite*)argument;
+    uint64_t state = 0xfeed;
+
+    size_t offset = 0;
+    while (offset < work->length) {
+        size_t piece = 1 + next_random(&state) % 7;
+        if (piece > work->length - offset) piece = work->length - offset;
+
+        ssize_t written = write(work->fd, work->data + offset, piece);
+        if (written <= 0) break;
+        offset += (size_t)written;
+    }
+
+    close(work->fd);
+    return NULL;
+}
+
+#define LINE_COUNT 2000
+
+static void test_line_reader(void) {
+    uint64_t state = 0x1ead;
+    size_t lengths[LINE_COUNT];
+    bool crlf[LINE_COUNT];
+    char* text = malloc(LINE_COUNT * 130);
+    if (!text) return;
+
+    // lines of 0 to 40 bytes with a few longer than the reader buffer, ending in \n or \r\n.
+    // the last line has no newline at all
+    size_t length = 0;
+    for (int i = 0; i < LINE_COUNT; i++) {
+        uint64_t random = next_random(&state);
+        lengths[i] = random % 8 == 0 ? 100 + random % 25 : random % 41;
+        crlf[i] = (random >> 32) % 2;
+
+        for (size_t j = 0; j < lengths[i]; j++) text[length++] = (char)('a' + (i + j) % 26);
+        if (i == LINE_COUNT - 1) break;
+        if (crlf[i]) text[length++] = '\r';
+        text[length++] = '\n';
+    }
+
+    for (int strip = 0; strip < 2; strip++) {
+        int fds[2];
+        CHECK(pipe(fds) == 0, "pipe failed: %s", strerror(errno));
+
+        ds_LineReader reader;
+        CHECK(ds_line_reader_init(&reader, fds[0], 16, strip ? DS_LINE_STRIP_CR : 0) == 0, "ds_line_reader_init failed");
+
+        PipeWrite work = {fds[1], text, length};
+        pthread_t writer;
+        pthread_create(&writer, NULL, write_pipe, &work);
+
+        int count = 0;
+        size_t offset = 0;
+        ds_StringView line;
+        while (ds_line_reader_next(&reader, &line)) {
+            if (count == LINE_COUNT) {
+                count++;
+                break;
+            }
+
+            size_t expected = lengths[count];
+            if (crlf[count] && !strip && count < LINE_COUNT - 1) expected++;
+            CHECK(line.length == expected && memcmp(line.data, text + offset, expected) == 0,
+                  "line %d has length %u, expected %zu (strip %d)", count, (unsigned)line.length, expected, strip);
+
+            offset += lengths[count] + (crlf[count] ? 2 : 1);
+            count++;
+        }
+        CHECK(count == LINE_COUNT, "read %d lines, expected %d (strip %d)", count, LINE_COUNT, strip);
+        CHECK(reader.error == 0, "line reader failed: %s", strerror(reader.error));
+
+        pthread_join(writer, NULL);
+        ds_line_reader_deinit(&reader);
+        close(fds[0]);
+    }
+
+    free(text);
+}
+
+int main() {
+    ds_enable_error_loggin(false);
+
+    test_integers();
+    test_doubles();
+    test_double_round_trip();
+    test_find_substr();
+    test_copy_on_write();
+    test_borrowed();
+    test_self_append();
+    test_files();
+    test_map();
+    test_intern_threads();
+    test_arena();
+    test_line_reader();
+
+    if (failures) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+
+    printf("all checks passed\n");
+    return 0;
+}